@@ -0,0 +1,301 @@
+/* __________________________________________________________________________
+* MODULE DESCRIPTION:
+* -------------------
+* Filename : AdaptiveStop.h
+*
+* Author: Alexy Torres Aurora Dugo
+*
+* Description: This file contains the adaptive stopping of the benchmarks.
+* Instead of taking INT_BENCH_SAMPLE_COUNT samples, a benchmark given a
+* stopping state tracks a running estimate of the execution time statistic
+* selected by INT_BENCH_STOP_MODE and stops once the half-width of its
+* confidence interval is within INT_BENCH_STOP_TOLERANCE of the estimate.
+*
+* The mean interval is the normal approximation computed from the running
+* variance (Welford). The quantile interval is distribution free: its bounds
+* are the order statistics of ranks n.q -/+ z.sqrt(n.q.(1-q)), read from a
+* log-linear histogram of the execution times (64 buckets per power of two,
+* the relative resolution is 1/64).
+*
+* The stopping point of each benchmark (number of samples and interval
+* half-width) is recorded in the dump header.
+* __________________________________________________________________________
+*/
+
+/* __________________________________________________________________________
+* PREPROCESSOR DIRECTIVES:
+* ------------------------
+*/
+#ifndef __ADAPTIVE_STOP_H__
+#define __ADAPTIVE_STOP_H__
+
+#include <stdint.h>
+#include <ARINC653.h>
+#include <OSAbstractionLayer.h>
+
+/*******************************************************************************
+ * CONFIGURATION
+ ******************************************************************************/
+
+/* Execution time histogram of the quantile mode: 64 sub-buckets per power of
+ * two up to 2^(INT_BENCH_STOP_HIST_OCTAVES + 5)ns, larger values are put in
+ * the last bucket.
+ */
+#define INT_BENCH_STOP_HIST_SUB_BITS 6
+#define INT_BENCH_STOP_HIST_SUB      (1 << INT_BENCH_STOP_HIST_SUB_BITS)
+#ifndef INT_BENCH_STOP_HIST_OCTAVES
+#define INT_BENCH_STOP_HIST_OCTAVES  32
+#endif
+#define INT_BENCH_STOP_HIST_SIZE \
+    ((INT_BENCH_STOP_HIST_OCTAVES + 1) * INT_BENCH_STOP_HIST_SUB)
+
+/* Number of stopping points the dump header can hold */
+#define INT_BENCH_STOP_MAX_POINTS 19
+
+/*******************************************************************************
+ * TYPES
+ ******************************************************************************/
+
+/* Adaptive stopping state of a benchmark. The state is large in the quantile
+ * mode, it should not be allocated on the process stack.
+ */
+typedef struct {
+    /* Number of samples */
+    uint32_t count;
+    /* Set when the benchmark stopped */
+    uint32_t done;
+    /* Running mean and sum of the squared deviations (mean mode) */
+    double   mean;
+    double   m2;
+    /* Estimate and confidence interval half-width at the last check */
+    double   estimate;
+    double   halfWidth;
+#if INT_BENCH_STOP_MODE == INT_BENCH_STOP_QUANTILE
+    /* Execution time histogram */
+    uint32_t histogram[INT_BENCH_STOP_HIST_SIZE];
+#endif
+} int_bench_stop_t;
+
+/* Stopping point recorded in the dump header */
+typedef struct {
+    /* Benchmark ID (INT_BENCH_RECORD_ID) */
+    uint32_t id;
+    /* Number of samples taken */
+    uint32_t samples;
+    /* Interval half-width relative to the estimate (parts per million) */
+    uint32_t halfWidthPpm;
+} int_bench_stop_point_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/* Square root (Newton), the partitions do not link the math library */
+static inline double __IntBenchStopSqrt(const double value)
+{
+    double   root;
+    uint32_t i;
+
+    if(0.0 >= value)
+    {
+        return 0.0;
+    }
+
+    root = (1.0 < value) ? value : 1.0;
+    for(i = 0; i < 64; ++i)
+    {
+        root = 0.5 * (root + value / root);
+    }
+    return root;
+}
+
+#if INT_BENCH_STOP_MODE == INT_BENCH_STOP_QUANTILE
+
+/* Returns the histogram bucket of a value */
+static inline uint32_t __IntBenchStopBucket(uint64_t value)
+{
+    uint32_t msb;
+
+    if(INT_BENCH_STOP_HIST_SUB > value)
+    {
+        return (uint32_t)value;
+    }
+
+    msb = INT_BENCH_STOP_HIST_SUB_BITS;
+    while(0 != (value >> (msb + 1)))
+    {
+        ++msb;
+    }
+    if(INT_BENCH_STOP_HIST_OCTAVES + INT_BENCH_STOP_HIST_SUB_BITS - 1 < msb)
+    {
+        return INT_BENCH_STOP_HIST_SIZE - 1;
+    }
+
+    return (msb - INT_BENCH_STOP_HIST_SUB_BITS + 1) * INT_BENCH_STOP_HIST_SUB +
+           (uint32_t)((value >> (msb - INT_BENCH_STOP_HIST_SUB_BITS)) &
+                      (INT_BENCH_STOP_HIST_SUB - 1));
+}
+
+/* Returns the lower bound of a histogram bucket */
+static inline double __IntBenchStopBucketLow(const uint32_t bucket)
+{
+    uint32_t octave;
+
+    octave = bucket / INT_BENCH_STOP_HIST_SUB;
+    if(0 == octave)
+    {
+        return (double)bucket;
+    }
+    return (double)((uint64_t)(INT_BENCH_STOP_HIST_SUB +
+                               bucket % INT_BENCH_STOP_HIST_SUB) <<
+                    (octave - 1));
+}
+
+/* Returns the bucket holding the sample of a given rank (1 based) */
+static inline uint32_t __IntBenchStopRank(const int_bench_stop_t* stop,
+                                          const uint32_t          rank)
+{
+    uint32_t bucket;
+    uint32_t cumul;
+
+    cumul = 0;
+    for(bucket = 0; bucket < INT_BENCH_STOP_HIST_SIZE - 1; ++bucket)
+    {
+        cumul += stop->histogram[bucket];
+        if(cumul >= rank)
+        {
+            break;
+        }
+    }
+    return bucket;
+}
+
+#endif /* INT_BENCH_STOP_MODE == INT_BENCH_STOP_QUANTILE */
+
+/* Updates the estimate and its confidence interval */
+static inline void __IntBenchStopEstimate(int_bench_stop_t* stop)
+{
+#if INT_BENCH_STOP_MODE == INT_BENCH_STOP_QUANTILE
+    double   n;
+    double   spread;
+    double   low;
+    double   high;
+
+    /* Order statistics ranks of the estimate and the interval bounds */
+    n        = (double)stop->count;
+    spread   = INT_BENCH_STOP_Z *
+               __IntBenchStopSqrt(n * INT_BENCH_STOP_QUANTILE_VAL *
+                                  (1.0 - INT_BENCH_STOP_QUANTILE_VAL));
+    low      = n * INT_BENCH_STOP_QUANTILE_VAL - spread;
+    high     = n * INT_BENCH_STOP_QUANTILE_VAL + spread + 1.0;
+
+    stop->estimate = __IntBenchStopBucketLow(
+        __IntBenchStopRank(stop,
+                           (uint32_t)(n * INT_BENCH_STOP_QUANTILE_VAL) + 1));
+
+    /* The interval cannot be bounded yet: the bounds are out of the samples */
+    if(1.0 > low || n < high)
+    {
+        stop->halfWidth = stop->estimate;
+        return;
+    }
+
+    /* Conservative bounds: low bucket lower bound, high bucket upper bound */
+    low  = __IntBenchStopBucketLow(__IntBenchStopRank(stop, (uint32_t)low));
+    high = __IntBenchStopBucketLow(__IntBenchStopRank(stop,
+                                                      (uint32_t)high) + 1);
+    stop->halfWidth = (high - low) / 2.0;
+#else
+    stop->estimate = stop->mean;
+    if(2 > stop->count)
+    {
+        stop->halfWidth = stop->estimate;
+        return;
+    }
+    stop->halfWidth = INT_BENCH_STOP_Z *
+                      __IntBenchStopSqrt(stop->m2 / (stop->count - 1) /
+                                         stop->count);
+#endif
+}
+
+/* Adds an execution time to the stopping state. Returns 1 when the benchmark
+ * must stop: the interval is within tolerance or the last sample is reached.
+ */
+static inline uint32_t __IntBenchStopUpdate(int_bench_stop_t* stop,
+                                            const SYSTEM_TIME_TYPE value,
+                                            const uint32_t lastSample)
+{
+#if INT_BENCH_STOP_MODE != INT_BENCH_STOP_QUANTILE
+    double delta;
+#endif
+
+    ++stop->count;
+#if INT_BENCH_STOP_MODE == INT_BENCH_STOP_QUANTILE
+    ++stop->histogram[__IntBenchStopBucket((uint64_t)value)];
+#else
+    delta       = (double)value - stop->mean;
+    stop->mean += delta / stop->count;
+    stop->m2   += delta * ((double)value - stop->mean);
+#endif
+
+    if(0 == lastSample &&
+       (INT_BENCH_STOP_MIN_SAMPLES > stop->count ||
+        0 != stop->count % INT_BENCH_STOP_CHECK_PERIOD))
+    {
+        return 0;
+    }
+
+    __IntBenchStopEstimate(stop);
+    if(0 != lastSample ||
+       stop->halfWidth <= INT_BENCH_STOP_TOLERANCE * stop->estimate)
+    {
+        stop->done = 1;
+        return 1;
+    }
+
+    return 0;
+}
+
+/* Returns the confidence interval half width relative to the estimate (ppm),
+ * 0xFFFFFFFF when the estimate is 0 (quantile in the first histogram bucket)
+ */
+static inline uint32_t __IntBenchStopPpm(const int_bench_stop_t* stop)
+{
+    return (0.0 < stop->estimate) ?
+           (uint32_t)(stop->halfWidth / stop->estimate * 1e6) : 0xFFFFFFFF;
+}
+
+/* Records a stopping point in the dump header. Returns -1 if the header is
+ * full.
+ */
+static inline int32_t __IntBenchStopRecord(const uint32_t          id,
+                                           const uint32_t          samples,
+                                           const int_bench_stop_t* stop)
+{
+    int_bench_stop_point_t* point;
+    uint32_t                index;
+
+    while(0 != __TestAndSet(INT_BENCH_STOP_LOCK));
+    index = *(uint32_t*)INT_BENCH_DUMP_REG_HEADER_STOP_CNT;
+    if(INT_BENCH_STOP_MAX_POINTS <= index)
+    {
+        __LockRelease(INT_BENCH_STOP_LOCK);
+        return -1;
+    }
+
+    point = (int_bench_stop_point_t*)INT_BENCH_DUMP_REG_HEADER_STOP_ADDR + index;
+    point->id           = id;
+    point->samples      = samples;
+    point->halfWidthPpm = __IntBenchStopPpm(stop);
+    *(uint32_t*)INT_BENCH_DUMP_REG_HEADER_STOP_CNT = index + 1;
+    __LockRelease(INT_BENCH_STOP_LOCK);
+
+    return 0;
+}
+
+#endif  /* ifndef __ADAPTIVE_STOP_H__ */
+/* __________________________________________________________________________
+* END OF FILE:
+* -------------
+* ___________________________________________________________________________
+*/
@@ -0,0 +1,106 @@
+/* __________________________________________________________________________
+* MODULE DESCRIPTION:
+* -------------------
+* Filename : AsyncInject.h
+*
+* Author: Alexy Torres Aurora Dugo
+*
+* Description: This file contains the same-core asynchronous interrupt
+* injection. The generators of InterruptBench.h wait for their own interrupt,
+* a benchmark given an injection state instead arms an internal timer
+* interrupt (decrementer on the e6500, __IntBenchArmAsyncInt) that fires
+* during its payload, at a configured offset from the start of the
+* measurement. The offsets are used in turn, one per sample, and the offset of
+* each sample is dumped in the async region, after the PART record of the
+* sample: the interference can be studied against the phase of the payload
+* that is interrupted. The benchmarks without injection state do not write
+* async records.
+*
+* The interrupt is disarmed at the end of the measurement, the intIntCount of
+* the interrupt count record of the sample tells if it fired during the
+* payload.
+*
+* Record format (12B):
+* ID (4B, INT_BENCH_RECORD_ID of the PART record), sample index (4B), offset
+* of the interrupt (4B, ns).
+* __________________________________________________________________________
+*/
+
+/* __________________________________________________________________________
+* PREPROCESSOR DIRECTIVES:
+* ------------------------
+*/
+#ifndef __ASYNC_INJECT_H__
+#define __ASYNC_INJECT_H__
+
+#include <stdint.h>
+#include <OSAbstractionLayer.h>
+
+/*******************************************************************************
+ * CONFIGURATION
+ ******************************************************************************/
+
+/* Size of an async record */
+#define INT_BENCH_ASYNC_RECORD_SIZE (sizeof(uint32_t) * 3)
+
+/*******************************************************************************
+ * TYPES
+ ******************************************************************************/
+
+/* Asynchronous injection state of a benchmark */
+typedef struct {
+    /* Offsets of the interrupt from the start of the measurement (ns) */
+    const uint32_t* offsets;
+    uint32_t        count;
+    /* Offset used by the next sample */
+    uint32_t        next;
+} int_bench_async_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/* Arms the interrupt of the next sample. Returns its offset. */
+static inline uint32_t __IntBenchAsyncArm(int_bench_async_t* async)
+{
+    uint32_t offset;
+
+    offset = async->offsets[async->next];
+    async->next = (async->next + 1) % async->count;
+    __IntBenchArmAsyncInt(offset);
+
+    return offset;
+}
+
+/* Dumps the offset of the interrupt of a sample in the async region. The
+ * records that do not fit in the region are dropped and counted in the dump
+ * header.
+ */
+static inline void __IntBenchAsyncDump(const uint32_t recordId,
+                                       const uint32_t sample,
+                                       const uint32_t offset)
+{
+    uint32_t* cursor;
+    uint32_t  size;
+
+    size = *(uint32_t*)INT_BENCH_DUMP_ASYNC_SIZE_ADDR;
+    if(INT_BENCH_DUMP_REG_SIZE - 8 - size < INT_BENCH_ASYNC_RECORD_SIZE)
+    {
+        ++*(uint32_t*)INT_BENCH_DUMP_REG_HEADER_DROP;
+        return;
+    }
+
+    cursor = (uint32_t*)(INT_BENCH_DUMP_ASYNC_CURSOR_ADDR + size);
+    cursor[0] = recordId;
+    cursor[1] = sample;
+    cursor[2] = offset;
+    *(uint32_t*)INT_BENCH_DUMP_ASYNC_SIZE_ADDR =
+        size + INT_BENCH_ASYNC_RECORD_SIZE;
+}
+
+#endif  /* ifndef __ASYNC_INJECT_H__ */
+/* __________________________________________________________________________
+* END OF FILE:
+* -------------
+* ___________________________________________________________________________
+*/
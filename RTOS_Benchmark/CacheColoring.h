@@ -0,0 +1,263 @@
+/* __________________________________________________________________________
+* MODULE DESCRIPTION:
+* -------------------
+* Filename : CacheColoring.h
+*
+* Author: Alexy Torres Aurora Dugo
+*
+* Description: This file contains the page coloring arena allocator. The L2
+* cache is split in colors: pages of the same color map to the same L2 sets.
+* Giving the payloads, the dump and the interrupt handlers disjoint colors
+* partitions the L2 in software, without cache partitioning hardware.
+*
+* An arena takes its pages from a memory pool provided by the partition and
+* only hands out the pages whose physical address has one of the arena's
+* colors. The physical addresses are given by the OS (__IntBenchVirtToPhys).
+* __________________________________________________________________________
+*/
+
+/* __________________________________________________________________________
+* PREPROCESSOR DIRECTIVES:
+* ------------------------
+*/
+#ifndef __CACHE_COLORING_H__
+#define __CACHE_COLORING_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <OSAbstractionLayer.h>
+
+/*******************************************************************************
+ * CONFIGURATION
+ ******************************************************************************/
+
+/* Number of colors of the L2 cache */
+#define INT_BENCH_COLOR_COUNT \
+    (INT_BENCH_L2_SIZE / INT_BENCH_L2_WAYS / INT_BENCH_PAGE_SIZE)
+
+#if INT_BENCH_COLOR_COUNT > 32 || INT_BENCH_COLOR_COUNT < 1
+#error "The color masks support between 1 and 32 colors"
+#endif
+
+/*******************************************************************************
+ * TYPES
+ ******************************************************************************/
+
+/* Page coloring arena */
+typedef struct {
+    /* Memory pool the pages are taken from (page aligned) */
+    uint8_t* pool;
+    /* Number of pages in the pool */
+    uint32_t poolPages;
+    /* Next pool page to examine */
+    uint32_t nextPage;
+    /* Colors the arena can use */
+    uint32_t colorMask;
+    /* Current page of the small allocations */
+    uint8_t* page;
+    /* Offset of the next small allocation in the current page */
+    uint32_t pageOffset;
+    /* Number of pages handed out by the arena */
+    uint32_t allocatedPages;
+} int_bench_color_arena_t;
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* Color of a physical address */
+#define INT_BENCH_COLOR_OF(PHYS_ADDR)                                          \
+    ((uint32_t)(((PHYS_ADDR) / INT_BENCH_PAGE_SIZE) % INT_BENCH_COLOR_COUNT))
+
+/* Mask of all the colors */
+#define INT_BENCH_COLOR_ALL                                                    \
+    ((uint32_t)((1ULL << INT_BENCH_COLOR_COUNT) - 1))
+
+/* Mask of COUNT colors starting at FIRST */
+#define INT_BENCH_COLOR_RANGE(FIRST, COUNT)                                    \
+    ((uint32_t)(((1ULL << (COUNT)) - 1) << (FIRST)) & INT_BENCH_COLOR_ALL)
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/* Returns the color of a virtual address */
+static inline uint32_t __IntBenchColorOf(const void* addr)
+{
+    return INT_BENCH_COLOR_OF(__IntBenchVirtToPhys(addr));
+}
+
+/* Returns the mask of the colors used by a memory range. The range must be
+ * mapped.
+ */
+static inline uint32_t __IntBenchColorMaskOf(const void* addr,
+                                             const size_t size)
+{
+    uintptr_t page;
+    uintptr_t end;
+    uint32_t  mask;
+
+    mask = 0;
+    page = (uintptr_t)addr & ~(uintptr_t)(INT_BENCH_PAGE_SIZE - 1);
+    end  = (uintptr_t)addr + size;
+    for(; page < end && INT_BENCH_COLOR_ALL != mask;
+        page += INT_BENCH_PAGE_SIZE)
+    {
+        mask |= 1U << __IntBenchColorOf((const void*)page);
+    }
+
+    return mask;
+}
+
+/* Initializes an arena. The pages of the pool that do not have one of the
+ * arena's colors are never used.
+ */
+static inline void __IntBenchColorArenaInit(int_bench_color_arena_t* arena,
+                                            void*                    pool,
+                                            const size_t             poolSize,
+                                            const uint32_t           colorMask)
+{
+    uintptr_t start;
+    uintptr_t end;
+
+    start = ((uintptr_t)pool + INT_BENCH_PAGE_SIZE - 1) &
+            ~(uintptr_t)(INT_BENCH_PAGE_SIZE - 1);
+    end   = ((uintptr_t)pool + poolSize) &
+            ~(uintptr_t)(INT_BENCH_PAGE_SIZE - 1);
+
+    arena->pool           = (uint8_t*)start;
+    arena->poolPages      = (end > start) ?
+                            (uint32_t)((end - start) / INT_BENCH_PAGE_SIZE) : 0;
+    arena->nextPage       = 0;
+    arena->colorMask      = colorMask & INT_BENCH_COLOR_ALL;
+    arena->page           = NULL;
+    arena->pageOffset     = INT_BENCH_PAGE_SIZE;
+    arena->allocatedPages = 0;
+}
+
+/* Allocates a page of one of the arena's colors. Returns NULL when the pool is
+ * exhausted.
+ */
+static inline void* __IntBenchColorAllocPage(int_bench_color_arena_t* arena)
+{
+    volatile uint8_t* page;
+
+    while(arena->nextPage < arena->poolPages)
+    {
+        page = arena->pool + (size_t)arena->nextPage * INT_BENCH_PAGE_SIZE;
+        ++arena->nextPage;
+
+        /* Make sure the page is backed before getting its physical address */
+        *page = 0;
+        if(0 != (arena->colorMask & (1U << __IntBenchColorOf((void*)page))))
+        {
+            ++arena->allocatedPages;
+            return (void*)page;
+        }
+    }
+
+    return NULL;
+}
+
+/* Allocates a small object (up to a page) in pages of the arena's colors. The
+ * objects are 8 bytes aligned and never cross a page boundary. Returns NULL
+ * when the pool is exhausted or the object is larger than a page.
+ */
+static inline void* __IntBenchColorAlloc(int_bench_color_arena_t* arena,
+                                         const size_t             size)
+{
+    size_t alignedSize;
+    void*  object;
+
+    alignedSize = (size + 7) & ~(size_t)7;
+    if(0 == alignedSize || INT_BENCH_PAGE_SIZE < alignedSize)
+    {
+        return NULL;
+    }
+
+    if(INT_BENCH_PAGE_SIZE - arena->pageOffset < alignedSize)
+    {
+        arena->page = (uint8_t*)__IntBenchColorAllocPage(arena);
+        if(NULL == arena->page)
+        {
+            return NULL;
+        }
+        arena->pageOffset = 0;
+    }
+
+    object = arena->page + arena->pageOffset;
+    arena->pageOffset += alignedSize;
+
+    return object;
+}
+
+#ifdef INT_BENCH_LINUX_BACKEND
+
+/* The Linux host backend builds the buffers by remapping the colored pages */
+#include <LinuxCacheColoring.h>
+
+#else
+
+/* Allocates a virtually contiguous buffer made of pages of the arena's colors.
+ * The target has no MMU service to remap pages, the buffer is a physically
+ * contiguous run of pool pages that all have one of the arena's colors: the
+ * colors being consecutive in memory, a buffer can be at most as large as the
+ * longest run of consecutive colors in the mask. Returns NULL if no such run
+ * remains in the pool.
+ */
+static inline void* __IntBenchColorAllocBuffer(int_bench_color_arena_t* arena,
+                                               const size_t             size)
+{
+    uint32_t  pageCount;
+    uint32_t  start;
+    uint32_t  i;
+    uint8_t*  page;
+    uintptr_t phys;
+    uintptr_t prevPhys;
+
+    pageCount = (uint32_t)((size + INT_BENCH_PAGE_SIZE - 1) /
+                           INT_BENCH_PAGE_SIZE);
+    if(0 == pageCount)
+    {
+        return NULL;
+    }
+
+    start    = arena->nextPage;
+    prevPhys = 0;
+    for(i = arena->nextPage; i < arena->poolPages; ++i)
+    {
+        page  = arena->pool + (size_t)i * INT_BENCH_PAGE_SIZE;
+        *(volatile uint8_t*)page = 0;
+        phys  = __IntBenchVirtToPhys(page);
+
+        /* Restart the run on a color or physical discontinuity */
+        if(0 == (arena->colorMask & (1U << INT_BENCH_COLOR_OF(phys))) ||
+           (i != start && phys != prevPhys + INT_BENCH_PAGE_SIZE))
+        {
+            start = i + 1;
+            if(0 != (arena->colorMask & (1U << INT_BENCH_COLOR_OF(phys))))
+            {
+                start = i;
+            }
+        }
+        prevPhys = phys;
+
+        if(i + 1 - start == pageCount)
+        {
+            arena->nextPage        = i + 1;
+            arena->allocatedPages += pageCount;
+            return arena->pool + (size_t)start * INT_BENCH_PAGE_SIZE;
+        }
+    }
+
+    return NULL;
+}
+
+#endif /* INT_BENCH_LINUX_BACKEND */
+
+#endif  /* ifndef __CACHE_COLORING_H__ */
+/* __________________________________________________________________________
+* END OF FILE:
+* -------------
+* ___________________________________________________________________________
+*/
@@ -0,0 +1,146 @@
+/* __________________________________________________________________________
+* MODULE DESCRIPTION:
+* -------------------
+* Filename : CampaignManifest.h
+*
+* Author: Alexy Torres Aurora Dugo
+*
+* Description: This file contains the campaign manifest of the dumps. A
+* campaign is spread over several boards: every dump records the board it was
+* measured on, the revision of the firmware (RTOS and benchmarks), the
+* scenario and mitigation it measures, the start and end dates of the run and
+* the event counted by each PMC. ExtractionConv.py writes the manifest next to
+* the extracted files and Scripts/CampaignAggregate.py uses it to merge the
+* results of the boards into one dataset.
+*
+* The manifest is written in the manifest region by INT_BENCH_DUMP_HADER, the
+* dump header only holds its version (0 for the dumps without manifest). The
+* OS or the probe script calls INT_BENCH_MANIFEST_CLOSE before the extraction
+* to record the end date of the run.
+*
+* The scenario and the mitigation are the names of the dataset folders the
+* dump goes to (INT_BENCH_SCENARIO, e.g. "MC_ALL_05" or "Baseline", and
+* INT_BENCH_MITIGATION, e.g. "L2-COLOR" for L2-COLOR_mitig).
+* __________________________________________________________________________
+*/
+
+/* __________________________________________________________________________
+* PREPROCESSOR DIRECTIVES:
+* ------------------------
+*/
+#ifndef __CAMPAIGN_MANIFEST_H__
+#define __CAMPAIGN_MANIFEST_H__
+
+#include <stdint.h>
+#include <string.h>
+#include <OSAbstractionLayer.h>
+#include <PMCDriver.h>
+#include <PartitionSwitch.h>
+#include <TickInterference.h>
+
+/*******************************************************************************
+ * CONFIGURATION
+ ******************************************************************************/
+
+/* Version of the manifest format, recorded in the dump header */
+#define INT_BENCH_MANIFEST_VERSION 1
+
+/* Sizes of the manifest strings, NUL terminated */
+#define INT_BENCH_MANIFEST_BOARD_SIZE    32
+#define INT_BENCH_MANIFEST_FIRMWARE_SIZE 72
+#define INT_BENCH_MANIFEST_NAME_SIZE     32
+
+/* Number of PMCs described by the counter schema */
+#define INT_BENCH_MANIFEST_PMC_COUNT (E6500_PMC_ID_MAX_VALUE + 1)
+
+/*******************************************************************************
+ * TYPES
+ ******************************************************************************/
+
+/* Campaign manifest (216B), stored after the manifest region header */
+typedef struct {
+    /* Manifest format version and number of PMCs of the counter schema */
+    uint32_t version;
+    uint32_t pmcCount;
+    /* Board identifier and firmware revision, given by the OS */
+    char     boardId[INT_BENCH_MANIFEST_BOARD_SIZE];
+    char     firmwareHash[INT_BENCH_MANIFEST_FIRMWARE_SIZE];
+    /* Dataset folders of the dump */
+    char     scenario[INT_BENCH_MANIFEST_NAME_SIZE];
+    char     mitigation[INT_BENCH_MANIFEST_NAME_SIZE];
+    /* Start and end dates of the run (seconds since the epoch, UTC), the end
+     * date is 0 until INT_BENCH_MANIFEST_CLOSE
+     */
+    uint64_t startDate;
+    uint64_t endDate;
+    /* Event counted by each PMC */
+    uint32_t pmcEvents[INT_BENCH_MANIFEST_PMC_COUNT];
+} int_bench_manifest_t;
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* Campaign manifest of the dump */
+#define INT_BENCH_MANIFEST                                                     \
+    ((int_bench_manifest_t*)INT_BENCH_DUMP_MANIFEST_CURSOR_ADDR)
+
+/* Records the end date of the run. Called by the OS (or the probe script)
+ * before the extraction.
+ */
+#define INT_BENCH_MANIFEST_CLOSE() {                                           \
+    INT_BENCH_MANIFEST->endDate = __IntBenchGetWallClock();                    \
+}
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/* Writes the manifest region, called by INT_BENCH_DUMP_HADER */
+static inline void __IntBenchManifestInit(void)
+{
+    int_bench_manifest_t* manifest;
+
+    memcpy((char*)INT_BENCH_DUMP_MANIFEST_MAGIC_ADDR,
+           (char*)INT_BENCH_DUMP_MANIFEST_HEADER_MAGIC_VAL, 4);
+    *(uint32_t*)INT_BENCH_DUMP_MANIFEST_SIZE_ADDR =
+        sizeof(int_bench_manifest_t);
+
+    manifest = INT_BENCH_MANIFEST;
+    memset(manifest, 0, sizeof(int_bench_manifest_t));
+    manifest->version  = INT_BENCH_MANIFEST_VERSION;
+    manifest->pmcCount = INT_BENCH_MANIFEST_PMC_COUNT;
+
+    /* The strings are truncated, the last byte stays NUL */
+    __IntBenchGetBoardInfo(manifest->boardId,
+                           INT_BENCH_MANIFEST_BOARD_SIZE - 1,
+                           manifest->firmwareHash,
+                           INT_BENCH_MANIFEST_FIRMWARE_SIZE - 1);
+    strncpy(manifest->scenario, INT_BENCH_SCENARIO,
+            INT_BENCH_MANIFEST_NAME_SIZE - 1);
+    strncpy(manifest->mitigation, INT_BENCH_MITIGATION,
+            INT_BENCH_MANIFEST_NAME_SIZE - 1);
+
+    /* Counter schema, from the PMCs programmed by the benchmarks. The PMCs no
+     * benchmark uses stay 0.
+     */
+    manifest->pmcEvents[INT_BENCH_PAYLOAD_PMC_L2]  = INT_BENCH_PMC_EVENT_L2;
+    manifest->pmcEvents[INT_BENCH_PAYLOAD_PMC_TLB] = INT_BENCH_PMC_EVENT_TLB;
+    manifest->pmcEvents[INT_BENCH_HANDLER_PMC_L2]  = INT_BENCH_PMC_EVENT_L2;
+    manifest->pmcEvents[INT_BENCH_HANDLER_PMC_TLB] = INT_BENCH_PMC_EVENT_TLB;
+    manifest->pmcEvents[INT_BENCH_PSW_PMC_L2]      = INT_BENCH_PMC_EVENT_L2;
+    manifest->pmcEvents[INT_BENCH_PSW_PMC_TLB]     = INT_BENCH_PMC_EVENT_TLB;
+    manifest->pmcEvents[INT_BENCH_TICK_PMC_L2]     = INT_BENCH_PMC_EVENT_L2;
+    manifest->pmcEvents[INT_BENCH_TICK_PMC_TLB]    = INT_BENCH_PMC_EVENT_TLB;
+
+    manifest->startDate = __IntBenchGetWallClock();
+
+    *(uint32_t*)INT_BENCH_DUMP_REG_HEADER_MANIFEST = INT_BENCH_MANIFEST_VERSION;
+}
+
+#endif  /* ifndef __CAMPAIGN_MANIFEST_H__ */
+/* __________________________________________________________________________
+* END OF FILE:
+* -------------
+* ___________________________________________________________________________
+*/
@@ -0,0 +1,197 @@
+/* __________________________________________________________________________
+* MODULE DESCRIPTION:
+* -------------------
+* Filename : InstrumentedPartition.c
+*
+* Description: This file contains the application partition with the optional
+* payload instrumentations. Each instrumentation is enabled at build time by
+* defining its symbol (on the Linux host, see the make variable given below).
+* __________________________________________________________________________
+*/
+
+/* INCLUDE SECTION */
+#include <stdio.h>
+#include <string.h>
+#include "InterruptBench.h"
+
+//#define GENERATE_INT
+
+/* ADAPTIVE_STOP (make STOP=1): stops the payload sampling once the execution
+ * time statistic is known within tolerance (see AdaptiveStop.h)
+ */
+#ifdef ADAPTIVE_STOP
+static int_bench_stop_t payloadStop;
+#endif
+
+/* FLIGHT_RECORDER (make FLIGHT=1): soak test, keeps the payload samples
+ * around the outliers and summaries only, the threshold is learned (see
+ * FlightRecorder.h)
+ */
+#ifdef FLIGHT_RECORDER
+static int_bench_flight_t payloadFlight;
+#endif
+
+/* ASYNC_INJECT (make ASYNC=1): interrupts the payload on its own core at the
+ * given offsets (ns), one offset per sample (see AsyncInject.h)
+ */
+#ifdef ASYNC_INJECT
+static const uint32_t    payloadAsyncOffsets[] = {1000, 10000, 50000, 100000};
+static int_bench_async_t payloadAsync;
+#endif
+
+/* PAYLOAD_SECTIONS (make SECTIONS=1): times the phases of the payload (see
+ * SectionTiming.h), one section per phase of the application
+ */
+
+/* SMT_SIBLING (make SMT=1): records the counters of the sibling hardware thread
+ * of the payload, which executes the sibling agent (see SmtSibling.h and
+ * SiblingPartition.c)
+ */
+#ifdef SMT_SIBLING
+static int_bench_smt_t payloadSmt;
+#endif
+
+/* TICK_COST (make TICK=<Hz>): measures the OS tick handler on the payload
+ * core, the tick cost can then be removed from the payload baseline (see
+ * TickInterference.h)
+ */
+
+/* MASK_LATENCY (make MASK=<period ns>): routes the periodic external timer to
+ * the payload core and measures how long the OS keeps the interrupts masked
+ * (see MaskLatency.h)
+ */
+
+static void bench_routine(void)
+{
+    /* None, here you can add whatever application you want */
+}
+
+void process1(void)
+{
+    RETURN_CODE_TYPE    retCode;
+    T_uint32            mafCount;
+    int_bench_measure_t benchData;
+    int_bench_measure_t intIntBenchData;
+    int_bench_measure_t extIntBenchData;
+    int_bench_measure_t scBenchData;
+    int_bench_measure_t ipiBenchData;
+
+    memset(&benchData, 0, sizeof(int_bench_measure_t));
+    memset(&intIntBenchData, 0, sizeof(int_bench_measure_t));
+    memset(&extIntBenchData, 0, sizeof(int_bench_measure_t));
+    memset(&scBenchData, 0, sizeof(int_bench_measure_t));
+    memset(&ipiBenchData, 0, sizeof(int_bench_measure_t));
+
+#ifdef ADAPTIVE_STOP
+    INT_BENCH_STOP_INIT(benchData, payloadStop);
+#endif
+#ifdef FLIGHT_RECORDER
+    INT_BENCH_FLIGHT_INIT(benchData, payloadFlight, 0);
+#endif
+#ifdef ASYNC_INJECT
+    INT_BENCH_ASYNC_INIT(benchData, payloadAsync, payloadAsyncOffsets,
+                         sizeof(payloadAsyncOffsets) / sizeof(uint32_t));
+#endif
+#ifdef SMT_SIBLING
+    INT_BENCH_SMT_INIT(benchData, payloadSmt, 0);
+#endif
+
+    INT_BENCH_INIT(0, 0, mafCount, benchData);
+#ifdef TICK_COST
+    INT_BENCH_TICK_START(0);
+#endif
+#ifdef MASK_LATENCY
+    INT_BENCH_MASK_START(0, INT_BENCH_MASK_PERIOD);
+#endif
+
+    while(1)
+    {
+        INT_BENCH_PAYLOAD_PROLOGUE(mafCount, benchData);
+
+#ifdef PAYLOAD_SECTIONS
+        INT_BENCH_SECTION_BEGIN(benchData, 0);
+        INT_BENCH_EXEC_PAYLOAD(bench_routine);
+        INT_BENCH_SECTION_END(benchData, 0);
+#else
+        INT_BENCH_EXEC_PAYLOAD(bench_routine);
+#endif
+
+        INT_BENCH_PAYLOAD_EPILOGUE(mafCount, benchData, 0, 0);
+
+#ifdef GENERATE_INT
+        INT_BENCH_GEN_INT_INT(0, 0, intIntBenchData);
+        INT_BENCH_GEN_SC(0, 0, scBenchData);
+        INT_BENCH_GEN_IPI(0, 0, ipiBenchData, 0);
+        INT_BENCH_GEN_EXT_INT(0, 0, extIntBenchData, 0);
+#endif
+
+        PERIODIC_WAIT(&retCode);
+        if(NO_ERROR != retCode)
+        {
+            printf("[C0P0] Cannot periodic wait: %d\n", retCode);
+        }
+    }
+}
+
+/* __________________________________________________________________________
+ *
+ * FUNCTION NAME : main_process
+ * DESCRIPTION   : Partition WR1Partition_T2080RDB_PCA main function.
+ * PARAMETERS :    None.
+ * INPUT :         None.
+ * OUTPUT :        None.
+ * RETURN :        None.
+ * __________________________________________________________________________
+ */
+void main_process(void)
+{
+    RETURN_CODE_TYPE       retCode;
+    PROCESS_ID_TYPE        thOutput1;
+    PROCESS_ATTRIBUTE_TYPE thAttrOutput1;
+
+    char* errorMessage = "Failed to transition to NORMAL mode";
+
+    /* Set processes */
+    printf("[CORE0][P0] Initialize P0 processes\n");
+
+    thAttrOutput1.ENTRY_POINT   = process1;
+    thAttrOutput1.DEADLINE      = SOFT;
+    thAttrOutput1.PERIOD        = 100000000;
+    thAttrOutput1.STACK_SIZE    = 0x1000;
+    thAttrOutput1.TIME_CAPACITY = 100000000;
+    thAttrOutput1.BASE_PRIORITY = 2;
+    memcpy(thAttrOutput1.NAME, "Process1\0", 9 * sizeof(char));
+
+    printf("[CORE0][P0] Initialize P0\n");
+    CREATE_PROCESS(&thAttrOutput1, &thOutput1, &retCode);
+    if(retCode != NO_ERROR)
+    {
+        printf("[CORE0][P0] ERROR Creating Process1: %d\n", retCode);
+        while(1);
+    }
+
+    START(thOutput1, &retCode);
+    if(retCode != NO_ERROR)
+    {
+        printf("[CORE0][P0] ERROR: Starting Process1: %d\n", retCode);
+        while(1);
+    }
+
+    SET_PARTITION_MODE (NORMAL, &retCode);
+    if(retCode != NO_ERROR)
+    {
+        printf("[CORE0][P0] ERROR: Switching to normal mode: %d\n", retCode);
+        while(1);
+    }
+
+    RAISE_APPLICATION_ERROR(APPLICATION_ERROR,
+                            (MESSAGE_ADDR_TYPE)errorMessage,
+                            (ERROR_MESSAGE_SIZE_TYPE)strlen(errorMessage) + 1,
+                            &retCode);
+}
+
+/* __________________________________________________________________________
+ * END OF FILE:
+ * -------------
+ * ___________________________________________________________________________
+ */
@@ -0,0 +1,138 @@
+/* __________________________________________________________________________
+* MODULE DESCRIPTION:
+* -------------------
+* Filename : MemCoRunnerPartition.c
+*
+* Description: This file contains the memory bandwidth co-runner partition
+* (see MemCoRunner.h). The partition streams over its buffer while the
+* interrupt generators execute on the other cores, the achieved bandwidth of
+* every window is dumped in the co-runner region.
+* __________________________________________________________________________
+*/
+
+/* INCLUDE SECTION */
+#include <stdio.h>
+#include <string.h>
+#include "ARINC653.h"
+#include "InterruptBench.h"
+
+/* Core and partition ID of the co-runner partition */
+#ifndef MBW_CORE_ID
+#define MBW_CORE_ID 2
+#endif
+#ifndef MBW_PART_ID
+#define MBW_PART_ID 1
+#endif
+
+/* Access mode: INT_BENCH_MBW_READ, INT_BENCH_MBW_WRITE or INT_BENCH_MBW_RMW */
+#ifndef MBW_MODE
+#define MBW_MODE INT_BENCH_MBW_READ
+#endif
+
+/* Streamed footprint and stride (B). The default footprint is four times the
+ * T2080 L2 so the stream reaches the memory controller.
+ */
+#ifndef MBW_FOOTPRINT
+#define MBW_FOOTPRINT 0x800000
+#endif
+#ifndef MBW_STRIDE
+#define MBW_STRIDE 64
+#endif
+
+/* Target bandwidth (MB/s), 0 for unthrottled */
+#ifndef MBW_TARGET
+#define MBW_TARGET 0
+#endif
+
+/* Duration of a co-runner window (ns), one record is dumped per window */
+#ifndef MBW_WINDOW
+#define MBW_WINDOW 10000000ULL
+#endif
+
+static void process1(void)
+{
+    RETURN_CODE_TYPE    retCode;
+    int_bench_measure_t benchData;
+    int_bench_mbw_t     mbwData;
+    uint32_t            mafCount;
+    void*               buffer;
+
+    memset(&benchData, 0, sizeof(int_bench_measure_t));
+
+    buffer = __IntBenchAllocLargePages(MBW_FOOTPRINT);
+    if(0 != __IntBenchMbwInit(&mbwData, buffer, MBW_FOOTPRINT, MBW_STRIDE,
+                              MBW_MODE, MBW_TARGET))
+    {
+        printf("[C%dP%d] Invalid co-runner configuration\n", MBW_CORE_ID,
+               MBW_PART_ID);
+        while(1)
+        {
+            PERIODIC_WAIT(&retCode);
+        }
+    }
+
+    INT_BENCH_INIT(MBW_CORE_ID, MBW_PART_ID, mafCount, benchData);
+
+    /* The co-runner never waits, it competes for the memory in every window
+     * of the partition.
+     */
+    while(1)
+    {
+        INT_BENCH_MBW_WINDOW(MBW_CORE_ID, MBW_PART_ID, mbwData, MBW_WINDOW);
+    }
+}
+
+void main_process(void)
+{
+    RETURN_CODE_TYPE       retCode;
+    PROCESS_ID_TYPE        thOutput1;
+    PROCESS_ATTRIBUTE_TYPE thAttrOutput1;
+
+    char* errorMessage = "Failed to transition to NORMAL mode";
+
+    /* Set processes */
+    printf("[CORE%d][P%d] Initialize processes\n", MBW_CORE_ID, MBW_PART_ID);
+
+    thAttrOutput1.ENTRY_POINT   = process1;
+    thAttrOutput1.DEADLINE      = SOFT;
+    thAttrOutput1.PERIOD        = 1000000000;
+    thAttrOutput1.STACK_SIZE    = 0x1000;
+    thAttrOutput1.TIME_CAPACITY = 1000000000;
+    thAttrOutput1.BASE_PRIORITY = 2;
+    memcpy(thAttrOutput1.NAME, "Process1\0", 9 * sizeof(char));
+
+    CREATE_PROCESS(&thAttrOutput1, &thOutput1, &retCode);
+    if(retCode != NO_ERROR)
+    {
+        printf("[CORE%d][P%d] ERROR Creating Process1: %d\n", MBW_CORE_ID,
+               MBW_PART_ID, retCode);
+        while(1);
+    }
+
+    START(thOutput1, &retCode);
+    if(retCode != NO_ERROR)
+    {
+        printf("[CORE%d][P%d] ERROR: Starting Process1: %d\n", MBW_CORE_ID,
+               MBW_PART_ID, retCode);
+        while(1);
+    }
+
+    SET_PARTITION_MODE (NORMAL, &retCode);
+    if(retCode != NO_ERROR)
+    {
+        printf("[CORE%d][P%d] ERROR: Switching to normal mode: %d\n",
+               MBW_CORE_ID, MBW_PART_ID, retCode);
+        while(1);
+    }
+
+    RAISE_APPLICATION_ERROR(APPLICATION_ERROR,
+                            (MESSAGE_ADDR_TYPE)errorMessage,
+                            (ERROR_MESSAGE_SIZE_TYPE)strlen(errorMessage) + 1,
+                            &retCode);
+}
+
+/* __________________________________________________________________________
+ * END OF FILE:
+ * -------------
+ * ___________________________________________________________________________
+ */
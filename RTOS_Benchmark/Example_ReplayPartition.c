@@ -0,0 +1,124 @@
+/* __________________________________________________________________________
+* MODULE DESCRIPTION:
+* -------------------
+* Filename : ReplayPartition.c
+*
+* Description: This file contains the trace replay generator partition. The
+* partition reproduces the interrupt arrival trace loaded by the OS (see
+* TraceReplay.h) and dumps the skew between the scheduled and the actual
+* generation times in the replay region. When several cores replay the same
+* trace, only one generator replays the IPIs and external interrupts.
+* __________________________________________________________________________
+*/
+
+/* INCLUDE SECTION */
+#include <stdio.h>
+#include <string.h>
+#include "ARINC653.h"
+#include "InterruptBench.h"
+
+/* Core and partition ID of the replay partition */
+#ifndef REPLAY_CORE_ID
+#define REPLAY_CORE_ID 1
+#endif
+#ifndef REPLAY_PART_ID
+#define REPLAY_PART_ID 1
+#endif
+
+/* Set if the partition replays the IPIs and external interrupts */
+#ifndef REPLAY_REMOTE
+#define REPLAY_REMOTE 1
+#endif
+
+static void process1(void)
+{
+    RETURN_CODE_TYPE    retCode;
+    int_bench_measure_t benchData;
+    int_bench_replay_t  replayData;
+    uint32_t            mafCount;
+
+    memset(&benchData, 0, sizeof(int_bench_measure_t));
+
+    INT_BENCH_INIT(REPLAY_CORE_ID, REPLAY_PART_ID, mafCount, benchData);
+    if(0 != __IntBenchReplayInit(&replayData, REPLAY_CORE_ID, REPLAY_REMOTE))
+    {
+        printf("[C%dP%d] No valid trace to replay\n", REPLAY_CORE_ID,
+               REPLAY_PART_ID);
+    }
+
+    /* The events are replayed against the global time base, the partition
+     * busy waits for them in its windows.
+     */
+    while(0 == replayData.done)
+    {
+        __IntBenchReplayStep(&replayData, REPLAY_PART_ID);
+    }
+    printf("[C%dP%d] Replay done: %u events\n", REPLAY_CORE_ID,
+           REPLAY_PART_ID, replayData.replayed);
+
+    while(1)
+    {
+        PERIODIC_WAIT(&retCode);
+        if(NO_ERROR != retCode)
+        {
+            printf("[C%dP%d] Cannot periodic wait: %d\n",
+                   REPLAY_CORE_ID, REPLAY_PART_ID, retCode);
+        }
+    }
+}
+
+void main_process(void)
+{
+    RETURN_CODE_TYPE       retCode;
+    PROCESS_ID_TYPE        thOutput1;
+    PROCESS_ATTRIBUTE_TYPE thAttrOutput1;
+
+    char* errorMessage = "Failed to transition to NORMAL mode";
+
+    /* Set processes */
+    printf("[CORE%d][P%d] Initialize processes\n", REPLAY_CORE_ID,
+           REPLAY_PART_ID);
+
+    thAttrOutput1.ENTRY_POINT   = process1;
+    thAttrOutput1.DEADLINE      = SOFT;
+    thAttrOutput1.PERIOD        = 1000000000;
+    thAttrOutput1.STACK_SIZE    = 0x1000;
+    thAttrOutput1.TIME_CAPACITY = 1000000000;
+    thAttrOutput1.BASE_PRIORITY = 2;
+    memcpy(thAttrOutput1.NAME, "Process1\0", 9 * sizeof(char));
+
+    CREATE_PROCESS(&thAttrOutput1, &thOutput1, &retCode);
+    if(retCode != NO_ERROR)
+    {
+        printf("[CORE%d][P%d] ERROR Creating Process1: %d\n", REPLAY_CORE_ID,
+               REPLAY_PART_ID, retCode);
+        while(1);
+    }
+
+    START(thOutput1, &retCode);
+    if(retCode != NO_ERROR)
+    {
+        printf("[CORE%d][P%d] ERROR: Starting Process1: %d\n", REPLAY_CORE_ID,
+               REPLAY_PART_ID, retCode);
+        while(1);
+    }
+
+    SET_PARTITION_MODE (NORMAL, &retCode);
+    if(retCode != NO_ERROR)
+    {
+        printf("[CORE%d][P%d] ERROR: Switching to normal mode: %d\n",
+               REPLAY_CORE_ID, REPLAY_PART_ID, retCode);
+        while(1);
+    }
+
+    RAISE_APPLICATION_ERROR(APPLICATION_ERROR,
+                            (MESSAGE_ADDR_TYPE)errorMessage,
+                            (ERROR_MESSAGE_SIZE_TYPE)strlen(errorMessage) + 1,
+                            &retCode);
+}
+
+/* __________________________________________________________________________
+ * END OF FILE:
+ * -------------
+ * ___________________________________________________________________________
+ */
@@ -0,0 +1,88 @@
+/* __________________________________________________________________________
+* MODULE DESCRIPTION:
+* -------------------
+* Filename : SiblingPartition.c
+*
+* Description: This file contains the SMT sibling agent partition (see
+* SmtSibling.h). The partition executes on the sibling hardware thread of the
+* payload, it idles until it takes an interrupt and publishes the counters of
+* its thread after every handler. It does not take part in the partitions
+* synchronization (INT_BENCH_INIT): it only answers the interrupts steered to
+* its thread.
+* __________________________________________________________________________
+*/
+
+/* INCLUDE SECTION */
+#include <stdio.h>
+#include <string.h>
+#include "ARINC653.h"
+#include "InterruptBench.h"
+
+/* Core and hardware thread of the sibling agent */
+#ifndef SIBLING_CORE_ID
+#define SIBLING_CORE_ID 0
+#endif
+#ifndef SIBLING_THREAD_ID
+#define SIBLING_THREAD_ID 1
+#endif
+
+static void process1(void)
+{
+    __IntBenchSmtAgent(SIBLING_CORE_ID, SIBLING_THREAD_ID);
+}
+
+void main_process(void)
+{
+    RETURN_CODE_TYPE       retCode;
+    PROCESS_ID_TYPE        thOutput1;
+    PROCESS_ATTRIBUTE_TYPE thAttrOutput1;
+
+    char* errorMessage = "Failed to transition to NORMAL mode";
+
+    /* Set processes */
+    printf("[CORE%d][T%d] Initialize processes\n", SIBLING_CORE_ID,
+           SIBLING_THREAD_ID);
+
+    thAttrOutput1.ENTRY_POINT   = process1;
+    thAttrOutput1.DEADLINE      = SOFT;
+    thAttrOutput1.PERIOD        = 1000000000;
+    thAttrOutput1.STACK_SIZE    = 0x1000;
+    thAttrOutput1.TIME_CAPACITY = 1000000000;
+    thAttrOutput1.BASE_PRIORITY = 2;
+    memcpy(thAttrOutput1.NAME, "Process1\0", 9 * sizeof(char));
+
+    CREATE_PROCESS(&thAttrOutput1, &thOutput1, &retCode);
+    if(retCode != NO_ERROR)
+    {
+        printf("[CORE%d][T%d] ERROR Creating Process1: %d\n", SIBLING_CORE_ID,
+               SIBLING_THREAD_ID, retCode);
+        while(1);
+    }
+
+    START(thOutput1, &retCode);
+    if(retCode != NO_ERROR)
+    {
+        printf("[CORE%d][T%d] ERROR: Starting Process1: %d\n",
+               SIBLING_CORE_ID, SIBLING_THREAD_ID, retCode);
+        while(1);
+    }
+
+    SET_PARTITION_MODE (NORMAL, &retCode);
+    if(retCode != NO_ERROR)
+    {
+        printf("[CORE%d][T%d] ERROR: Switching to normal mode: %d\n",
+               SIBLING_CORE_ID, SIBLING_THREAD_ID, retCode);
+        while(1);
+    }
+
+    RAISE_APPLICATION_ERROR(APPLICATION_ERROR,
+                            (MESSAGE_ADDR_TYPE)errorMessage,
+                            (ERROR_MESSAGE_SIZE_TYPE)strlen(errorMessage) + 1,
+                            &retCode);
+}
+
+/* __________________________________________________________________________
+ * END OF FILE:
+ * -------------
+ * ___________________________________________________________________________
+ */
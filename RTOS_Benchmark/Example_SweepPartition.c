@@ -0,0 +1,120 @@
+/* __________________________________________________________________________
+* MODULE DESCRIPTION:
+* -------------------
+* Filename : SweepPartition.c
+*
+* Description: This file contains the interrupt sweep partition. The partition
+* generates every interrupt type to every destination core from its own core
+* and dumps the measurements in the sweep region. Instantiating the partition
+* on every core gives the complete source x destination interference matrix
+* (see Scripts/InterfMatrix.py).
+* __________________________________________________________________________
+*/
+
+/* INCLUDE SECTION */
+#include <stdio.h>
+#include <string.h>
+#include "ARINC653.h"
+#include "InterruptBench.h"
+
+/* Core and partition ID of the sweep partition */
+#ifndef SWEEP_CORE_ID
+#define SWEEP_CORE_ID 2
+#endif
+#ifndef SWEEP_PART_ID
+#define SWEEP_PART_ID 1
+#endif
+
+/* Number of interrupts generated per period */
+#define SWEEP_BURST 100
+
+static void process1(void)
+{
+    RETURN_CODE_TYPE    retCode;
+    int_bench_measure_t benchData;
+    int_bench_sweep_t   sweepData;
+    uint32_t            mafCount;
+    uint32_t            i;
+
+    memset(&benchData, 0, sizeof(int_bench_measure_t));
+
+    INT_BENCH_INIT(SWEEP_CORE_ID, SWEEP_PART_ID, mafCount, benchData);
+    INT_BENCH_SWEEP_INIT(SWEEP_CORE_ID, sweepData);
+
+    while(1)
+    {
+        for(i = 0; i < SWEEP_BURST && 0 == sweepData.done; ++i)
+        {
+            /* Space the interrupts to let the destination handle them */
+            __IntBenchSpin(0x00060000);
+            INT_BENCH_SWEEP_STEP(SWEEP_CORE_ID, SWEEP_PART_ID, sweepData);
+            if(0 != sweepData.done)
+            {
+                printf("[C%dP%d] Sweep done\n", SWEEP_CORE_ID, SWEEP_PART_ID);
+            }
+        }
+
+        PERIODIC_WAIT(&retCode);
+        if(NO_ERROR != retCode)
+        {
+            printf("[C%dP%d] Cannot periodic wait: %d\n",
+                   SWEEP_CORE_ID, SWEEP_PART_ID, retCode);
+        }
+    }
+}
+
+void main_process(void)
+{
+    RETURN_CODE_TYPE       retCode;
+    PROCESS_ID_TYPE        thOutput1;
+    PROCESS_ATTRIBUTE_TYPE thAttrOutput1;
+
+    char* errorMessage = "Failed to transition to NORMAL mode";
+
+    /* Set processes */
+    printf("[CORE%d][P%d] Initialize processes\n", SWEEP_CORE_ID,
+           SWEEP_PART_ID);
+
+    thAttrOutput1.ENTRY_POINT   = process1;
+    thAttrOutput1.DEADLINE      = SOFT;
+    thAttrOutput1.PERIOD        = 1000000000;
+    thAttrOutput1.STACK_SIZE    = 0x1000;
+    thAttrOutput1.TIME_CAPACITY = 1000000000;
+    thAttrOutput1.BASE_PRIORITY = 2;
+    memcpy(thAttrOutput1.NAME, "Process1\0", 9 * sizeof(char));
+
+    CREATE_PROCESS(&thAttrOutput1, &thOutput1, &retCode);
+    if(retCode != NO_ERROR)
+    {
+        printf("[CORE%d][P%d] ERROR Creating Process1: %d\n", SWEEP_CORE_ID,
+               SWEEP_PART_ID, retCode);
+        while(1);
+    }
+
+    START(thOutput1, &retCode);
+    if(retCode != NO_ERROR)
+    {
+        printf("[CORE%d][P%d] ERROR: Starting Process1: %d\n", SWEEP_CORE_ID,
+               SWEEP_PART_ID, retCode);
+        while(1);
+    }
+
+    SET_PARTITION_MODE (NORMAL, &retCode);
+    if(retCode != NO_ERROR)
+    {
+        printf("[CORE%d][P%d] ERROR: Switching to normal mode: %d\n",
+               SWEEP_CORE_ID, SWEEP_PART_ID, retCode);
+        while(1);
+    }
+
+    RAISE_APPLICATION_ERROR(APPLICATION_ERROR,
+                            (MESSAGE_ADDR_TYPE)errorMessage,
+                            (ERROR_MESSAGE_SIZE_TYPE)strlen(errorMessage) + 1,
+                            &retCode);
+}
+
+/* __________________________________________________________________________
+ * END OF FILE:
+ * -------------
+ * ___________________________________________________________________________
+ */
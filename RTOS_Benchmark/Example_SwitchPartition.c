@@ -0,0 +1,119 @@
+/* __________________________________________________________________________
+* MODULE DESCRIPTION:
+* -------------------
+* Filename : SwitchPartition.c
+*
+* Description: This file contains the partition switch generator partition.
+* The partition starts the partition switch benchmark of its core (see
+* PartitionSwitch.h) and idles. Its windows are interleaved with the windows
+* of the other partitions of the core in the schedule: the switch rate is set
+* by the number of windows of the partition per MAF.
+* __________________________________________________________________________
+*/
+
+/* INCLUDE SECTION */
+#include <stdio.h>
+#include <string.h>
+#include "ARINC653.h"
+#include "InterruptBench.h"
+
+/* Core and partition ID of the switch partition */
+#ifndef SWITCH_CORE_ID
+#define SWITCH_CORE_ID 0
+#endif
+#ifndef SWITCH_PART_ID
+#define SWITCH_PART_ID 1
+#endif
+
+/* Period of the partition process (ns), the MAF of the core */
+#ifndef SWITCH_PERIOD
+#define SWITCH_PERIOD 10000000
+#endif
+
+static void process1(void)
+{
+    RETURN_CODE_TYPE    retCode;
+    int_bench_measure_t benchData;
+    uint32_t            mafCount;
+    uint32_t            done;
+
+    memset(&benchData, 0, sizeof(int_bench_measure_t));
+
+    INT_BENCH_INIT(SWITCH_CORE_ID, SWITCH_PART_ID, mafCount, benchData);
+    INT_BENCH_PSW_START(SWITCH_CORE_ID);
+
+    done = 0;
+    while(1)
+    {
+        if(0 == done &&
+           INT_BENCH_SAMPLE_COUNT <= INT_BENCH_PSW_STATE(SWITCH_CORE_ID)->count)
+        {
+            printf("[C%dP%d] Partition switch sample count reached\n",
+                   SWITCH_CORE_ID, SWITCH_PART_ID);
+            done = 1;
+        }
+
+        PERIODIC_WAIT(&retCode);
+        if(NO_ERROR != retCode)
+        {
+            printf("[C%dP%d] Cannot periodic wait: %d\n",
+                   SWITCH_CORE_ID, SWITCH_PART_ID, retCode);
+        }
+    }
+}
+
+void main_process(void)
+{
+    RETURN_CODE_TYPE       retCode;
+    PROCESS_ID_TYPE        thOutput1;
+    PROCESS_ATTRIBUTE_TYPE thAttrOutput1;
+
+    char* errorMessage = "Failed to transition to NORMAL mode";
+
+    /* Set processes */
+    printf("[CORE%d][P%d] Initialize processes\n", SWITCH_CORE_ID,
+           SWITCH_PART_ID);
+
+    thAttrOutput1.ENTRY_POINT   = process1;
+    thAttrOutput1.DEADLINE      = SOFT;
+    thAttrOutput1.PERIOD        = SWITCH_PERIOD;
+    thAttrOutput1.STACK_SIZE    = 0x1000;
+    thAttrOutput1.TIME_CAPACITY = SWITCH_PERIOD;
+    thAttrOutput1.BASE_PRIORITY = 2;
+    memcpy(thAttrOutput1.NAME, "Process1\0", 9 * sizeof(char));
+
+    CREATE_PROCESS(&thAttrOutput1, &thOutput1, &retCode);
+    if(retCode != NO_ERROR)
+    {
+        printf("[CORE%d][P%d] ERROR Creating Process1: %d\n", SWITCH_CORE_ID,
+               SWITCH_PART_ID, retCode);
+        while(1);
+    }
+
+    START(thOutput1, &retCode);
+    if(retCode != NO_ERROR)
+    {
+        printf("[CORE%d][P%d] ERROR: Starting Process1: %d\n", SWITCH_CORE_ID,
+               SWITCH_PART_ID, retCode);
+        while(1);
+    }
+
+    SET_PARTITION_MODE (NORMAL, &retCode);
+    if(retCode != NO_ERROR)
+    {
+        printf("[CORE%d][P%d] ERROR: Switching to normal mode: %d\n",
+               SWITCH_CORE_ID, SWITCH_PART_ID, retCode);
+        while(1);
+    }
+
+    RAISE_APPLICATION_ERROR(APPLICATION_ERROR,
+                            (MESSAGE_ADDR_TYPE)errorMessage,
+                            (ERROR_MESSAGE_SIZE_TYPE)strlen(errorMessage) + 1,
+                            &retCode);
+}
+
+/* __________________________________________________________________________
+ * END OF FILE:
+ * -------------
+ * ___________________________________________________________________________
+ */
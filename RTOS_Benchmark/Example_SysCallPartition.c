@@ -16,16 +16,26 @@
 
 #define GENERATE_INT
 
+/* Steers IPIs and external interrupts to the sibling hardware thread of the
+ * payload on core 0 instead of generating system calls (see SmtSibling.h)
+ */
+//#define SIBLING_INT
+
+/* Sibling hardware thread of the payload */
+#define SIBLING_DST INT_BENCH_DST_THREAD(0, INT_BENCH_SIBLING_THREAD(0))
+
 static void process1(void)
 {
     RETURN_CODE_TYPE    retCode;
     int_bench_measure_t benchData;
     int_bench_measure_t extIntBenchData;
+    int_bench_measure_t ipiBenchData;
     uint32_t            mafCount;
     uint32_t            i;
 
     memset(&benchData, 0, sizeof(int_bench_measure_t));
     memset(&extIntBenchData, 0, sizeof(int_bench_measure_t));
+    memset(&ipiBenchData, 0, sizeof(int_bench_measure_t));
 
     INT_BENCH_INIT(1, 1, mafCount, benchData);
 
@@ -38,34 +48,36 @@ static void process1(void)
 #ifndef GENERATE_INT
                 (void)i;
                 (void)extIntBenchData;
+                (void)ipiBenchData;
                 /* IDLE partition for more than 900ms */
-                __asm__ __volatile__ (
-                    "lis 3, 0x2000\n\t"
-                    "p_idle_loop:\n\t"
-                    "addi 3, 3, -1\n\t"
-                    "cmpwi 3, 0\n\t"
-                    "bne p_idle_loop\n\t"
-                :::"3");
+                __IntBenchSpin(0x20000000);
 #else
             for(i = 0; i < 1800; ++i)
             {
 
                 /* Generates an interrupt every 0.5ms aproximately */
-                __asm__ __volatile__ (
-                        "lis 3, 0x0006\n\t"
-                        "p_idle_loop:\n\t"
-                        "addi 3, 3, -1\n\t"
-                        "cmpwi 3, 0\n\t"
-                        "bne p_idle_loop\n\t"
-                    :::"3");
+                __IntBenchSpin(0x00060000);
+#ifdef SIBLING_INT
+                if(0 == (i & 1))
+                {
+                    INT_BENCH_GEN_IPI(1, 1, ipiBenchData, SIBLING_DST);
+                }
+                else
+                {
+                    INT_BENCH_GEN_EXT_INT(1, 1, extIntBenchData, SIBLING_DST);
+                }
+#else
+                (void)ipiBenchData;
                 INT_BENCH_GEN_SC(1, 1, extIntBenchData);
+#endif
             }
 #endif
             GET_TIME(&benchData.endTime, &retCode);
             if (retCode == NO_ERROR)
             {
                 printf("[C1P1] %uus\n",
-                       ((benchData.endTime - benchData.startTime) / 1000));
+                       (uint32_t)((benchData.endTime - benchData.startTime) /
+                                  1000));
             }
             else
             {
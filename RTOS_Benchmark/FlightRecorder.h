@@ -0,0 +1,367 @@
+/* __________________________________________________________________________
+* MODULE DESCRIPTION:
+* -------------------
+* Filename : FlightRecorder.h
+*
+* Author: Alexy Torres Aurora Dugo
+*
+* Description: This file contains the flight recorder of the benchmarks. A
+* benchmark given a flight recorder state does not dump every sample: its
+* detailed records (absolute timestamp, counters, benchmark ID) go to a small
+* circular buffer of its core. When a sample exceeds the threshold of its
+* benchmark, the buffer (the history of the core) and the following records
+* of the core are committed to the flight dump region as a window. Only a
+* compact summary of the other samples is committed, every
+* INT_BENCH_FLIGHT_SUMMARY_PERIOD samples. Long soak tests then fit in the
+* shared memory.
+*
+* The threshold is either static or learned: INT_BENCH_FLIGHT_MARGIN times
+* the running INT_BENCH_FLIGHT_QUANTILE quantile, estimated with the P2
+* algorithm (Jain and Chlamtac, 1985).
+* __________________________________________________________________________
+*/
+
+/* __________________________________________________________________________
+* PREPROCESSOR DIRECTIVES:
+* ------------------------
+*/
+#ifndef __FLIGHT_RECORDER_H__
+#define __FLIGHT_RECORDER_H__
+
+#include <stdint.h>
+#include <string.h>
+#include <ARINC653.h>
+#include <OSAbstractionLayer.h>
+
+/*******************************************************************************
+ * CONFIGURATION
+ ******************************************************************************/
+
+/* Flight record kinds */
+#define INT_BENCH_FLIGHT_KIND_DETAIL  1
+#define INT_BENCH_FLIGHT_KIND_TRIGGER 2
+#define INT_BENCH_FLIGHT_KIND_SUMMARY 3
+
+/* The circular buffers (16B + 40B per record) are stored in the shared memory
+ * free space
+ */
+#if INT_BENCH_CORE_COUNT * (16 + 40 * INT_BENCH_FLIGHT_DEPTH) > \
+    INT_BENCH_FLIGHT_RINGS_MAX_SIZE
+#error "The flight recorder buffers do not fit in the shared memory"
+#endif
+
+/*******************************************************************************
+ * TYPES
+ ******************************************************************************/
+
+/* Detailed flight record (40B) */
+typedef struct {
+    /* INT_BENCH_FLIGHT_KIND_DETAIL or INT_BENCH_FLIGHT_KIND_TRIGGER */
+    uint32_t kind;
+    /* Benchmark ID (INT_BENCH_RECORD_ID) */
+    uint32_t id;
+    /* Sample index in the benchmark */
+    uint32_t seq;
+    /* Window number on the core, set when the record is committed */
+    uint32_t window;
+    /* Absolute start time and execution time */
+    uint64_t timestamp;
+    uint64_t execTime;
+    uint32_t l2Miss;
+    uint32_t tlbMiss;
+} int_bench_flight_rec_t;
+
+/* Summary flight record (40B) */
+typedef struct {
+    /* INT_BENCH_FLIGHT_KIND_SUMMARY */
+    uint32_t kind;
+    /* Benchmark ID (INT_BENCH_RECORD_ID) */
+    uint32_t id;
+    /* Index of the first sample and number of samples summarized */
+    uint32_t firstSeq;
+    uint32_t count;
+    /* Execution time statistics */
+    uint64_t minExecTime;
+    uint64_t maxExecTime;
+    uint64_t sumExecTime;
+} int_bench_flight_sum_t;
+
+/* Per-core circular buffer, it only contains the records not committed yet */
+typedef struct {
+    /* Next slot */
+    uint32_t               head;
+    /* Number of records */
+    uint32_t               count;
+    /* Number of records still committed after the last trigger */
+    uint32_t               postLeft;
+    /* Number of windows committed by the core */
+    uint32_t               window;
+    int_bench_flight_rec_t records[INT_BENCH_FLIGHT_DEPTH];
+} int_bench_flight_ring_t;
+
+/* Flight recorder state of a benchmark */
+typedef struct {
+    /* Static threshold, 0 to learn the threshold */
+    SYSTEM_TIME_TYPE       threshold;
+    /* P2 quantile estimator: markers heights, positions and desired
+     * positions
+     */
+    uint32_t               count;
+    double                 heights[5];
+    double                 positions[5];
+    double                 desired[5];
+    /* Summary being built */
+    int_bench_flight_sum_t summary;
+} int_bench_flight_t;
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* Circular buffer of a core */
+#define INT_BENCH_FLIGHT_RING(CORE)                                            \
+    ((int_bench_flight_ring_t*)INT_BENCH_FLIGHT_RINGS_ADDR + (CORE))
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/* Commits a 40B flight record to the flight dump region. The records that do
+ * not fit are counted in the dump header.
+ */
+static inline void __IntBenchFlightCommit(const void* record)
+{
+    uint32_t size;
+
+    while(0 != __TestAndSet(INT_BENCH_FLIGHT_LOCK));
+    size = *(uint32_t*)INT_BENCH_DUMP_FLIGHT_SIZE_ADDR;
+    if(INT_BENCH_DUMP_REG_SIZE - 8 - size < sizeof(int_bench_flight_rec_t))
+    {
+        ++*(uint32_t*)INT_BENCH_DUMP_REG_HEADER_FLT_DROP;
+    }
+    else
+    {
+        memcpy((void*)(INT_BENCH_DUMP_FLIGHT_CURSOR_ADDR + size), record,
+               sizeof(int_bench_flight_rec_t));
+        *(uint32_t*)INT_BENCH_DUMP_FLIGHT_SIZE_ADDR =
+            size + sizeof(int_bench_flight_rec_t);
+    }
+    __LockRelease(INT_BENCH_FLIGHT_LOCK);
+}
+
+/* Updates the P2 estimate of the INT_BENCH_FLIGHT_QUANTILE quantile */
+static inline void __IntBenchFlightQuantile(int_bench_flight_t* flight,
+                                            const double        value)
+{
+    double   delta;
+    double   height;
+    double   sign;
+    uint32_t i;
+    uint32_t j;
+    uint32_t k;
+
+    /* The first five values initialize the markers */
+    if(5 > flight->count)
+    {
+        i = flight->count;
+        while(0 < i && flight->heights[i - 1] > value)
+        {
+            flight->heights[i] = flight->heights[i - 1];
+            --i;
+        }
+        flight->heights[i] = value;
+        ++flight->count;
+
+        if(5 == flight->count)
+        {
+            for(i = 0; i < 5; ++i)
+            {
+                flight->positions[i] = i + 1;
+            }
+            flight->desired[0] = 1;
+            flight->desired[1] = 1 + 2 * INT_BENCH_FLIGHT_QUANTILE;
+            flight->desired[2] = 1 + 4 * INT_BENCH_FLIGHT_QUANTILE;
+            flight->desired[3] = 3 + 2 * INT_BENCH_FLIGHT_QUANTILE;
+            flight->desired[4] = 5;
+        }
+        return;
+    }
+    ++flight->count;
+
+    /* Find the cell of the value and update the extreme markers */
+    if(value < flight->heights[0])
+    {
+        flight->heights[0] = value;
+        k = 0;
+    }
+    else if(value >= flight->heights[4])
+    {
+        flight->heights[4] = value;
+        k = 3;
+    }
+    else
+    {
+        for(k = 0; k < 3 && value >= flight->heights[k + 1]; ++k);
+    }
+
+    for(i = k + 1; i < 5; ++i)
+    {
+        flight->positions[i] += 1;
+    }
+    flight->desired[1] += INT_BENCH_FLIGHT_QUANTILE / 2;
+    flight->desired[2] += INT_BENCH_FLIGHT_QUANTILE;
+    flight->desired[3] += (1 + INT_BENCH_FLIGHT_QUANTILE) / 2;
+    flight->desired[4] += 1;
+
+    /* Adjust the middle markers */
+    for(i = 1; i < 4; ++i)
+    {
+        delta = flight->desired[i] - flight->positions[i];
+        if((1 <= delta &&
+            1 < flight->positions[i + 1] - flight->positions[i]) ||
+           (-1 >= delta &&
+            -1 > flight->positions[i - 1] - flight->positions[i]))
+        {
+            sign = (0 < delta) ? 1 : -1;
+
+            /* Piecewise parabolic prediction */
+            height = flight->heights[i] + sign /
+                     (flight->positions[i + 1] - flight->positions[i - 1]) *
+                     ((flight->positions[i] - flight->positions[i - 1] + sign) *
+                      (flight->heights[i + 1] - flight->heights[i]) /
+                      (flight->positions[i + 1] - flight->positions[i]) +
+                      (flight->positions[i + 1] - flight->positions[i] - sign) *
+                      (flight->heights[i] - flight->heights[i - 1]) /
+                      (flight->positions[i] - flight->positions[i - 1]));
+
+            /* Linear prediction if the parabolic one is not monotonic */
+            if(flight->heights[i - 1] >= height ||
+               flight->heights[i + 1] <= height)
+            {
+                j = (0 < sign) ? i + 1 : i - 1;
+                height = flight->heights[i] + sign *
+                         (flight->heights[j] - flight->heights[i]) /
+                         (flight->positions[j] - flight->positions[i]);
+            }
+
+            flight->heights[i]    = height;
+            flight->positions[i] += sign;
+        }
+    }
+}
+
+/* Tells if an execution time exceeds the threshold of the benchmark. The
+ * learned threshold is updated with the execution time.
+ */
+static inline uint32_t __IntBenchFlightTrigger(int_bench_flight_t*    flight,
+                                               const SYSTEM_TIME_TYPE execTime)
+{
+    uint32_t trigger;
+
+    if(0 != flight->threshold)
+    {
+        return (execTime > flight->threshold) ? 1 : 0;
+    }
+
+    /* Test before learning so the outlier does not raise its threshold */
+    trigger = (INT_BENCH_FLIGHT_WARMUP <= flight->count &&
+               (double)execTime >
+               INT_BENCH_FLIGHT_MARGIN * flight->heights[2]) ? 1 : 0;
+    __IntBenchFlightQuantile(flight, (double)execTime);
+
+    return trigger;
+}
+
+/* Records a sample: the record is added to the circular buffer of the core,
+ * the buffer is committed if the sample triggers a window or if a window is
+ * in progress, and the summary is updated.
+ */
+static inline void __IntBenchFlightRecord(int_bench_flight_t*    flight,
+                                          const uint32_t         core,
+                                          const uint32_t         id,
+                                          const uint32_t         seq,
+                                          const SYSTEM_TIME_TYPE startTime,
+                                          const SYSTEM_TIME_TYPE endTime,
+                                          const uint32_t         l2Miss,
+                                          const uint32_t         tlbMiss)
+{
+    int_bench_flight_ring_t* ring;
+    int_bench_flight_rec_t*  record;
+    SYSTEM_TIME_TYPE         execTime;
+    uint32_t                 trigger;
+    uint32_t                 i;
+
+    execTime = endTime - startTime;
+    trigger  = __IntBenchFlightTrigger(flight, execTime);
+
+    /* Add the record to the circular buffer */
+    ring   = INT_BENCH_FLIGHT_RING(core);
+    record = &ring->records[ring->head];
+    record->kind      = (0 != trigger) ? INT_BENCH_FLIGHT_KIND_TRIGGER :
+                                         INT_BENCH_FLIGHT_KIND_DETAIL;
+    record->id        = id;
+    record->seq       = seq;
+    record->timestamp = (uint64_t)startTime;
+    record->execTime  = (uint64_t)execTime;
+    record->l2Miss    = l2Miss;
+    record->tlbMiss   = tlbMiss;
+    ring->head = (ring->head + 1) % INT_BENCH_FLIGHT_DEPTH;
+    if(INT_BENCH_FLIGHT_DEPTH > ring->count)
+    {
+        ++ring->count;
+    }
+
+    /* Commit the history, oldest first, on a trigger outside of a window, and
+     * the records following a trigger. A trigger in a window extends it.
+     */
+    if(0 != trigger || 0 != ring->postLeft)
+    {
+        if(0 == ring->postLeft)
+        {
+            ++ring->window;
+        }
+        for(i = 0; i < ring->count; ++i)
+        {
+            record = &ring->records[(ring->head + INT_BENCH_FLIGHT_DEPTH -
+                                     ring->count + i) %
+                                    INT_BENCH_FLIGHT_DEPTH];
+            record->window = ring->window;
+            __IntBenchFlightCommit(record);
+        }
+        ring->count    = 0;
+        ring->postLeft = (0 != trigger) ? INT_BENCH_FLIGHT_POST :
+                                          ring->postLeft - 1;
+    }
+
+    /* Update the summary */
+    if(0 == flight->summary.count)
+    {
+        flight->summary.kind        = INT_BENCH_FLIGHT_KIND_SUMMARY;
+        flight->summary.id          = id;
+        flight->summary.firstSeq    = seq;
+        flight->summary.minExecTime = (uint64_t)execTime;
+        flight->summary.maxExecTime = (uint64_t)execTime;
+        flight->summary.sumExecTime = 0;
+    }
+    if(flight->summary.minExecTime > (uint64_t)execTime)
+    {
+        flight->summary.minExecTime = (uint64_t)execTime;
+    }
+    if(flight->summary.maxExecTime < (uint64_t)execTime)
+    {
+        flight->summary.maxExecTime = (uint64_t)execTime;
+    }
+    flight->summary.sumExecTime += (uint64_t)execTime;
+    if(INT_BENCH_FLIGHT_SUMMARY_PERIOD <= ++flight->summary.count)
+    {
+        __IntBenchFlightCommit(&flight->summary);
+        flight->summary.count = 0;
+    }
+}
+
+#endif  /* ifndef __FLIGHT_RECORDER_H__ */
+/* __________________________________________________________________________
+* END OF FILE:
+* -------------
+* ___________________________________________________________________________
+*/
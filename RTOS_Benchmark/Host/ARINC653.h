@@ -0,0 +1,138 @@
+/* __________________________________________________________________________
+* MODULE DESCRIPTION:
+* -------------------
+* Filename : ARINC653.h
+*
+* Author: Alexy Torres Aurora Dugo
+*
+* Description: This file contains the subset of the ARINC653 APEX API used by
+* the benchmark framework and the example partitions. It is implemented by the
+* Linux host runtime (ARINC653Host.c) and is only used when building the
+* benchmarks on a Linux host, the RTOS provides its own ARINC653.h otherwise.
+* __________________________________________________________________________
+*/
+
+/* __________________________________________________________________________
+* PREPROCESSOR DIRECTIVES:
+* ------------------------
+*/
+#ifndef __ARINC653_H__
+#define __ARINC653_H__
+
+#include <stdint.h>
+
+/*******************************************************************************
+ * CONFIGURATION
+ ******************************************************************************/
+
+/* Maximal number of processes per partition */
+#define ARINC653_HOST_MAX_PROCESS_PER_PART 8
+
+/* Maximal length of a process name */
+#define MAX_NAME_LENGTH 30
+
+/*******************************************************************************
+ * TYPES
+ ******************************************************************************/
+
+typedef uint32_t T_uint32;
+
+typedef enum
+{
+    NO_ERROR       = 0,
+    NO_ACTION      = 1,
+    NOT_AVAILABLE  = 2,
+    INVALID_PARAM  = 3,
+    INVALID_CONFIG = 4,
+    INVALID_MODE   = 5,
+    TIMED_OUT      = 6
+} RETURN_CODE_TYPE;
+
+typedef enum
+{
+    SOFT = 0,
+    HARD = 1
+} DEADLINE_TYPE;
+
+typedef enum
+{
+    IDLE       = 0,
+    COLD_START = 1,
+    WARM_START = 2,
+    NORMAL     = 3
+} OPERATING_MODE_TYPE;
+
+typedef enum
+{
+    DEADLINE_MISSED   = 0,
+    APPLICATION_ERROR = 1,
+    NUMERIC_ERROR     = 2,
+    ILLEGAL_REQUEST   = 3,
+    STACK_OVERFLOW    = 4,
+    MEMORY_VIOLATION  = 5,
+    HARDWARE_FAULT    = 6,
+    POWER_FAIL        = 7
+} ERROR_CODE_TYPE;
+
+/* Time in nanoseconds */
+typedef long long SYSTEM_TIME_TYPE;
+
+typedef int32_t  PROCESS_ID_TYPE;
+typedef int32_t  PRIORITY_TYPE;
+typedef uint32_t STACK_SIZE_TYPE;
+typedef char     PROCESS_NAME_TYPE[MAX_NAME_LENGTH];
+typedef void     (*SYSTEM_ADDRESS_TYPE)(void);
+
+typedef char*    MESSAGE_ADDR_TYPE;
+typedef int32_t  ERROR_MESSAGE_SIZE_TYPE;
+
+typedef struct
+{
+    SYSTEM_TIME_TYPE    PERIOD;
+    SYSTEM_TIME_TYPE    TIME_CAPACITY;
+    SYSTEM_ADDRESS_TYPE ENTRY_POINT;
+    STACK_SIZE_TYPE     STACK_SIZE;
+    PRIORITY_TYPE       BASE_PRIORITY;
+    DEADLINE_TYPE       DEADLINE;
+    PROCESS_NAME_TYPE   NAME;
+} PROCESS_ATTRIBUTE_TYPE;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/* Creates a process in the calling partition. The process is started with
+ * START and is only released when the partition enters the NORMAL mode.
+ */
+void CREATE_PROCESS(PROCESS_ATTRIBUTE_TYPE* attributes,
+                    PROCESS_ID_TYPE*        processId,
+                    RETURN_CODE_TYPE*       returnCode);
+
+/* Starts a previously created process */
+void START(PROCESS_ID_TYPE processId, RETURN_CODE_TYPE* returnCode);
+
+/* Sets the operating mode of the calling partition. When switching to NORMAL,
+ * the started processes are released and the calling (initialization) process
+ * is stopped.
+ */
+void SET_PARTITION_MODE(OPERATING_MODE_TYPE operatingMode,
+                        RETURN_CODE_TYPE*   returnCode);
+
+/* Suspends the calling periodic process until its next release point */
+void PERIODIC_WAIT(RETURN_CODE_TYPE* returnCode);
+
+/* Returns the current system time */
+void GET_TIME(SYSTEM_TIME_TYPE* systemTime, RETURN_CODE_TYPE* returnCode);
+
+/* Reports an application error to the health monitor */
+void RAISE_APPLICATION_ERROR(ERROR_CODE_TYPE         errorCode,
+                             MESSAGE_ADDR_TYPE       message,
+                             ERROR_MESSAGE_SIZE_TYPE length,
+                             RETURN_CODE_TYPE*       returnCode);
+
+#endif  /* ifndef __ARINC653_H__ */
+/* __________________________________________________________________________
+* END OF FILE:
+* -------------
+* ___________________________________________________________________________
+*/
@@ -0,0 +1,1776 @@
+/* __________________________________________________________________________
+* MODULE DESCRIPTION:
+* -------------------
+* Filename : ARINC653Host.c
+*
+* Author: Alexy Torres Aurora Dugo
+*
+* Description: This file contains the Linux host runtime. It implements the
+* subset of the ARINC653 APEX used by the example partitions and the API
+* requirements of OSAbstractionLayer.h.
+*
+* Each emulated core is a scheduler thread pinned on a host CPU that executes
+* the core's MAF: at the beginning of a partition window the partition is
+* activated, at the end of the window it is preempted. The processes are
+* threads pinned on the CPU of their partition's core. The preemption is done
+* with a signal whose handler suspends the process until its partition is
+* activated again.
+*
+* The emulated interrupts are signals whose handlers acknowledge the interrupt
+* by clearing the interrupt wait flag (see LinuxBackend.h).
+*
+* The core threads call the partition switch hooks (PartitionSwitch.h) when
+* they preempt a partition and when they activate the next one, the partition
+* IDs are the indexes of the partitions table. They also open and close the
+* deferred interrupt delivery windows (InterruptDefer.h) with the emulated
+* interrupts masked, the queued interrupts are delivered by the core thread at
+* the end of the window or by the service core thread (HOST_SIG_DEFER).
+*
+* In the SMT sibling mode (INT_BENCH_HOST_SMT), each core has a sibling thread
+* pinned on the SMT sibling of the core's CPU (or on the same CPU when the host
+* has no SMT). It executes the sibling agent (SmtSibling.h) and handles the
+* IPIs and external interrupts routed to the second thread of the core.
+*
+* When a tick frequency is requested (__IntBenchSetTickFrequency), each core
+* thread takes an emulated OS tick (HOST_SIG_TICK) from a periodic timer. The
+* host scheduler is driven by the core threads, the tick handler only executes
+* the tick hooks (TickInterference.h).
+*
+* The periodic external timer of the interrupt masking window benchmark
+* (MaskLatency.h) is a periodic timer expiring on the core thread of its
+* destination core (HOST_SIG_MASK), masked with the other emulated interrupts.
+* Its expiries are aligned on the time it was armed, the handler gives the
+* partition active on the core to the hook.
+*
+* The asynchronous internal interrupts (AsyncInject.h) are one-shot timers
+* created per thread that expire on the thread that armed them
+* (HOST_SIG_ASYNC), their handler does not release the interrupt wait flag.
+*
+* The interrupt handlers execute on alternate signal stacks allocated in the
+* colors requested with __IntBenchSetHandlerColors.
+*
+* The shared memory and the payload buffers are mapped with huge pages in the
+* large page mapping mode (INT_BENCH_LARGE_PAGES) and with ordinary pages
+* otherwise. Their translations are counted from /proc/self/smaps.
+*
+* The shared memory is allocated at startup and the dump region (from the dump
+* header to the end of the dump regions) is written to a file when the run
+* ends, the file can be converted with Scripts/ExtractionConv.py. The campaign
+* manifest (CampaignManifest.h) is closed before the dump is written.
+* __________________________________________________________________________
+*/
+
+/* INCLUDE SECTION */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#include "HostRuntime.h"
+#include "../InterruptBench.h"
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* Partition preemption signal, the handler suspends the process until its
+ * partition is activated.
+ */
+#define HOST_SIG_PREEMPT (SIGRTMIN + 1)
+/* Partition activation signal, only used to wake up suspended processes */
+#define HOST_SIG_RESUME  (SIGRTMIN + 2)
+/* Emulated interrupts signals */
+#define HOST_SIG_INTINT  (SIGRTMIN + 3)
+#define HOST_SIG_IPI     (SIGRTMIN + 4)
+#define HOST_SIG_EXTINT  (SIGRTMIN + 5)
+/* Deferred interrupts batch notification of the service core */
+#define HOST_SIG_DEFER   (SIGRTMIN + 6)
+/* Asynchronous internal interrupt signal */
+#define HOST_SIG_ASYNC   (SIGRTMIN + 7)
+/* Emulated OS tick signal */
+#define HOST_SIG_TICK    (SIGRTMIN + 8)
+/* Periodic external timer signal of the interrupt masking window benchmark */
+#define HOST_SIG_MASK    (SIGRTMIN + 9)
+
+#define HOST_NS_PER_SEC 1000000000LL
+
+/* Size of the interrupt handlers stacks */
+#define HOST_HANDLER_STACK_SIZE 0x10000
+/* Size of the memory pool the handlers stacks are allocated from */
+#define HOST_HANDLER_POOL_SIZE  0x2000000
+
+/* Maximal number of mappings owned by the framework (shared memory and
+ * payload buffers)
+ */
+#define HOST_MAX_FRAMEWORK_MAPPINGS 64
+
+/* Firmware revision of the manifest, set by the Makefile */
+#ifndef INT_BENCH_HOST_REV
+#define INT_BENCH_HOST_REV "unknown"
+#endif
+
+/*******************************************************************************
+ * TYPES
+ ******************************************************************************/
+
+struct host_partition;
+
+/* Process control block */
+typedef struct
+{
+    PROCESS_ATTRIBUTE_TYPE attributes;
+    struct host_partition* partition;
+    pthread_t              thread;
+    volatile int           started;
+    SYSTEM_TIME_TYPE       release;
+    uint32_t               deadlineMisses;
+} host_process_t;
+
+/* Partition control block */
+typedef struct host_partition
+{
+    const int_bench_host_partition_t* config;
+    volatile int                      active;
+    volatile int                      mode;
+    host_process_t processes[ARINC653_HOST_MAX_PROCESS_PER_PART];
+    volatile uint32_t                 processCount;
+} host_partition_t;
+
+/* Core control block */
+typedef struct
+{
+    pthread_t         thread;
+    pid_t             tid;
+    timer_t           extIntTimer;
+    timer_t           tickTimer;
+    SYSTEM_TIME_TYPE  maf;
+    host_partition_t* windows[INT_BENCH_HOST_MAX_PARTITIONS];
+    uint32_t          windowCount;
+    volatile uint32_t intCount[3];
+    /* Partition executing on the core (INT_BENCH_MASK_NO_PART between the
+     * windows)
+     */
+    volatile uint32_t activePart;
+    /* Sibling thread of the SMT sibling mode */
+    pthread_t         siblingThread;
+    timer_t           siblingExtIntTimer;
+} host_core_t;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/* Shared memory used by the OS abstraction layer */
+uint8_t* __IntBenchHostSharedMem = NULL;
+
+static host_partition_t sPartitions[INT_BENCH_HOST_MAX_PARTITIONS];
+static host_core_t      sCores[INT_BENCH_HOST_CORE_COUNT];
+static double           sTimeScale = 1.0;
+static SYSTEM_TIME_TYPE sStartTime;
+static volatile uint32_t sCoresReady = 0;
+
+/* Emulated OS tick frequency (Hz), 0 when no tick is emulated */
+static volatile uint32_t sTickHz = 0;
+
+/* One-shot external timer of the interrupt masking window benchmark, armed
+ * again by the hook at every expiry
+ */
+static pthread_mutex_t  sMaskTimerLock = PTHREAD_MUTEX_INITIALIZER;
+static timer_t          sMaskTimer;
+static volatile int     sMaskTimerCreated = 0;
+
+/* Interrupt arrival trace to replay */
+static void*    sReplayTrace     = NULL;
+static uint32_t sReplayTraceSize = 0;
+
+/* Interrupt handlers colors, the stacks are updated when the generation
+ * changes.
+ */
+static pthread_mutex_t         sHandlerLock = PTHREAD_MUTEX_INITIALIZER;
+static int_bench_color_arena_t sHandlerArena;
+static uint8_t*                sHandlerPool = NULL;
+static volatile uint32_t       sHandlerColorGen = 0;
+
+/* Mappings owned by the framework, used to count its translations */
+static pthread_mutex_t sMappingsLock = PTHREAD_MUTEX_INITIALIZER;
+static uintptr_t       sMappingsStart[HOST_MAX_FRAMEWORK_MAPPINGS];
+static uintptr_t       sMappingsEnd[HOST_MAX_FRAMEWORK_MAPPINGS];
+static uint32_t        sMappingsCount = 0;
+
+static __thread host_partition_t* tlsPartition = NULL;
+static __thread host_process_t*   tlsProcess   = NULL;
+static __thread uint32_t          tlsCore      = 0;
+static __thread uint32_t          tlsHandlerColorGen = 0;
+static __thread timer_t           tlsAsyncTimer;
+static __thread int               tlsAsyncTimerCreated = 0;
+
+/*******************************************************************************
+ * INTERNAL FUNCTIONS
+ ******************************************************************************/
+
+static SYSTEM_TIME_TYPE __HostGetTime(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (SYSTEM_TIME_TYPE)ts.tv_sec * HOST_NS_PER_SEC + ts.tv_nsec;
+}
+
+/* Converts a configured duration to the scaled host duration */
+static SYSTEM_TIME_TYPE __HostScale(const SYSTEM_TIME_TYPE duration)
+{
+    return (SYSTEM_TIME_TYPE)((double)duration / sTimeScale);
+}
+
+/* Sleeps until an absolute time, the sleep is restarted when interrupted */
+static void __HostSleepUntil(const SYSTEM_TIME_TYPE time)
+{
+    struct timespec ts;
+
+    ts.tv_sec  = time / HOST_NS_PER_SEC;
+    ts.tv_nsec = time % HOST_NS_PER_SEC;
+    while(EINTR == clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL));
+}
+
+/* Returns the host CPU of an emulated core */
+static long __HostCoreCpu(const uint32_t core)
+{
+    long cpuCount;
+
+    cpuCount = sysconf(_SC_NPROCESSORS_ONLN);
+    if(0 >= cpuCount)
+    {
+        cpuCount = 1;
+    }
+
+    return core % cpuCount;
+}
+
+static void __HostPinCpu(const long cpu)
+{
+    cpu_set_t cpuSet;
+
+    CPU_ZERO(&cpuSet);
+    CPU_SET(cpu, &cpuSet);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+}
+
+static void __HostPinThread(const uint32_t core)
+{
+    __HostPinCpu(__HostCoreCpu(core));
+}
+
+#ifdef INT_BENCH_HOST_SMT
+/* Returns the first SMT sibling of a host CPU from its topology
+ * (thread_siblings_list, e.g. "0,4" or "0-1"), the CPU itself when it has
+ * none.
+ */
+static long __HostSiblingCpu(const long cpu)
+{
+    char  path[128];
+    char  line[128];
+    char* cursor;
+    char* end;
+    FILE* file;
+    long  first;
+    long  last;
+
+    snprintf(path, sizeof(path),
+             "/sys/devices/system/cpu/cpu%ld/topology/thread_siblings_list",
+             cpu);
+    file = fopen(path, "r");
+    if(NULL == file)
+    {
+        return cpu;
+    }
+    if(NULL == fgets(line, sizeof(line), file))
+    {
+        fclose(file);
+        return cpu;
+    }
+    fclose(file);
+
+    cursor = line;
+    while('\0' != *cursor && '\n' != *cursor)
+    {
+        first = strtol(cursor, &end, 10);
+        if(end == cursor)
+        {
+            break;
+        }
+        last = first;
+        if('-' == *end)
+        {
+            cursor = end + 1;
+            last   = strtol(cursor, &end, 10);
+        }
+        for(; first <= last; ++first)
+        {
+            if(first != cpu)
+            {
+                return first;
+            }
+        }
+        cursor = (',' == *end) ? end + 1 : end;
+    }
+
+    return cpu;
+}
+#endif
+
+/* Maps a framework memory region. In the large page mapping mode, the region
+ * is backed by hugetlbfs pages, or by transparent huge pages on a large page
+ * aligned mapping when no huge page is reserved. Otherwise, the transparent
+ * huge pages are disabled on the region so the ordinary page baseline does not
+ * depend on the host THP policy.
+ */
+static void* __HostMapFramework(size_t size)
+{
+    uint8_t* buffer;
+#ifdef INT_BENCH_LARGE_PAGES
+    uint8_t* raw;
+    size_t   padding;
+    static int warned = 0;
+#endif
+
+    if(HOST_MAX_FRAMEWORK_MAPPINGS <= sMappingsCount)
+    {
+        fprintf(stderr, "[HOST] Too many framework mappings\n");
+        return NULL;
+    }
+
+#ifdef INT_BENCH_LARGE_PAGES
+    size = (size + INT_BENCH_LARGE_PAGE_SIZE - 1) &
+           ~(size_t)(INT_BENCH_LARGE_PAGE_SIZE - 1);
+
+    buffer = mmap(NULL, size, PROT_READ | PROT_WRITE,
+                  MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if(MAP_FAILED == buffer)
+    {
+        if(0 == __atomic_exchange_n(&warned, 1, __ATOMIC_RELAXED))
+        {
+            fprintf(stderr, "[HOST] No huge page reserved, using transparent "
+                            "huge pages\n");
+        }
+
+        /* Over-allocate to align the mapping on the large page size */
+        padding = INT_BENCH_LARGE_PAGE_SIZE;
+        raw = mmap(NULL, size + padding, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if(MAP_FAILED == raw)
+        {
+            return NULL;
+        }
+        buffer = (uint8_t*)(((uintptr_t)raw + INT_BENCH_LARGE_PAGE_SIZE - 1) &
+                            ~(uintptr_t)(INT_BENCH_LARGE_PAGE_SIZE - 1));
+        if(buffer != raw)
+        {
+            munmap(raw, buffer - raw);
+        }
+        munmap(buffer + size, raw + size + padding - (buffer + size));
+        madvise(buffer, size, MADV_HUGEPAGE);
+    }
+#else
+    buffer = mmap(NULL, size, PROT_READ | PROT_WRITE,
+                  MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(MAP_FAILED == buffer)
+    {
+        return NULL;
+    }
+    madvise(buffer, size, MADV_NOHUGEPAGE);
+#endif
+
+    pthread_mutex_lock(&sMappingsLock);
+    sMappingsStart[sMappingsCount] = (uintptr_t)buffer;
+    sMappingsEnd[sMappingsCount]   = (uintptr_t)buffer + size;
+    ++sMappingsCount;
+    pthread_mutex_unlock(&sMappingsLock);
+
+    return buffer;
+}
+
+/* Tells if a host mapping overlaps one of the framework mappings */
+static int __HostIsFrameworkMapping(const uintptr_t start, const uintptr_t end)
+{
+    uint32_t i;
+
+    for(i = 0; i < sMappingsCount; ++i)
+    {
+        if(start < sMappingsEnd[i] && sMappingsStart[i] < end)
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* Moves the interrupt handlers stack of the calling thread to the colors
+ * requested with __IntBenchSetHandlerColors. The previous stack is not freed.
+ * Must not be called from a signal handler.
+ */
+static void __HostUpdateHandlerStack(void)
+{
+    stack_t  stack;
+    uint8_t* buffer;
+    uint32_t gen;
+
+    gen = __atomic_load_n(&sHandlerColorGen, __ATOMIC_ACQUIRE);
+    if(gen == tlsHandlerColorGen)
+    {
+        return;
+    }
+    tlsHandlerColorGen = gen;
+
+    pthread_mutex_lock(&sHandlerLock);
+    buffer = __IntBenchColorAllocBuffer(&sHandlerArena,
+                                        HOST_HANDLER_STACK_SIZE);
+    pthread_mutex_unlock(&sHandlerLock);
+    if(NULL == buffer)
+    {
+        fprintf(stderr, "[HOST] Cannot allocate colored handler stack\n");
+        return;
+    }
+
+    stack.ss_sp    = buffer;
+    stack.ss_size  = HOST_HANDLER_STACK_SIZE;
+    stack.ss_flags = 0;
+    sigaltstack(&stack, NULL);
+}
+
+/* Waits until the calling process can execute: the process must be started,
+ * its partition must be in NORMAL mode and activated. HOST_SIG_RESUME is
+ * blocked in the process threads and only delivered while waiting.
+ */
+static void __HostWaitReady(host_process_t* process)
+{
+    sigset_t waitMask;
+
+    __HostUpdateHandlerStack();
+
+    pthread_sigmask(SIG_BLOCK, NULL, &waitMask);
+    sigdelset(&waitMask, HOST_SIG_RESUME);
+
+    while(0 == process->started ||
+          NORMAL != process->partition->mode ||
+          0 == process->partition->active)
+    {
+        sigsuspend(&waitMask);
+    }
+}
+
+/* Sends a signal to all the started processes of a partition */
+static void __HostSignalPartition(host_partition_t* partition, const int sig)
+{
+    uint32_t i;
+    uint32_t count;
+
+    count = __atomic_load_n(&partition->processCount, __ATOMIC_ACQUIRE);
+    for(i = 0; i < count; ++i)
+    {
+        if(0 != partition->processes[i].started)
+        {
+            pthread_kill(partition->processes[i].thread, sig);
+        }
+    }
+}
+
+static void __HostActivatePartition(host_partition_t* partition)
+{
+    if(0 == partition->active)
+    {
+        __atomic_store_n(&partition->active, 1, __ATOMIC_RELEASE);
+        __HostSignalPartition(partition, HOST_SIG_RESUME);
+    }
+}
+
+static void __HostPreemptPartition(host_partition_t* partition)
+{
+    __atomic_store_n(&partition->active, 0, __ATOMIC_RELEASE);
+    __HostSignalPartition(partition, HOST_SIG_PREEMPT);
+}
+
+/*******************************************************************************
+ * SIGNAL HANDLERS
+ ******************************************************************************/
+
+static void __HostPreemptHandler(int sig)
+{
+    sigset_t waitMask;
+    int      savedErrno;
+
+    (void)sig;
+
+    if(NULL == tlsPartition)
+    {
+        return;
+    }
+
+    savedErrno = errno;
+    pthread_sigmask(SIG_BLOCK, NULL, &waitMask);
+    sigdelset(&waitMask, HOST_SIG_RESUME);
+    while(0 == tlsPartition->active)
+    {
+        sigsuspend(&waitMask);
+    }
+    errno = savedErrno;
+}
+
+static void __HostResumeHandler(int sig)
+{
+    (void)sig;
+}
+
+/* Masks the emulated interrupts of the calling thread, the previous mask is
+ * returned in savedMask
+ */
+static void __HostMaskInts(sigset_t* savedMask)
+{
+    sigset_t mask;
+
+    sigemptyset(&mask);
+    sigaddset(&mask, HOST_SIG_IPI);
+    sigaddset(&mask, HOST_SIG_EXTINT);
+    sigaddset(&mask, HOST_SIG_DEFER);
+    sigaddset(&mask, HOST_SIG_MASK);
+    pthread_sigmask(SIG_BLOCK, &mask, savedMask);
+}
+
+/* Executes the handler of an emulated interrupt on the calling core */
+static void __HostDeliverInt(const uint32_t benchType)
+{
+    uint32_t type;
+
+    if(INT_BENCH_TYPE_INTINT == benchType)
+    {
+        type = INT_BENCH_HOST_INT_INTERNAL;
+    }
+    else if(INT_BENCH_TYPE_IPI == benchType)
+    {
+        type = INT_BENCH_HOST_INT_IPI;
+    }
+    else
+    {
+        type = INT_BENCH_HOST_INT_EXTERNAL;
+    }
+    __atomic_fetch_add(&sCores[tlsCore].intCount[type], 1, __ATOMIC_RELAXED);
+    __IntBenchCountInt(tlsCore, benchType);
+
+    /* Acknowledge the interrupt */
+    __atomic_store_n(INT_BENCH_INT_WAIT_PTR, 0, __ATOMIC_RELEASE);
+}
+
+/* Executes the handlers of the deferred interrupts on the calling core */
+static void __HostDeliverDeferred(const uint32_t pending[])
+{
+    uint32_t i;
+    uint32_t j;
+
+    for(i = 0; i < INT_BENCH_DEFER_TYPES; ++i)
+    {
+        for(j = 0; j < pending[i]; ++j)
+        {
+            __HostDeliverInt(INT_BENCH_DEFER_TYPE(i));
+        }
+    }
+}
+
+static void __HostIntHandler(int sig)
+{
+    uint32_t benchType;
+    uint32_t decision;
+
+    if(HOST_SIG_INTINT == sig)
+    {
+        benchType = INT_BENCH_TYPE_INTINT;
+    }
+    else if(HOST_SIG_IPI == sig)
+    {
+        benchType = INT_BENCH_TYPE_IPI;
+    }
+    else
+    {
+        benchType = INT_BENCH_TYPE_EXTINT;
+    }
+
+    /* The signal is the minimal acknowledgment, the handler is only executed
+     * if the interrupt is not deferred.
+     */
+    decision = __IntBenchDeferInterrupt(tlsCore, benchType);
+    if(INT_BENCH_DEFER_DELIVER == decision)
+    {
+        __HostDeliverInt(benchType);
+    }
+    else if(INT_BENCH_DEFER_NOTIFY == decision)
+    {
+        pthread_kill(sCores[INT_BENCH_DEFER_SERVICE_CORE].thread,
+                     HOST_SIG_DEFER);
+    }
+}
+
+/* Asynchronous internal interrupt: counted, the wait flag is left untouched
+ * as no generator waits for it
+ */
+static void __HostAsyncHandler(int sig)
+{
+    (void)sig;
+
+    __atomic_fetch_add(&sCores[tlsCore].intCount[INT_BENCH_HOST_INT_INTERNAL],
+                       1, __ATOMIC_RELAXED);
+    __IntBenchCountInt(tlsCore, INT_BENCH_TYPE_INTINT);
+}
+
+/* Emulated OS tick: the host scheduler is driven by the core threads, only
+ * the tick hooks are executed
+ */
+static void __HostTickHandler(int sig)
+{
+    (void)sig;
+
+    __IntBenchTickEnter(tlsCore);
+    __IntBenchTickExit(tlsCore);
+}
+
+/* External timer of the interrupt masking window benchmark: the hook reads
+ * the delay and arms the next expiry first, the interrupt is counted as an
+ * external one
+ */
+static void __HostMaskTimerHandler(int sig)
+{
+    (void)sig;
+
+    __IntBenchMaskTimerHit(sCores[tlsCore].activePart);
+    __atomic_fetch_add(&sCores[tlsCore].intCount[INT_BENCH_HOST_INT_EXTERNAL],
+                       1, __ATOMIC_RELAXED);
+    __IntBenchCountInt(tlsCore, INT_BENCH_TYPE_EXTINT);
+}
+
+/* Arms the emulated OS tick timer of a core with the current frequency */
+static void __HostArmTick(host_core_t* core)
+{
+    struct itimerspec timerValue;
+    SYSTEM_TIME_TYPE  period;
+
+    memset(&timerValue, 0, sizeof(timerValue));
+    if(0 != sTickHz)
+    {
+        period = __HostScale(HOST_NS_PER_SEC / sTickHz);
+        if(0 >= period)
+        {
+            period = 1;
+        }
+        timerValue.it_value.tv_sec  = period / HOST_NS_PER_SEC;
+        timerValue.it_value.tv_nsec = period % HOST_NS_PER_SEC;
+        timerValue.it_interval      = timerValue.it_value;
+    }
+    timer_settime(core->tickTimer, 0, &timerValue, NULL);
+}
+
+/* Service core: executes the interrupts queued on every core */
+static void __HostDeferHandler(int sig)
+{
+    uint32_t pending[INT_BENCH_DEFER_TYPES];
+    sigset_t savedMask;
+    uint32_t i;
+
+    (void)sig;
+
+    __HostMaskInts(&savedMask);
+    for(i = 0; i < INT_BENCH_HOST_CORE_COUNT; ++i)
+    {
+        if(0 != __IntBenchDeferDrain(i, pending))
+        {
+            __HostDeliverDeferred(pending);
+        }
+    }
+    pthread_sigmask(SIG_SETMASK, &savedMask, NULL);
+}
+
+static void __HostInstallHandler(const int sig, void (*handler)(int))
+{
+    struct sigaction action;
+
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = handler;
+    action.sa_flags   = SA_RESTART | SA_ONSTACK;
+    sigemptyset(&action.sa_mask);
+    sigaddset(&action.sa_mask, HOST_SIG_RESUME);
+    sigaction(sig, &action, NULL);
+}
+
+/*******************************************************************************
+ * THREADS
+ ******************************************************************************/
+
+/* Opens the deferred interrupt delivery window of a partition on the calling
+ * core
+ */
+static void __HostDeferWindowStart(const uint32_t partId)
+{
+    sigset_t savedMask;
+
+    __HostMaskInts(&savedMask);
+    __IntBenchDeferWindowStart(tlsCore, partId);
+    pthread_sigmask(SIG_SETMASK, &savedMask, NULL);
+}
+
+/* Closes the deferred interrupt delivery window of the calling core and
+ * executes the interrupts queued during the window
+ */
+static void __HostDeferWindowEnd(void)
+{
+    uint32_t pending[INT_BENCH_DEFER_TYPES];
+    sigset_t savedMask;
+
+    __HostMaskInts(&savedMask);
+    if(0 != __IntBenchDeferWindowEnd(tlsCore, pending))
+    {
+        __HostDeliverDeferred(pending);
+    }
+    pthread_sigmask(SIG_SETMASK, &savedMask, NULL);
+}
+
+static void* __HostProcessThread(void* args)
+{
+    host_process_t* process;
+
+    process      = args;
+    tlsPartition = process->partition;
+    tlsProcess   = process;
+    tlsCore      = process->partition->config->core;
+    __HostPinThread(tlsCore);
+
+    __HostWaitReady(process);
+
+    process->release = __HostGetTime();
+    process->attributes.ENTRY_POINT();
+
+    return NULL;
+}
+
+static void* __HostInitThread(void* args)
+{
+    host_partition_t* partition;
+
+    partition    = args;
+    tlsPartition = partition;
+    tlsCore      = partition->config->core;
+    __HostPinThread(tlsCore);
+
+    partition->config->mainProcess();
+
+    return NULL;
+}
+
+static void* __HostCoreThread(void* args)
+{
+    host_core_t*       core;
+    host_partition_t*  partition;
+    host_partition_t*  next;
+    SYSTEM_TIME_TYPE   mafStart;
+    SYSTEM_TIME_TYPE   windowEnd;
+    SYSTEM_TIME_TYPE   nextStart;
+    struct sigevent    event;
+    struct sched_param schedParam;
+    sigset_t           waitMask;
+    uint32_t           i;
+
+    tlsCore = (uint32_t)(uintptr_t)args;
+    core    = &sCores[tlsCore];
+    __HostPinThread(tlsCore);
+
+    /* The core thread handles the IPIs and external interrupts, it should
+     * preempt the partitions as the interrupts do on the target. This requires
+     * privileges, the default policy is kept otherwise.
+     */
+    schedParam.sched_priority = sched_get_priority_max(SCHED_FIFO);
+    pthread_setschedparam(pthread_self(), SCHED_FIFO, &schedParam);
+
+    /* Create the external interrupt timer, it expires on this thread */
+    core->tid = syscall(SYS_gettid);
+    memset(&event, 0, sizeof(event));
+    event.sigev_notify          = SIGEV_THREAD_ID;
+    event.sigev_signo           = HOST_SIG_EXTINT;
+    event._sigev_un._tid        = core->tid;
+    if(0 != timer_create(CLOCK_MONOTONIC, &event, &core->extIntTimer))
+    {
+        perror("[HOST] Cannot create the external interrupt timer");
+        exit(EXIT_FAILURE);
+    }
+
+    core->activePart = INT_BENCH_MASK_NO_PART;
+
+    /* Create the emulated OS tick timer, it expires on this thread */
+    event.sigev_signo = HOST_SIG_TICK;
+    if(0 != timer_create(CLOCK_MONOTONIC, &event, &core->tickTimer))
+    {
+        perror("[HOST] Cannot create the tick timer");
+        exit(EXIT_FAILURE);
+    }
+    __HostArmTick(core);
+
+    __atomic_fetch_add(&sCoresReady, 1, __ATOMIC_RELEASE);
+
+    /* Cores without partitions only receive interrupts */
+    if(0 == core->windowCount || 0 == core->maf)
+    {
+        pthread_sigmask(SIG_BLOCK, NULL, &waitMask);
+        while(1)
+        {
+            __HostUpdateHandlerStack();
+            sigsuspend(&waitMask);
+        }
+    }
+
+    mafStart = sStartTime;
+    while(1)
+    {
+        for(i = 0; i < core->windowCount; ++i)
+        {
+            partition = core->windows[i];
+            __HostUpdateHandlerStack();
+            __HostSleepUntil(mafStart +
+                             __HostScale(partition->config->windowOffset));
+            __HostDeferWindowStart((uint32_t)(partition - sPartitions));
+            __HostActivatePartition(partition);
+            core->activePart = (uint32_t)(partition - sPartitions);
+            __IntBenchPartitionSwitchIn(tlsCore,
+                                        (uint32_t)(partition - sPartitions));
+
+            windowEnd = partition->config->windowOffset +
+                        partition->config->windowDuration;
+            __HostSleepUntil(mafStart + __HostScale(windowEnd));
+
+            /* Do not preempt the partition if it owns the next window */
+            if(i + 1 < core->windowCount)
+            {
+                next      = core->windows[i + 1];
+                nextStart = next->config->windowOffset;
+            }
+            else
+            {
+                next      = core->windows[0];
+                nextStart = next->config->windowOffset + core->maf;
+            }
+            if(next != partition || nextStart != windowEnd)
+            {
+                __IntBenchPartitionSwitchOut(tlsCore,
+                                             (uint32_t)(partition -
+                                                        sPartitions));
+                core->activePart = INT_BENCH_MASK_NO_PART;
+                __HostPreemptPartition(partition);
+            }
+            __HostDeferWindowEnd();
+        }
+        mafStart += __HostScale(core->maf);
+    }
+
+    return NULL;
+}
+
+#ifdef INT_BENCH_HOST_SMT
+/* Sibling thread of a core: handles the interrupts routed to the second thread
+ * of the core and executes the sibling agent between them
+ */
+static void* __HostSiblingThread(void* args)
+{
+    host_core_t*    core;
+    struct sigevent event;
+
+    tlsCore = (uint32_t)(uintptr_t)args;
+    core    = &sCores[tlsCore];
+    __HostPinCpu(__HostSiblingCpu(__HostCoreCpu(tlsCore)));
+
+    /* Create the external interrupt timer, it expires on this thread */
+    memset(&event, 0, sizeof(event));
+    event.sigev_notify          = SIGEV_THREAD_ID;
+    event.sigev_signo           = HOST_SIG_EXTINT;
+    event._sigev_un._tid        = syscall(SYS_gettid);
+    if(0 != timer_create(CLOCK_MONOTONIC, &event, &core->siblingExtIntTimer))
+    {
+        perror("[HOST] Cannot create the sibling external interrupt timer");
+        exit(EXIT_FAILURE);
+    }
+
+    __atomic_fetch_add(&sCoresReady, 1, __ATOMIC_RELEASE);
+
+    __IntBenchSmtAgent(tlsCore, 1);
+
+    return NULL;
+}
+#endif
+
+/*******************************************************************************
+ * API REQUIREMENTS (OSAbstractionLayer.h)
+ ******************************************************************************/
+
+uint64_t __IntBenchGetTimestamp(void)
+{
+    return (uint64_t)(__HostGetTime() - sStartTime);
+}
+
+const void* __IntBenchGetReplayTrace(uint32_t* size)
+{
+    *size = sReplayTraceSize;
+    return sReplayTrace;
+}
+
+int32_t __TestAndSet(volatile int32_t * lock)
+{
+    return __atomic_exchange_n(lock, 1, __ATOMIC_ACQUIRE);
+}
+
+void __LockRelease(volatile int32_t * lock)
+{
+    __atomic_store_n(lock, 0, __ATOMIC_RELEASE);
+}
+
+void __IntBenchGenerateSyscall(void)
+{
+    syscall(SYS_getppid);
+    __IntBenchCountInt(tlsCore, INT_BENCH_TYPE_SC);
+}
+
+uintptr_t __IntBenchVirtToPhys(const void* addr)
+{
+    static int       pagemapFd = -2;
+    static long      pageSize  = 0;
+    uint64_t         entry;
+    uint64_t         pfn;
+
+    /* Open the pagemap once, unprivileged processes read null frame numbers */
+    if(-2 == __atomic_load_n(&pagemapFd, __ATOMIC_ACQUIRE))
+    {
+        pageSize = sysconf(_SC_PAGESIZE);
+        __atomic_store_n(&pagemapFd, open("/proc/self/pagemap", O_RDONLY),
+                         __ATOMIC_RELEASE);
+    }
+
+    pfn = 0;
+    if(0 <= pagemapFd &&
+       sizeof(entry) == pread(pagemapFd, &entry, sizeof(entry),
+                              ((uintptr_t)addr / pageSize) * sizeof(entry)))
+    {
+        /* Bit 63: page present, bits 0-54: page frame number */
+        if(0 != (entry >> 63))
+        {
+            pfn = entry & ((1ULL << 55) - 1);
+        }
+    }
+
+    if(0 == pfn)
+    {
+        static int warned = 0;
+        if(0 == __atomic_exchange_n(&warned, 1, __ATOMIC_RELAXED))
+        {
+            fprintf(stderr, "[HOST] Physical addresses unavailable, the colors "
+                            "are computed from the virtual addresses\n");
+        }
+        return (uintptr_t)addr;
+    }
+
+    return (uintptr_t)(pfn * pageSize) + ((uintptr_t)addr % pageSize);
+}
+
+void __IntBenchSetHandlerColors(const uint32_t colorMask)
+{
+    pthread_mutex_lock(&sHandlerLock);
+    if(NULL == sHandlerPool)
+    {
+        sHandlerPool = mmap(NULL, HOST_HANDLER_POOL_SIZE,
+                            PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+                            -1, 0);
+        if(MAP_FAILED == sHandlerPool)
+        {
+            sHandlerPool = NULL;
+            pthread_mutex_unlock(&sHandlerLock);
+            perror("[HOST] Cannot allocate the handlers memory pool");
+            return;
+        }
+        __IntBenchColorArenaInit(&sHandlerArena, sHandlerPool,
+                                 HOST_HANDLER_POOL_SIZE, colorMask);
+    }
+    else
+    {
+        sHandlerArena.colorMask = colorMask & INT_BENCH_COLOR_ALL;
+    }
+    pthread_mutex_unlock(&sHandlerLock);
+
+    /* The threads update their handlers stack at their next scheduling
+     * point, the calling thread is updated now.
+     */
+    __atomic_fetch_add(&sHandlerColorGen, 1, __ATOMIC_RELEASE);
+    __HostUpdateHandlerStack();
+}
+
+void* __IntBenchAllocLargePages(const size_t size)
+{
+    if(0 == size)
+    {
+        return NULL;
+    }
+    return __HostMapFramework(size);
+}
+
+uint32_t __IntBenchFrameworkTranslations(uint32_t* pageSize)
+{
+    FILE*         file;
+    char          line[256];
+    unsigned long start;
+    unsigned long end;
+    unsigned long value;
+    unsigned long size;
+    unsigned long rss;
+    unsigned long anonHuge;
+    unsigned long kernelPage;
+    int           tracked;
+    uint32_t      count;
+    uint32_t      largest;
+
+    count   = 0;
+    largest = 0;
+
+    /* The mappings are not split by the framework ranges: a host mapping
+     * overlapping a framework mapping is counted as a whole.
+     */
+    file = fopen("/proc/self/smaps", "r");
+    if(NULL == file)
+    {
+        *pageSize = 0;
+        return 0;
+    }
+
+    pthread_mutex_lock(&sMappingsLock);
+    tracked = 0;
+    size = rss = anonHuge = kernelPage = 0;
+    while(1)
+    {
+        if(NULL == fgets(line, sizeof(line), file) ||
+           2 == sscanf(line, "%lx-%lx ", &start, &end))
+        {
+            /* Account the previous mapping */
+            if(0 != tracked && 4 < kernelPage)
+            {
+                /* hugetlbfs: the pages are reserved at mapping time */
+                count += (size + kernelPage - 1) / kernelPage;
+                if(largest < kernelPage * 1024)
+                {
+                    largest = kernelPage * 1024;
+                }
+            }
+            else if(0 != tracked && 0 != kernelPage)
+            {
+                /* Transparent huge pages and resident ordinary pages */
+                count += anonHuge / (INT_BENCH_LARGE_PAGE_SIZE / 1024) +
+                         (rss - anonHuge) / kernelPage;
+                if(0 != anonHuge)
+                {
+                    largest = INT_BENCH_LARGE_PAGE_SIZE;
+                }
+                else if(0 != rss && largest < kernelPage * 1024)
+                {
+                    largest = kernelPage * 1024;
+                }
+            }
+
+            if(feof(file))
+            {
+                break;
+            }
+
+            tracked = __HostIsFrameworkMapping(start, end);
+            size = rss = anonHuge = kernelPage = 0;
+        }
+        else if(1 == sscanf(line, "Size: %lu kB", &value))
+        {
+            size = value;
+        }
+        else if(1 == sscanf(line, "Rss: %lu kB", &value))
+        {
+            rss = value;
+        }
+        else if(1 == sscanf(line, "AnonHugePages: %lu kB", &value))
+        {
+            anonHuge = value;
+        }
+        else if(1 == sscanf(line, "KernelPageSize: %lu kB", &value))
+        {
+            kernelPage = value;
+        }
+    }
+    pthread_mutex_unlock(&sMappingsLock);
+
+    fclose(file);
+
+    *pageSize = largest;
+    return count;
+}
+
+void __IntBenchHostRaiseInt(const int_bench_host_int_t type,
+                            const uint32_t             coreId)
+{
+    struct itimerspec timerValue;
+    uint32_t          core;
+    pthread_t         thread;
+    timer_t           timer;
+
+    core   = INT_BENCH_DST_CORE(coreId) % INT_BENCH_HOST_CORE_COUNT;
+    thread = sCores[core].thread;
+    timer  = sCores[core].extIntTimer;
+#ifdef INT_BENCH_HOST_SMT
+    if(0 != INT_BENCH_DST_THR(coreId))
+    {
+        thread = sCores[core].siblingThread;
+        timer  = sCores[core].siblingExtIntTimer;
+    }
+#endif
+
+    switch(type)
+    {
+        case INT_BENCH_HOST_INT_INTERNAL:
+            pthread_kill(pthread_self(), HOST_SIG_INTINT);
+            break;
+        case INT_BENCH_HOST_INT_IPI:
+            pthread_kill(thread, HOST_SIG_IPI);
+            break;
+        case INT_BENCH_HOST_INT_EXTERNAL:
+            memset(&timerValue, 0, sizeof(timerValue));
+            timerValue.it_value.tv_nsec = 1;
+            timer_settime(timer, 0, &timerValue, NULL);
+            break;
+        default:
+            break;
+    }
+}
+
+uint32_t __IntBenchHostArmMaskTimer(const uint32_t coreId,
+                                    const uint32_t period)
+{
+    struct itimerspec timerValue;
+    struct sigevent   event;
+    SYSTEM_TIME_TYPE  scaled;
+    SYSTEM_TIME_TYPE  start;
+
+    pthread_mutex_lock(&sMaskTimerLock);
+
+    /* The timer is created again for every destination */
+    if(0 != sMaskTimerCreated)
+    {
+        timer_delete(sMaskTimer);
+        sMaskTimerCreated = 0;
+    }
+    if(0 == period)
+    {
+        pthread_mutex_unlock(&sMaskTimerLock);
+        return 0;
+    }
+
+    memset(&event, 0, sizeof(event));
+    event.sigev_notify   = SIGEV_THREAD_ID;
+    event.sigev_signo    = HOST_SIG_MASK;
+    event._sigev_un._tid =
+        sCores[INT_BENCH_DST_CORE(coreId) % INT_BENCH_HOST_CORE_COUNT].tid;
+    if(0 != timer_create(CLOCK_MONOTONIC, &event, &sMaskTimer))
+    {
+        perror("[HOST] Cannot create the masking window timer");
+        pthread_mutex_unlock(&sMaskTimerLock);
+        return 0;
+    }
+    sMaskTimerCreated = 1;
+
+    scaled = __HostScale(period);
+    if(0 >= scaled)
+    {
+        scaled = 1;
+    }
+
+    /* Only the first expiry is armed, the hook arms the next ones */
+    memset(&timerValue, 0, sizeof(timerValue));
+    start = __HostGetTime() + scaled;
+    timerValue.it_value.tv_sec  = start / HOST_NS_PER_SEC;
+    timerValue.it_value.tv_nsec = start % HOST_NS_PER_SEC;
+    timer_settime(sMaskTimer, TIMER_ABSTIME, &timerValue, NULL);
+
+    pthread_mutex_unlock(&sMaskTimerLock);
+
+    return (uint32_t)scaled;
+}
+
+void __IntBenchHostRearmMaskTimer(const uint64_t delay)
+{
+    struct itimerspec timerValue;
+
+    /* Called from the timer signal handler, the lock is not taken */
+    if(0 == sMaskTimerCreated)
+    {
+        return;
+    }
+
+    memset(&timerValue, 0, sizeof(timerValue));
+    timerValue.it_value.tv_sec  = (time_t)(delay / HOST_NS_PER_SEC);
+    timerValue.it_value.tv_nsec = (long)(delay % HOST_NS_PER_SEC);
+    if(0 == delay)
+    {
+        timerValue.it_value.tv_nsec = 1;
+    }
+    timer_settime(sMaskTimer, 0, &timerValue, NULL);
+}
+
+uint32_t __IntBenchSetTickFrequency(const uint32_t hz)
+{
+    uint32_t i;
+
+    if(0 == hz || hz == sTickHz)
+    {
+        return sTickHz;
+    }
+
+    /* The core threads arm their timer when they start, the timers of the
+     * started cores are armed again
+     */
+    sTickHz = hz;
+    if(INT_BENCH_HOST_CORE_COUNT * INT_BENCH_THREADS_PER_CORE <=
+       __atomic_load_n(&sCoresReady, __ATOMIC_ACQUIRE))
+    {
+        for(i = 0; i < INT_BENCH_HOST_CORE_COUNT; ++i)
+        {
+            __HostArmTick(&sCores[i]);
+        }
+    }
+
+    return sTickHz;
+}
+
+void __IntBenchGetBoardInfo(char* boardId, const uint32_t boardSize,
+                            char* firmwareHash, const uint32_t firmwareSize)
+{
+    const char* value;
+
+    value = getenv(INT_BENCH_HOST_ENV_BOARD);
+    if(NULL != value)
+    {
+        strncpy(boardId, value, boardSize);
+    }
+    else if(0 != gethostname(boardId, boardSize))
+    {
+        strncpy(boardId, "unknown", boardSize);
+    }
+
+    value = getenv(INT_BENCH_HOST_ENV_FIRMWARE);
+    strncpy(firmwareHash, NULL != value ? value : INT_BENCH_HOST_REV,
+            firmwareSize);
+}
+
+uint64_t __IntBenchGetWallClock(void)
+{
+    return (uint64_t)time(NULL);
+}
+
+void __IntBenchWaitInt(void)
+{
+    sigset_t waitMask;
+
+    __HostUpdateHandlerStack();
+    pthread_sigmask(SIG_BLOCK, NULL, &waitMask);
+    sigsuspend(&waitMask);
+}
+
+void __IntBenchHostArmAsyncInt(const uint64_t delay)
+{
+    struct itimerspec timerValue;
+    struct sigevent   event;
+
+    if(0 == tlsAsyncTimerCreated)
+    {
+        if(0 == delay)
+        {
+            return;
+        }
+        memset(&event, 0, sizeof(event));
+        event.sigev_notify   = SIGEV_THREAD_ID;
+        event.sigev_signo    = HOST_SIG_ASYNC;
+        event._sigev_un._tid = syscall(SYS_gettid);
+        if(0 != timer_create(CLOCK_MONOTONIC, &event, &tlsAsyncTimer))
+        {
+            perror("[HOST] Cannot create the asynchronous interrupt timer");
+            return;
+        }
+        tlsAsyncTimerCreated = 1;
+    }
+
+    memset(&timerValue, 0, sizeof(timerValue));
+    timerValue.it_value.tv_sec  = delay / HOST_NS_PER_SEC;
+    timerValue.it_value.tv_nsec = delay % HOST_NS_PER_SEC;
+    timer_settime(tlsAsyncTimer, 0, &timerValue, NULL);
+}
+
+/*******************************************************************************
+ * APEX
+ ******************************************************************************/
+
+void CREATE_PROCESS(PROCESS_ATTRIBUTE_TYPE* attributes,
+                    PROCESS_ID_TYPE*        processId,
+                    RETURN_CODE_TYPE*       returnCode)
+{
+    host_partition_t* partition;
+    host_process_t*   process;
+    pthread_attr_t    threadAttr;
+    uint32_t          count;
+
+    partition = tlsPartition;
+    if(NULL == partition || NORMAL == partition->mode)
+    {
+        *returnCode = INVALID_MODE;
+        return;
+    }
+    if(NULL == attributes || NULL == attributes->ENTRY_POINT ||
+       NULL == processId)
+    {
+        *returnCode = INVALID_PARAM;
+        return;
+    }
+
+    count = partition->processCount;
+    if(ARINC653_HOST_MAX_PROCESS_PER_PART <= count)
+    {
+        *returnCode = INVALID_CONFIG;
+        return;
+    }
+
+    process = &partition->processes[count];
+    memset(process, 0, sizeof(host_process_t));
+    memcpy(&process->attributes, attributes, sizeof(PROCESS_ATTRIBUTE_TYPE));
+    process->partition = partition;
+
+    pthread_attr_init(&threadAttr);
+    pthread_attr_setstacksize(&threadAttr,
+                              PTHREAD_STACK_MIN + attributes->STACK_SIZE);
+    if(0 != pthread_create(&process->thread, &threadAttr, __HostProcessThread,
+                           process))
+    {
+        pthread_attr_destroy(&threadAttr);
+        *returnCode = INVALID_CONFIG;
+        return;
+    }
+    pthread_attr_destroy(&threadAttr);
+
+    __atomic_store_n(&partition->processCount, count + 1, __ATOMIC_RELEASE);
+
+    *processId  = (PROCESS_ID_TYPE)count;
+    *returnCode = NO_ERROR;
+}
+
+void START(PROCESS_ID_TYPE processId, RETURN_CODE_TYPE* returnCode)
+{
+    host_partition_t* partition;
+    host_process_t*   process;
+
+    partition = tlsPartition;
+    if(NULL == partition || 0 > processId ||
+       partition->processCount <= (uint32_t)processId)
+    {
+        *returnCode = INVALID_PARAM;
+        return;
+    }
+
+    process = &partition->processes[processId];
+    if(0 != process->started)
+    {
+        *returnCode = NO_ACTION;
+        return;
+    }
+
+    __atomic_store_n(&process->started, 1, __ATOMIC_RELEASE);
+    pthread_kill(process->thread, HOST_SIG_RESUME);
+
+    *returnCode = NO_ERROR;
+}
+
+void SET_PARTITION_MODE(OPERATING_MODE_TYPE operatingMode,
+                        RETURN_CODE_TYPE*   returnCode)
+{
+    host_partition_t* partition;
+
+    partition = tlsPartition;
+    if(NULL == partition)
+    {
+        *returnCode = INVALID_MODE;
+        return;
+    }
+
+    if(NORMAL == operatingMode)
+    {
+        if(NORMAL == partition->mode)
+        {
+            *returnCode = NO_ACTION;
+            return;
+        }
+
+        __atomic_store_n(&partition->mode, NORMAL, __ATOMIC_RELEASE);
+        __HostSignalPartition(partition, HOST_SIG_RESUME);
+
+        /* The initialization process stops when entering NORMAL mode */
+        if(NULL == tlsProcess)
+        {
+            pthread_exit(NULL);
+        }
+    }
+    else if(IDLE == operatingMode)
+    {
+        printf("[HOST] Partition %s set to IDLE\n", partition->config->name);
+        __atomic_store_n(&partition->mode, IDLE, __ATOMIC_RELEASE);
+        __atomic_store_n(&partition->active, 0, __ATOMIC_RELEASE);
+        __HostSignalPartition(partition, HOST_SIG_PREEMPT);
+        pthread_exit(NULL);
+    }
+    else
+    {
+        /* Restarting a partition is not supported on the host */
+        *returnCode = NOT_AVAILABLE;
+        return;
+    }
+
+    *returnCode = NO_ERROR;
+}
+
+void PERIODIC_WAIT(RETURN_CODE_TYPE* returnCode)
+{
+    host_process_t*  process;
+    SYSTEM_TIME_TYPE now;
+
+    process = tlsProcess;
+    if(NULL == process || 0 >= process->attributes.PERIOD)
+    {
+        *returnCode = INVALID_MODE;
+        return;
+    }
+
+    now = __HostGetTime();
+    if(0 < process->attributes.TIME_CAPACITY &&
+       now > process->release + __HostScale(process->attributes.TIME_CAPACITY))
+    {
+        ++process->deadlineMisses;
+    }
+
+    /* Skip the release points missed by an overrunning process */
+    do
+    {
+        process->release += __HostScale(process->attributes.PERIOD);
+    } while(process->release <= now);
+    __HostSleepUntil(process->release);
+    __HostWaitReady(process);
+
+    *returnCode = NO_ERROR;
+}
+
+void GET_TIME(SYSTEM_TIME_TYPE* systemTime, RETURN_CODE_TYPE* returnCode)
+{
+    *systemTime = __HostGetTime() - sStartTime;
+    *returnCode = NO_ERROR;
+}
+
+void RAISE_APPLICATION_ERROR(ERROR_CODE_TYPE         errorCode,
+                             MESSAGE_ADDR_TYPE       message,
+                             ERROR_MESSAGE_SIZE_TYPE length,
+                             RETURN_CODE_TYPE*       returnCode)
+{
+    if(APPLICATION_ERROR != errorCode || NULL == message || 0 > length)
+    {
+        *returnCode = INVALID_PARAM;
+        return;
+    }
+
+    fprintf(stderr, "[HOST] Application error in %s: %.*s\n",
+            (NULL != tlsPartition) ? tlsPartition->config->name : "host",
+            (int)length, message);
+
+    *returnCode = NO_ERROR;
+}
+
+/*******************************************************************************
+ * RUNTIME
+ ******************************************************************************/
+
+/* Loads the interrupt arrival trace to replay */
+static int __HostLoadTrace(const char* path)
+{
+    FILE* file;
+    long  size;
+
+    file = fopen(path, "rb");
+    if(NULL == file)
+    {
+        perror("[HOST] Cannot open the trace file");
+        return -1;
+    }
+    if(0 != fseek(file, 0, SEEK_END) || 0 > (size = ftell(file)) ||
+       0 != fseek(file, 0, SEEK_SET) || UINT32_MAX < (unsigned long)size)
+    {
+        perror("[HOST] Cannot get the trace file size");
+        fclose(file);
+        return -1;
+    }
+
+    sReplayTrace = malloc((size_t)size);
+    if(NULL == sReplayTrace ||
+       (size_t)size != fread(sReplayTrace, 1, (size_t)size, file))
+    {
+        perror("[HOST] Cannot read the trace file");
+        free(sReplayTrace);
+        sReplayTrace = NULL;
+        fclose(file);
+        return -1;
+    }
+    fclose(file);
+
+    sReplayTraceSize = (uint32_t)size;
+    printf("[HOST] Trace %s loaded (%u bytes)\n", path, sReplayTraceSize);
+    return 0;
+}
+
+static int __HostWriteDump(const char* path)
+{
+    FILE*  file;
+    size_t size;
+
+    size = INT_BENCH_DUMP_REG_END_ADDR - INT_BENCH_DUMP_REG_HEADER_ADDR;
+
+    file = fopen(path, "wb");
+    if(NULL == file)
+    {
+        perror("[HOST] Cannot open the dump file");
+        return -1;
+    }
+    if(size != fwrite((void*)INT_BENCH_DUMP_REG_HEADER_ADDR, 1, size, file))
+    {
+        perror("[HOST] Cannot write the dump file");
+        fclose(file);
+        return -1;
+    }
+    fclose(file);
+
+    printf("[HOST] Dump written to %s (%zu bytes)\n", path, size);
+    return 0;
+}
+
+static void __HostPrintStats(void)
+{
+    host_partition_t* partition;
+    uint32_t          i;
+    uint32_t          j;
+
+    for(i = 0; i < gIntBenchHostPartitionCount; ++i)
+    {
+        partition = &sPartitions[i];
+        for(j = 0; j < partition->processCount; ++j)
+        {
+            printf("[HOST] %s/%s: %u deadline misses\n",
+                   partition->config->name,
+                   partition->processes[j].attributes.NAME,
+                   partition->processes[j].deadlineMisses);
+        }
+    }
+    for(i = 0; i < INT_BENCH_HOST_CORE_COUNT; ++i)
+    {
+        printf("[HOST] Core %u: %u internal, %u IPI, %u external interrupts\n",
+               i,
+               sCores[i].intCount[INT_BENCH_HOST_INT_INTERNAL],
+               sCores[i].intCount[INT_BENCH_HOST_INT_IPI],
+               sCores[i].intCount[INT_BENCH_HOST_INT_EXTERNAL]);
+    }
+    printf("[HOST] Framework translations: %u (largest page %u bytes)\n",
+           *(uint32_t*)INT_BENCH_DUMP_REG_HEADER_TLB_COUNT,
+           *(uint32_t*)INT_BENCH_DUMP_REG_HEADER_TLB_PAGE);
+}
+
+int main(void)
+{
+    host_partition_t* partition;
+    host_core_t*      core;
+    pthread_t         thread;
+    sigset_t          mask;
+    struct timespec   timeout;
+    const char*       env;
+    const char*       dumpPath;
+    double            duration;
+    size_t            memSize;
+    uint32_t          i;
+    uint32_t          j;
+
+    /* Parse the environment */
+    env = getenv(INT_BENCH_HOST_ENV_TIME_SCALE);
+    if(NULL != env && 0.0 < atof(env))
+    {
+        sTimeScale = atof(env);
+    }
+    env = getenv(INT_BENCH_HOST_ENV_DURATION);
+    duration = (NULL != env) ? atof(env) : 0.0;
+    dumpPath = getenv(INT_BENCH_HOST_ENV_DUMP_PATH);
+    if(NULL == dumpPath)
+    {
+        dumpPath = INT_BENCH_HOST_DEFAULT_DUMP_PATH;
+    }
+    env = getenv(INT_BENCH_HOST_ENV_TRACE_PATH);
+    if(NULL != env && 0 != __HostLoadTrace(env))
+    {
+        return EXIT_FAILURE;
+    }
+
+    /* Allocate the shared memory */
+    memSize = INT_BENCH_SHARED_MEM_SIZE;
+    __IntBenchHostSharedMem = __HostMapFramework(memSize);
+    if(NULL == __IntBenchHostSharedMem)
+    {
+        perror("[HOST] Cannot allocate the shared memory");
+        return EXIT_FAILURE;
+    }
+    INT_BENCH_DUMP_HADER();
+
+    /* Setup the signals, HOST_SIG_RESUME is only delivered while waiting and
+     * the termination signals are handled by the main thread.
+     */
+    __HostInstallHandler(HOST_SIG_PREEMPT, __HostPreemptHandler);
+    __HostInstallHandler(HOST_SIG_RESUME,  __HostResumeHandler);
+    __HostInstallHandler(HOST_SIG_INTINT,  __HostIntHandler);
+    __HostInstallHandler(HOST_SIG_IPI,     __HostIntHandler);
+    __HostInstallHandler(HOST_SIG_EXTINT,  __HostIntHandler);
+    __HostInstallHandler(HOST_SIG_DEFER,   __HostDeferHandler);
+    __HostInstallHandler(HOST_SIG_ASYNC,   __HostAsyncHandler);
+    __HostInstallHandler(HOST_SIG_TICK,    __HostTickHandler);
+    __HostInstallHandler(HOST_SIG_MASK,    __HostMaskTimerHandler);
+
+    sigemptyset(&mask);
+    sigaddset(&mask, HOST_SIG_RESUME);
+    sigaddset(&mask, SIGINT);
+    sigaddset(&mask, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &mask, NULL);
+
+    /* Build the cores schedules, the windows are sorted by offset */
+    if(INT_BENCH_HOST_MAX_PARTITIONS < gIntBenchHostPartitionCount)
+    {
+        fprintf(stderr, "[HOST] Too many partitions\n");
+        return EXIT_FAILURE;
+    }
+    for(i = 0; i < INT_BENCH_HOST_CORE_COUNT; ++i)
+    {
+        sCores[i].maf = gIntBenchHostMaf[i];
+    }
+    for(i = 0; i < gIntBenchHostPartitionCount; ++i)
+    {
+        partition         = &sPartitions[i];
+        partition->config = &gIntBenchHostPartitions[i];
+        partition->mode   = COLD_START;
+
+        if(INT_BENCH_HOST_CORE_COUNT <= partition->config->core)
+        {
+            fprintf(stderr, "[HOST] Invalid core for partition %s\n",
+                    partition->config->name);
+            return EXIT_FAILURE;
+        }
+        core = &sCores[partition->config->core];
+        if(core->maf < partition->config->windowOffset +
+                       partition->config->windowDuration)
+        {
+            fprintf(stderr, "[HOST] Window of partition %s exceeds the MAF\n",
+                    partition->config->name);
+            return EXIT_FAILURE;
+        }
+
+        j = core->windowCount++;
+        while(0 < j && core->windows[j - 1]->config->windowOffset >
+                       partition->config->windowOffset)
+        {
+            core->windows[j] = core->windows[j - 1];
+            --j;
+        }
+        core->windows[j] = partition;
+    }
+
+    /* Start the cores, then the partitions */
+    sStartTime = __HostGetTime();
+    for(i = 0; i < INT_BENCH_HOST_CORE_COUNT; ++i)
+    {
+        if(0 != pthread_create(&sCores[i].thread, NULL, __HostCoreThread,
+                               (void*)(uintptr_t)i))
+        {
+            perror("[HOST] Cannot create core thread");
+            return EXIT_FAILURE;
+        }
+    }
+#ifdef INT_BENCH_HOST_SMT
+    for(i = 0; i < INT_BENCH_HOST_CORE_COUNT; ++i)
+    {
+        if(0 != pthread_create(&sCores[i].siblingThread, NULL,
+                               __HostSiblingThread, (void*)(uintptr_t)i))
+        {
+            perror("[HOST] Cannot create sibling thread");
+            return EXIT_FAILURE;
+        }
+    }
+#endif
+    while(INT_BENCH_HOST_CORE_COUNT * INT_BENCH_THREADS_PER_CORE >
+          __atomic_load_n(&sCoresReady, __ATOMIC_ACQUIRE))
+    {
+        sched_yield();
+    }
+    for(i = 0; i < gIntBenchHostPartitionCount; ++i)
+    {
+        if(0 != pthread_create(&thread, NULL, __HostInitThread,
+                               &sPartitions[i]))
+        {
+            perror("[HOST] Cannot create partition thread");
+            return EXIT_FAILURE;
+        }
+        pthread_detach(thread);
+    }
+
+    printf("[HOST] Running %u partitions, time scale %.2f\n",
+           gIntBenchHostPartitionCount, sTimeScale);
+
+    /* Wait for the end of the run */
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGINT);
+    sigaddset(&mask, SIGTERM);
+    if(0.0 < duration)
+    {
+        timeout.tv_sec  = (time_t)duration;
+        timeout.tv_nsec = (long)((duration - (double)timeout.tv_sec) *
+                                 HOST_NS_PER_SEC);
+        while(0 > sigtimedwait(&mask, NULL, &timeout) && EINTR == errno);
+    }
+    else
+    {
+        while(0 > sigwaitinfo(&mask, NULL) && EINTR == errno);
+    }
+
+    /* The mappings are populated lazily, count the translations again */
+    INT_BENCH_DUMP_TRANSLATIONS();
+    INT_BENCH_MANIFEST_CLOSE();
+
+    __HostPrintStats();
+    if(0 != __HostWriteDump(dumpPath))
+    {
+        return EXIT_FAILURE;
+    }
+
+    /* Do not wait for the partitions, they never return */
+    exit(EXIT_SUCCESS);
+}
+
+/* __________________________________________________________________________
+ * END OF FILE:
+ * -------------
+ * ___________________________________________________________________________
+ */
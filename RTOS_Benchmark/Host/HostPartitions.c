@@ -0,0 +1,174 @@
+/* __________________________________________________________________________
+* MODULE DESCRIPTION:
+* -------------------
+* Filename : HostPartitions.c
+*
+* Description: This file contains the partitions configuration of the Linux
+* host runtime. It mirrors the T2080 configuration of the example partitions:
+* the applicative partition executes on core 0 with a 100ms MAF and the system
+* call generator executes on core 1 with a 1s MAF.
+*
+* When INT_BENCH_HOST_SWEEP is defined, one sweep partition executes on each
+* core to build the source x destination interference matrix.
+*
+* When INT_BENCH_HOST_SWITCH is defined, the applicative partition and the
+* partition switch generator share core 0: each owns half of the
+* INT_BENCH_HOST_SWITCH_MAF MAF, the core switches partitions twice per MAF.
+*
+* When INT_BENCH_HOST_REPLAY is defined, the system call generator is replaced
+* by the trace replay generator (the trace is given by INTBENCH_HOST_TRACE).
+*
+* When INT_BENCH_HOST_MBW is defined, the memory bandwidth co-runner
+* (MemCoRunnerPartition.c) executes on core 2 alongside the default
+* configuration.
+*
+* When INT_BENCH_HOST_MICRO is defined, the framework microbenchmarks
+* (MicroBench.c) execute alone on core 0, the other cores only receive the
+* generated interrupts.
+*
+* The example partitions are compiled with their main_process renamed (see the
+* Makefile) to link them in a single executable.
+* __________________________________________________________________________
+*/
+
+/* INCLUDE SECTION */
+#include "HostRuntime.h"
+
+#ifdef INT_BENCH_HOST_SWEEP
+
+extern void SweepPartition0_main_process(void);
+extern void SweepPartition1_main_process(void);
+extern void SweepPartition2_main_process(void);
+extern void SweepPartition3_main_process(void);
+
+const int_bench_host_partition_t gIntBenchHostPartitions[] =
+{
+    /* Name              Core  Offset  Duration       Entry point */
+    {"SweepPartition0",  0,    0,      1000000000ULL, SweepPartition0_main_process},
+    {"SweepPartition1",  1,    0,      1000000000ULL, SweepPartition1_main_process},
+    {"SweepPartition2",  2,    0,      1000000000ULL, SweepPartition2_main_process},
+    {"SweepPartition3",  3,    0,      1000000000ULL, SweepPartition3_main_process}
+};
+
+const uint64_t gIntBenchHostMaf[INT_BENCH_HOST_CORE_COUNT] =
+{
+    1000000000ULL,  /* Core 0 */
+    1000000000ULL,  /* Core 1 */
+    1000000000ULL,  /* Core 2 */
+    1000000000ULL   /* Core 3 */
+};
+
+#elif defined(INT_BENCH_HOST_SWITCH)
+
+#ifndef INT_BENCH_HOST_SWITCH_MAF
+#define INT_BENCH_HOST_SWITCH_MAF 10000000ULL
+#endif
+
+extern void ApplicativePartition_main_process(void);
+extern void SwitchPartition_main_process(void);
+
+const int_bench_host_partition_t gIntBenchHostPartitions[] =
+{
+    /* Name                  Core  Offset                         Duration                       Entry point */
+    {"ApplicativePartition", 0,    0,                             INT_BENCH_HOST_SWITCH_MAF / 2, ApplicativePartition_main_process},
+    {"SwitchPartition",      0,    INT_BENCH_HOST_SWITCH_MAF / 2, INT_BENCH_HOST_SWITCH_MAF / 2, SwitchPartition_main_process}
+};
+
+const uint64_t gIntBenchHostMaf[INT_BENCH_HOST_CORE_COUNT] =
+{
+    INT_BENCH_HOST_SWITCH_MAF,  /* Core 0 */
+    0,                          /* Core 1 */
+    0,                          /* Core 2 */
+    0                           /* Core 3 */
+};
+
+#elif defined(INT_BENCH_HOST_REPLAY)
+
+extern void ApplicativePartition_main_process(void);
+extern void ReplayPartition_main_process(void);
+
+const int_bench_host_partition_t gIntBenchHostPartitions[] =
+{
+    /* Name                  Core  Offset  Duration       Entry point */
+    {"ApplicativePartition", 0,    0,      100000000ULL,  ApplicativePartition_main_process},
+    {"ReplayPartition",      1,    0,      1000000000ULL, ReplayPartition_main_process}
+};
+
+const uint64_t gIntBenchHostMaf[INT_BENCH_HOST_CORE_COUNT] =
+{
+    100000000ULL,   /* Core 0 */
+    1000000000ULL,  /* Core 1 */
+    0,              /* Core 2 */
+    0               /* Core 3 */
+};
+
+#elif defined(INT_BENCH_HOST_MBW)
+
+extern void ApplicativePartition_main_process(void);
+extern void SysCallPartition_main_process(void);
+extern void MemCoRunnerPartition_main_process(void);
+
+const int_bench_host_partition_t gIntBenchHostPartitions[] =
+{
+    /* Name                  Core  Offset  Duration       Entry point */
+    {"ApplicativePartition", 0,    0,      100000000ULL,  ApplicativePartition_main_process},
+    {"SysCallPartition",     1,    0,      1000000000ULL, SysCallPartition_main_process},
+    {"MemCoRunnerPartition", 2,    0,      1000000000ULL, MemCoRunnerPartition_main_process}
+};
+
+const uint64_t gIntBenchHostMaf[INT_BENCH_HOST_CORE_COUNT] =
+{
+    100000000ULL,   /* Core 0 */
+    1000000000ULL,  /* Core 1 */
+    1000000000ULL,  /* Core 2 */
+    0               /* Core 3 */
+};
+
+#elif defined(INT_BENCH_HOST_MICRO)
+
+extern void MicroBench_main_process(void);
+
+const int_bench_host_partition_t gIntBenchHostPartitions[] =
+{
+    /* Name                  Core  Offset  Duration       Entry point */
+    {"MicroBench",           0,    0,      1000000000ULL, MicroBench_main_process}
+};
+
+const uint64_t gIntBenchHostMaf[INT_BENCH_HOST_CORE_COUNT] =
+{
+    1000000000ULL,  /* Core 0 */
+    0,              /* Core 1 */
+    0,              /* Core 2 */
+    0               /* Core 3 */
+};
+
+#else
+
+extern void ApplicativePartition_main_process(void);
+extern void SysCallPartition_main_process(void);
+
+const int_bench_host_partition_t gIntBenchHostPartitions[] =
+{
+    /* Name                  Core  Offset  Duration       Entry point */
+    {"ApplicativePartition", 0,    0,      100000000ULL,  ApplicativePartition_main_process},
+    {"SysCallPartition",     1,    0,      1000000000ULL, SysCallPartition_main_process}
+};
+
+const uint64_t gIntBenchHostMaf[INT_BENCH_HOST_CORE_COUNT] =
+{
+    100000000ULL,   /* Core 0 */
+    1000000000ULL,  /* Core 1 */
+    0,              /* Core 2 */
+    0               /* Core 3 */
+};
+
+#endif /* INT_BENCH_HOST_SWEEP, _SWITCH, _REPLAY, _MBW, _MICRO */
+
+const uint32_t gIntBenchHostPartitionCount =
+    sizeof(gIntBenchHostPartitions) / sizeof(gIntBenchHostPartitions[0]);
+
+/* __________________________________________________________________________
+ * END OF FILE:
+ * -------------
+ * ___________________________________________________________________________
+ */
@@ -0,0 +1,97 @@
+/* __________________________________________________________________________
+* MODULE DESCRIPTION:
+* -------------------
+* Filename : HostRuntime.h
+*
+* Author: Alexy Torres Aurora Dugo
+*
+* Description: This file contains the configuration interface of the Linux
+* host runtime (ARINC653Host.c). The partitions, their core and their time
+* window in the core's major frame (MAF) are declared in HostPartitions.c.
+* __________________________________________________________________________
+*/
+
+/* __________________________________________________________________________
+* PREPROCESSOR DIRECTIVES:
+* ------------------------
+*/
+#ifndef __HOST_RUNTIME_H__
+#define __HOST_RUNTIME_H__
+
+#include <stdint.h>
+#include <ARINC653.h>
+#include <OSAbstractionLayer.h>
+
+/*******************************************************************************
+ * CONFIGURATION
+ ******************************************************************************/
+
+/* Maximal number of partitions */
+#define INT_BENCH_HOST_MAX_PARTITIONS 16
+
+/* Environment variable: divides all the periods, capacities, windows and MAF
+ * durations to run the benchmarks faster than real time (default 1).
+ */
+#define INT_BENCH_HOST_ENV_TIME_SCALE "INTBENCH_HOST_TIME_SCALE"
+
+/* Environment variable: duration of the run in seconds, the dump is written
+ * when the run ends (default 0, run until SIGINT/SIGTERM).
+ */
+#define INT_BENCH_HOST_ENV_DURATION "INTBENCH_HOST_DURATION"
+
+/* Environment variable: path of the dump file (default intbench_dump.bin) */
+#define INT_BENCH_HOST_ENV_DUMP_PATH "INTBENCH_HOST_DUMP"
+#define INT_BENCH_HOST_DEFAULT_DUMP_PATH "intbench_dump.bin"
+
+/* Environment variable: path of the interrupt arrival trace to replay (see
+ * TraceReplay.h and Scripts/TraceConv.py), no trace is loaded by default.
+ */
+#define INT_BENCH_HOST_ENV_TRACE_PATH "INTBENCH_HOST_TRACE"
+
+/* Environment variables: board identifier and firmware revision recorded in
+ * the campaign manifest (see CampaignManifest.h), the host name and the
+ * revision of the tree the host was built from by default.
+ */
+#define INT_BENCH_HOST_ENV_BOARD    "INTBENCH_HOST_BOARD"
+#define INT_BENCH_HOST_ENV_FIRMWARE "INTBENCH_HOST_FIRMWARE"
+
+/*******************************************************************************
+ * TYPES
+ ******************************************************************************/
+
+/* Partition configuration. A partition executes on a single core, during its
+ * time window in the core's MAF.
+ */
+typedef struct
+{
+    /* Partition name */
+    const char* name;
+    /* Core executing the partition */
+    uint32_t    core;
+    /* Window start offset in the core's MAF (ns) */
+    uint64_t    windowOffset;
+    /* Window duration (ns) */
+    uint64_t    windowDuration;
+    /* Partition initialization process (main_process) */
+    void        (*mainProcess)(void);
+} int_bench_host_partition_t;
+
+/*******************************************************************************
+ * CONFIGURATION DATA (HostPartitions.c)
+ ******************************************************************************/
+
+/* Partitions table */
+extern const int_bench_host_partition_t gIntBenchHostPartitions[];
+
+/* Number of partitions in the table */
+extern const uint32_t gIntBenchHostPartitionCount;
+
+/* MAF duration of each core (ns), 0 if the core does not execute partitions */
+extern const uint64_t gIntBenchHostMaf[INT_BENCH_HOST_CORE_COUNT];
+
+#endif  /* ifndef __HOST_RUNTIME_H__ */
+/* __________________________________________________________________________
+* END OF FILE:
+* -------------
+* ___________________________________________________________________________
+*/
@@ -0,0 +1,160 @@
+/* __________________________________________________________________________
+* MODULE DESCRIPTION:
+* -------------------
+* Filename : LinuxBackend.h
+*
+* Author: Alexy Torres Aurora Dugo
+*
+* Description: This file contains the Linux host implementation of the
+* OSAbstractionLayer.h API. It is included by OSAbstractionLayer.h when
+* INT_BENCH_LINUX_BACKEND is defined.
+*
+* The interrupts are emulated with signals: the internal interrupt is a signal
+* sent to the calling thread, the IPI is a signal sent to the destination core
+* thread of the host runtime and the external interrupt is a POSIX timer
+* expiring on the destination core thread. As on the target, the generating
+* functions wait until the handler acknowledges the interrupt.
+* __________________________________________________________________________
+*/
+
+/* __________________________________________________________________________
+* PREPROCESSOR DIRECTIVES:
+* ------------------------
+*/
+#ifndef __LINUX_BACKEND_H__
+#define __LINUX_BACKEND_H__
+
+#include <stdint.h>
+#include <time.h>
+
+/*******************************************************************************
+ * HOST RUNTIME API
+ * The following functions are implemented by the host runtime
+ * (ARINC653Host.c).
+ ******************************************************************************/
+
+/* Interrupt types emulated by the host runtime */
+typedef enum
+{
+    INT_BENCH_HOST_INT_INTERNAL = 0,
+    INT_BENCH_HOST_INT_IPI      = 1,
+    INT_BENCH_HOST_INT_EXTERNAL = 2
+} int_bench_host_int_t;
+
+/* Raises an emulated interrupt on a given core, or on a given thread of the
+ * core (INT_BENCH_DST_THREAD) in the SMT sibling mode. The internal interrupt
+ * is always raised on the calling thread.
+ */
+extern void __IntBenchHostRaiseInt(const int_bench_host_int_t type,
+                                   const uint32_t             coreId);
+
+/* Arms a one-shot timer that interrupts the calling thread after delay ns,
+ * a delay of 0 disarms it. The handler counts an internal interrupt.
+ */
+extern void __IntBenchHostArmAsyncInt(const uint64_t delay);
+
+/* Arms the first fire of the external timer of the interrupt masking window
+ * benchmark one period after the call on a given core, a period of 0 disarms
+ * it. Returns the applied period (ns).
+ */
+extern uint32_t __IntBenchHostArmMaskTimer(const uint32_t coreId,
+                                           const uint32_t period);
+
+/* Arms the next fire of the external timer delay ns after the call */
+extern void __IntBenchHostRearmMaskTimer(const uint64_t delay);
+
+/*******************************************************************************
+ * API IMPLEMENTATION
+ ******************************************************************************/
+
+/* Busy waits for a given number of loop iterations. This is used by the
+ * generator partitions to space the generated interrupts.
+ */
+static inline void __IntBenchSpin(const uint32_t loops)
+{
+    volatile uint32_t i;
+
+    for(i = loops; i > 0; --i);
+}
+
+/* Generate an internal interrupt. A signal is sent to the calling thread, the
+ * function waits until the handler acknowledges the interrupt.
+ */
+static inline void __IntBenchGenerateInternalInt(void)
+{
+    *INT_BENCH_INT_WAIT_PTR = 1;
+    __IntBenchHostRaiseInt(INT_BENCH_HOST_INT_INTERNAL, 0);
+    while(1 == *INT_BENCH_INT_WAIT_PTR){}
+}
+
+/* Reads the time base: CLOCK_MONOTONIC (vDSO) in ns */
+static inline uint64_t __IntBenchReadTimebase(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+/* Arms an asynchronous internal interrupt that fires on the calling thread
+ * after delay ns, the function returns immediately.
+ */
+static inline void __IntBenchArmAsyncInt(const uint32_t delay)
+{
+    __IntBenchHostArmAsyncInt(0 == delay ? 1 : delay);
+}
+
+/* Disarms the asynchronous internal interrupt if it did not fire */
+static inline void __IntBenchDisarmAsyncInt(void)
+{
+    __IntBenchHostArmAsyncInt(0);
+}
+
+/* Generate an IPI. A signal is sent to the destination core thread, the
+ * function waits until the handler acknowledges the interrupt.
+ */
+static inline void __IntBenchGenerateIPI(uint32_t coreId)
+{
+    *INT_BENCH_INT_WAIT_PTR = 1;
+    __IntBenchHostRaiseInt(INT_BENCH_HOST_INT_IPI, coreId);
+    while(1 == *INT_BENCH_INT_WAIT_PTR){}
+}
+
+/* Generate an external interrupt. A one-shot timer is armed to expire on the
+ * destination core thread as soon as possible, the function waits until the
+ * handler acknowledges the interrupt.
+ */
+static inline void __IntBenchGenerateExternalInt(const uint32_t coreId)
+{
+    *INT_BENCH_INT_WAIT_PTR = 1;
+    __IntBenchHostRaiseInt(INT_BENCH_HOST_INT_EXTERNAL, coreId);
+    while(1 == *INT_BENCH_INT_WAIT_PTR){}
+}
+
+/* Starts the external timer of the interrupt masking window benchmark on a
+ * core, returns the applied period (ns).
+ */
+static inline uint32_t __IntBenchMaskTimerStart(const uint32_t coreId,
+                                                const uint32_t period)
+{
+    return __IntBenchHostArmMaskTimer(coreId, period);
+}
+
+/* Stops the external timer */
+static inline void __IntBenchMaskTimerStop(void)
+{
+    __IntBenchHostArmMaskTimer(0, 0);
+}
+
+/* Arms the next fire of the external timer delay ns after the call */
+static inline void __IntBenchMaskTimerArm(const uint64_t delay)
+{
+    __IntBenchHostRearmMaskTimer(delay);
+}
+
+#endif  /* ifndef __LINUX_BACKEND_H__ */
+/* __________________________________________________________________________
+* END OF FILE:
+* -------------
+* ___________________________________________________________________________
+*/
@@ -0,0 +1,78 @@
+/* __________________________________________________________________________
+* MODULE DESCRIPTION:
+* -------------------
+* Filename : LinuxBackendConfig.h
+*
+* Author: Alexy Torres Aurora Dugo
+*
+* Description: This file contains the configuration overrides of the Linux
+* host backend. It is included by OSAbstractionLayer.h when
+* INT_BENCH_LINUX_BACKEND is defined.
+* __________________________________________________________________________
+*/
+
+/* __________________________________________________________________________
+* PREPROCESSOR DIRECTIVES:
+* ------------------------
+*/
+#ifndef __LINUX_BACKEND_CONFIG_H__
+#define __LINUX_BACKEND_CONFIG_H__
+
+#include <stdio.h>
+#include <stdint.h>
+
+/******************************************************************************
+ * CONFIGURATION
+ ******************************************************************************/
+
+/* Number of cores emulated by the host runtime. The cores are mapped on the
+ * host CPUs modulo the number of online CPUs.
+ */
+#ifndef INT_BENCH_HOST_CORE_COUNT
+#define INT_BENCH_HOST_CORE_COUNT 4
+#endif
+
+/* Host topology: one thread per emulated core. In the SMT sibling mode
+ * (INT_BENCH_HOST_SMT), each emulated core has a second thread pinned on the
+ * SMT sibling of the core's host CPU.
+ */
+#define INT_BENCH_CORE_COUNT       INT_BENCH_HOST_CORE_COUNT
+#ifdef INT_BENCH_HOST_SMT
+#define INT_BENCH_THREADS_PER_CORE 2
+#else
+#define INT_BENCH_THREADS_PER_CORE 1
+#endif
+
+/* Host large pages: the default huge page size (x86-64, AArch64 4KB granule).
+ * The host runtime uses hugetlbfs pages when some are reserved and transparent
+ * huge pages otherwise.
+ */
+#ifndef INT_BENCH_LARGE_PAGE_SIZE
+#define INT_BENCH_LARGE_PAGE_SIZE 0x200000
+#endif
+
+/* The shared memory is allocated by the host runtime, it contains the whole
+ * memory layout defined in OSAbstractionLayer.h.
+ */
+extern uint8_t* __IntBenchHostSharedMem;
+#define INT_BENCH_SHARED_MEM_BASE ((uintptr_t)__IntBenchHostSharedMem)
+
+/* The example partitions: core 0 partition 0 and core 1 partition 1 */
+#ifndef INT_BENCH_RDYMASK_VAL
+#define INT_BENCH_RDYMASK_VAL 0x0000000000020001ULL
+#endif
+
+/* The host time base is CLOCK_MONOTONIC in ns */
+#ifndef INT_BENCH_TIMEBASE_HZ
+#define INT_BENCH_TIMEBASE_HZ 1000000000ULL
+#endif
+
+/* The RTOS unsafe print is the standard print on the host */
+#define amp_printf_unsafe printf
+
+#endif  /* ifndef __LINUX_BACKEND_CONFIG_H__ */
+/* __________________________________________________________________________
+* END OF FILE:
+* -------------
+* ___________________________________________________________________________
+*/
@@ -0,0 +1,82 @@
+/* __________________________________________________________________________
+* MODULE DESCRIPTION:
+* -------------------
+* Filename : LinuxCacheColoring.h
+*
+* Author: Alexy Torres Aurora Dugo
+*
+* Description: This file contains the Linux host implementation of the
+* colored buffer allocation of CacheColoring.h. It is included by
+* CacheColoring.h when INT_BENCH_LINUX_BACKEND is defined.
+*
+* The physical pages of a process are not contiguous on Linux: the colored
+* pages are selected with /proc/self/pagemap (see __IntBenchVirtToPhys in
+* ARINC653Host.c) and moved with mremap in a virtually contiguous buffer.
+* __________________________________________________________________________
+*/
+
+/* __________________________________________________________________________
+* PREPROCESSOR DIRECTIVES:
+* ------------------------
+*/
+#ifndef __LINUX_CACHE_COLORING_H__
+#define __LINUX_CACHE_COLORING_H__
+
+/* mremap requires _GNU_SOURCE (set by the Makefile) */
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/mman.h>
+
+/*******************************************************************************
+ * API IMPLEMENTATION
+ ******************************************************************************/
+
+/* Allocates a virtually contiguous buffer made of pages of the arena's colors.
+ * The pages are removed from the pool mapping and remapped in the buffer, the
+ * pool must be private memory. Returns NULL when the pool is exhausted.
+ */
+static inline void* __IntBenchColorAllocBuffer(int_bench_color_arena_t* arena,
+                                               const size_t             size)
+{
+    uint32_t pageCount;
+    uint32_t i;
+    uint8_t* buffer;
+    void*    page;
+
+    pageCount = (uint32_t)((size + INT_BENCH_PAGE_SIZE - 1) /
+                           INT_BENCH_PAGE_SIZE);
+    if(0 == pageCount)
+    {
+        return NULL;
+    }
+
+    /* Reserve the buffer virtual range */
+    buffer = (uint8_t*)mmap(NULL, (size_t)pageCount * INT_BENCH_PAGE_SIZE,
+                            PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(MAP_FAILED == buffer)
+    {
+        return NULL;
+    }
+
+    for(i = 0; i < pageCount; ++i)
+    {
+        page = __IntBenchColorAllocPage(arena);
+        if(NULL == page ||
+           MAP_FAILED == mremap(page, INT_BENCH_PAGE_SIZE, INT_BENCH_PAGE_SIZE,
+                                MREMAP_MAYMOVE | MREMAP_FIXED,
+                                buffer + (size_t)i * INT_BENCH_PAGE_SIZE))
+        {
+            munmap(buffer, (size_t)pageCount * INT_BENCH_PAGE_SIZE);
+            return NULL;
+        }
+    }
+
+    return buffer;
+}
+
+#endif  /* ifndef __LINUX_CACHE_COLORING_H__ */
+/* __________________________________________________________________________
+* END OF FILE:
+* -------------
+* ___________________________________________________________________________
+*/
@@ -0,0 +1,247 @@
+/* __________________________________________________________________________
+* MODULE DESCRIPTION:
+* -------------------
+* Filename : LinuxPMCDriver.c
+*
+* Author: Alexy Torres Aurora Dugo
+*
+* Description: This file contains the Linux host implementation of the PMC
+* driver. Each PMC of each thread is backed by a perf event counting for the
+* calling thread only. When perf events are not available (unprivileged
+* container, missing PMU, etc.) the counters read 0.
+* __________________________________________________________________________
+*/
+
+/* INCLUDE SECTION */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#include "LinuxPMCDriver.h"
+
+/* Number of PMCs managed by the driver */
+#define PMC_COUNT (E6500_PMC_ID_MAX_VALUE + 1)
+
+/* Per-thread PMC state */
+typedef struct
+{
+    int      fd;
+    int32_t  event;
+    uint32_t traceEntity;
+    uint32_t offset;
+} pmc_state_t;
+
+static __thread pmc_state_t sPmcs[PMC_COUNT];
+static __thread int         sPmcsInit = 0;
+static int                  sPerfUnavailable = 0;
+
+/* Converts an e6500 event to a perf event. Returns -1 if the event is not
+ * supported.
+ */
+static int __PMCDrvGetPerfEvent(const int32_t event,
+                                struct perf_event_attr* pAttr)
+{
+    memset(pAttr, 0, sizeof(struct perf_event_attr));
+    pAttr->size = sizeof(struct perf_event_attr);
+
+    switch(event)
+    {
+        case E6500_PMC_EVENT_CPU_CYCLES:
+            pAttr->type   = PERF_TYPE_HARDWARE;
+            pAttr->config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+        case E6500_PMC_EVENT_INSTR_COMPLTD:
+            pAttr->type   = PERF_TYPE_HARDWARE;
+            pAttr->config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+        case E6500_PMC_EVENT_L2_MISS:
+        case E6500_PMC_EVENT_THREAD_L2_MISS:
+            pAttr->type   = PERF_TYPE_HARDWARE;
+            pAttr->config = PERF_COUNT_HW_CACHE_MISSES;
+            break;
+        case E6500_PMC_EVENT_THREAD_L2_ACC:
+            pAttr->type   = PERF_TYPE_HARDWARE;
+            pAttr->config = PERF_COUNT_HW_CACHE_REFERENCES;
+            break;
+        case E6500_PMC_EVENT_L2MMU_MISS:
+            pAttr->type   = PERF_TYPE_HW_CACHE;
+            pAttr->config = PERF_COUNT_HW_CACHE_DTLB |
+                            (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                            (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            break;
+        default:
+            return -1;
+    }
+
+    return 0;
+}
+
+static void __PMCDrvInit(void)
+{
+    uint32_t i;
+
+    if(0 == sPmcsInit)
+    {
+        for(i = 0; i < PMC_COUNT; ++i)
+        {
+            sPmcs[i].fd    = -1;
+            sPmcs[i].event = -1;
+        }
+        sPmcsInit = 1;
+    }
+}
+
+ERROR_CODE_E __PMCDrvRead(const uint32_t pmcID, uint32_t* pPmcValue)
+{
+    uint64_t value;
+
+    if(E6500_PMC_ID_MAX_VALUE < pmcID)
+    {
+        return INVALID_PARAM;
+    }
+
+    __PMCDrvInit();
+
+    value = 0;
+    if(0 <= sPmcs[pmcID].fd)
+    {
+        if(sizeof(value) != read(sPmcs[pmcID].fd, &value, sizeof(value)))
+        {
+            value = 0;
+        }
+    }
+
+    *pPmcValue = (uint32_t)value + sPmcs[pmcID].offset;
+
+    return NO_ERROR;
+}
+
+ERROR_CODE_E __PMCDrvWrite(const uint32_t pmcID, const uint32_t pmcValue)
+{
+    uint64_t value;
+
+    if(E6500_PMC_ID_MAX_VALUE < pmcID)
+    {
+        return INVALID_PARAM;
+    }
+
+    __PMCDrvInit();
+
+    /* Perf events cannot be written, reset the counter and keep the written
+     * value as an offset.
+     */
+    value = 0;
+    if(0 <= sPmcs[pmcID].fd)
+    {
+        ioctl(sPmcs[pmcID].fd, PERF_EVENT_IOC_RESET, 0);
+        if(sizeof(value) != read(sPmcs[pmcID].fd, &value, sizeof(value)))
+        {
+            value = 0;
+        }
+    }
+    sPmcs[pmcID].offset = pmcValue - (uint32_t)value;
+
+    return NO_ERROR;
+}
+
+ERROR_CODE_E __PMCDrvEnable(const uint32_t pmcID, const int32_t event,
+                            const PMC_TRACE_ENTITY_E traceEntity,
+                            const uint32_t intEnabled)
+{
+    struct perf_event_attr attr;
+    uint32_t               value;
+
+    (void)intEnabled;
+
+    if(E6500_PMC_ID_MAX_VALUE < pmcID)
+    {
+        return INVALID_PARAM;
+    }
+
+    __PMCDrvInit();
+
+    /* Reopen the event only if the configuration changed */
+    if(sPmcs[pmcID].event != event ||
+       sPmcs[pmcID].traceEntity != (uint32_t)traceEntity)
+    {
+        /* Keep the counter value when switching events */
+        __PMCDrvRead(pmcID, &value);
+
+        if(0 <= sPmcs[pmcID].fd)
+        {
+            close(sPmcs[pmcID].fd);
+            sPmcs[pmcID].fd = -1;
+        }
+
+        sPmcs[pmcID].event       = event;
+        sPmcs[pmcID].traceEntity = traceEntity;
+        sPmcs[pmcID].offset      = value;
+
+        if(0 != sPerfUnavailable ||
+           0 != __PMCDrvGetPerfEvent(event, &attr))
+        {
+            return NO_ERROR;
+        }
+
+        attr.disabled       = 1;
+        attr.exclude_hv     = 1;
+        attr.exclude_kernel = (PMC_USER == traceEntity);
+        attr.exclude_user   = (PMC_SUPERVISOR == traceEntity);
+
+        sPmcs[pmcID].fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        if(0 > sPmcs[pmcID].fd && 0 == attr.exclude_kernel &&
+           0 == attr.exclude_user)
+        {
+            /* Unprivileged users cannot trace the kernel, retry with user
+             * space only
+             */
+            attr.exclude_kernel = 1;
+            sPmcs[pmcID].fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        }
+        if(0 > sPmcs[pmcID].fd)
+        {
+            if(0 == __atomic_exchange_n(&sPerfUnavailable, 1, __ATOMIC_RELAXED))
+            {
+                fprintf(stderr, "[PMC] perf events unavailable, counters will "
+                                "read 0\n");
+            }
+            return NO_ERROR;
+        }
+    }
+
+    if(0 <= sPmcs[pmcID].fd)
+    {
+        ioctl(sPmcs[pmcID].fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+
+    return NO_ERROR;
+}
+
+ERROR_CODE_E __PMCDrvDisable(const uint32_t pmcID)
+{
+    if(E6500_PMC_ID_MAX_VALUE < pmcID)
+    {
+        return INVALID_PARAM;
+    }
+
+    __PMCDrvInit();
+
+    if(0 <= sPmcs[pmcID].fd)
+    {
+        ioctl(sPmcs[pmcID].fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+
+    return NO_ERROR;
+}
+
+/* __________________________________________________________________________
+ * END OF FILE:
+ * -------------
+ * ___________________________________________________________________________
+ */
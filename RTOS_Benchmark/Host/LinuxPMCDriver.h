@@ -0,0 +1,84 @@
+/* __________________________________________________________________________
+* MODULE DESCRIPTION:
+* -------------------
+* Filename : LinuxPMCDriver.h
+*
+* Author: Alexy Torres Aurora Dugo
+*
+* Description: This file contains the Linux host implementation of the
+* PMCDriver.h API. It is included by PMCDriver.h when INT_BENCH_LINUX_BACKEND
+* is defined. The counters are per-thread perf events, the e6500 events used
+* by the benchmarks are mapped to their closest generic perf event.
+* __________________________________________________________________________
+*/
+
+/* __________________________________________________________________________
+* PREPROCESSOR DIRECTIVES:
+* ------------------------
+*/
+#ifndef __LINUX_PMC_DRIVER_H__
+#define __LINUX_PMC_DRIVER_H__
+
+#include <stdint.h>
+#include <ARINC653.h>
+
+#define E6500_PMC_ID_MAX_VALUE 5
+
+/* The driver returns the ARINC653 return codes on the host to avoid
+ * redefining NO_ERROR and INVALID_PARAM.
+ */
+typedef RETURN_CODE_TYPE ERROR_CODE_E;
+
+/* PMC Trace entity: select the elevation privilege that will be able to trace
+ * PMC events.
+ */
+typedef enum
+{
+  PMC_SUPERVISOR,
+  PMC_USER,
+  PMC_ALL
+} PMC_TRACE_ENTITY_E;
+
+#define M_PMC_SUPERVISOR PMC_SUPERVISOR
+#define M_PMC_USER       PMC_USER
+#define M_PMC_ALL        PMC_ALL
+
+/* Supported events, see LinuxPMCDriver.c for the perf event mapping */
+#define E6500_PMC_EVENT_CPU_CYCLES      1
+#define E6500_PMC_EVENT_INSTR_COMPLTD   2
+#define E6500_PMC_EVENT_TOTAL_TRANSL    26
+#define E6500_PMC_EVENT_CACHE_INHIBIT   31
+#define E6500_PMC_EVENT_LSU_STALL       110
+#define E6500_PMC_EVENT_L2MMU_MISS      264
+#define E6500_PMC_EVENT_L2_HIT          456
+#define E6500_PMC_EVENT_L2_MISS         457
+#define E6500_PMC_EVENT_THREAD_L2_HIT   465
+#define E6500_PMC_EVENT_THREAD_L2_MISS  466
+#define E6500_PMC_EVENT_THREAD_L2_ACC   467
+
+/* FUNCTIONS DECLARATIONS */
+ERROR_CODE_E __PMCDrvRead(const uint32_t pmcID, uint32_t* pPmcValue);
+
+ERROR_CODE_E __PMCDrvWrite(const uint32_t pmcID, const uint32_t pmcValue);
+
+ERROR_CODE_E __PMCDrvEnable(const uint32_t pmcID, const int32_t event,
+                            const PMC_TRACE_ENTITY_E traceEntity,
+                            const uint32_t intEnabled);
+
+ERROR_CODE_E __PMCDrvDisable(const uint32_t pmcID);
+
+/* Compile-time accessors of PMCDriver.h, the perf events are always accessed
+ * through the driver functions.
+ */
+#define __PMC_DRV_READ(ID, PVALUE)  __PMCDrvRead(ID, PVALUE)
+#define __PMC_DRV_WRITE(ID, VALUE)  __PMCDrvWrite(ID, VALUE)
+#define __PMC_DRV_DISABLE(ID)       __PMCDrvDisable(ID)
+#define __PMC_DRV_ENABLE(ID, EVENT) __PMCDrvEnable(ID, EVENT, PMC_ALL, 0)
+
+#endif /* __LINUX_PMC_DRIVER_H__ */
+
+/* __________________________________________________________________________
+* END OF FILE:
+* -------------
+* ___________________________________________________________________________
+*/
@@ -0,0 +1,554 @@
+/* __________________________________________________________________________
+* MODULE DESCRIPTION:
+* -------------------
+* Filename : MicroBench.c
+*
+* Author: Alexy Torres Aurora Dugo
+*
+* Description: This file contains the microbenchmarks of the framework
+* primitives on the Linux host (make micro). The overhead of the
+* instrumentation is part of every interference measurement, the suite catches
+* its regressions before they reach the board.
+*
+* The suite is a partition executed by the host runtime on core 0 (the other
+* core threads receive the generated IPIs and external interrupts). It
+* measures the dump of a record (INT_BENCH_DUMP, fixed size and encoded), the
+* payload prologue and epilogue pair, the PMC driver functions, the framework
+* lock under contention from 1 to INTBENCH_MICRO_THREADS threads, every
+* interrupt generation primitive and the system call probe of the C and C++
+* APIs (INT_BENCH_GEN_SC and IntBench.hpp, see MicroBenchCpp.cpp). Each
+* benchmark is executed INTBENCH_MICRO_REPS times, every repetition measures a
+* batch of calls.
+*
+* The results are written to INTBENCH_MICRO_OUT (CSV, one line per benchmark)
+* and compared across revisions with Scripts/MicroCompare.py. The cycles are
+* read from the CPU cycle counter when the host has one (TSC on x86), the time
+* base (ns) is used otherwise.
+* __________________________________________________________________________
+*/
+
+/* INCLUDE SECTION */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <fcntl.h>
+#include <math.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "HostRuntime.h"
+#include "../InterruptBench.h"
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* Environment variable: path of the results file */
+#define MICRO_ENV_OUT_PATH     "INTBENCH_MICRO_OUT"
+#define MICRO_DEFAULT_OUT_PATH "intbench_micro.csv"
+
+/* Environment variable: repetitions of each benchmark (default 30) */
+#define MICRO_ENV_REPS     "INTBENCH_MICRO_REPS"
+#define MICRO_DEFAULT_REPS 30
+#define MICRO_MAX_REPS     1000
+
+/* Environment variable: maximal number of threads contending for the lock,
+ * the lock is measured with 1, 2, 4, ... threads (default 4)
+ */
+#define MICRO_ENV_THREADS     "INTBENCH_MICRO_THREADS"
+#define MICRO_DEFAULT_THREADS 4
+#define MICRO_MAX_THREADS     64
+
+/* Destination core of the generated IPIs and external interrupts */
+#define MICRO_DST_CORE 1
+
+/* Revision of the framework, set by the Makefile */
+#ifndef INT_BENCH_MICRO_REV
+#define INT_BENCH_MICRO_REV "unknown"
+#endif
+
+/*******************************************************************************
+ * TYPES
+ ******************************************************************************/
+
+/* Microbenchmark: run executes a batch of calls calls */
+typedef struct
+{
+    const char* name;
+    uint32_t    calls;
+    void        (*run)(const uint32_t calls);
+} micro_bench_t;
+
+/* Statistics of a benchmark, per call */
+typedef struct
+{
+    double meanCycles;
+    double stdevCycles;
+    double minCycles;
+    double medianCycles;
+    double meanNs;
+} micro_stats_t;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+static int_bench_measure_t sBenchData;
+static volatile int32_t    sLock __attribute__((aligned(64))) = 0;
+static volatile uint32_t   sContendersStop = 0;
+static volatile uint32_t   sContendersReady = 0;
+
+/*******************************************************************************
+ * INTERNAL FUNCTIONS
+ ******************************************************************************/
+
+/* C++ API batches (MicroBenchCpp.cpp) */
+extern void __MicroRunProbeCpp(const uint32_t calls);
+
+/* Reads the CPU cycle counter, the time base if the host has none */
+static inline uint64_t __MicroReadCycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#elif defined(__aarch64__)
+    uint64_t value;
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r" (value));
+    return value;
+#else
+    return __IntBenchReadTimebase();
+#endif
+}
+
+static void __MicroRunDump(const uint32_t calls)
+{
+    uint32_t i;
+
+    *(uint32_t*)INT_BENCH_DUMP_SC_SIZE_ADDR = 0;
+    __IntBenchEncReset(INT_BENCH_DUMP_SC_MAGIC_ADDR);
+    for(i = 0; i < calls; ++i)
+    {
+        INT_BENCH_DUMP(1, sBenchData, SC);
+    }
+}
+
+static void __MicroRunDumpEnc(const uint32_t calls)
+{
+    uint32_t i;
+
+    *(uint32_t*)INT_BENCH_DUMP_SC_SIZE_ADDR = 0;
+    __IntBenchEncReset(INT_BENCH_DUMP_SC_MAGIC_ADDR);
+    for(i = 0; i < calls; ++i)
+    {
+        INT_BENCH_DUMP_ENC(1, sBenchData, SC);
+    }
+}
+
+static void __MicroRunPayload(const uint32_t calls)
+{
+    uint32_t mafCount;
+    uint32_t i;
+
+    *(uint32_t*)INT_BENCH_DUMP_PART_SIZE_ADDR     = 0;
+    *(uint32_t*)INT_BENCH_DUMP_INTCOUNT_SIZE_ADDR = 0;
+    for(i = 0; i < calls; ++i)
+    {
+        mafCount = 1;
+        sBenchData.samples = 0;
+        INT_BENCH_PAYLOAD_PROLOGUE(mafCount, sBenchData)
+        INT_BENCH_PAYLOAD_EPILOGUE(mafCount, sBenchData, 0, 0)
+    }
+}
+
+static void __MicroRunPmcEnable(const uint32_t calls)
+{
+    uint32_t i;
+
+    for(i = 0; i < calls; ++i)
+    {
+        __PMCDrvEnable(1, E6500_PMC_EVENT_THREAD_L2_MISS, PMC_ALL, 0);
+    }
+}
+
+static void __MicroRunPmcRead(const uint32_t calls)
+{
+    uint32_t value;
+    uint32_t i;
+
+    for(i = 0; i < calls; ++i)
+    {
+        __PMCDrvRead(1, &value);
+    }
+}
+
+static void __MicroRunPmcDisable(const uint32_t calls)
+{
+    uint32_t i;
+
+    for(i = 0; i < calls; ++i)
+    {
+        __PMCDrvDisable(1);
+    }
+}
+
+static void __MicroRunLock(const uint32_t calls)
+{
+    uint32_t i;
+
+    for(i = 0; i < calls; ++i)
+    {
+        while(0 != __TestAndSet(&sLock));
+        __LockRelease(&sLock);
+    }
+}
+
+static void __MicroRunGenSyscall(const uint32_t calls)
+{
+    uint32_t i;
+
+    for(i = 0; i < calls; ++i)
+    {
+        __IntBenchGenerateSyscall();
+    }
+}
+
+static void __MicroRunGenInternalInt(const uint32_t calls)
+{
+    uint32_t i;
+
+    for(i = 0; i < calls; ++i)
+    {
+        __IntBenchGenerateInternalInt();
+    }
+}
+
+static void __MicroRunGenIPI(const uint32_t calls)
+{
+    uint32_t i;
+
+    for(i = 0; i < calls; ++i)
+    {
+        __IntBenchGenerateIPI(MICRO_DST_CORE);
+    }
+}
+
+static void __MicroRunGenExternalInt(const uint32_t calls)
+{
+    uint32_t i;
+
+    for(i = 0; i < calls; ++i)
+    {
+        __IntBenchGenerateExternalInt(MICRO_DST_CORE);
+    }
+}
+
+static void __MicroRunProbe(const uint32_t calls)
+{
+    uint32_t i;
+
+    *(uint32_t*)INT_BENCH_DUMP_SC_SIZE_ADDR = 0;
+    __IntBenchEncReset(INT_BENCH_DUMP_SC_MAGIC_ADDR);
+    for(i = 0; i < calls; ++i)
+    {
+        sBenchData.samples = 0;
+        INT_BENCH_GEN_SC(0, 1, sBenchData);
+    }
+}
+
+static int __MicroCompare(const void* first, const void* second)
+{
+    const double a = *(const double*)first;
+    const double b = *(const double*)second;
+
+    return (a > b) - (a < b);
+}
+
+/* Executes the repetitions of a benchmark, a first batch warms it up */
+static void __MicroMeasure(const micro_bench_t* bench,
+                           const uint32_t       reps,
+                           micro_stats_t*       stats)
+{
+    double   cycles[MICRO_MAX_REPS];
+    double   totalNs;
+    double   variance;
+    uint64_t startCycles;
+    uint64_t startNs;
+    uint64_t endCycles;
+    uint64_t endNs;
+    uint32_t i;
+
+    bench->run(bench->calls);
+
+    totalNs = 0.0;
+    stats->meanCycles = 0.0;
+    for(i = 0; i < reps; ++i)
+    {
+        startNs     = __IntBenchReadTimebase();
+        startCycles = __MicroReadCycles();
+        bench->run(bench->calls);
+        endCycles   = __MicroReadCycles();
+        endNs       = __IntBenchReadTimebase();
+
+        cycles[i] = (double)(endCycles - startCycles) / bench->calls;
+        stats->meanCycles += cycles[i];
+        totalNs += (double)(endNs - startNs) / bench->calls;
+    }
+    stats->meanCycles /= reps;
+    stats->meanNs      = totalNs / reps;
+
+    variance = 0.0;
+    for(i = 0; i < reps; ++i)
+    {
+        variance += (cycles[i] - stats->meanCycles) *
+                    (cycles[i] - stats->meanCycles);
+    }
+    stats->stdevCycles = (1 < reps) ? sqrt(variance / (reps - 1)) : 0.0;
+
+    qsort(cycles, reps, sizeof(double), __MicroCompare);
+    stats->minCycles    = cycles[0];
+    stats->medianCycles = (0 == reps % 2) ?
+                          (cycles[reps / 2 - 1] + cycles[reps / 2]) / 2.0 :
+                          cycles[reps / 2];
+}
+
+static void __MicroWriteStats(FILE*                file,
+                              const micro_bench_t* bench,
+                              const uint32_t       threads,
+                              const uint32_t       reps,
+                              const micro_stats_t* stats)
+{
+    fprintf(file, "%s,%u,%u,%u,%.2f,%.2f,%.2f,%.2f,%.2f,%s\n",
+            bench->name, threads, bench->calls, reps, stats->meanCycles,
+            stats->stdevCycles, stats->minCycles, stats->medianCycles,
+            stats->meanNs, INT_BENCH_MICRO_REV);
+    printf("[MICRO] %-20s %2u thread(s): %10.2f cycles/call "
+           "(stdev %.2f, median %.2f)\n",
+           bench->name, threads, stats->meanCycles, stats->stdevCycles,
+           stats->medianCycles);
+}
+
+/* Redirects the standard output to /dev/null, returns the saved output */
+static int __MicroMuteStdout(void)
+{
+    int savedStdout;
+    int nullFd;
+
+    fflush(stdout);
+    savedStdout = dup(STDOUT_FILENO);
+    nullFd      = open("/dev/null", O_WRONLY);
+    if(0 <= nullFd)
+    {
+        dup2(nullFd, STDOUT_FILENO);
+        close(nullFd);
+    }
+
+    return savedStdout;
+}
+
+static void __MicroRestoreStdout(const int savedStdout)
+{
+    if(0 <= savedStdout)
+    {
+        fflush(stdout);
+        dup2(savedStdout, STDOUT_FILENO);
+        close(savedStdout);
+    }
+}
+
+/* Lock contender: takes and releases the lock until the benchmark ends */
+static void* __MicroContender(void* args)
+{
+    cpu_set_t cpuSet;
+    long      cpuCount;
+
+    cpuCount = sysconf(_SC_NPROCESSORS_ONLN);
+    if(0 >= cpuCount)
+    {
+        cpuCount = 1;
+    }
+    CPU_ZERO(&cpuSet);
+    CPU_SET((uint32_t)(uintptr_t)args % cpuCount, &cpuSet);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+
+    __atomic_fetch_add(&sContendersReady, 1, __ATOMIC_RELEASE);
+    while(0 == __atomic_load_n(&sContendersStop, __ATOMIC_ACQUIRE))
+    {
+        while(0 != __TestAndSet(&sLock));
+        __LockRelease(&sLock);
+    }
+
+    return NULL;
+}
+
+/* Measures the lock with threads - 1 contenders */
+static int __MicroMeasureLock(FILE*          file,
+                              const uint32_t threads,
+                              const uint32_t reps)
+{
+    static const micro_bench_t bench = {"lock", 10000, __MicroRunLock};
+
+    pthread_t     contenders[MICRO_MAX_THREADS];
+    micro_stats_t stats;
+    uint32_t      i;
+
+    sContendersStop  = 0;
+    sContendersReady = 0;
+    for(i = 1; i < threads; ++i)
+    {
+        if(0 != pthread_create(&contenders[i], NULL, __MicroContender,
+                               (void*)(uintptr_t)i))
+        {
+            perror("[MICRO] Cannot create contender thread");
+            return -1;
+        }
+    }
+    while(threads - 1 > __atomic_load_n(&sContendersReady, __ATOMIC_ACQUIRE))
+    {
+        sched_yield();
+    }
+
+    __MicroMeasure(&bench, reps, &stats);
+
+    __atomic_store_n(&sContendersStop, 1, __ATOMIC_RELEASE);
+    for(i = 1; i < threads; ++i)
+    {
+        pthread_join(contenders[i], NULL);
+    }
+
+    __MicroWriteStats(file, &bench, threads, reps, &stats);
+    return 0;
+}
+
+static void process1(void)
+{
+    static const micro_bench_t benches[] =
+    {
+        /* Name          Calls  Batch */
+        {"dump",         10000, __MicroRunDump},
+        {"dump_enc",     10000, __MicroRunDumpEnc},
+        {"payload_pair", 1000,  __MicroRunPayload},
+        {"pmc_enable",   10000, __MicroRunPmcEnable},
+        {"pmc_read",     10000, __MicroRunPmcRead},
+        {"pmc_disable",  10000, __MicroRunPmcDisable},
+        {"gen_sc",       1000,  __MicroRunGenSyscall},
+        {"gen_intint",   1000,  __MicroRunGenInternalInt},
+        {"gen_ipi",      1000,  __MicroRunGenIPI},
+        {"gen_extint",   1000,  __MicroRunGenExternalInt},
+        {"probe_sc",     1000,  __MicroRunProbe},
+        {"probe_sc_cpp", 1000,  __MicroRunProbeCpp}
+    };
+
+    micro_stats_t stats;
+    const char*   env;
+    const char*   outPath;
+    FILE*         file;
+    uint32_t      reps;
+    uint32_t      maxThreads;
+    uint32_t      threads;
+    uint32_t      i;
+    int           savedStdout;
+
+    outPath = getenv(MICRO_ENV_OUT_PATH);
+    if(NULL == outPath)
+    {
+        outPath = MICRO_DEFAULT_OUT_PATH;
+    }
+    env  = getenv(MICRO_ENV_REPS);
+    reps = (NULL != env) ? (uint32_t)atoi(env) : MICRO_DEFAULT_REPS;
+    if(0 == reps || MICRO_MAX_REPS < reps)
+    {
+        reps = MICRO_DEFAULT_REPS;
+    }
+    env        = getenv(MICRO_ENV_THREADS);
+    maxThreads = (NULL != env) ? (uint32_t)atoi(env) : MICRO_DEFAULT_THREADS;
+    if(0 == maxThreads || MICRO_MAX_THREADS < maxThreads)
+    {
+        maxThreads = MICRO_DEFAULT_THREADS;
+    }
+
+    file = fopen(outPath, "w");
+    if(NULL == file)
+    {
+        perror("[MICRO] Cannot open the results file");
+        exit(EXIT_FAILURE);
+    }
+    fprintf(file, "Benchmark,Threads,Calls,Reps,MeanCycles,StdevCycles,"
+                  "MinCycles,MedianCycles,MeanNs,Revision\n");
+
+    memset(&sBenchData, 0, sizeof(int_bench_measure_t));
+
+    for(i = 0; i < sizeof(benches) / sizeof(benches[0]); ++i)
+    {
+        /* The epilogue prints every sample, the output is discarded while
+         * the pair is measured
+         */
+        savedStdout = -1;
+        if(__MicroRunPayload == benches[i].run)
+        {
+            savedStdout = __MicroMuteStdout();
+        }
+        __MicroMeasure(&benches[i], reps, &stats);
+        __MicroRestoreStdout(savedStdout);
+
+        __MicroWriteStats(file, &benches[i], 1, reps, &stats);
+    }
+
+    for(threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        if(0 != __MicroMeasureLock(file, threads, reps))
+        {
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    fclose(file);
+    printf("[MICRO] Results written to %s\n", outPath);
+
+    /* The suite is the only partition, end the run */
+    exit(EXIT_SUCCESS);
+}
+
+void main_process(void)
+{
+    RETURN_CODE_TYPE       retCode;
+    PROCESS_ID_TYPE        thOutput1;
+    PROCESS_ATTRIBUTE_TYPE thAttrOutput1;
+
+    thAttrOutput1.ENTRY_POINT   = process1;
+    thAttrOutput1.DEADLINE      = SOFT;
+    thAttrOutput1.PERIOD        = 1000000000;
+    thAttrOutput1.STACK_SIZE    = 0x10000;
+    thAttrOutput1.TIME_CAPACITY = 0;
+    thAttrOutput1.BASE_PRIORITY = 2;
+    memcpy(thAttrOutput1.NAME, "Micro\0", 6 * sizeof(char));
+
+    CREATE_PROCESS(&thAttrOutput1, &thOutput1, &retCode);
+    if(retCode != NO_ERROR)
+    {
+        printf("[MICRO] ERROR Creating the suite process: %d\n", retCode);
+        exit(EXIT_FAILURE);
+    }
+
+    START(thOutput1, &retCode);
+    if(retCode != NO_ERROR)
+    {
+        printf("[MICRO] ERROR: Starting the suite process: %d\n", retCode);
+        exit(EXIT_FAILURE);
+    }
+
+    SET_PARTITION_MODE(NORMAL, &retCode);
+    if(retCode != NO_ERROR)
+    {
+        printf("[MICRO] ERROR: Switching to normal mode: %d\n", retCode);
+        exit(EXIT_FAILURE);
+    }
+}
+
+/* __________________________________________________________________________
+ * END OF FILE:
+ * -------------
+ * ___________________________________________________________________________
+ */
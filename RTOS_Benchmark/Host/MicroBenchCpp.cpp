@@ -0,0 +1,49 @@
+/* __________________________________________________________________________
+* MODULE DESCRIPTION:
+* -------------------
+* Filename : MicroBenchCpp.cpp
+*
+* Author: Alexy Torres Aurora Dugo
+*
+* Description: This file contains the C++ API batches of the framework
+* microbenchmarks (see MicroBench.c). The generators of IntBench.hpp are
+* measured against their C macro counterparts, the dumps of both APIs being
+* identical.
+* __________________________________________________________________________
+*/
+
+/* INCLUDE SECTION */
+#include "IntBench.hpp"
+
+using namespace int_bench;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+static int_bench_measure_t sCppBenchData;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/* System call probe with the C++ API, counterpart of the C probe batch */
+extern "C" void __MicroRunProbeCpp(const uint32_t calls)
+{
+    uint32_t i;
+
+    *(uint32_t*)INT_BENCH_DUMP_SC_SIZE_ADDR = 0;
+    __IntBenchEncReset(INT_BENCH_DUMP_SC_MAGIC_ADDR);
+    for(i = 0; i < calls; ++i)
+    {
+        sCppBenchData.samples = 0;
+        IntBench<Type::SC, Counters<L2Miss, L2MMUMiss> >::measure(
+            0, 1, sCppBenchData);
+    }
+}
+
+/* __________________________________________________________________________
+ * END OF FILE:
+ * -------------
+ * ___________________________________________________________________________
+ */
@@ -0,0 +1,206 @@
+/* __________________________________________________________________________
+* MODULE DESCRIPTION:
+* -------------------
+* Filename : IntBench.hpp
+*
+* Author: Alexy Torres Aurora Dugo
+*
+* Description: This file contains the header-only C++ API of the interrupt
+* generators, for the partitions written in C++. The interrupt type and the
+* counted events are template parameters:
+*
+*     IntBench<Type::SC, Counters<L2Miss, L2MMUMiss> >::measure(core, part,
+*                                                               benchData);
+*
+* The generator, the dump region and the PMR ids are resolved at compile time,
+* the counters are programmed with straight-line mtpmr/mfpmr sequences
+* (compile-time accessors of PMCDriver.h). The records are stored with the C
+* macros of InterruptBench.h: the dumps of both APIs are identical. The probe
+* of both APIs is measured on the host by make micro (probe_sc and
+* probe_sc_cpp, compared by Scripts/MicroCompare.py).
+*
+* A new interrupt type needs its dump region (INT_BENCH_DUMP_<TYPE>_*), an
+* entry in Type, an INT_BENCH_CPP_REGION and a Generator specialization.
+* __________________________________________________________________________
+*/
+
+/* __________________________________________________________________________
+* PREPROCESSOR DIRECTIVES:
+* ------------------------
+*/
+#ifndef __INT_BENCH_HPP__
+#define __INT_BENCH_HPP__
+
+extern "C" {
+#include <stdint.h>
+#include <ARINC653.h>
+#include <InterruptBench.h>
+}
+
+namespace int_bench {
+
+/*******************************************************************************
+ * TYPES
+ ******************************************************************************/
+
+/* Generated interrupt types */
+enum class Type : uint32_t {
+    SC     = INT_BENCH_TYPE_SC,
+    INTINT = INT_BENCH_TYPE_INTINT,
+    EXTINT = INT_BENCH_TYPE_EXTINT,
+    IPI    = INT_BENCH_TYPE_IPI
+};
+
+/* Counted events */
+template<int32_t EVENT>
+struct Event {
+    static constexpr int32_t id = EVENT;
+};
+
+typedef Event<E6500_PMC_EVENT_CPU_CYCLES>     CpuCycles;
+typedef Event<E6500_PMC_EVENT_INSTR_COMPLTD>  Instructions;
+typedef Event<E6500_PMC_EVENT_THREAD_L2_MISS> L2Miss;
+typedef Event<E6500_PMC_EVENT_L2MMU_MISS>     L2MMUMiss;
+
+/* Events counted during a measurement, on two consecutive PMCs starting at
+ * PMC. The records hold two counters, stored in the l2Miss and tlbMiss fields.
+ */
+template<typename EVENT0, typename EVENT1>
+struct Counters {
+    template<uint32_t PMC>
+    static inline void start(void)
+    {
+        static_assert(E6500_PMC_ID_MAX_VALUE >= PMC + 1, "Invalid PMC ID");
+
+        __PMC_DRV_WRITE(PMC, 0);
+        __PMC_DRV_WRITE(PMC + 1, 0);
+        __PMC_DRV_ENABLE(PMC, EVENT0::id);
+        __PMC_DRV_ENABLE(PMC + 1, EVENT1::id);
+    }
+
+    template<uint32_t PMC>
+    static inline void stop(int_bench_measure_t& data)
+    {
+        __PMC_DRV_DISABLE(PMC);
+        __PMC_DRV_DISABLE(PMC + 1);
+        __PMC_DRV_READ(PMC, &data.l2Miss);
+        __PMC_DRV_READ(PMC + 1, &data.tlbMiss);
+    }
+};
+
+/* Dump region of an interrupt type */
+template<Type TYPE>
+struct Region;
+
+/* Stores a sample in the TYPE region (or in the flight recorder of the
+ * benchmark) and updates its adaptive stopping state.
+ */
+#define INT_BENCH_CPP_REGION(TYPE)                                             \
+template<>                                                                     \
+struct Region<Type::TYPE> {                                                    \
+    static inline void record(const uint32_t       core,                       \
+                              const uint32_t       partId,                     \
+                              int_bench_measure_t& data)                       \
+    {                                                                          \
+        INT_BENCH_RECORD(core, partId, data, TYPE);                            \
+        ++data.samples;                                                        \
+        INT_BENCH_STOP_UPDATE(core, partId, data, TYPE);                       \
+    }                                                                          \
+};
+
+INT_BENCH_CPP_REGION(SC)
+INT_BENCH_CPP_REGION(INTINT)
+INT_BENCH_CPP_REGION(EXTINT)
+INT_BENCH_CPP_REGION(IPI)
+
+/* Generation of an interrupt type, dstId is the destination core */
+template<Type TYPE>
+struct Generator;
+
+template<>
+struct Generator<Type::SC> {
+    static inline void generate(const uint32_t)
+    {
+        __IntBenchGenerateSyscall();
+    }
+};
+
+template<>
+struct Generator<Type::INTINT> {
+    static inline void generate(const uint32_t)
+    {
+        __IntBenchGenerateInternalInt();
+    }
+};
+
+template<>
+struct Generator<Type::EXTINT> {
+    static inline void generate(const uint32_t dstId)
+    {
+        __IntBenchGenerateExternalInt(dstId);
+    }
+};
+
+template<>
+struct Generator<Type::IPI> {
+    static inline void generate(const uint32_t dstId)
+    {
+        __IntBenchGenerateIPI(dstId);
+    }
+};
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/* Interrupt generator benchmark, C++ counterpart of INT_BENCH_GEN. The
+ * generators count on the handler PMCs, the payloads keep theirs.
+ */
+template<Type TYPE, typename COUNTERS = Counters<L2Miss, L2MMUMiss> >
+struct IntBench {
+    static const uint32_t FIRST_PMC = INT_BENCH_HANDLER_PMC_L2;
+
+    /* Generates an interrupt and measures it. dstId is the destination core
+     * of the external interrupts and IPIs.
+     */
+    static inline void measure(const uint32_t       core,
+                               const uint32_t       partId,
+                               int_bench_measure_t& data,
+                               const uint32_t       dstId = 0)
+    {
+        COUNTERS::template start<FIRST_PMC>();
+
+        GET_TIME(&data.startTime, &data.errCode);
+        if(NO_ERROR != data.errCode)
+        {
+            amp_printf_unsafe("Cannot get start execution time: %d\n\r",
+                              data.errCode);
+            return;
+        }
+
+        Generator<TYPE>::generate(dstId);
+
+        GET_TIME(&data.endTime, &data.errCode);
+        if(NO_ERROR != data.errCode)
+        {
+            amp_printf_unsafe("Cannot get end execution time: %d\n\r",
+                              data.errCode);
+            return;
+        }
+
+        COUNTERS::template stop<FIRST_PMC>(data);
+        if(INT_BENCH_SAMPLING(data))
+        {
+            Region<TYPE>::record(core, partId, data);
+        }
+    }
+};
+
+} /* namespace int_bench */
+
+#endif  /* ifndef __INT_BENCH_HPP__ */
+/* __________________________________________________________________________
+* END OF FILE:
+* -------------
+* ___________________________________________________________________________
+*/
@@ -20,12 +20,48 @@
 #include <ARINC653.h>           /* ARINC653 API (GET_TIME, etc.) */
 #include <OSAbstractionLayer.h> /* API, print, etc. */
 #include <PMCDriver.h>          /* Performance monitoring counters driver */
+#include <CacheColoring.h>      /* Page coloring arena allocator */
+#include <AdaptiveStop.h>       /* Adaptive stopping */
+#include <FlightRecorder.h>     /* Flight recorder */
+#include <PartitionSwitch.h>    /* Partition switch benchmark */
+#include <TraceReplay.h>        /* Trace driven interrupt replay */
+#include <InterruptDefer.h>     /* Deferred interrupt delivery */
+#include <AsyncInject.h>        /* Asynchronous interrupt injection */
+#include <SectionTiming.h>      /* Payload sections timing */
+#include <MemCoRunner.h>        /* Memory bandwidth co-runner */
+#include <SmtSibling.h>         /* SMT sibling interference mode */
+#include <RecordEncoding.h>     /* Delta and varint record encoding */
+#include <TickInterference.h>   /* OS tick interference */
+#include <CampaignManifest.h>   /* Campaign manifest */
+#include <MaskLatency.h>        /* Interrupt masking window */
 
 /*******************************************************************************
  * CONFIGURATION
  ******************************************************************************/
 
-/* None */
+/* Size of the fixed size records: ID (4B), execution time (8B), L2 misses
+ * (4B) and TLB misses (4B)
+ */
+#define INT_BENCH_DUMP_RECORD_SIZE 20
+
+/* Size of the interrupt count records: ID (4B, INT_BENCH_RECORD_ID of the
+ * PART record), sample index (4B) and the number of interrupts of each type
+ * (2B each, saturated). Only the samples hit by an interrupt have a record.
+ */
+#define INT_BENCH_INT_RECORD_SIZE (8 + 2 * INT_BENCH_INT_COUNTER_TYPES)
+
+/* Every sample of the payload partitions must fit in the PART region and in
+ * the interrupt count region
+ */
+#if INT_BENCH_DUMP_ENCODING == INT_BENCH_DUMP_ENC_RAW &&                       \
+    INT_BENCH_PAYLOAD_PARTITIONS * INT_BENCH_SAMPLE_COUNT *                    \
+    INT_BENCH_DUMP_RECORD_SIZE > INT_BENCH_DUMP_REG_SIZE - 8
+#error "The PART records of the payload partitions do not fit in their region"
+#endif
+#if INT_BENCH_PAYLOAD_PARTITIONS * INT_BENCH_SAMPLE_COUNT *                    \
+    INT_BENCH_INT_RECORD_SIZE > INT_BENCH_DUMP_REG_SIZE - 8
+#error "The interrupt count records do not fit in the interrupt count region"
+#endif
 
 /*******************************************************************************
  * TYPES
@@ -41,16 +77,69 @@ typedef struct {
     uint32_t         l2Miss;
     uint32_t         tlbMiss;
     uint32_t         samples;
+    /* Core of the benchmark and interrupts of each type it handled during the
+     * last sample (INT_BENCH_TYPE_SC to INT_BENCH_TYPE_IPI)
+     */
+    uint32_t         core;
+    uint32_t         intCount[INT_BENCH_INT_COUNTER_TYPES];
+    /* Offset of the asynchronous interrupt of the last sample, set when the
+     * benchmark has an injection state
+     */
+    uint32_t         asyncOffset;
+    /* Payload sections of the last sample and mask of the sections entered */
+    uint32_t            sectionMask;
+    int_bench_section_t sections[INT_BENCH_SECTION_COUNT];
+    /* Adaptive stopping state, NULL to take INT_BENCH_SAMPLE_COUNT samples */
+    int_bench_stop_t* stop;
+    /* Flight recorder state, NULL to dump every sample */
+    int_bench_flight_t* flight;
+    /* Asynchronous injection state, NULL to not interrupt the payload */
+    int_bench_async_t* async;
+    /* SMT sibling state, NULL to not record the sibling thread counters */
+    int_bench_smt_t* smt;
 } int_bench_measure_t;
 
+/* Interrupt types generated by the sweep */
+typedef enum {
+    INT_BENCH_SWEEP_INTINT = 0,
+    INT_BENCH_SWEEP_IPI    = 1,
+    INT_BENCH_SWEEP_EXTINT = 2,
+    INT_BENCH_SWEEP_TYPE_COUNT
+} int_bench_sweep_type_t;
+
+/* Sweep state: the sweep iterates over every (type, destination) combination
+ * from the calling (source) core.
+ */
+typedef struct {
+    int_bench_measure_t    benchData;
+    int_bench_sweep_type_t type;
+    uint32_t               dstId;
+    uint32_t               done;
+} int_bench_sweep_t;
+
 /*******************************************************************************
  * MACROS
  ******************************************************************************/
 
+/* Records the number of translations used by the framework in the dump
+ * header. Called by INT_BENCH_DUMP_HADER, the OS can call it again before the
+ * extraction when the mappings are populated lazily.
+ */
+#define INT_BENCH_DUMP_TRANSLATIONS() {                                        \
+    *(uint32_t*)INT_BENCH_DUMP_REG_HEADER_TLB_COUNT =                          \
+        __IntBenchFrameworkTranslations(                                       \
+            (uint32_t*)INT_BENCH_DUMP_REG_HEADER_TLB_PAGE);                    \
+}
+
 /* Generates the dump header */
 #define INT_BENCH_DUMP_HADER() {                                               \
     memcpy((char*)INT_BENCH_DUMP_REG_HEADER_MAGIC,                             \
            INT_BENCH_DUMP_REG_HEADER_MAGIC_VAL, 8);                            \
+    *(uint32_t*)INT_BENCH_DUMP_REG_HEADER_BOM =                                \
+        INT_BENCH_DUMP_REG_HEADER_BOM_VAL;                                     \
+    INT_BENCH_DUMP_TRANSLATIONS();                                             \
+    *(uint32_t*)INT_BENCH_DUMP_REG_HEADER_STOP_MODE = INT_BENCH_STOP_MODE;     \
+    *(uint32_t*)INT_BENCH_DUMP_REG_HEADER_STOP_CNT  = 0;                       \
     memcpy((char*)INT_BENCH_DUMP_PART_MAGIC_ADDR,                              \
            (char*)INT_BENCH_DUMP_PART_HEADER_MAGIC_VAL, 4);                    \
     memcpy((char*)INT_BENCH_DUMP_SC_MAGIC_ADDR,                                \
@@ -61,26 +150,392 @@ typedef struct {
            (char*)INT_BENCH_DUMP_EXTINT_HEADER_MAGIC_VAL, 4);                  \
     memcpy((char*)INT_BENCH_DUMP_IPI_MAGIC_ADDR,                               \
            (char*)INT_BENCH_DUMP_IPI_HEADER_MAGIC_VAL, 4);                     \
+    memcpy((char*)INT_BENCH_DUMP_SWEEP_MAGIC_ADDR,                             \
+           (char*)INT_BENCH_DUMP_SWEEP_HEADER_MAGIC_VAL, 4);                   \
+    memcpy((char*)INT_BENCH_DUMP_FLIGHT_MAGIC_ADDR,                            \
+           (char*)INT_BENCH_DUMP_FLIGHT_HEADER_MAGIC_VAL, 4);                  \
+    memcpy((char*)INT_BENCH_DUMP_INTCOUNT_MAGIC_ADDR,                          \
+           (char*)INT_BENCH_DUMP_INTCOUNT_HEADER_MAGIC_VAL, 4);                \
+    *(uint32_t*)INT_BENCH_DUMP_REG_HEADER_DROP = 0;                            \
+    memset((void*)INT_BENCH_INT_COUNTERS_ADDR, 0,                              \
+           INT_BENCH_CORE_COUNT * INT_BENCH_INT_COUNTER_TYPES *                \
+           sizeof(uint32_t));                                                  \
+    memcpy((char*)INT_BENCH_DUMP_PSW_MAGIC_ADDR,                               \
+           (char*)INT_BENCH_DUMP_PSW_HEADER_MAGIC_VAL, 4);                     \
+    memset((void*)INT_BENCH_PSW_STATES_ADDR, 0,                                \
+           INT_BENCH_CORE_COUNT * sizeof(int_bench_psw_state_t));              \
+    memcpy((char*)INT_BENCH_DUMP_REPLAY_MAGIC_ADDR,                            \
+           (char*)INT_BENCH_DUMP_REPLAY_HEADER_MAGIC_VAL, 4);                  \
+    memcpy((char*)INT_BENCH_DUMP_ASYNC_MAGIC_ADDR,                             \
+           (char*)INT_BENCH_DUMP_ASYNC_HEADER_MAGIC_VAL, 4);                   \
+    memcpy((char*)INT_BENCH_DUMP_SECTION_MAGIC_ADDR,                           \
+           (char*)INT_BENCH_DUMP_SECTION_HEADER_MAGIC_VAL, 4);                 \
+    memcpy((char*)INT_BENCH_DUMP_MBW_MAGIC_ADDR,                               \
+           (char*)INT_BENCH_DUMP_MBW_HEADER_MAGIC_VAL, 4);                     \
+    memcpy((char*)INT_BENCH_DUMP_SMT_MAGIC_ADDR,                               \
+           (char*)INT_BENCH_DUMP_SMT_HEADER_MAGIC_VAL, 4);                     \
+    memcpy((char*)INT_BENCH_DUMP_TICK_MAGIC_ADDR,                              \
+           (char*)INT_BENCH_DUMP_TICK_HEADER_MAGIC_VAL, 4);                    \
+    memset((void*)INT_BENCH_TICK_STATES_ADDR, 0,                               \
+           INT_BENCH_CORE_COUNT * sizeof(int_bench_tick_state_t));             \
+    *(uint32_t*)INT_BENCH_DUMP_REG_HEADER_TICK_HZ =                            \
+        __IntBenchSetTickFrequency(INT_BENCH_TICK_HZ);                         \
+    __IntBenchManifestInit();                                                  \
+    memcpy((char*)INT_BENCH_DUMP_MASK_MAGIC_ADDR,                              \
+           (char*)INT_BENCH_DUMP_MASK_HEADER_MAGIC_VAL, 4);                    \
+    memset((void*)INT_BENCH_MASK_STATE, 0, sizeof(int_bench_mask_state_t));    \
+    *INT_BENCH_REPLAY_ORIGIN_PTR = 0;                                          \
+    *(uint32_t*)INT_BENCH_DUMP_REG_HEADER_RPLY_SKIP = 0;                       \
+    *(uint32_t*)INT_BENCH_DUMP_REG_HEADER_FLT_DROP = 0;                        \
+    *(uint32_t*)INT_BENCH_DUMP_REG_HEADER_DEFER = INT_BENCH_DEFER_MODE;        \
+    memset((void*)INT_BENCH_DEFER_STATES_ADDR, 0,                              \
+           INT_BENCH_CORE_COUNT * sizeof(int_bench_defer_state_t));            \
+    memset((void*)INT_BENCH_FLIGHT_RINGS_ADDR, 0,                              \
+           INT_BENCH_CORE_COUNT * sizeof(int_bench_flight_ring_t));            \
+    __IntBenchEncReset(INT_BENCH_DUMP_PART_MAGIC_ADDR);                        \
+    __IntBenchEncReset(INT_BENCH_DUMP_SC_MAGIC_ADDR);                          \
+    __IntBenchEncReset(INT_BENCH_DUMP_INTINT_MAGIC_ADDR);                      \
+    __IntBenchEncReset(INT_BENCH_DUMP_EXTINT_MAGIC_ADDR);                      \
+    __IntBenchEncReset(INT_BENCH_DUMP_IPI_MAGIC_ADDR);                         \
 }
 
-/* Dumps the data gathered for the calling internal interrupt */
+/* Dumps the data gathered for the calling internal interrupt. The records of
+ * the regions with an encoded variant are encoded when
+ * INT_BENCH_DUMP_ENCODING is INT_BENCH_DUMP_ENC_DELTA.
+ */
 #define INT_BENCH_DUMP(PARTID, BENCH_DATA, TYPE) {                             \
     /* Here there is not need to protect the data with a lock as only one */   \
     /* partition should execute this at a time.*/                              \
+    if(INT_BENCH_DUMP_ENC_DELTA == INT_BENCH_DUMP_ENCODING &&                  \
+       0 != INT_BENCH_DUMP_ENCODED_ ## TYPE)                                   \
+    {                                                                          \
+        INT_BENCH_DUMP_ENC(PARTID, BENCH_DATA, TYPE);                          \
+    }                                                                          \
+    else                                                                       \
+    {                                                                          \
+        INT_BENCH_DUMP_RAW(PARTID, BENCH_DATA, TYPE);                          \
+    }                                                                          \
+}
+
+/* Dumps a fixed size record. The records that do not fit in the region are
+ * dropped and counted in the dump header.
+ */
+#define INT_BENCH_DUMP_RAW(PARTID, BENCH_DATA, TYPE) {                         \
+    if(INT_BENCH_DUMP_REG_SIZE - 8 -                                           \
+       *(uint32_t*)INT_BENCH_DUMP_ ## TYPE ## _SIZE_ADDR <                     \
+       INT_BENCH_DUMP_RECORD_SIZE)                                             \
+    {                                                                          \
+        ++*(uint32_t*)INT_BENCH_DUMP_REG_HEADER_DROP;                          \
+    }                                                                          \
+    else                                                                       \
+    {                                                                          \
+        *((uint32_t*)INT_BENCH_DUMP_ ## TYPE ## _CURSOR_PTR) = PARTID;         \
+        *(uint32_t*)INT_BENCH_DUMP_ ## TYPE ## _SIZE_ADDR += sizeof(uint32_t); \
                                                                                \
-    *((uint32_t*)INT_BENCH_DUMP_ ## TYPE ## _CURSOR_PTR) = PARTID;             \
-    *(uint32_t*)INT_BENCH_DUMP_ ## TYPE ## _SIZE_ADDR += sizeof(uint32_t);     \
-                                                                               \
-    *((SYSTEM_TIME_TYPE*)INT_BENCH_DUMP_ ## TYPE ## _CURSOR_PTR) =             \
-        BENCH_DATA.endTime - BENCH_DATA.startTime;                             \
-    *(uint32_t*)INT_BENCH_DUMP_ ## TYPE ## _SIZE_ADDR +=                       \
-        sizeof(SYSTEM_TIME_TYPE);                                              \
+        *((SYSTEM_TIME_TYPE*)INT_BENCH_DUMP_ ## TYPE ## _CURSOR_PTR) =         \
+            BENCH_DATA.endTime - BENCH_DATA.startTime;                         \
+        *(uint32_t*)INT_BENCH_DUMP_ ## TYPE ## _SIZE_ADDR +=                   \
+            sizeof(SYSTEM_TIME_TYPE);                                          \
                                                                                \
-    *((uint32_t*)INT_BENCH_DUMP_ ## TYPE ## _CURSOR_PTR) = BENCH_DATA.l2Miss;  \
-    *(uint32_t*)INT_BENCH_DUMP_ ## TYPE ## _SIZE_ADDR += sizeof(uint32_t);     \
+        *((uint32_t*)INT_BENCH_DUMP_ ## TYPE ## _CURSOR_PTR) =                 \
+            BENCH_DATA.l2Miss;                                                 \
+        *(uint32_t*)INT_BENCH_DUMP_ ## TYPE ## _SIZE_ADDR += sizeof(uint32_t); \
                                                                                \
-    *((uint32_t*)INT_BENCH_DUMP_ ## TYPE ## _CURSOR_PTR) = BENCH_DATA.tlbMiss; \
-    *(uint32_t*)INT_BENCH_DUMP_ ## TYPE ## _SIZE_ADDR += sizeof(uint32_t);     \
+        *((uint32_t*)INT_BENCH_DUMP_ ## TYPE ## _CURSOR_PTR) =                 \
+            BENCH_DATA.tlbMiss;                                                \
+        *(uint32_t*)INT_BENCH_DUMP_ ## TYPE ## _SIZE_ADDR += sizeof(uint32_t); \
+    }                                                                          \
+}
+
+/* Dumps an encoded record (see RecordEncoding.h) */
+#define INT_BENCH_DUMP_ENC(PARTID, BENCH_DATA, TYPE) {                         \
+    __IntBenchEncDump(INT_BENCH_DUMP_ ## TYPE ## _MAGIC_ADDR, PARTID,          \
+                      BENCH_DATA.endTime - BENCH_DATA.startTime,               \
+                      BENCH_DATA.l2Miss, BENCH_DATA.tlbMiss);                  \
+}
+
+/* Regions with an encoded variant, the sweep records keep their fixed size */
+#define INT_BENCH_DUMP_ENCODED_PART   1
+#define INT_BENCH_DUMP_ENCODED_SC     1
+#define INT_BENCH_DUMP_ENCODED_INTINT 1
+#define INT_BENCH_DUMP_ENCODED_EXTINT 1
+#define INT_BENCH_DUMP_ENCODED_IPI    1
+#define INT_BENCH_DUMP_ENCODED_SWEEP  0
+
+/* Snapshots the interrupt counters of the benchmark core */
+#define INT_BENCH_INT_SNAPSHOT(BENCH_DATA) {                                   \
+    uint32_t intType_;                                                         \
+    for(intType_ = 0; intType_ < INT_BENCH_INT_COUNTER_TYPES; ++intType_)      \
+    {                                                                          \
+        BENCH_DATA.intCount[intType_] =                                        \
+            *INT_BENCH_INT_COUNTER_PTR(BENCH_DATA.core,                        \
+                                       INT_BENCH_TYPE_SC + intType_);          \
+    }                                                                          \
+}
+
+/* Replaces the snapshot by the number of interrupts handled since */
+#define INT_BENCH_INT_DELTA(BENCH_DATA) {                                      \
+    uint32_t intType_;                                                         \
+    for(intType_ = 0; intType_ < INT_BENCH_INT_COUNTER_TYPES; ++intType_)      \
+    {                                                                          \
+        BENCH_DATA.intCount[intType_] =                                        \
+            *INT_BENCH_INT_COUNTER_PTR(BENCH_DATA.core,                        \
+                                       INT_BENCH_TYPE_SC + intType_) -         \
+            BENCH_DATA.intCount[intType_];                                     \
+    }                                                                          \
+}
+
+/* Dumps the interrupt counts of the sample in the interrupt count region, if
+ * any interrupt hit the payload. The records that do not fit in the region
+ * are dropped and counted in the dump header.
+ */
+#define INT_BENCH_INT_DUMP(CORE, PARTID, BENCH_DATA) {                         \
+    uint32_t  intType_;                                                        \
+    uint32_t  intHit_;                                                         \
+    uint32_t  intSize_;                                                        \
+    uint32_t* intCursor_;                                                      \
+    uint16_t* intCounts_;                                                      \
+    intHit_ = 0;                                                               \
+    for(intType_ = 0; intType_ < INT_BENCH_INT_COUNTER_TYPES; ++intType_)      \
+    {                                                                          \
+        intHit_ |= BENCH_DATA.intCount[intType_];                              \
+    }                                                                          \
+    if(0 != intHit_)                                                           \
+    {                                                                          \
+        intSize_ = *(uint32_t*)INT_BENCH_DUMP_INTCOUNT_SIZE_ADDR;              \
+        if(INT_BENCH_DUMP_REG_SIZE - 8 - intSize_ < INT_BENCH_INT_RECORD_SIZE) \
+        {                                                                      \
+            ++*(uint32_t*)INT_BENCH_DUMP_REG_HEADER_DROP;                      \
+        }                                                                      \
+        else                                                                   \
+        {                                                                      \
+            intCursor_ = (uint32_t*)(INT_BENCH_DUMP_INTCOUNT_CURSOR_ADDR +     \
+                                     intSize_);                                \
+            intCursor_[0] = INT_BENCH_RECORD_ID(INT_BENCH_TYPE_PART, CORE,     \
+                                                PARTID);                       \
+            intCursor_[1] = BENCH_DATA.samples;                                \
+            intCounts_ = (uint16_t*)(intCursor_ + 2);                          \
+            for(intType_ = 0; intType_ < INT_BENCH_INT_COUNTER_TYPES;          \
+                ++intType_)                                                    \
+            {                                                                  \
+                intCounts_[intType_] =                                         \
+                    (0xFFFF < BENCH_DATA.intCount[intType_]) ?                 \
+                    0xFFFF : (uint16_t)BENCH_DATA.intCount[intType_];          \
+            }                                                                  \
+            *(uint32_t*)INT_BENCH_DUMP_INTCOUNT_SIZE_ADDR =                    \
+                intSize_ + INT_BENCH_INT_RECORD_SIZE;                          \
+        }                                                                      \
+    }                                                                          \
+}
+
+/* Record ID: bits[16-23] benchmark type, bits[8-15] core, bits[0-7] partition
+ */
+#define INT_BENCH_RECORD_ID(TYPE, CORE, PARTID)                                \
+    ((((uint32_t)(TYPE) & 0xFF) << 16) | (((uint32_t)(CORE) & 0xFF) << 8) |    \
+     ((uint32_t)(PARTID) & 0xFF))
+
+/* Tells if the benchmark still samples: the benchmarks with a flight recorder
+ * always sample, the others sample until the sample count is reached or, with
+ * adaptive stopping, until they stop.
+ */
+#define INT_BENCH_SAMPLING(BENCH_DATA)                                         \
+    (NULL != BENCH_DATA.flight ||                                              \
+     (INT_BENCH_SAMPLE_COUNT > BENCH_DATA.samples &&                           \
+      (NULL == BENCH_DATA.stop || 0 == BENCH_DATA.stop->done)))
+
+/* Enables the flight recorder of a benchmark. FLIGHT_DATA is the flight
+ * recorder state (int_bench_flight_t), THRESHOLD the static execution time
+ * threshold or 0 to learn it.
+ */
+#define INT_BENCH_FLIGHT_INIT(BENCH_DATA, FLIGHT_DATA, THRESHOLD) {            \
+    memset(&FLIGHT_DATA, 0, sizeof(int_bench_flight_t));                       \
+    FLIGHT_DATA.threshold = THRESHOLD;                                         \
+    BENCH_DATA.flight = &FLIGHT_DATA;                                          \
+}
+
+/* Stores a sample: in the flight recorder of the benchmark if it has one, in
+ * the dump region of its type otherwise.
+ */
+#define INT_BENCH_RECORD(CORE, PARTID, BENCH_DATA, TYPE) {                     \
+    if(NULL != BENCH_DATA.flight)                                              \
+    {                                                                          \
+        __IntBenchFlightRecord(BENCH_DATA.flight, CORE,                        \
+                               INT_BENCH_RECORD_ID(INT_BENCH_TYPE_ ## TYPE,    \
+                                                   CORE, PARTID),              \
+                               BENCH_DATA.samples, BENCH_DATA.startTime,       \
+                               BENCH_DATA.endTime, BENCH_DATA.l2Miss,          \
+                               BENCH_DATA.tlbMiss);                            \
+    }                                                                          \
+    else                                                                       \
+    {                                                                          \
+        INT_BENCH_DUMP(PARTID, BENCH_DATA, TYPE);                              \
+    }                                                                          \
+}
+
+/* Enables the asynchronous interrupt injection of a benchmark. OFFSETS is
+ * the array of COUNT offsets (ns) from the start of the measurement, used in
+ * turn by the samples.
+ */
+#define INT_BENCH_ASYNC_INIT(BENCH_DATA, ASYNC_DATA, OFFSETS, COUNT) {         \
+    ASYNC_DATA.offsets = OFFSETS;                                              \
+    ASYNC_DATA.count   = COUNT;                                                \
+    ASYNC_DATA.next    = 0;                                                    \
+    BENCH_DATA.async   = &ASYNC_DATA;                                          \
+}
+
+/* Arms the asynchronous interrupt of the sample, if the benchmark has an
+ * injection state
+ */
+#define INT_BENCH_ASYNC_ARM(BENCH_DATA) {                                      \
+    if(NULL != BENCH_DATA.async)                                               \
+    {                                                                          \
+        BENCH_DATA.asyncOffset = __IntBenchAsyncArm(BENCH_DATA.async);         \
+    }                                                                          \
+}
+
+/* Disarms the asynchronous interrupt of the sample */
+#define INT_BENCH_ASYNC_DISARM(BENCH_DATA) {                                   \
+    if(NULL != BENCH_DATA.async)                                               \
+    {                                                                          \
+        __IntBenchDisarmAsyncInt();                                            \
+    }                                                                          \
+}
+
+/* Dumps the offset of the asynchronous interrupt of the sample, if the
+ * benchmark has an injection state
+ */
+#define INT_BENCH_ASYNC_DUMP(CORE, PARTID, BENCH_DATA) {                       \
+    if(NULL != BENCH_DATA.async)                                               \
+    {                                                                          \
+        __IntBenchAsyncDump(INT_BENCH_RECORD_ID(INT_BENCH_TYPE_PART, CORE,     \
+                                                PARTID),                       \
+                            BENCH_DATA.samples, BENCH_DATA.asyncOffset);       \
+    }                                                                          \
+}
+
+/* Marks the beginning of a payload section, ID is lower than
+ * INT_BENCH_SECTION_COUNT
+ */
+#define INT_BENCH_SECTION_BEGIN(BENCH_DATA, ID) {                              \
+    BENCH_DATA.sections[ID].beginTime = __IntBenchReadTimebase();              \
+    __PMC_DRV_READ(INT_BENCH_PAYLOAD_PMC_L2,                                   \
+                   &BENCH_DATA.sections[ID].beginL2);                          \
+    __PMC_DRV_READ(INT_BENCH_PAYLOAD_PMC_TLB,                                  \
+                   &BENCH_DATA.sections[ID].beginTlb);                         \
+}
+
+/* Marks the end of a payload section, the deltas are accumulated */
+#define INT_BENCH_SECTION_END(BENCH_DATA, ID) {                                \
+    uint32_t sectionL2_;                                                       \
+    uint32_t sectionTlb_;                                                      \
+    __PMC_DRV_READ(INT_BENCH_PAYLOAD_PMC_L2, &sectionL2_);                     \
+    __PMC_DRV_READ(INT_BENCH_PAYLOAD_PMC_TLB, &sectionTlb_);                   \
+    BENCH_DATA.sections[ID].time += __IntBenchReadTimebase() -                 \
+                                    BENCH_DATA.sections[ID].beginTime;         \
+    BENCH_DATA.sections[ID].l2Miss  += sectionL2_ -                            \
+                                       BENCH_DATA.sections[ID].beginL2;        \
+    BENCH_DATA.sections[ID].tlbMiss += sectionTlb_ -                           \
+                                       BENCH_DATA.sections[ID].beginTlb;       \
+    BENCH_DATA.sectionMask |= 1U << (ID);                                      \
+}
+
+/* Clears the sections of the previous sample */
+#define INT_BENCH_SECTION_RESET(BENCH_DATA) {                                  \
+    if(0 != BENCH_DATA.sectionMask)                                            \
+    {                                                                          \
+        memset(BENCH_DATA.sections, 0, sizeof(BENCH_DATA.sections));           \
+        BENCH_DATA.sectionMask = 0;                                            \
+    }                                                                          \
+}
+
+/* Dumps the sections of the sample, if the payload entered any */
+#define INT_BENCH_SECTION_DUMP(CORE, PARTID, BENCH_DATA) {                     \
+    if(0 != BENCH_DATA.sectionMask)                                            \
+    {                                                                          \
+        __IntBenchSectionDump(INT_BENCH_RECORD_ID(INT_BENCH_TYPE_PART, CORE,   \
+                                                  PARTID),                     \
+                              BENCH_DATA.samples, BENCH_DATA.sectionMask,      \
+                              BENCH_DATA.sections);                            \
+    }                                                                          \
+}
+
+/* Enables the SMT sibling mode of a payload executing on hardware thread
+ * THREAD of its core. SMT_DATA is the sibling state (int_bench_smt_t), the
+ * sibling thread must execute the sibling agent (see SmtSibling.h).
+ */
+#define INT_BENCH_SMT_INIT(BENCH_DATA, SMT_DATA, THREAD) {                     \
+    memset(&SMT_DATA, 0, sizeof(int_bench_smt_t));                             \
+    SMT_DATA.thread  = THREAD;                                                 \
+    SMT_DATA.sibling = INT_BENCH_SIBLING_THREAD(THREAD);                       \
+    BENCH_DATA.smt   = &SMT_DATA;                                              \
+}
+
+/* Snapshots the sibling counters, if the benchmark has a sibling state */
+#define INT_BENCH_SMT_SNAPSHOT(BENCH_DATA) {                                   \
+    if(NULL != BENCH_DATA.smt)                                                 \
+    {                                                                          \
+        __IntBenchSmtStart(BENCH_DATA.smt, BENCH_DATA.core);                   \
+    }                                                                          \
+}
+
+/* Replaces the snapshot by the sibling counters deltas */
+#define INT_BENCH_SMT_DELTA(BENCH_DATA) {                                      \
+    if(NULL != BENCH_DATA.smt)                                                 \
+    {                                                                          \
+        __IntBenchSmtStop(BENCH_DATA.smt, BENCH_DATA.core);                    \
+    }                                                                          \
+}
+
+/* Dumps the counters of both threads of the sample */
+#define INT_BENCH_SMT_DUMP(CORE, PARTID, BENCH_DATA) {                         \
+    if(NULL != BENCH_DATA.smt)                                                 \
+    {                                                                          \
+        __IntBenchSmtDump(INT_BENCH_RECORD_ID(INT_BENCH_TYPE_PART, CORE,       \
+                                              PARTID),                         \
+                          BENCH_DATA.samples, BENCH_DATA.smt,                  \
+                          BENCH_DATA.l2Miss, BENCH_DATA.tlbMiss);              \
+    }                                                                          \
+}
+
+/* Executes a memory co-runner window of WINDOW_NS ns (see MemCoRunner.h),
+ * MBW_DATA is the co-runner state (int_bench_mbw_t)
+ */
+#define INT_BENCH_MBW_WINDOW(CORE, PARTID, MBW_DATA, WINDOW_NS)                \
+    __IntBenchMbwWindow(&MBW_DATA,                                             \
+                        INT_BENCH_RECORD_ID(INT_BENCH_TYPE_PART, CORE,         \
+                                            PARTID),                           \
+                        WINDOW_NS)
+
+/* Enables the adaptive stopping of a benchmark. STOP_DATA is the stopping
+ * state (int_bench_stop_t), it must outlive the benchmark.
+ */
+#define INT_BENCH_STOP_INIT(BENCH_DATA, STOP_DATA) {                           \
+    memset(&STOP_DATA, 0, sizeof(int_bench_stop_t));                           \
+    BENCH_DATA.stop = &STOP_DATA;                                              \
+}
+
+/* Updates the adaptive stopping state with the last sample and records the
+ * stopping point in the dump header when the benchmark stops.
+ */
+#define INT_BENCH_STOP_UPDATE(CORE, PARTID, BENCH_DATA, TYPE) {                \
+    if(NULL != BENCH_DATA.stop && 0 == BENCH_DATA.stop->done &&                \
+       0 != __IntBenchStopUpdate(BENCH_DATA.stop,                              \
+                                 BENCH_DATA.endTime - BENCH_DATA.startTime,    \
+                                 INT_BENCH_SAMPLE_COUNT <=                     \
+                                 BENCH_DATA.samples))                          \
+    {                                                                          \
+        amp_printf_unsafe("[C%dP%d] Stopped after %u samples (+/-%u ppm)\n\r", \
+                          CORE, PARTID, BENCH_DATA.samples,                    \
+                          __IntBenchStopPpm(BENCH_DATA.stop));                 \
+        if(0 != __IntBenchStopRecord(                                          \
+                    INT_BENCH_RECORD_ID(INT_BENCH_TYPE_ ## TYPE, CORE,         \
+                                        PARTID),                               \
+                    BENCH_DATA.samples, BENCH_DATA.stop))                      \
+        {                                                                      \
+            amp_printf_unsafe("[C%dP%d] Stopping points table full\n\r",       \
+                              CORE, PARTID);                                   \
+        }                                                                      \
+    }                                                                          \
 }
 
 /* Initializes the benchmark data for the calling partition. This routine also
@@ -115,6 +570,7 @@ typedef struct {
     __LockRelease(INT_BENCH_RDYMASK_LOCK);                                     \
     MAFCOUNT = 0;                                                              \
     BENCH_DATA.samples = 0;                                                    \
+    BENCH_DATA.core = CORE;                                                    \
 }
 
 /* Starts a sampling iteration. We discard the first and last MAF every 10 MAFs
@@ -124,10 +580,14 @@ typedef struct {
 #define INT_BENCH_PAYLOAD_PROLOGUE(MAF_COUNT, BENCH_DATA)                      \
     if(0 < MAF_COUNT && 9 > MAF_COUNT)                                         \
     {                                                                          \
-        __PMCDrvWrite(1, 0);                                                   \
-        __PMCDrvWrite(2, 0);                                                   \
-        __PMCDrvEnable(1, E6500_PMC_EVENT_THREAD_L2_MISS, M_PMC_ALL, 0);       \
-        __PMCDrvEnable(2, E6500_PMC_EVENT_L2MMU_MISS, M_PMC_ALL, 0);           \
+        __PMC_DRV_WRITE(INT_BENCH_PAYLOAD_PMC_L2, 0);                          \
+        __PMC_DRV_WRITE(INT_BENCH_PAYLOAD_PMC_TLB, 0);                         \
+        __PMC_DRV_ENABLE(INT_BENCH_PAYLOAD_PMC_L2, INT_BENCH_PMC_EVENT_L2);    \
+        __PMC_DRV_ENABLE(INT_BENCH_PAYLOAD_PMC_TLB, INT_BENCH_PMC_EVENT_TLB);  \
+        INT_BENCH_SECTION_RESET(BENCH_DATA);                                   \
+        INT_BENCH_INT_SNAPSHOT(BENCH_DATA);                                    \
+        INT_BENCH_SMT_SNAPSHOT(BENCH_DATA);                                    \
+        INT_BENCH_ASYNC_ARM(BENCH_DATA);                                       \
         GET_TIME(&BENCH_DATA.startTime, &BENCH_DATA.errCode);                  \
         if (BENCH_DATA.errCode == NO_ERROR)                                    \
         {
@@ -137,18 +597,27 @@ typedef struct {
  */
 #define INT_BENCH_PAYLOAD_EPILOGUE(MAF_COUNT, BENCH_DATA, CORE, PARTID)        \
             GET_TIME(&BENCH_DATA.endTime, &BENCH_DATA.errCode);                \
+            INT_BENCH_ASYNC_DISARM(BENCH_DATA);                                \
             if (BENCH_DATA.errCode == NO_ERROR)                                \
             {                                                                  \
-                __PMCDrvDisable(1);                                            \
-                __PMCDrvDisable(2);                                            \
-                __PMCDrvRead(1, &BENCH_DATA.l2Miss);                           \
-                __PMCDrvRead(2, &BENCH_DATA.tlbMiss);                          \
-                if(INT_BENCH_SAMPLE_COUNT > BENCH_DATA.samples)                \
+                __PMC_DRV_DISABLE(INT_BENCH_PAYLOAD_PMC_L2);                   \
+                __PMC_DRV_DISABLE(INT_BENCH_PAYLOAD_PMC_TLB);                  \
+                __PMC_DRV_READ(INT_BENCH_PAYLOAD_PMC_L2, &BENCH_DATA.l2Miss);  \
+                __PMC_DRV_READ(INT_BENCH_PAYLOAD_PMC_TLB,                      \
+                               &BENCH_DATA.tlbMiss);                           \
+                INT_BENCH_INT_DELTA(BENCH_DATA);                               \
+                INT_BENCH_SMT_DELTA(BENCH_DATA);                               \
+                if(INT_BENCH_SAMPLING(BENCH_DATA))                             \
                 {                                                              \
-                    INT_BENCH_DUMP(PARTID, BENCH_DATA, PART);                  \
+                    INT_BENCH_RECORD(CORE, PARTID, BENCH_DATA, PART);          \
+                    INT_BENCH_INT_DUMP(CORE, PARTID, BENCH_DATA);              \
+                    INT_BENCH_ASYNC_DUMP(CORE, PARTID, BENCH_DATA);            \
+                    INT_BENCH_SECTION_DUMP(CORE, PARTID, BENCH_DATA);          \
+                    INT_BENCH_SMT_DUMP(CORE, PARTID, BENCH_DATA);              \
                     printf("C%dP%d %llius\n\r", CORE, PARTID,                  \
                            (BENCH_DATA.endTime - BENCH_DATA.startTime) / 1000);\
                     ++BENCH_DATA.samples;                                      \
+                    INT_BENCH_STOP_UPDATE(CORE, PARTID, BENCH_DATA, PART);     \
                 }                                                              \
                 else if(INT_BENCH_SAMPLE_COUNT == BENCH_DATA.samples)          \
                 {                                                              \
@@ -174,34 +643,36 @@ typedef struct {
 /* Executes payload */
 #define INT_BENCH_EXEC_PAYLOAD(PAYLOAD) PAYLOAD();
 
-/* Generate an internal interrupt.
- * This function enters an infinite loop until the interrupt occur. The
- * interrupt handler is responsible of changing the interrupt return IP value to
- * jump over the infinite loop. */
-#define INT_BENCH_GEN_INT_INT(COREID, PARTID, BENCH_DATA)                      \
+/* Generates an interrupt with the GENERATE call and measures it. The
+ * measurement is stored in the TYPE region (INT_BENCH_DUMP_<TYPE>_*) or in the
+ * flight recorder of the benchmark. The interrupt types only differ by their
+ * generation call, a new type only needs its region and a wrapper below.
+ */
+#define INT_BENCH_GEN(COREID, PARTID, BENCH_DATA, TYPE, GENERATE)              \
 {                                                                              \
     /* Init measurements */                                                    \
-    __PMCDrvWrite(3, 0);                                                       \
-    __PMCDrvWrite(4, 0);                                                       \
-    __PMCDrvEnable(3, E6500_PMC_EVENT_THREAD_L2_MISS, M_PMC_ALL, 0);           \
-    __PMCDrvEnable(4, E6500_PMC_EVENT_L2MMU_MISS, M_PMC_ALL, 0);               \
+    __PMC_DRV_WRITE(INT_BENCH_HANDLER_PMC_L2, 0);                              \
+    __PMC_DRV_WRITE(INT_BENCH_HANDLER_PMC_TLB, 0);                             \
+    __PMC_DRV_ENABLE(INT_BENCH_HANDLER_PMC_L2, INT_BENCH_PMC_EVENT_L2);        \
+    __PMC_DRV_ENABLE(INT_BENCH_HANDLER_PMC_TLB, INT_BENCH_PMC_EVENT_TLB);      \
                                                                                \
     GET_TIME(&BENCH_DATA.startTime, &BENCH_DATA.errCode);                      \
     if (BENCH_DATA.errCode == NO_ERROR)                                        \
     {                                                                          \
         /* Generate interrupt */                                               \
-        __IntBenchGenerateInternalInt();                                       \
+        GENERATE;                                                              \
         GET_TIME(&BENCH_DATA.endTime, &BENCH_DATA.errCode);                    \
         if(BENCH_DATA.errCode == NO_ERROR)                                     \
         {                                                                      \
-            __PMCDrvDisable(3);                                                \
-            __PMCDrvDisable(4);                                                \
-            __PMCDrvRead(3, &BENCH_DATA.l2Miss);                               \
-            __PMCDrvRead(4, &BENCH_DATA.tlbMiss);                              \
-            if(INT_BENCH_SAMPLE_COUNT > BENCH_DATA.samples)                    \
+            __PMC_DRV_DISABLE(INT_BENCH_HANDLER_PMC_L2);                       \
+            __PMC_DRV_DISABLE(INT_BENCH_HANDLER_PMC_TLB);                      \
+            __PMC_DRV_READ(INT_BENCH_HANDLER_PMC_L2, &BENCH_DATA.l2Miss);      \
+            __PMC_DRV_READ(INT_BENCH_HANDLER_PMC_TLB, &BENCH_DATA.tlbMiss);    \
+            if(INT_BENCH_SAMPLING(BENCH_DATA))                                 \
             {                                                                  \
-                INT_BENCH_DUMP(PARTID, BENCH_DATA, INTINT);                    \
+                INT_BENCH_RECORD(COREID, PARTID, BENCH_DATA, TYPE);            \
                 ++BENCH_DATA.samples;                                          \
+                INT_BENCH_STOP_UPDATE(COREID, PARTID, BENCH_DATA, TYPE);       \
             }                                                                  \
         }                                                                      \
         else                                                                   \
@@ -217,131 +688,143 @@ typedef struct {
     }                                                                          \
 }
 
+/* Generate an internal interrupt.
+ * This function enters an infinite loop until the interrupt occur. The
+ * interrupt handler is responsible of changing the interrupt return IP value to
+ * jump over the infinite loop. */
+#define INT_BENCH_GEN_INT_INT(COREID, PARTID, BENCH_DATA)                      \
+    INT_BENCH_GEN(COREID, PARTID, BENCH_DATA, INTINT,                          \
+                  __IntBenchGenerateInternalInt())
+
 /* Generate a syscall interrupt */
 #define INT_BENCH_GEN_SC(COREID, PARTID, BENCH_DATA)                           \
-{                                                                              \
-    /* Init measurements */                                                    \
-    __PMCDrvWrite(3, 0);                                                       \
-    __PMCDrvWrite(4, 0);                                                       \
-    __PMCDrvEnable(3, E6500_PMC_EVENT_THREAD_L2_MISS, M_PMC_ALL, 0);           \
-    __PMCDrvEnable(4, E6500_PMC_EVENT_L2MMU_MISS, M_PMC_ALL, 0);               \
-                                                                               \
-    GET_TIME(&BENCH_DATA.startTime, &BENCH_DATA.errCode);                      \
-    if (BENCH_DATA.errCode == NO_ERROR)                                        \
-    {                                                                          \
-        /* Generate syscall */                                                 \
-        __IntBenchGenerateSyscall();                                           \
-        GET_TIME(&BENCH_DATA.endTime, &BENCH_DATA.errCode);                    \
-        if(BENCH_DATA.errCode == NO_ERROR)                                     \
-        {                                                                      \
-            __PMCDrvDisable(3);                                                \
-            __PMCDrvDisable(4);                                                \
-            __PMCDrvRead(3, &BENCH_DATA.l2Miss);                               \
-            __PMCDrvRead(4, &BENCH_DATA.tlbMiss);                              \
-            if(INT_BENCH_SAMPLE_COUNT > BENCH_DATA.samples)                    \
-            {                                                                  \
-                INT_BENCH_DUMP(PARTID, BENCH_DATA, SC);                        \
-                ++BENCH_DATA.samples;                                          \
-            }                                                                  \
-        }                                                                      \
-        else                                                                   \
-        {                                                                      \
-            amp_printf_unsafe("Cannot get end execution time: %d\n\r",         \
-                                BENCH_DATA.errCode);                           \
-        }                                                                      \
-    }                                                                          \
-    else                                                                       \
-    {                                                                          \
-        amp_printf_unsafe("Cannot get start execution time: %d\n\r",           \
-                            BENCH_DATA.errCode);                               \
-    }                                                                          \
-}
+    INT_BENCH_GEN(COREID, PARTID, BENCH_DATA, SC, __IntBenchGenerateSyscall())
 
 /* Generate an IPI.
  * This function enters an infinite loop until the interrupt occur. The
  * interrupt handler is responsible of changing the interrupt return IP value to
  * jump over the infinite loop. */
 #define INT_BENCH_GEN_IPI(COREID, PARTID, BENCH_DATA, DSTID)                   \
-{                                                                              \
-    /* Init measurements */                                                    \
-    __PMCDrvWrite(3, 0);                                                       \
-    __PMCDrvWrite(4, 0);                                                       \
-    __PMCDrvEnable(3, E6500_PMC_EVENT_THREAD_L2_MISS, M_PMC_ALL, 0);           \
-    __PMCDrvEnable(4, E6500_PMC_EVENT_L2MMU_MISS, M_PMC_ALL, 0);               \
-                                                                               \
-    GET_TIME(&BENCH_DATA.startTime, &BENCH_DATA.errCode);                      \
-    if (BENCH_DATA.errCode == NO_ERROR)                                        \
+    INT_BENCH_GEN(COREID, PARTID, BENCH_DATA, IPI, __IntBenchGenerateIPI(DSTID))
+
+/* Generate an external interrupt.
+ * This function enters an infinite loop until the interrupt occur. The
+ * interrupt handler is responsible of changing the interrupt return IP value to
+ * jump over the infinite loop. */
+#define INT_BENCH_GEN_EXT_INT(COREID, PARTID, BENCH_DATA, DSTID)               \
+    INT_BENCH_GEN(COREID, PARTID, BENCH_DATA, EXTINT,                          \
+                  __IntBenchGenerateExternalInt(DSTID))
+
+/* Sweep record ID: bits[24-31] interrupt type, bits[16-23] source core,
+ * bits[8-15] destination core, bits[0-7] partition ID.
+ */
+#define INT_BENCH_SWEEP_ID(TYPE, SRCID, DSTID, PARTID)                         \
+    ((((uint32_t)(TYPE) & 0xFF) << 24) | (((uint32_t)(SRCID) & 0xFF) << 16) |  \
+     (((uint32_t)(DSTID) & 0xFF) << 8) | ((uint32_t)(PARTID) & 0xFF))
+
+/* Initializes a sweep, the first combination is the internal interrupt */
+#define INT_BENCH_SWEEP_INIT(COREID, SWEEP_DATA) {                             \
+    memset(&SWEEP_DATA, 0, sizeof(int_bench_sweep_t));                         \
+    SWEEP_DATA.type  = INT_BENCH_SWEEP_INTINT;                                 \
+    SWEEP_DATA.dstId = COREID;                                                 \
+}
+
+/* Moves the sweep to the next (type, destination) combination. The internal
+ * interrupt is only generated on the source core and the destinations outside
+ * INT_BENCH_SWEEP_CORE_MASK are skipped.
+ */
+#define INT_BENCH_SWEEP_NEXT(COREID, SWEEP_DATA) {                             \
+    SWEEP_DATA.benchData.samples = 0;                                          \
+    do                                                                         \
     {                                                                          \
-        /* Generate interrupt */                                               \
-        __IntBenchGenerateIPI(DSTID);                                          \
-        GET_TIME(&BENCH_DATA.endTime, &BENCH_DATA.errCode);                    \
-        if(BENCH_DATA.errCode == NO_ERROR)                                     \
+        if(INT_BENCH_SWEEP_INTINT == SWEEP_DATA.type ||                        \
+           INT_BENCH_CORE_COUNT <= SWEEP_DATA.dstId + 1)                       \
         {                                                                      \
-            __PMCDrvDisable(3);                                                \
-            __PMCDrvDisable(4);                                                \
-            __PMCDrvRead(3, &BENCH_DATA.l2Miss);                               \
-            __PMCDrvRead(4, &BENCH_DATA.tlbMiss);                              \
-            if(INT_BENCH_SAMPLE_COUNT > BENCH_DATA.samples)                    \
-            {                                                                  \
-                INT_BENCH_DUMP(PARTID, BENCH_DATA, IPI);                       \
-                ++BENCH_DATA.samples;                                          \
-            }                                                                  \
+            SWEEP_DATA.type = (int_bench_sweep_type_t)(SWEEP_DATA.type + 1);   \
+            SWEEP_DATA.dstId = 0;                                              \
         }                                                                      \
         else                                                                   \
         {                                                                      \
-            amp_printf_unsafe("Cannot get end execution time: %d\n\r",         \
-                                BENCH_DATA.errCode);                           \
+            ++SWEEP_DATA.dstId;                                                \
         }                                                                      \
-    }                                                                          \
-    else                                                                       \
+    } while(INT_BENCH_SWEEP_TYPE_COUNT > SWEEP_DATA.type &&                    \
+            0 == (INT_BENCH_SWEEP_CORE_MASK & (1U << SWEEP_DATA.dstId)));      \
+    if(INT_BENCH_SWEEP_TYPE_COUNT <= SWEEP_DATA.type)                          \
     {                                                                          \
-        amp_printf_unsafe("Cannot get start execution time: %d\n\r",           \
-                            BENCH_DATA.errCode);                               \
+        SWEEP_DATA.done = 1;                                                   \
     }                                                                          \
 }
 
-/* Generate an external interrupt.
- * This function enters an infinite loop until the interrupt occur. The
- * interrupt handler is responsible of changing the interrupt return IP value to
- * jump over the infinite loop. */
-#define INT_BENCH_GEN_EXT_INT(COREID, PARTID, BENCH_DATA, DSTID)               \
+/* Executes one step of the sweep: generates one interrupt of the current
+ * combination and dumps the measurement with the (source, destination) pair in
+ * the sweep region. The interrupt wait flag and the sweep region are shared by
+ * the sweeps executing on the other cores, the steps are serialized with the
+ * sweep lock.
+ */
+#define INT_BENCH_SWEEP_STEP(COREID, PARTID, SWEEP_DATA)                       \
+do                                                                             \
 {                                                                              \
-    /* Init measurements */                                                    \
-    __PMCDrvWrite(3, 0);                                                       \
-    __PMCDrvWrite(4, 0);                                                       \
-    __PMCDrvEnable(3, E6500_PMC_EVENT_THREAD_L2_MISS, M_PMC_ALL, 0);           \
-    __PMCDrvEnable(4, E6500_PMC_EVENT_L2MMU_MISS, M_PMC_ALL, 0);               \
-                                                                               \
-    GET_TIME(&BENCH_DATA.startTime, &BENCH_DATA.errCode);                      \
-    if (BENCH_DATA.errCode == NO_ERROR)                                        \
+    if(0 == SWEEP_DATA.done)                                                   \
     {                                                                          \
-        /* Generate interrupt */                                               \
-        __IntBenchGenerateExternalInt(DSTID);                                  \
-        GET_TIME(&BENCH_DATA.endTime, &BENCH_DATA.errCode);                    \
-        if(BENCH_DATA.errCode == NO_ERROR)                                     \
+        /* Init measurements */                                                \
+        __PMC_DRV_WRITE(INT_BENCH_HANDLER_PMC_L2, 0);                          \
+        __PMC_DRV_WRITE(INT_BENCH_HANDLER_PMC_TLB, 0);                         \
+        __PMC_DRV_ENABLE(INT_BENCH_HANDLER_PMC_L2, INT_BENCH_PMC_EVENT_L2);    \
+        __PMC_DRV_ENABLE(INT_BENCH_HANDLER_PMC_TLB, INT_BENCH_PMC_EVENT_TLB);  \
+                                                                               \
+        while(0 != __TestAndSet(INT_BENCH_SWEEP_LOCK));                        \
+        GET_TIME(&SWEEP_DATA.benchData.startTime,                              \
+                 &SWEEP_DATA.benchData.errCode);                               \
+        if (SWEEP_DATA.benchData.errCode == NO_ERROR)                          \
         {                                                                      \
-            __PMCDrvDisable(3);                                                \
-            __PMCDrvDisable(4);                                                \
-            __PMCDrvRead(3, &BENCH_DATA.l2Miss);                               \
-            __PMCDrvRead(4, &BENCH_DATA.tlbMiss);                              \
-            if(INT_BENCH_SAMPLE_COUNT > BENCH_DATA.samples)                    \
+            /* Generate interrupt */                                           \
+            if(INT_BENCH_SWEEP_INTINT == SWEEP_DATA.type)                      \
             {                                                                  \
-                INT_BENCH_DUMP(PARTID, BENCH_DATA, EXTINT);                    \
-                ++BENCH_DATA.samples;                                          \
+                __IntBenchGenerateInternalInt();                               \
+            }                                                                  \
+            else if(INT_BENCH_SWEEP_IPI == SWEEP_DATA.type)                    \
+            {                                                                  \
+                __IntBenchGenerateIPI(SWEEP_DATA.dstId);                       \
+            }                                                                  \
+            else                                                               \
+            {                                                                  \
+                __IntBenchGenerateExternalInt(SWEEP_DATA.dstId);               \
+            }                                                                  \
+            GET_TIME(&SWEEP_DATA.benchData.endTime,                            \
+                     &SWEEP_DATA.benchData.errCode);                           \
+            if(SWEEP_DATA.benchData.errCode == NO_ERROR)                       \
+            {                                                                  \
+                __PMC_DRV_DISABLE(INT_BENCH_HANDLER_PMC_L2);                   \
+                __PMC_DRV_DISABLE(INT_BENCH_HANDLER_PMC_TLB);                  \
+                __PMC_DRV_READ(INT_BENCH_HANDLER_PMC_L2,                       \
+                               &SWEEP_DATA.benchData.l2Miss);                  \
+                __PMC_DRV_READ(INT_BENCH_HANDLER_PMC_TLB,                      \
+                               &SWEEP_DATA.benchData.tlbMiss);                 \
+                                                                               \
+                INT_BENCH_DUMP(INT_BENCH_SWEEP_ID(SWEEP_DATA.type, COREID,     \
+                                                  SWEEP_DATA.dstId, PARTID),   \
+                               SWEEP_DATA.benchData, SWEEP);                   \
+                                                                               \
+                if(INT_BENCH_SWEEP_SAMPLE_COUNT <=                             \
+                   ++SWEEP_DATA.benchData.samples)                             \
+                {                                                              \
+                    INT_BENCH_SWEEP_NEXT(COREID, SWEEP_DATA);                  \
+                }                                                              \
+            }                                                                  \
+            else                                                               \
+            {                                                                  \
+                amp_printf_unsafe("Cannot get end execution time: %d\n\r",     \
+                                    SWEEP_DATA.benchData.errCode);             \
             }                                                                  \
         }                                                                      \
         else                                                                   \
         {                                                                      \
-            amp_printf_unsafe("Cannot get end execution time: %d\n\r",         \
-                                BENCH_DATA.errCode);                           \
+            amp_printf_unsafe("Cannot get start execution time: %d\n\r",       \
+                                SWEEP_DATA.benchData.errCode);                 \
         }                                                                      \
+        __LockRelease(INT_BENCH_SWEEP_LOCK);                                   \
     }                                                                          \
-    else                                                                       \
-    {                                                                          \
-        amp_printf_unsafe("Cannot get start execution time: %d\n\r",           \
-                            BENCH_DATA.errCode);                               \
-    }                                                                          \
-}
+} while(0)
 
 #endif  /* ifndef _INTERRUPT_BENCH_H_ */
 /* __________________________________________________________________________
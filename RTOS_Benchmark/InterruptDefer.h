@@ -0,0 +1,211 @@
+/* __________________________________________________________________________
+* MODULE DESCRIPTION:
+* -------------------
+* Filename : InterruptDefer.h
+*
+* Author: Alexy Torres Aurora Dugo
+*
+* Description: This file contains the deferred and coalesced interrupt
+* delivery, benchmarked as an interrupt mitigation (INT_BENCH_DEFER_MODE in
+* OSAbstractionLayer.h). The external interrupts and IPIs that hit the window
+* of a protected partition are only acknowledged by the OS and queued, they are
+* delivered in a batch at the end of the window or by the service core.
+*
+* The OS scheduler calls __IntBenchDeferWindowStart before the first
+* instruction of a partition window and __IntBenchDeferWindowEnd at the end of
+* every window, even if the partition owns the next window. The external
+* interrupt and IPI handlers call __IntBenchDeferInterrupt once the interrupt
+* is acknowledged: the handler is only executed when the interrupt is not
+* queued. The queued interrupts returned by __IntBenchDeferWindowEnd and
+* __IntBenchDeferDrain are then executed by the OS.
+*
+* The interrupt wait flag must only be released when the handler executes: the
+* latency added by the deferral is measured by the generators in the EINT and
+* IPI regions, the interrupt occurrence counters (__IntBenchCountInt) are
+* updated by the delivered handlers so the PART records only count the
+* interrupts that reached the partition.
+*
+* The scheduler must call the window hooks with the interrupts masked, the
+* states are shared with the interrupt handlers of the core and with the
+* service core.
+* __________________________________________________________________________
+*/
+
+/* __________________________________________________________________________
+* PREPROCESSOR DIRECTIVES:
+* ------------------------
+*/
+#ifndef __INTERRUPT_DEFER_H__
+#define __INTERRUPT_DEFER_H__
+
+#include <stdint.h>
+#include <OSAbstractionLayer.h>
+
+/*******************************************************************************
+ * CONFIGURATION
+ ******************************************************************************/
+
+/* Decisions returned by __IntBenchDeferInterrupt */
+#define INT_BENCH_DEFER_DELIVER 0 /* Execute the handler now */
+#define INT_BENCH_DEFER_QUEUED  1 /* Queued, nothing to do */
+#define INT_BENCH_DEFER_NOTIFY  2 /* Queued, notify the service core */
+
+/* Number of interrupt types that can be deferred (INT_BENCH_TYPE_EXTINT and
+ * INT_BENCH_TYPE_IPI)
+ */
+#define INT_BENCH_DEFER_TYPES 2
+
+/*******************************************************************************
+ * TYPES
+ ******************************************************************************/
+
+/* Deferred interrupt delivery state of a core (INT_BENCH_DEFER_STATE_SIZE
+ * bytes)
+ */
+typedef struct {
+    /* Protects the state from the service core */
+    int32_t  lock;
+    /* Set during the window of a protected partition */
+    uint32_t isProtected;
+    /* Queued interrupts of each type (INT_BENCH_DEFER_SLOT) */
+    uint32_t pending[INT_BENCH_DEFER_TYPES];
+} int_bench_defer_state_t;
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* Deferred interrupt delivery state of a core */
+#define INT_BENCH_DEFER_STATE(CORE)                                            \
+    ((volatile int_bench_defer_state_t*)INT_BENCH_DEFER_STATES_ADDR + (CORE))
+
+/* Index of an interrupt type in the pending counts and its reverse */
+#define INT_BENCH_DEFER_SLOT(TYPE) ((TYPE) - INT_BENCH_TYPE_EXTINT)
+#define INT_BENCH_DEFER_TYPE(SLOT) ((SLOT) + INT_BENCH_TYPE_EXTINT)
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/* Takes the queued interrupts of a state. The protected window is closed if
+ * leave is set. Returns the number of queued interrupts.
+ */
+static inline uint32_t
+__IntBenchDeferTake(volatile int_bench_defer_state_t* state,
+                    uint32_t                          pending[],
+                    const uint32_t                    leave)
+{
+    uint32_t count;
+    uint32_t i;
+
+    count = 0;
+    while(0 != __TestAndSet(&state->lock));
+    for(i = 0; i < INT_BENCH_DEFER_TYPES; ++i)
+    {
+        pending[i]        = state->pending[i];
+        count            += state->pending[i];
+        state->pending[i] = 0;
+    }
+    if(0 != leave)
+    {
+        state->isProtected = 0;
+    }
+    __LockRelease(&state->lock);
+
+    return count;
+}
+
+/* OS hook: called by the scheduler of a core before the first instruction of
+ * a partition window.
+ */
+static inline void __IntBenchDeferWindowStart(const uint32_t core,
+                                              const uint32_t partId)
+{
+    volatile int_bench_defer_state_t* state;
+    uint32_t                          isProtected;
+
+    isProtected = 0;
+    if(INT_BENCH_DEFER_NONE != INT_BENCH_DEFER_MODE && 16 > partId &&
+       (INT_BENCH_DEFER_SERVICE != INT_BENCH_DEFER_MODE ||
+        INT_BENCH_DEFER_SERVICE_CORE != core))
+    {
+        isProtected = (uint32_t)((INT_BENCH_DEFER_PROTECTED_MASK >>
+                                  (core * 16 + partId)) & 1);
+    }
+
+    state = INT_BENCH_DEFER_STATE(core);
+    while(0 != __TestAndSet(&state->lock));
+    state->isProtected = isProtected;
+    __LockRelease(&state->lock);
+}
+
+/* OS hook: called by the scheduler of a core at the end of a partition
+ * window. The interrupts queued during the window are returned in pending
+ * (one count per INT_BENCH_DEFER_SLOT), the OS executes their handlers.
+ * Returns the number of queued interrupts.
+ */
+static inline uint32_t __IntBenchDeferWindowEnd(const uint32_t core,
+                                                uint32_t       pending[])
+{
+    return __IntBenchDeferTake(INT_BENCH_DEFER_STATE(core), pending, 1);
+}
+
+/* OS hook: called by the external interrupt and IPI handlers of a core once
+ * the interrupt is acknowledged. Returns INT_BENCH_DEFER_DELIVER if the
+ * handler must be executed, INT_BENCH_DEFER_QUEUED if the interrupt was
+ * queued and INT_BENCH_DEFER_NOTIFY if it was queued and the service core must
+ * be notified (first interrupt of a batch).
+ */
+static inline uint32_t __IntBenchDeferInterrupt(const uint32_t core,
+                                                const uint32_t type)
+{
+    volatile int_bench_defer_state_t* state;
+    uint32_t                          decision;
+    uint32_t                          i;
+
+    if(INT_BENCH_DEFER_NONE == INT_BENCH_DEFER_MODE ||
+       (INT_BENCH_TYPE_EXTINT != type && INT_BENCH_TYPE_IPI != type))
+    {
+        return INT_BENCH_DEFER_DELIVER;
+    }
+
+    state = INT_BENCH_DEFER_STATE(core);
+    while(0 != __TestAndSet(&state->lock));
+    decision = INT_BENCH_DEFER_DELIVER;
+    if(0 != state->isProtected)
+    {
+        decision = INT_BENCH_DEFER_QUEUED;
+        if(INT_BENCH_DEFER_SERVICE == INT_BENCH_DEFER_MODE)
+        {
+            decision = INT_BENCH_DEFER_NOTIFY;
+            for(i = 0; i < INT_BENCH_DEFER_TYPES; ++i)
+            {
+                if(0 != state->pending[i])
+                {
+                    decision = INT_BENCH_DEFER_QUEUED;
+                }
+            }
+        }
+        ++state->pending[INT_BENCH_DEFER_SLOT(type)];
+    }
+    __LockRelease(&state->lock);
+
+    return decision;
+}
+
+/* OS hook: called by the service core when it is notified of a batch, takes
+ * the interrupts queued on a core. The OS executes their handlers on the
+ * service core. Returns the number of queued interrupts.
+ */
+static inline uint32_t __IntBenchDeferDrain(const uint32_t core,
+                                            uint32_t       pending[])
+{
+    return __IntBenchDeferTake(INT_BENCH_DEFER_STATE(core), pending, 0);
+}
+
+#endif  /* ifndef __INTERRUPT_DEFER_H__ */
+/* __________________________________________________________________________
+* END OF FILE:
+* -------------
+* ___________________________________________________________________________
+*/
@@ -0,0 +1,192 @@
+/* __________________________________________________________________________
+* MODULE DESCRIPTION:
+* -------------------
+* Filename : MaskLatency.h
+*
+* Author: Alexy Torres Aurora Dugo
+*
+* Description: This file contains the interrupt masking window benchmark. The
+* SC, IINT, EINT and IPI benchmarks measure the cost of the handlers, not the
+* time the OS keeps the interrupts masked (critical sections, scheduler,
+* partition switches, other handlers). This time adds to the latency of every
+* external interrupt, the I/O latency budget depends on it.
+*
+* An external timer (__IntBenchMaskTimerStart in OSAbstraction.h) is routed to
+* the measured core and fires on an absolute schedule: start + n * period on
+* the time base of __IntBenchGetTimestamp. The OS handler of the timer calls
+* __IntBenchMaskTimerHit at its entry, the hook computes the delivery delay
+* from the programmed fire time and arms the timer for the next fire of the
+* schedule (__IntBenchMaskTimerArm). The delay is not bounded by the period.
+* The delay, the fire time and the partition executing when the timer fired
+* are dumped in the mask region. The timer is not synchronized with the
+* partition windows nor with the OS tick (INT_BENCH_MASK_PERIOD), the fire
+* times sweep the whole MAF and the delay distribution is built over long runs
+* and across partitions. The timer is armed after the time base is read, the
+* delays include the arming time (a few register accesses).
+*
+* The fires of the schedule that elapse while the interrupt is pending are
+* missed: a missed fire means that the interrupts were masked for more than a
+* period. Once the region is full, the records are dropped but the fires, the
+* missed fires and the maximal delay are still accounted in the state of the
+* benchmark, stored at the end of the region.
+*
+* Record format (32B):
+* ID (4B, interrupted partition), core (4B), fire index (4B), missed fires
+* (4B), programmed fire time (8B, __IntBenchGetTimestamp), delay (8B, ns).
+* __________________________________________________________________________
+*/
+
+/* __________________________________________________________________________
+* PREPROCESSOR DIRECTIVES:
+* ------------------------
+*/
+#ifndef __MASK_LATENCY_H__
+#define __MASK_LATENCY_H__
+
+#include <stdint.h>
+#include <string.h>
+#include <OSAbstractionLayer.h>
+
+/*******************************************************************************
+ * CONFIGURATION
+ ******************************************************************************/
+
+/* Partition ID of the fires taken outside of any partition window */
+#define INT_BENCH_MASK_NO_PART 0xFFFFFFFF
+
+/* Size of a mask record */
+#define INT_BENCH_MASK_RECORD_SIZE (sizeof(uint32_t) * 4 + sizeof(uint64_t) * 2)
+
+/* State of the benchmark, stored at the end of the mask region */
+#define INT_BENCH_MASK_STATE                                                   \
+    ((volatile int_bench_mask_state_t*)(INT_BENCH_DUMP_MASK_MAGIC_ADDR +       \
+                                        INT_BENCH_DUMP_REG_SIZE -              \
+                                        sizeof(int_bench_mask_state_t)))
+
+/*******************************************************************************
+ * TYPES
+ ******************************************************************************/
+
+/* Interrupt masking window benchmark state */
+typedef struct {
+    /* Set while the timer fires are measured */
+    uint32_t enabled;
+    /* Core the timer is routed to */
+    uint32_t core;
+    /* Period applied by the OS (ns) */
+    uint32_t period;
+    /* Handler entries, missed fires and records that did not fit */
+    uint32_t fires;
+    uint32_t missed;
+    uint32_t dropped;
+    /* Programmed fire time of the next fire */
+    uint64_t nextFire;
+    /* Longest delivery delay (ns) */
+    uint64_t maxDelay;
+} int_bench_mask_state_t;
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* Routes the external timer to a core and starts measuring its delivery
+ * delays. PERIOD is given in ns (e.g. INT_BENCH_MASK_PERIOD), the first fire
+ * is one period after the start.
+ */
+#define INT_BENCH_MASK_START(CORE, PERIOD) {                                   \
+    uint64_t maskStart_;                                                       \
+    memset((void*)INT_BENCH_MASK_STATE, 0, sizeof(int_bench_mask_state_t));    \
+    INT_BENCH_MASK_STATE->core    = (CORE);                                    \
+    maskStart_ = __IntBenchGetTimestamp();                                     \
+    INT_BENCH_MASK_STATE->period  =                                            \
+        __IntBenchMaskTimerStart((CORE), (PERIOD));                            \
+    INT_BENCH_MASK_STATE->nextFire =                                           \
+        maskStart_ + INT_BENCH_MASK_STATE->period;                             \
+    INT_BENCH_MASK_STATE->enabled = (0 != INT_BENCH_MASK_STATE->period);       \
+}
+
+/* Stops the external timer */
+#define INT_BENCH_MASK_STOP() {                                                \
+    INT_BENCH_MASK_STATE->enabled = 0;                                         \
+    __IntBenchMaskTimerStop();                                                 \
+}
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/* OS hook: called by the handler of the external timer at its entry, before
+ * the interrupt is acknowledged. partId is the partition that executed when
+ * the interrupt was taken, INT_BENCH_MASK_NO_PART outside of the partition
+ * windows.
+ */
+static inline void __IntBenchMaskTimerHit(const uint32_t partId)
+{
+    volatile int_bench_mask_state_t* state;
+    uint64_t                         now;
+    uint64_t                         delay;
+    uint64_t                         fireTime;
+    uint32_t                         missed;
+    uint32_t                         size;
+    uint8_t*                         cursor;
+
+    now = __IntBenchGetTimestamp();
+
+    state = INT_BENCH_MASK_STATE;
+    if(0 == state->enabled)
+    {
+        return;
+    }
+
+    /* An interrupt raised before the programmed fire time comes from a timer
+     * that reloaded before it was armed again, it is not a fire
+     */
+    fireTime = state->nextFire;
+    if(now < fireTime)
+    {
+        return;
+    }
+    delay = now - fireTime;
+
+    /* Arm the next fire of the schedule, the fires that elapsed while the
+     * interrupt was pending are missed
+     */
+    now    = __IntBenchGetTimestamp();
+    missed = (uint32_t)((now - fireTime) / state->period);
+    state->nextFire = fireTime + ((uint64_t)missed + 1) * state->period;
+    __IntBenchMaskTimerArm(state->nextFire - now);
+
+    state->missed += missed;
+    if(delay > state->maxDelay)
+    {
+        state->maxDelay = delay;
+    }
+
+    size = *(uint32_t*)INT_BENCH_DUMP_MASK_SIZE_ADDR;
+    if(INT_BENCH_DUMP_REG_SIZE - 8 - sizeof(int_bench_mask_state_t) - size >=
+       INT_BENCH_MASK_RECORD_SIZE)
+    {
+        cursor = (uint8_t*)INT_BENCH_DUMP_MASK_CURSOR_ADDR + size;
+        *(uint32_t*)cursor        = partId;
+        *(uint32_t*)(cursor + 4)  = state->core;
+        *(uint32_t*)(cursor + 8)  = state->fires;
+        *(uint32_t*)(cursor + 12) = missed;
+        *(uint64_t*)(cursor + 16) = fireTime;
+        *(uint64_t*)(cursor + 24) = delay;
+        *(uint32_t*)INT_BENCH_DUMP_MASK_SIZE_ADDR =
+            size + INT_BENCH_MASK_RECORD_SIZE;
+    }
+    else
+    {
+        ++state->dropped;
+    }
+
+    ++state->fires;
+}
+
+#endif  /* ifndef __MASK_LATENCY_H__ */
+/* __________________________________________________________________________
+* END OF FILE:
+* -------------
+* ___________________________________________________________________________
+*/
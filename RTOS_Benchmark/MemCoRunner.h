@@ -0,0 +1,247 @@
+/* __________________________________________________________________________
+* MODULE DESCRIPTION:
+* -------------------
+* Filename : MemCoRunner.h
+*
+* Author: Alexy Torres Aurora Dugo
+*
+* Description: This file contains the memory bandwidth co-runner. The
+* co-runner streams over a buffer with read, write or read-modify-write
+* accesses, one 8B access every stride bytes, wrapping at the footprint. It
+* competes with the payloads for the shared L2 and the memory controller
+* while the interrupt generators execute on the other cores.
+*
+* The co-runner is throttled to a target bandwidth (MB/s, 0 for unthrottled):
+* after every chunk of INT_BENCH_MBW_CHUNK accesses, it busy waits on the time
+* base (__IntBenchReadTimebase) until the chunk's share of the target is
+* reached. The bytes moved by an access are the stride, capped to the cache
+* line size, doubled for the read-modify-write accesses (line fill and write
+* back).
+*
+* The co-runner executes in windows, the achieved bandwidth of every window
+* is dumped in the co-runner region.
+*
+* Record format (40B):
+* ID (4B, INT_BENCH_RECORD_ID of the co-runner partition), mode (4B), footprint
+* (4B), stride (4B), target bandwidth (4B, MB/s), window index (4B), bytes
+* moved (8B), window duration (8B, ns).
+* __________________________________________________________________________
+*/
+
+/* __________________________________________________________________________
+* PREPROCESSOR DIRECTIVES:
+* ------------------------
+*/
+#ifndef __MEM_CO_RUNNER_H__
+#define __MEM_CO_RUNNER_H__
+
+#include <stdint.h>
+#include <string.h>
+#include <OSAbstractionLayer.h>
+
+/*******************************************************************************
+ * CONFIGURATION
+ ******************************************************************************/
+
+/* Size of a co-runner record */
+#define INT_BENCH_MBW_RECORD_SIZE (sizeof(uint32_t) * 6 + sizeof(uint64_t) * 2)
+
+/* Cache line size, bytes moved by a read or write access with a stride
+ * larger than a line
+ */
+#ifndef INT_BENCH_MBW_LINE_SIZE
+#define INT_BENCH_MBW_LINE_SIZE 64
+#endif
+
+/* Number of accesses between two throttling points */
+#ifndef INT_BENCH_MBW_CHUNK
+#define INT_BENCH_MBW_CHUNK 64
+#endif
+
+/* Access modes of the co-runner */
+#define INT_BENCH_MBW_READ  0
+#define INT_BENCH_MBW_WRITE 1
+#define INT_BENCH_MBW_RMW   2
+
+/*******************************************************************************
+ * TYPES
+ ******************************************************************************/
+
+/* Co-runner state */
+typedef struct {
+    /* Streamed buffer, 8B aligned */
+    volatile uint8_t* buffer;
+    uint32_t          footprint;
+    uint32_t          stride;
+    uint32_t          mode;
+    /* Target bandwidth (MB/s), 0 for unthrottled */
+    uint32_t          targetMBps;
+    /* Time base ticks of a chunk at the target bandwidth, 16.16 fixed point */
+    uint64_t          chunkTicks;
+    /* Bytes moved by a chunk */
+    uint32_t          chunkBytes;
+    /* Offset of the next access */
+    uint32_t          offset;
+    /* Windows executed */
+    uint32_t          windows;
+    /* Accumulator of the read accesses, keeps them from being optimized */
+    uint64_t          sink;
+} int_bench_mbw_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/* Initializes a co-runner over the first footprint bytes of buffer. The stride
+ * is rounded up to 8B. Returns 0 on success, -1 if the configuration is
+ * invalid.
+ */
+static inline int32_t __IntBenchMbwInit(int_bench_mbw_t* mbw,
+                                        void*            buffer,
+                                        const uint32_t   footprint,
+                                        const uint32_t   stride,
+                                        const uint32_t   mode,
+                                        const uint32_t   targetMBps)
+{
+    uint32_t accessBytes;
+
+    memset(mbw, 0, sizeof(int_bench_mbw_t));
+
+    mbw->stride = (stride + 7) & ~7U;
+    if(NULL == buffer || 0 != ((uintptr_t)buffer & 7) || 0 == mbw->stride ||
+       mbw->stride > footprint || INT_BENCH_MBW_RMW < mode)
+    {
+        return -1;
+    }
+
+    mbw->buffer     = (volatile uint8_t*)buffer;
+    mbw->footprint  = footprint - footprint % mbw->stride;
+    mbw->mode       = mode;
+    mbw->targetMBps = targetMBps;
+
+    accessBytes = mbw->stride < INT_BENCH_MBW_LINE_SIZE ?
+                  mbw->stride : INT_BENCH_MBW_LINE_SIZE;
+    if(INT_BENCH_MBW_RMW == mode)
+    {
+        accessBytes *= 2;
+    }
+    mbw->chunkBytes = accessBytes * INT_BENCH_MBW_CHUNK;
+
+    if(0 != targetMBps)
+    {
+        mbw->chunkTicks = (((uint64_t)mbw->chunkBytes * INT_BENCH_TIMEBASE_HZ)
+                           << 16) / ((uint64_t)targetMBps * 1000000ULL);
+    }
+
+    return 0;
+}
+
+/* Streams one chunk of accesses */
+static inline void __IntBenchMbwChunk(int_bench_mbw_t* mbw)
+{
+    volatile uint64_t* access;
+    uint64_t           sink;
+    uint32_t           offset;
+    uint32_t           i;
+
+    sink   = 0;
+    offset = mbw->offset;
+    for(i = 0; i < INT_BENCH_MBW_CHUNK; ++i)
+    {
+        access = (volatile uint64_t*)(mbw->buffer + offset);
+        switch(mbw->mode)
+        {
+            case INT_BENCH_MBW_READ:
+                sink += *access;
+                break;
+            case INT_BENCH_MBW_WRITE:
+                *access = offset;
+                break;
+            default:
+                *access = *access + 1;
+                break;
+        }
+
+        offset += mbw->stride;
+        if(offset >= mbw->footprint)
+        {
+            offset = 0;
+        }
+    }
+    mbw->offset = offset;
+    mbw->sink  += sink;
+}
+
+/* Dumps the achieved bandwidth of a window in the co-runner region */
+static inline void __IntBenchMbwDump(const uint32_t         recordId,
+                                     const int_bench_mbw_t* mbw,
+                                     const uint64_t         bytes,
+                                     const uint64_t         timeNs)
+{
+    uint32_t* cursor;
+    uint32_t  size;
+
+    size = *(uint32_t*)INT_BENCH_DUMP_MBW_SIZE_ADDR;
+    if(INT_BENCH_DUMP_REG_SIZE - 8 - size < INT_BENCH_MBW_RECORD_SIZE)
+    {
+        return;
+    }
+
+    cursor = (uint32_t*)(INT_BENCH_DUMP_MBW_CURSOR_ADDR + size);
+    cursor[0] = recordId;
+    cursor[1] = mbw->mode;
+    cursor[2] = mbw->footprint;
+    cursor[3] = mbw->stride;
+    cursor[4] = mbw->targetMBps;
+    cursor[5] = mbw->windows;
+    *(uint64_t*)(cursor + 6) = bytes;
+    *(uint64_t*)(cursor + 8) = timeNs;
+    *(uint32_t*)INT_BENCH_DUMP_MBW_SIZE_ADDR = size + INT_BENCH_MBW_RECORD_SIZE;
+}
+
+/* Executes a co-runner window of windowNs ns and dumps its achieved
+ * bandwidth. The window can be longer when the partition is preempted, the
+ * dumped duration is the actual one.
+ */
+static inline void __IntBenchMbwWindow(int_bench_mbw_t* mbw,
+                                       const uint32_t   recordId,
+                                       const uint64_t   windowNs)
+{
+    uint64_t windowTicks;
+    uint64_t deadline;
+    uint64_t start;
+    uint64_t elapsed;
+    uint64_t bytes;
+
+    windowTicks = windowNs * INT_BENCH_TIMEBASE_HZ / 1000000000ULL;
+    deadline    = 0;
+    bytes       = 0;
+
+    start = __IntBenchReadTimebase();
+    do
+    {
+        __IntBenchMbwChunk(mbw);
+        bytes += mbw->chunkBytes;
+
+        elapsed = __IntBenchReadTimebase() - start;
+        if(0 != mbw->targetMBps)
+        {
+            deadline += mbw->chunkTicks;
+            while((elapsed << 16) < deadline && elapsed < windowTicks)
+            {
+                elapsed = __IntBenchReadTimebase() - start;
+            }
+        }
+    } while(elapsed < windowTicks);
+
+    __IntBenchMbwDump(recordId, mbw, bytes,
+                      elapsed * 1000000000ULL / INT_BENCH_TIMEBASE_HZ);
+    ++mbw->windows;
+}
+
+#endif  /* ifndef __MEM_CO_RUNNER_H__ */
+/* __________________________________________________________________________
+* END OF FILE:
+* -------------
+* ___________________________________________________________________________
+*/
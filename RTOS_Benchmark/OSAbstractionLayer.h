@@ -17,29 +17,207 @@
 #ifndef __OS_ABSTRACTION_LAYER_H__
 #define __OS_ABSTRACTION_LAYER_H__
 
+#include <stddef.h>
 #include <stdint.h>
 
 /******************************************************************************
  * CONFIGURATION
  ******************************************************************************/
 
+#ifdef INT_BENCH_LINUX_BACKEND
+/* The Linux host backend (see the Host folder) overrides part of the
+ * configuration.
+ */
+#include <LinuxBackendConfig.h>
+#endif
+
+/* Large page mapping mode. When INT_BENCH_LARGE_PAGES is defined, the shared
+ * memory window and the payload buffers (__IntBenchAllocLargePages) are backed
+ * by large pages so the framework does not add to the TLB pressure it
+ * measures. On the e6500, the window is mapped by a single TLB1 variable size
+ * entry: the shared memory base must be aligned on INT_BENCH_LARGE_PAGE_SIZE
+ * and the window (see MEMORY LAYOUT) must fit in the page. The window is
+ * larger than 16MB, the next TLB1 page size is 64MB.
+ */
+/* #define INT_BENCH_LARGE_PAGES */
+#ifndef INT_BENCH_LARGE_PAGE_SIZE
+#define INT_BENCH_LARGE_PAGE_SIZE 0x4000000
+#endif
+
 /* AMP partitions shared memory base address, must be updated according to the
  * project's configuration.
  */
+#ifndef INT_BENCH_SHARED_MEM_BASE
+#ifdef INT_BENCH_LARGE_PAGES
+#define INT_BENCH_SHARED_MEM_BASE 0x70000000
+#else
 #define INT_BENCH_SHARED_MEM_BASE 0x70001000
+#endif
+#endif
 
 /* The ready mask that tells which partitions to wait during synchronization */
+#ifndef INT_BENCH_RDYMASK_VAL
 #define INT_BENCH_RDYMASK_VAL 0x00020002000203FFULL
+#endif
 
-/* Number of samples taken before ending the sampling */
+/* Number of samples taken before ending the sampling. With adaptive stopping,
+ * this is the maximal number of samples.
+ */
+#ifndef INT_BENCH_SAMPLE_COUNT
 #define INT_BENCH_SAMPLE_COUNT 10000
+#endif
+
+/* Number of partitions taking payload samples, the PART region must hold
+ * INT_BENCH_SAMPLE_COUNT samples of each of them
+ */
+#ifndef INT_BENCH_PAYLOAD_PARTITIONS
+#define INT_BENCH_PAYLOAD_PARTITIONS 10
+#endif
+
+/* Adaptive stopping (see AdaptiveStop.h). The benchmarks given a stopping
+ * state stop sampling once the confidence interval of the statistic is within
+ * tolerance:
+ * INT_BENCH_STOP_MEAN: the mean execution time.
+ * INT_BENCH_STOP_QUANTILE: the INT_BENCH_STOP_QUANTILE_VAL quantile of the
+ * execution time.
+ * INT_BENCH_STOP_TOLERANCE is the maximal half-width of the interval relative
+ * to the estimate, INT_BENCH_STOP_Z the normal quantile of the confidence level
+ * (1.96: 95%). The interval is checked every INT_BENCH_STOP_CHECK_PERIOD
+ * samples after INT_BENCH_STOP_MIN_SAMPLES samples.
+ */
+#define INT_BENCH_STOP_MEAN     1
+#define INT_BENCH_STOP_QUANTILE 2
+#ifndef INT_BENCH_STOP_MODE
+#define INT_BENCH_STOP_MODE INT_BENCH_STOP_MEAN
+#endif
+#ifndef INT_BENCH_STOP_QUANTILE_VAL
+#define INT_BENCH_STOP_QUANTILE_VAL 0.99
+#endif
+#ifndef INT_BENCH_STOP_TOLERANCE
+#define INT_BENCH_STOP_TOLERANCE 0.02
+#endif
+#ifndef INT_BENCH_STOP_Z
+#define INT_BENCH_STOP_Z 1.96
+#endif
+#ifndef INT_BENCH_STOP_MIN_SAMPLES
+#define INT_BENCH_STOP_MIN_SAMPLES 500
+#endif
+#ifndef INT_BENCH_STOP_CHECK_PERIOD
+#define INT_BENCH_STOP_CHECK_PERIOD 50
+#endif
+
+/* Flight recorder (see FlightRecorder.h). The benchmarks given a flight
+ * recorder state keep their last INT_BENCH_FLIGHT_DEPTH detailed records in a
+ * per-core circular buffer. When a sample exceeds its threshold, the buffer
+ * and the INT_BENCH_FLIGHT_POST following records of the core are committed
+ * to the flight dump region. The learned threshold is INT_BENCH_FLIGHT_MARGIN
+ * times the running INT_BENCH_FLIGHT_QUANTILE quantile, it is used after
+ * INT_BENCH_FLIGHT_WARMUP samples. A summary of the execution times is
+ * committed every INT_BENCH_FLIGHT_SUMMARY_PERIOD samples.
+ */
+#ifndef INT_BENCH_FLIGHT_DEPTH
+#define INT_BENCH_FLIGHT_DEPTH 16
+#endif
+#ifndef INT_BENCH_FLIGHT_POST
+#define INT_BENCH_FLIGHT_POST 4
+#endif
+#ifndef INT_BENCH_FLIGHT_QUANTILE
+#define INT_BENCH_FLIGHT_QUANTILE 0.99
+#endif
+#ifndef INT_BENCH_FLIGHT_MARGIN
+#define INT_BENCH_FLIGHT_MARGIN 1.5
+#endif
+#ifndef INT_BENCH_FLIGHT_WARMUP
+#define INT_BENCH_FLIGHT_WARMUP 1000
+#endif
+#ifndef INT_BENCH_FLIGHT_SUMMARY_PERIOD
+#define INT_BENCH_FLIGHT_SUMMARY_PERIOD 100000
+#endif
+
+/* Maximal number of payload sections timed per sample (see SectionTiming.h) */
+#ifndef INT_BENCH_SECTION_COUNT
+#define INT_BENCH_SECTION_COUNT 4
+#endif
+
+/* Frequency (Hz) of the OS scheduler tick requested at initialization (see
+ * TickInterference.h), 0 keeps the frequency of the OS. The frequency the OS
+ * applied is recorded in the dump header.
+ */
+#ifndef INT_BENCH_TICK_HZ
+#define INT_BENCH_TICK_HZ 0
+#endif
+
+/* Scenario and mitigation recorded in the campaign manifest of the dumps (see
+ * CampaignManifest.h): the names of the dataset folders the dump goes to.
+ */
+#ifndef INT_BENCH_SCENARIO
+#define INT_BENCH_SCENARIO ""
+#endif
+#ifndef INT_BENCH_MITIGATION
+#define INT_BENCH_MITIGATION ""
+#endif
+
+/* PMCs of the payload measurements (also used by the sections and the SMT
+ * sibling mode) and of the interrupt handler measurements (generators and
+ * sweep), and the events they count. The partition switch and tick benchmarks
+ * have their own PMCs. The counter schema of the campaign manifest is derived
+ * from these values.
+ */
+#define INT_BENCH_PAYLOAD_PMC_L2  1
+#define INT_BENCH_PAYLOAD_PMC_TLB 2
+#define INT_BENCH_HANDLER_PMC_L2  3
+#define INT_BENCH_HANDLER_PMC_TLB 4
+#define INT_BENCH_PMC_EVENT_L2    E6500_PMC_EVENT_THREAD_L2_MISS
+#define INT_BENCH_PMC_EVENT_TLB   E6500_PMC_EVENT_L2MMU_MISS
+
+/* Period (ns) of the external timer of the interrupt masking window benchmark
+ * (see MaskLatency.h). It is not a multiple of the usual MAF and tick periods
+ * so the fire times sweep the partition windows.
+ */
+#ifndef INT_BENCH_MASK_PERIOD
+#define INT_BENCH_MASK_PERIOD 997000
+#endif
 
 /* Size of the dumb region for every interrupt types */
 #define INT_BENCH_DUMP_REG_SIZE 0x200000
 
+/* Encoding of the PART, SC, IntINT, ExtINT and IPI records (see
+ * RecordEncoding.h):
+ * INT_BENCH_DUMP_ENC_RAW: fixed size records.
+ * INT_BENCH_DUMP_ENC_DELTA: delta and varint encoded records, a sync point is
+ * written every INT_BENCH_DUMP_ENC_SYNC_PERIOD records of a region.
+ * The encoded regions have their own magic values.
+ */
+#define INT_BENCH_DUMP_ENC_RAW   0
+#define INT_BENCH_DUMP_ENC_DELTA 1
+#ifndef INT_BENCH_DUMP_ENCODING
+#define INT_BENCH_DUMP_ENCODING INT_BENCH_DUMP_ENC_RAW
+#endif
+#ifndef INT_BENCH_DUMP_ENC_SYNC_PERIOD
+#define INT_BENCH_DUMP_ENC_SYNC_PERIOD 64
+#endif
+
 /* Magic value put at the begining of the extraction region (8B) */
 #define INT_BENCH_DUMP_REG_HEADER_MAGIC_VAL "INTBDUMP"
 
+/* Byte order mark put after the magic value (4B), written with the native
+ * endianness so the extraction script can detect the dump byte order.
+ */
+#define INT_BENCH_DUMP_REG_HEADER_BOM_VAL 0x01020304
+
+#if INT_BENCH_DUMP_ENCODING == INT_BENCH_DUMP_ENC_DELTA
+
+/* Magic values of the encoded part, sc, internal int, external int and ipi
+ * dump regions (4B)
+ */
+#define INT_BENCH_DUMP_PART_HEADER_MAGIC_VAL   "PRTZ"
+#define INT_BENCH_DUMP_SC_HEADER_MAGIC_VAL     "SCZ "
+#define INT_BENCH_DUMP_INTINT_HEADER_MAGIC_VAL "IINZ"
+#define INT_BENCH_DUMP_EXTINT_HEADER_MAGIC_VAL "EINZ"
+#define INT_BENCH_DUMP_IPI_HEADER_MAGIC_VAL    "IPIZ"
+
+#else
+
 /* Magic value put at the begining of the part dump region (4B) */
 #define INT_BENCH_DUMP_PART_HEADER_MAGIC_VAL "PART"
 
@@ -55,9 +233,170 @@
 /* Magic value put at the begining of the ipi dump region (4B) */
 #define INT_BENCH_DUMP_IPI_HEADER_MAGIC_VAL "IPI "
 
+#endif
+
+/* Magic value put at the begining of the sweep dump region (4B) */
+#define INT_BENCH_DUMP_SWEEP_HEADER_MAGIC_VAL "SWEP"
+
+/* Magic value put at the begining of the flight recorder dump region (4B) */
+#define INT_BENCH_DUMP_FLIGHT_HEADER_MAGIC_VAL "FLGT"
+
+/* Magic value put at the begining of the interrupt count dump region (4B) */
+#define INT_BENCH_DUMP_INTCOUNT_HEADER_MAGIC_VAL "PINT"
+
+/* Magic value put at the begining of the partition switch dump region (4B) */
+#define INT_BENCH_DUMP_PSW_HEADER_MAGIC_VAL "PSW "
+
+/* Magic value put at the begining of the trace replay dump region (4B) */
+#define INT_BENCH_DUMP_REPLAY_HEADER_MAGIC_VAL "RPLY"
+
+/* Magic value put at the begining of the async injection dump region (4B) */
+#define INT_BENCH_DUMP_ASYNC_HEADER_MAGIC_VAL "ASYN"
+
+/* Magic value put at the begining of the section dump region (4B) */
+#define INT_BENCH_DUMP_SECTION_HEADER_MAGIC_VAL "SECT"
+
+/* Magic value put at the begining of the memory co-runner dump region (4B) */
+#define INT_BENCH_DUMP_MBW_HEADER_MAGIC_VAL "MBW "
+
+/* Magic value put at the begining of the SMT sibling dump region (4B) */
+#define INT_BENCH_DUMP_SMT_HEADER_MAGIC_VAL "SMT "
+
+/* Magic value put at the begining of the OS tick dump region (4B) */
+#define INT_BENCH_DUMP_TICK_HEADER_MAGIC_VAL "TICK"
+
+/* Magic value put at the begining of the campaign manifest region (4B) */
+#define INT_BENCH_DUMP_MANIFEST_HEADER_MAGIC_VAL "MNFT"
+
+/* Magic value put at the begining of the interrupt masking dump region (4B) */
+#define INT_BENCH_DUMP_MASK_HEADER_MAGIC_VAL "MASK"
+
+/* Benchmark types, used in the IDs of the records that are not stored in the
+ * region of their type (INT_BENCH_RECORD_ID)
+ */
+#define INT_BENCH_TYPE_PART   0
+#define INT_BENCH_TYPE_SC     1
+#define INT_BENCH_TYPE_INTINT 2
+#define INT_BENCH_TYPE_EXTINT 3
+#define INT_BENCH_TYPE_IPI    4
+
+/* Number of interrupt types counted by the interrupt occurrence counters
+ * (INT_BENCH_TYPE_SC to INT_BENCH_TYPE_IPI)
+ */
+#define INT_BENCH_INT_COUNTER_TYPES 4
+
 /* Defines the interrupt vector used by the external interrupt. */
 #define INT_BENCH_EXTERNAL_INT_VECTOR 80
 
+/* Defines the interrupt vector used by the periodic external timer of the
+ * interrupt masking window benchmark (see MaskLatency.h).
+ */
+#define INT_BENCH_MASK_TIMER_VECTOR 81
+
+/* Time base frequency, used to arm the asynchronous internal interrupt
+ * (decrementer). On the T2080, the time base is the platform clock divided by
+ * 16.
+ */
+#ifndef INT_BENCH_TIMEBASE_HZ
+#define INT_BENCH_TIMEBASE_HZ 37496250
+#endif
+
+/* Platform topology: number of cores and number of hardware threads per core.
+ * The benchmarks address the destination of the IPIs and external interrupts
+ * by core ID, the interrupt is routed to the first thread of the core. A given
+ * thread is addressed with INT_BENCH_DST_THREAD (SMT sibling mode, see
+ * SmtSibling.h).
+ */
+#ifndef INT_BENCH_CORE_COUNT
+#define INT_BENCH_CORE_COUNT 4
+#endif
+#ifndef INT_BENCH_THREADS_PER_CORE
+#define INT_BENCH_THREADS_PER_CORE 2
+#endif
+
+/* Interrupt routing encoding of a hardware thread.
+ * INT_BENCH_TOPO_PIR_TAG: doorbell (msgsnd) PIR tag, on the e6500 the thread
+ * ID is stored in the 3 lower bits of the PIR.
+ * INT_BENCH_TOPO_MPIC_DST: MPIC destination register mask, one bit per
+ * hardware thread.
+ */
+#ifndef INT_BENCH_TOPO_PIR_TAG
+#define INT_BENCH_TOPO_PIR_TAG(CORE, THREAD) (((CORE) << 3) | (THREAD))
+#endif
+#ifndef INT_BENCH_TOPO_MPIC_DST
+#define INT_BENCH_TOPO_MPIC_DST(CORE, THREAD) \
+    (1U << ((CORE) * INT_BENCH_THREADS_PER_CORE + (THREAD)))
+#endif
+
+/* Destination of an IPI or external interrupt routed to a given hardware
+ * thread. A plain core ID is the destination of the first thread of the core.
+ */
+#define INT_BENCH_DST_THREAD(CORE, THREAD) ((CORE) | ((THREAD) << 8))
+#define INT_BENCH_DST_CORE(DST)            ((DST) & 0xFF)
+#define INT_BENCH_DST_THR(DST)             (((DST) >> 8) & 0xFF)
+
+/* Sibling hardware thread of a thread on its core */
+#define INT_BENCH_SIBLING_THREAD(THREAD)                                       \
+    (((THREAD) + 1) % INT_BENCH_THREADS_PER_CORE)
+
+/* Cores that can be the destination of an interrupt during a sweep */
+#ifndef INT_BENCH_SWEEP_CORE_MASK
+#define INT_BENCH_SWEEP_CORE_MASK ((1U << INT_BENCH_CORE_COUNT) - 1)
+#endif
+
+/* Number of samples taken for each (destination, type) combination of a
+ * sweep.
+ */
+#ifndef INT_BENCH_SWEEP_SAMPLE_COUNT
+#define INT_BENCH_SWEEP_SAMPLE_COUNT 1000
+#endif
+
+/* Trace replay (see TraceReplay.h): delay between the initialization of the
+ * first replay generator and the time origin of the trace (ns), it lets every
+ * generator initialize before the first event.
+ */
+#ifndef INT_BENCH_REPLAY_LEAD
+#define INT_BENCH_REPLAY_LEAD 10000000
+#endif
+
+/* Deferred interrupt delivery (see InterruptDefer.h), benchmarked as an
+ * interrupt mitigation. The external interrupts and IPIs that hit the window
+ * of a protected partition are only acknowledged and queued, they are
+ * delivered in a batch:
+ * INT_BENCH_DEFER_NONE: no deferral, the interrupts are delivered immediately.
+ * INT_BENCH_DEFER_BOUNDARY: at the end of the window (partition boundary).
+ * INT_BENCH_DEFER_SERVICE: by the INT_BENCH_DEFER_SERVICE_CORE core, notified
+ * by the first interrupt of a batch, or at the end of the window.
+ * The protected partitions are given by INT_BENCH_DEFER_PROTECTED_MASK with
+ * the ready mask layout, the partitions of core 0 by default.
+ */
+#define INT_BENCH_DEFER_NONE     0
+#define INT_BENCH_DEFER_BOUNDARY 1
+#define INT_BENCH_DEFER_SERVICE  2
+#ifndef INT_BENCH_DEFER_MODE
+#define INT_BENCH_DEFER_MODE INT_BENCH_DEFER_NONE
+#endif
+#ifndef INT_BENCH_DEFER_PROTECTED_MASK
+#define INT_BENCH_DEFER_PROTECTED_MASK (INT_BENCH_RDYMASK_VAL & 0xFFFFULL)
+#endif
+#ifndef INT_BENCH_DEFER_SERVICE_CORE
+#define INT_BENCH_DEFER_SERVICE_CORE (INT_BENCH_CORE_COUNT - 1)
+#endif
+
+/* L2 cache geometry and page size used by the page coloring allocator
+ * (CacheColoring.h). A color is a group of pages mapping to the same L2 sets,
+ * the T2080 L2 (2MB, 16 ways) with 4KB pages has 32 colors.
+ */
+#ifndef INT_BENCH_L2_SIZE
+#define INT_BENCH_L2_SIZE 0x200000
+#endif
+#ifndef INT_BENCH_L2_WAYS
+#define INT_BENCH_L2_WAYS 16
+#endif
+#ifndef INT_BENCH_PAGE_SIZE
+#define INT_BENCH_PAGE_SIZE 0x1000
+#endif
+
 /*******************************************************************************
  * CONFIGURATION END
  ******************************************************************************/
@@ -66,18 +405,47 @@
  * MEMORY LAYOUT
  ******************************************************************************/
 /* NOTE: Here the base is configured to be 0x70001000, but can be changed in
- * the configuration.
+ * the configuration (0x70000000 in the large page mapping mode).
  * Regions marked as FREE can be used for future data storage.
  *
  * #------------#---------------------------------------#
  * | 0x70001000 | READY MASK POINTER (8B)               |
  * | 0x70001008 | READY MASK LOCK (4B)                  |
- * | 0x7000100B | FREE                                  |
+ * | 0x7000100C | INTERRUPT WAIT FLAG (4B)              |
+ * | 0x70001010 | SWEEP LOCK (4B)                       |
+ * | 0x70001014 | STOPPING POINTS LOCK (4B)             |
+ * | 0x70001018 | FLIGHT RECORDER LOCK (4B)             |
+ * | 0x7000101C | PARTITION SWITCH LOCK (4B)            |
+ * | 0x70001020 | INTERRUPT COUNTERS (4 x 4B per core)  |
+ * |     ...    | INTERRUPT COUNTERS (4 x 4B per core)  |
+ * |     ...    | PARTITION SWITCH STATES (24B per core)|
+ * |     ...    | TRACE REPLAY TIME ORIGIN (8B)         |
+ * |     ...    | FREE                                  |
+ * |     ...    | FREE                                  |
+ * | 0x70001100 | FLIGHT RECORDER BUFFERS (1 per core)  |
+ * |     ...    | FLIGHT RECORDER BUFFERS (1 per core)  |
+ * | 0x70001E00 | DEFERRED INT STATES (16B per core)    |
+ * |     ...    | FREE                                  |
+ * | 0x70001E80 | OS TICK LOCK (4B)                     |
+ * | 0x70001E88 | OS TICK STATES (24B per core)         |
+ * |     ...    | FREE                                  |
+ * | 0x70001F00 | SMT SIBLING MAILBOXES (16B per thread)|
  * |     ...    | FREE                                  |
  * #------------#---------------------------------------#
  * | 0x70002000 | MAGIC NUMBER                          | <- Extraction start
- * | 0x70002008 | FREE                                  |
- * |     ...    | FREE                                  |
+ * | 0x70002008 | BYTE ORDER MARK (4B)                  |
+ * | 0x7000200C | FRAMEWORK TRANSLATIONS (4B)           |
+ * | 0x70002010 | FRAMEWORK LARGEST PAGE SIZE (4B)      |
+ * | 0x70002014 | STOPPING MODE (4B)                    |
+ * | 0x70002018 | STOPPING POINTS COUNT (4B)            |
+ * | 0x7000201C | STOPPING POINTS (19 x 12B)            |
+ * |     ...    | STOPPING POINTS (19 x 12B)            |
+ * | 0x700020E8 | FLIGHT RECORDS DROPPED (4B)           |
+ * | 0x700020EC | INTERRUPT DELIVERY MODE (4B)          |
+ * | 0x700020F0 | OS TICK FREQUENCY (4B)                |
+ * | 0x700020F4 | CAMPAIGN MANIFEST VERSION (4B)        |
+ * | 0x700020F8 | RECORDS DROPPED (4B)                  |
+ * | 0x700020FC | REPLAY EVENTS WITHOUT GENERATOR (4B)  |
  * #------------#---------------------------------------#
  * | 0x70002100 | PART DUMP MAGIC (4B)                  |
  * | 0x70002104 | PART DUMP REGION SIZE (4B)            |
@@ -104,7 +472,68 @@
  * | 0x70802108 | IPI DUMP MEMORY REGION (2M - 8B)      |
  * |     ...    | IPI DUMP MEMORY REGION (2M - 8B)      |
  * #------------#---------------------------------------#
- * | 0x70A02100 | END                                   | <- Extraction end
+ * | 0x70A02100 | SWEEP DUMP MAGIC (4B)                 |
+ * | 0x70A02104 | SWEEP DUMP REGION SIZE (4B)           |
+ * | 0x70A02108 | SWEEP DUMP MEMORY REGION (2M - 8B)    |
+ * |     ...    | SWEEP DUMP MEMORY REGION (2M - 8B)    |
+ * #------------#---------------------------------------#
+ * | 0x70C02100 | FLIGHT DUMP MAGIC (4B)                |
+ * | 0x70C02104 | FLIGHT DUMP REGION SIZE (4B)          |
+ * | 0x70C02108 | FLIGHT DUMP MEMORY REGION (2M - 8B)   |
+ * |     ...    | FLIGHT DUMP MEMORY REGION (2M - 8B)   |
+ * #------------#---------------------------------------#
+ * | 0x70E02100 | INTCOUNT DUMP MAGIC (4B)              |
+ * | 0x70E02104 | INTCOUNT DUMP REGION SIZE (4B)        |
+ * | 0x70E02108 | INTCOUNT DUMP MEMORY REGION (2M - 8B) |
+ * |     ...    | INTCOUNT DUMP MEMORY REGION (2M - 8B) |
+ * #------------#---------------------------------------#
+ * | 0x71002100 | PSW DUMP MAGIC (4B)                   |
+ * | 0x71002104 | PSW DUMP REGION SIZE (4B)             |
+ * | 0x71002108 | PSW DUMP MEMORY REGION (2M - 8B)      |
+ * |     ...    | PSW DUMP MEMORY REGION (2M - 8B)      |
+ * #------------#---------------------------------------#
+ * | 0x71202100 | REPLAY DUMP MAGIC (4B)                |
+ * | 0x71202104 | REPLAY DUMP REGION SIZE (4B)          |
+ * | 0x71202108 | REPLAY DUMP MEMORY REGION (2M - 8B)   |
+ * |     ...    | REPLAY DUMP MEMORY REGION (2M - 8B)   |
+ * #------------#---------------------------------------#
+ * | 0x71402100 | ASYNC DUMP MAGIC (4B)                 |
+ * | 0x71402104 | ASYNC DUMP REGION SIZE (4B)           |
+ * | 0x71402108 | ASYNC DUMP MEMORY REGION (2M - 8B)    |
+ * |     ...    | ASYNC DUMP MEMORY REGION (2M - 8B)    |
+ * #------------#---------------------------------------#
+ * | 0x71602100 | SECTION DUMP MAGIC (4B)               |
+ * | 0x71602104 | SECTION DUMP REGION SIZE (4B)         |
+ * | 0x71602108 | SECTION DUMP MEMORY REGION (2M - 8B)  |
+ * |     ...    | SECTION DUMP MEMORY REGION (2M - 8B)  |
+ * #------------#---------------------------------------#
+ * | 0x71802100 | MBW DUMP MAGIC (4B)                   |
+ * | 0x71802104 | MBW DUMP REGION SIZE (4B)             |
+ * | 0x71802108 | MBW DUMP MEMORY REGION (2M - 8B)      |
+ * |     ...    | MBW DUMP MEMORY REGION (2M - 8B)      |
+ * #------------#---------------------------------------#
+ * | 0x71A02100 | SMT DUMP MAGIC (4B)                   |
+ * | 0x71A02104 | SMT DUMP REGION SIZE (4B)             |
+ * | 0x71A02108 | SMT DUMP MEMORY REGION (2M - 8B)      |
+ * |     ...    | SMT DUMP MEMORY REGION (2M - 8B)      |
+ * #------------#---------------------------------------#
+ * | 0x71C02100 | TICK DUMP MAGIC (4B)                  |
+ * | 0x71C02104 | TICK DUMP REGION SIZE (4B)            |
+ * | 0x71C02108 | TICK DUMP MEMORY REGION (2M - 8B)     |
+ * |     ...    | TICK DUMP MEMORY REGION (2M - 8B)     |
+ * #------------#---------------------------------------#
+ * | 0x71E02100 | MANIFEST MAGIC (4B)                   |
+ * | 0x71E02104 | MANIFEST SIZE (4B)                    |
+ * | 0x71E02108 | CAMPAIGN MANIFEST (216B)              |
+ * |     ...    | FREE                                  |
+ * #------------#---------------------------------------#
+ * | 0x72002100 | MASK DUMP MAGIC (4B)                  |
+ * | 0x72002104 | MASK DUMP REGION SIZE (4B)            |
+ * | 0x72002108 | MASK DUMP MEMORY REGION (2M - 48B)    |
+ * |     ...    | MASK DUMP MEMORY REGION (2M - 48B)    |
+ * | 0x722020D8 | MASK BENCHMARK STATE (40B)            |
+ * #------------#---------------------------------------#
+ * | 0x72202100 | END                                   | <- Extraction end
  * #------------#---------------------------------------#
  *
  * NOTE: This memory region is retreived with a probe (T32 Probe) and dumped as
@@ -119,13 +548,84 @@
  * bits[48-63] partitions 0 to 15 on core 3
  */
 #define INT_BENCH_RDYMASK_PTR  ((volatile uint64_t*)INT_BENCH_SHARED_MEM_BASE)
-#define INT_BENCH_RDYMASK_LOCK ((volatile uint32_t*)(INT_BENCH_SHARED_MEM_BASE + 8))
+#define INT_BENCH_RDYMASK_LOCK ((volatile int32_t*)(INT_BENCH_SHARED_MEM_BASE + 8))
 #define INT_BENCH_INT_WAIT_PTR ((volatile uint32_t*)(INT_BENCH_SHARED_MEM_BASE + 12))
+#define INT_BENCH_SWEEP_LOCK   ((volatile int32_t*)(INT_BENCH_SHARED_MEM_BASE + 16))
+#define INT_BENCH_STOP_LOCK    ((volatile int32_t*)(INT_BENCH_SHARED_MEM_BASE + 20))
+#define INT_BENCH_FLIGHT_LOCK  ((volatile int32_t*)(INT_BENCH_SHARED_MEM_BASE + 24))
+#define INT_BENCH_PSW_LOCK     ((volatile int32_t*)(INT_BENCH_SHARED_MEM_BASE + 28))
+
+/* Interrupt occurrence counters: one counter per core and interrupt type */
+#define INT_BENCH_INT_COUNTERS_ADDR (INT_BENCH_SHARED_MEM_BASE + 0x20)
+#define INT_BENCH_INT_COUNTER_PTR(CORE, TYPE)                                  \
+    ((volatile uint32_t*)INT_BENCH_INT_COUNTERS_ADDR +                         \
+     (CORE) * INT_BENCH_INT_COUNTER_TYPES + ((TYPE) - INT_BENCH_TYPE_SC))
+
+/* Partition switch states (see PartitionSwitch.h): one 24B state per core */
+#define INT_BENCH_PSW_STATE_SIZE 24
+#define INT_BENCH_PSW_STATES_ADDR                                              \
+    (INT_BENCH_INT_COUNTERS_ADDR +                                             \
+     INT_BENCH_CORE_COUNT * INT_BENCH_INT_COUNTER_TYPES * 4)
+
+/* Time origin of the replayed trace (see TraceReplay.h) */
+#define INT_BENCH_REPLAY_ORIGIN_PTR                                            \
+    ((volatile uint64_t*)(INT_BENCH_PSW_STATES_ADDR +                          \
+                          INT_BENCH_CORE_COUNT * INT_BENCH_PSW_STATE_SIZE))
+
+#if INT_BENCH_CORE_COUNT * (INT_BENCH_INT_COUNTER_TYPES * 4 +                  \
+                            INT_BENCH_PSW_STATE_SIZE) + 8 > 0xE0
+#error "The interrupt counters, partition switch states and replay origin do not fit before the flight recorder buffers"
+#endif
+
+#define INT_BENCH_FLIGHT_RINGS_ADDR     (INT_BENCH_SHARED_MEM_BASE + 0x100)
+#define INT_BENCH_FLIGHT_RINGS_MAX_SIZE 0xD00
+
+/* Deferred interrupt delivery states (see InterruptDefer.h): one 16B state
+ * per core
+ */
+#define INT_BENCH_DEFER_STATE_SIZE  16
+#define INT_BENCH_DEFER_STATES_ADDR (INT_BENCH_SHARED_MEM_BASE + 0xE00)
+
+#if INT_BENCH_CORE_COUNT * INT_BENCH_DEFER_STATE_SIZE > 0x80
+#error "The deferred interrupt states do not fit before the OS tick states"
+#endif
+
+/* OS tick lock and states (see TickInterference.h): one 24B state per core */
+#define INT_BENCH_TICK_LOCK        ((volatile int32_t*)(INT_BENCH_SHARED_MEM_BASE + 0xE80))
+#define INT_BENCH_TICK_STATE_SIZE  24
+#define INT_BENCH_TICK_STATES_ADDR (INT_BENCH_SHARED_MEM_BASE + 0xE88)
+
+#if INT_BENCH_CORE_COUNT * INT_BENCH_TICK_STATE_SIZE > 0x78
+#error "The OS tick states do not fit before the SMT sibling mailboxes"
+#endif
+
+/* SMT sibling mailboxes (see SmtSibling.h): one 16B mailbox per hardware
+ * thread
+ */
+#define INT_BENCH_SMT_MAILBOX_SIZE   16
+#define INT_BENCH_SMT_MAILBOXES_ADDR (INT_BENCH_SHARED_MEM_BASE + 0xF00)
+
+#if INT_BENCH_CORE_COUNT * INT_BENCH_THREADS_PER_CORE *                        \
+    INT_BENCH_SMT_MAILBOX_SIZE > 0x100
+#error "The SMT sibling mailboxes do not fit before the dump header"
+#endif
 
 #define INT_BENCH_DUMP_REG_HEADER_ADDR      (INT_BENCH_SHARED_MEM_BASE + 0x1000)
 #define INT_BENCH_DUMP_REG_ADDR             (INT_BENCH_SHARED_MEM_BASE + 0x1100)
 
 #define INT_BENCH_DUMP_REG_HEADER_MAGIC     INT_BENCH_DUMP_REG_HEADER_ADDR
+#define INT_BENCH_DUMP_REG_HEADER_BOM       (INT_BENCH_DUMP_REG_HEADER_ADDR + 8)
+#define INT_BENCH_DUMP_REG_HEADER_TLB_COUNT (INT_BENCH_DUMP_REG_HEADER_ADDR + 12)
+#define INT_BENCH_DUMP_REG_HEADER_TLB_PAGE  (INT_BENCH_DUMP_REG_HEADER_ADDR + 16)
+#define INT_BENCH_DUMP_REG_HEADER_STOP_MODE (INT_BENCH_DUMP_REG_HEADER_ADDR + 20)
+#define INT_BENCH_DUMP_REG_HEADER_STOP_CNT  (INT_BENCH_DUMP_REG_HEADER_ADDR + 24)
+#define INT_BENCH_DUMP_REG_HEADER_STOP_ADDR (INT_BENCH_DUMP_REG_HEADER_ADDR + 28)
+#define INT_BENCH_DUMP_REG_HEADER_FLT_DROP  (INT_BENCH_DUMP_REG_HEADER_ADDR + 0xE8)
+#define INT_BENCH_DUMP_REG_HEADER_DEFER     (INT_BENCH_DUMP_REG_HEADER_ADDR + 0xEC)
+#define INT_BENCH_DUMP_REG_HEADER_TICK_HZ   (INT_BENCH_DUMP_REG_HEADER_ADDR + 0xF0)
+#define INT_BENCH_DUMP_REG_HEADER_MANIFEST  (INT_BENCH_DUMP_REG_HEADER_ADDR + 0xF4)
+#define INT_BENCH_DUMP_REG_HEADER_DROP      (INT_BENCH_DUMP_REG_HEADER_ADDR + 0xF8)
+#define INT_BENCH_DUMP_REG_HEADER_RPLY_SKIP (INT_BENCH_DUMP_REG_HEADER_ADDR + 0xFC)
 
 #define INT_BENCH_DUMP_PART_MAGIC_ADDR      (INT_BENCH_DUMP_REG_ADDR)
 #define INT_BENCH_DUMP_PART_SIZE_ADDR       (INT_BENCH_DUMP_REG_ADDR + 4)
@@ -152,6 +652,71 @@
 #define INT_BENCH_DUMP_IPI_CURSOR_ADDR      (INT_BENCH_DUMP_IPI_SIZE_ADDR + 4)
 #define INT_BENCH_DUMP_IPI_CURSOR_PTR       (INT_BENCH_DUMP_IPI_CURSOR_ADDR + *(uint32_t*)INT_BENCH_DUMP_IPI_SIZE_ADDR)
 
+#define INT_BENCH_DUMP_SWEEP_MAGIC_ADDR     (INT_BENCH_DUMP_REG_ADDR + INT_BENCH_DUMP_REG_SIZE * 5)
+#define INT_BENCH_DUMP_SWEEP_SIZE_ADDR      (INT_BENCH_DUMP_SWEEP_MAGIC_ADDR + 4)
+#define INT_BENCH_DUMP_SWEEP_CURSOR_ADDR    (INT_BENCH_DUMP_SWEEP_SIZE_ADDR + 4)
+#define INT_BENCH_DUMP_SWEEP_CURSOR_PTR     (INT_BENCH_DUMP_SWEEP_CURSOR_ADDR + *(uint32_t*)INT_BENCH_DUMP_SWEEP_SIZE_ADDR)
+
+#define INT_BENCH_DUMP_FLIGHT_MAGIC_ADDR    (INT_BENCH_DUMP_REG_ADDR + INT_BENCH_DUMP_REG_SIZE * 6)
+#define INT_BENCH_DUMP_FLIGHT_SIZE_ADDR     (INT_BENCH_DUMP_FLIGHT_MAGIC_ADDR + 4)
+#define INT_BENCH_DUMP_FLIGHT_CURSOR_ADDR   (INT_BENCH_DUMP_FLIGHT_SIZE_ADDR + 4)
+
+#define INT_BENCH_DUMP_INTCOUNT_MAGIC_ADDR  (INT_BENCH_DUMP_REG_ADDR + INT_BENCH_DUMP_REG_SIZE * 7)
+#define INT_BENCH_DUMP_INTCOUNT_SIZE_ADDR   (INT_BENCH_DUMP_INTCOUNT_MAGIC_ADDR + 4)
+#define INT_BENCH_DUMP_INTCOUNT_CURSOR_ADDR (INT_BENCH_DUMP_INTCOUNT_SIZE_ADDR + 4)
+
+#define INT_BENCH_DUMP_PSW_MAGIC_ADDR       (INT_BENCH_DUMP_REG_ADDR + INT_BENCH_DUMP_REG_SIZE * 8)
+#define INT_BENCH_DUMP_PSW_SIZE_ADDR        (INT_BENCH_DUMP_PSW_MAGIC_ADDR + 4)
+#define INT_BENCH_DUMP_PSW_CURSOR_ADDR      (INT_BENCH_DUMP_PSW_SIZE_ADDR + 4)
+#define INT_BENCH_DUMP_PSW_CURSOR_PTR       (INT_BENCH_DUMP_PSW_CURSOR_ADDR + *(uint32_t*)INT_BENCH_DUMP_PSW_SIZE_ADDR)
+
+#define INT_BENCH_DUMP_REPLAY_MAGIC_ADDR    (INT_BENCH_DUMP_REG_ADDR + INT_BENCH_DUMP_REG_SIZE * 9)
+#define INT_BENCH_DUMP_REPLAY_SIZE_ADDR     (INT_BENCH_DUMP_REPLAY_MAGIC_ADDR + 4)
+#define INT_BENCH_DUMP_REPLAY_CURSOR_ADDR   (INT_BENCH_DUMP_REPLAY_SIZE_ADDR + 4)
+#define INT_BENCH_DUMP_REPLAY_CURSOR_PTR    (INT_BENCH_DUMP_REPLAY_CURSOR_ADDR + *(uint32_t*)INT_BENCH_DUMP_REPLAY_SIZE_ADDR)
+
+#define INT_BENCH_DUMP_ASYNC_MAGIC_ADDR     (INT_BENCH_DUMP_REG_ADDR + INT_BENCH_DUMP_REG_SIZE * 10)
+#define INT_BENCH_DUMP_ASYNC_SIZE_ADDR      (INT_BENCH_DUMP_ASYNC_MAGIC_ADDR + 4)
+#define INT_BENCH_DUMP_ASYNC_CURSOR_ADDR    (INT_BENCH_DUMP_ASYNC_SIZE_ADDR + 4)
+
+#define INT_BENCH_DUMP_SECTION_MAGIC_ADDR   (INT_BENCH_DUMP_REG_ADDR + INT_BENCH_DUMP_REG_SIZE * 11)
+#define INT_BENCH_DUMP_SECTION_SIZE_ADDR    (INT_BENCH_DUMP_SECTION_MAGIC_ADDR + 4)
+#define INT_BENCH_DUMP_SECTION_CURSOR_ADDR  (INT_BENCH_DUMP_SECTION_SIZE_ADDR + 4)
+
+#define INT_BENCH_DUMP_MBW_MAGIC_ADDR       (INT_BENCH_DUMP_REG_ADDR + INT_BENCH_DUMP_REG_SIZE * 12)
+#define INT_BENCH_DUMP_MBW_SIZE_ADDR        (INT_BENCH_DUMP_MBW_MAGIC_ADDR + 4)
+#define INT_BENCH_DUMP_MBW_CURSOR_ADDR      (INT_BENCH_DUMP_MBW_SIZE_ADDR + 4)
+
+#define INT_BENCH_DUMP_SMT_MAGIC_ADDR       (INT_BENCH_DUMP_REG_ADDR + INT_BENCH_DUMP_REG_SIZE * 13)
+#define INT_BENCH_DUMP_SMT_SIZE_ADDR        (INT_BENCH_DUMP_SMT_MAGIC_ADDR + 4)
+#define INT_BENCH_DUMP_SMT_CURSOR_ADDR      (INT_BENCH_DUMP_SMT_SIZE_ADDR + 4)
+
+#define INT_BENCH_DUMP_TICK_MAGIC_ADDR      (INT_BENCH_DUMP_REG_ADDR + INT_BENCH_DUMP_REG_SIZE * 14)
+#define INT_BENCH_DUMP_TICK_SIZE_ADDR       (INT_BENCH_DUMP_TICK_MAGIC_ADDR + 4)
+#define INT_BENCH_DUMP_TICK_CURSOR_ADDR     (INT_BENCH_DUMP_TICK_SIZE_ADDR + 4)
+
+#define INT_BENCH_DUMP_MANIFEST_MAGIC_ADDR  (INT_BENCH_DUMP_REG_ADDR + INT_BENCH_DUMP_REG_SIZE * 15)
+#define INT_BENCH_DUMP_MANIFEST_SIZE_ADDR   (INT_BENCH_DUMP_MANIFEST_MAGIC_ADDR + 4)
+#define INT_BENCH_DUMP_MANIFEST_CURSOR_ADDR (INT_BENCH_DUMP_MANIFEST_SIZE_ADDR + 4)
+
+#define INT_BENCH_DUMP_MASK_MAGIC_ADDR      (INT_BENCH_DUMP_REG_ADDR + INT_BENCH_DUMP_REG_SIZE * 16)
+#define INT_BENCH_DUMP_MASK_SIZE_ADDR       (INT_BENCH_DUMP_MASK_MAGIC_ADDR + 4)
+#define INT_BENCH_DUMP_MASK_CURSOR_ADDR     (INT_BENCH_DUMP_MASK_SIZE_ADDR + 4)
+
+/* Number of dump regions */
+#define INT_BENCH_DUMP_REG_COUNT 17
+
+#define INT_BENCH_DUMP_REG_END_ADDR         (INT_BENCH_DUMP_REG_ADDR + INT_BENCH_DUMP_REG_SIZE * INT_BENCH_DUMP_REG_COUNT)
+
+/* Size of the whole shared memory window */
+#define INT_BENCH_SHARED_MEM_SIZE (INT_BENCH_DUMP_REG_END_ADDR - INT_BENCH_SHARED_MEM_BASE)
+
+#if defined(INT_BENCH_LARGE_PAGES) &&                                          \
+    0x1100 + INT_BENCH_DUMP_REG_SIZE * INT_BENCH_DUMP_REG_COUNT >              \
+    INT_BENCH_LARGE_PAGE_SIZE && !defined(INT_BENCH_LINUX_BACKEND)
+#error "The shared memory window does not fit in a large page"
+#endif
+
 /*******************************************************************************
  * MEMORY LAYOUT END
  ******************************************************************************/
@@ -177,6 +742,68 @@ extern void __LockRelease(volatile int32_t * lock);
  */
 extern void __IntBenchGenerateSyscall(void);
 
+/* Returns the physical address of a virtual address of the calling partition.
+ * This is used by the page coloring allocator.
+ */
+extern uintptr_t __IntBenchVirtToPhys(const void* addr);
+
+/* Requests the OS to place the data used by the interrupt handlers (stacks,
+ * handler variables) in pages of the given colors (see CacheColoring.h).
+ */
+extern void __IntBenchSetHandlerColors(const uint32_t colorMask);
+
+/* Allocates a payload buffer backed by large pages (see INT_BENCH_LARGE_PAGES),
+ * or by ordinary pages when the large page mapping mode is disabled. Returns
+ * NULL if the buffer cannot be allocated. Large pages span every
+ * color: the buffers are not meant to be used as page coloring pools.
+ */
+extern void* __IntBenchAllocLargePages(const size_t size);
+
+/* Returns the number of translations (TLB entries) used by the framework
+ * itself to map the shared memory window and the large page payload buffers.
+ * The size of the largest page used is returned in pageSize.
+ */
+extern uint32_t __IntBenchFrameworkTranslations(uint32_t* pageSize);
+
+/* Returns the current time in nanoseconds, on the time base of GET_TIME. It
+ * must be callable from the OS scheduler (partition switch hooks, see
+ * PartitionSwitch.h).
+ */
+extern uint64_t __IntBenchGetTimestamp(void);
+
+/* Returns the interrupt arrival trace to replay (see TraceReplay.h for the
+ * format), loaded in memory by the OS or with the probe. The size of the trace
+ * is returned in size. Returns NULL if no trace is loaded.
+ */
+extern const void* __IntBenchGetReplayTrace(uint32_t* size);
+
+/* Waits until the calling hardware thread takes an interrupt, returns after
+ * its handler. This is used by the SMT sibling agent (see SmtSibling.h) to
+ * idle between the interrupts steered to the sibling thread.
+ */
+extern void __IntBenchWaitInt(void);
+
+/* Requests the OS to drive its scheduler tick at the given frequency (Hz), 0
+ * keeps the current frequency. Returns the frequency the tick is driven at:
+ * the current one when the RTOS cannot change it, 0 for a tickless scheduler.
+ * The OS tick handler calls the tick hooks (see TickInterference.h).
+ */
+extern uint32_t __IntBenchSetTickFrequency(const uint32_t hz);
+
+/* Copies the identifier of the board and the revision of the firmware (RTOS,
+ * BSP and benchmarks build) in the given buffers, at most boardSize and
+ * firmwareSize characters. They are recorded in the campaign manifest (see
+ * CampaignManifest.h).
+ */
+extern void __IntBenchGetBoardInfo(char* boardId, const uint32_t boardSize,
+                                   char* firmwareHash,
+                                   const uint32_t firmwareSize);
+
+/* Returns the wall clock date in seconds since the epoch (UTC), 0 when the
+ * board has no real time clock.
+ */
+extern uint64_t __IntBenchGetWallClock(void);
+
 /*******************************************************************************
  * API REQUIREMENTS END
  ******************************************************************************/
@@ -189,6 +816,37 @@ extern void __IntBenchGenerateSyscall(void);
  * files to get our implementation of those function in the RTOS.
  ******************************************************************************/
 
+/* Interrupt occurrence hook: the OS interrupt handlers must call it with the
+ * core handling the interrupt and the interrupt type (INT_BENCH_TYPE_SC for
+ * the probing system call, INT_BENCH_TYPE_INTINT, INT_BENCH_TYPE_EXTINT or
+ * INT_BENCH_TYPE_IPI). The payload samples record how many interrupts of each
+ * type hit their core during the measurement.
+ */
+static inline void __IntBenchCountInt(const uint32_t core, const uint32_t type)
+{
+    ++*INT_BENCH_INT_COUNTER_PTR(core, type);
+}
+
+#ifdef INT_BENCH_LINUX_BACKEND
+
+/* The Linux host backend provides its own implementation of the API */
+#include <LinuxBackend.h>
+
+#else
+
+/* Busy waits for a given number of loop iterations. This is used by the
+ * generator partitions to space the generated interrupts.
+ */
+static void __IntBenchSpin(const uint32_t loops)
+{
+    __asm__ __volatile__("mr 3, %0\n\t"
+                         "1:\n\t"
+                         "addi 3, 3, -1\n\t"
+                         "cmpwi 3, 0\n\t"
+                         "bne 1b\n\t"
+                         :: "r" (loops) : "3", "cr0");
+}
+
 /* Generate an internal interrupt. FIT interrupt on the e6500, the interrupt
  * should happen instantly. Our measurement shown that the interrupt takes no
  * more than 0.19us.
@@ -213,23 +871,91 @@ static void __IntBenchGenerateInternalInt(void)
                          ::: "3", "4");
 }
 
+/* Reads the time base (a handful of instructions), the frequency is
+ * INT_BENCH_TIMEBASE_HZ. This is used by the payload section markers (see
+ * SectionTiming.h).
+ */
+static inline uint64_t __IntBenchReadTimebase(void)
+{
+    uint32_t upper;
+    uint32_t lower;
+    uint32_t check;
+
+    do
+    {
+        __asm__ __volatile__("mftbu %0\n\t"
+                             "mftb %1\n\t"
+                             "mftbu %2\n\t"
+                             : "=r" (upper), "=r" (lower), "=r" (check));
+    } while(upper != check);
+
+    return ((uint64_t)upper << 32) | lower;
+}
+
+/* Arms an asynchronous internal interrupt: the decrementer interrupt fires on
+ * the calling core after delay ns, the function returns immediately. This is
+ * used to interrupt the payload at a given offset (see AsyncInject.h).
+ *
+ * @Warning The OS is responsible of handling the decrementer interrupt: it
+ * acknowledges it (TSR[DIS]), disables it (TCR[DIE]) and counts it as an
+ * internal interrupt (__IntBenchCountInt) without releasing the interrupt
+ * wait flag.
+ */
+static void __IntBenchArmAsyncInt(const uint32_t delay)
+{
+    uint32_t ticks;
+
+    ticks = (uint32_t)(((uint64_t)delay * INT_BENCH_TIMEBASE_HZ) /
+                       1000000000ULL);
+    if(0 == ticks)
+    {
+        ticks = 1;
+    }
+
+    /* One-shot: TCR[ARE] cleared, TCR[DIE] set */
+    __asm__ __volatile__("mtspr 22, %0\n\t"
+                         "mfspr 3, 340\n\t"
+                         "rlwinm 3, 3, 0, 10, 8\n\t"
+                         "oris 3, 3, 0x0400\n\t"
+                         "mtspr 340, 3\n\t"
+                         :: "r" (ticks) : "3");
+}
+
+/* Disarms the asynchronous internal interrupt if it did not fire */
+static void __IntBenchDisarmAsyncInt(void)
+{
+    /* TCR[DIE] cleared, decrementer stopped and TSR[DIS] cleared */
+    __asm__ __volatile__("mfspr 3, 340\n\t"
+                         "rlwinm 3, 3, 0, 6, 4\n\t"
+                         "mtspr 340, 3\n\t"
+                         "li 3, 0\n\t"
+                         "mtspr 22, 3\n\t"
+                         "lis 3, 0x0800\n\t"
+                         "mtspr 336, 3\n\t"
+                         ::: "3");
+}
+
 /* Generate an IPI. On the e6500, the IPI is generated by a doorbell.
  * This function enters an infinite loop until the interrupt occur. The
  * interrupt handler is responsible of changing the interrupt return IP value to
- * jump over the infinite loop.  */
+ * jump over the infinite loop. coreId is a core ID or an INT_BENCH_DST_THREAD
+ * destination. */
 static void __IntBenchGenerateIPI(uint32_t coreId)
 {
-    /* On T2080 to get the Core ID we must multiply by two (because each core
-     * has two threads).
+    uint32_t pirTag;
+
+    /* The doorbell is addressed to the first thread of the core unless a
+     * thread is given
      */
-    coreId = coreId << 3;
+    pirTag = INT_BENCH_TOPO_PIR_TAG(INT_BENCH_DST_CORE(coreId),
+                                    INT_BENCH_DST_THR(coreId));
     __asm__ __volatile__("__IntBenchGenIPI:\n\t"
                          "mr 3, %0\n\t"
                          "msgsnd 3\n\t"
                          "__IntBenchGenIPI_END:\n\t"
                          "b __IntBenchGenIPI_END\n\t"
-                         : "=r" (coreId)
-                         :: "3");
+                         :: "r" (pirTag)
+                         : "3");
 
 }
 
@@ -289,9 +1015,10 @@ void __IntBenchGenerateExternalInt(const uint32_t coreId)
     MPICReg  = (uint32_t *)BSP_MPIC_TFRRB_ADDR;
     *MPICReg = MPIC_CLOCK_FREQUENCY_HZ;
 
-    /* Set interrupt to be sent to desired core */
+    /* Set interrupt to be sent to desired core (or thread) */
     MPICReg  = (uint32_t *)BSP_MPIC_GTDRB_ADDR;
-    *MPICReg = (uint32_t)(1 << (coreId * 2));
+    *MPICReg = INT_BENCH_TOPO_MPIC_DST(INT_BENCH_DST_CORE(coreId),
+                                       INT_BENCH_DST_THR(coreId));
 
     /* Wait to be able to change the values */
     MPICReg  =  (uint32_t *)BSP_MPIC_GTVPRB_ADDR;
@@ -308,6 +1035,113 @@ void __IntBenchGenerateExternalInt(const uint32_t coreId)
     while(1 == *(volatile uint32_t*)INT_BENCH_INT_WAIT_PTR){}
 }
 
+/* External timer of the interrupt masking window benchmark (see
+ * MaskLatency.h): global timer B1 on the T2080, its input clock is the MPIC
+ * clock divided by 8 (TCRB[CLKR], shared with the timer B0). The timer counts
+ * down from its base count, it fires and reloads when the count reaches 0.
+ * The hook programs the base count of every fire (__IntBenchMaskTimerArm), a
+ * reload only fires when the hook is late, it is then ignored.
+ *
+ * @Warning The OS is responsible of handling the interrupt: its handler calls
+ * __IntBenchMaskTimerHit first, counts an external interrupt
+ * (__IntBenchCountInt) and acknowledges it (EOI) without releasing the
+ * interrupt wait flag.
+ */
+
+#define BSP_MPIC_GTCCRB1_ADDR  (BSP_MPIC_GLBL_REG_ADDR + 0x2140)
+#define BSP_MPIC_GTBCRB1_ADDR  (BSP_MPIC_GLBL_REG_ADDR + 0x2150)
+#define BSP_MPIC_GTVPRB1_ADDR  (BSP_MPIC_GLBL_REG_ADDR + 0x2160)
+#define BSP_MPIC_GTDRB1_ADDR   (BSP_MPIC_GLBL_REG_ADDR + 0x2170)
+
+#define MPIC_GTCCR_COUNT_MASK 0x7FFFFFFF
+
+#define MPIC_TIMER_FREQUENCY_HZ (MPIC_CLOCK_FREQUENCY_HZ / 8)
+
+/* Starts the external timer on a core (or thread), the first fire happens one
+ * period after the call. Returns the applied period in ns, 0 if the period
+ * cannot be programmed.
+ */
+static uint32_t __IntBenchMaskTimerStart(const uint32_t coreId,
+                                         const uint32_t period)
+{
+    volatile uint32_t * MPICReg;
+    uint64_t            ticks;
+
+    ticks = (uint64_t)period * MPIC_TIMER_FREQUENCY_HZ / 1000000000ULL;
+    if(0 == ticks || MPIC_GTCCR_COUNT_MASK < ticks)
+    {
+        return 0;
+    }
+
+    /* Make sure the timer count is disabled */
+    MPICReg  = (uint32_t *)BSP_MPIC_GTBCRB1_ADDR;
+    *MPICReg = MPIC_GTBCR_CI;
+
+    /* Set 8 clock ratio based on CCB */
+    MPICReg  = (uint32_t *)BSP_MPIC_TCRB_ADDR;
+    *MPICReg &= ~(uint32_t)MPIC_TCR_ROVR_MASK & ~(uint32_t)MPIC_TCR_RTM_MASK &
+               ~(uint32_t)MPIC_TCR_CLKR_MASK & ~(uint32_t)MPIC_TCR_CASC_MASK;
+    *MPICReg |= MPIC_TCR_RTM_CCB | MPIC_TCR_CLKR_8;
+
+    /* Set interrupt to be sent to desired core (or thread) */
+    MPICReg  = (uint32_t *)BSP_MPIC_GTDRB1_ADDR;
+    *MPICReg = INT_BENCH_TOPO_MPIC_DST(INT_BENCH_DST_CORE(coreId),
+                                       INT_BENCH_DST_THR(coreId));
+
+    /* Wait to be able to change the values */
+    MPICReg  =  (uint32_t *)BSP_MPIC_GTVPRB1_ADDR;
+    while(0 != (*MPICReg & MPIC_GTVPR_A));
+
+    /* Set priority and vector, unmask interrupt */
+    *MPICReg  &= ~(uint32_t)MPIC_GTVPR_PRIO_MASK &
+                 ~(uint32_t)MPIC_GTVPR_VECTOR_MASK & ~(uint32_t)MPIC_GTVPR_MSK;
+    *MPICReg |= MPIC_GTVPR_PRIO_15 | INT_BENCH_MASK_TIMER_VECTOR;
+
+    /* Enable count with the period as base count */
+    MPICReg  = (uint32_t *)BSP_MPIC_GTBCRB1_ADDR;
+    *MPICReg = (uint32_t)ticks;
+
+    return (uint32_t)(ticks * 1000000000ULL / MPIC_TIMER_FREQUENCY_HZ);
+}
+
+/* Stops the external timer */
+static void __IntBenchMaskTimerStop(void)
+{
+    volatile uint32_t * MPICReg;
+
+    MPICReg  = (uint32_t *)BSP_MPIC_GTBCRB1_ADDR;
+    *MPICReg |= MPIC_GTBCR_CI;
+
+    MPICReg  = (uint32_t *)BSP_MPIC_GTVPRB1_ADDR;
+    *MPICReg |= MPIC_GTVPR_MSK;
+}
+
+/* Arms the next fire of the external timer delay ns after the call. Called by
+ * the OS handler: the count is inhibited and restarted from the delay, rounded
+ * up to the timer clock so the timer does not fire before the programmed time.
+ */
+static inline void __IntBenchMaskTimerArm(const uint64_t delay)
+{
+    volatile uint32_t * MPICReg;
+    uint64_t            ticks;
+
+    ticks = (delay * MPIC_TIMER_FREQUENCY_HZ + 999999999ULL) / 1000000000ULL;
+    if(0 == ticks)
+    {
+        ticks = 1;
+    }
+    else if(MPIC_GTCCR_COUNT_MASK < ticks)
+    {
+        ticks = MPIC_GTCCR_COUNT_MASK;
+    }
+
+    MPICReg  = (uint32_t *)BSP_MPIC_GTBCRB1_ADDR;
+    *MPICReg = MPIC_GTBCR_CI | (uint32_t)ticks;
+    *MPICReg = (uint32_t)ticks;
+}
+
+#endif /* INT_BENCH_LINUX_BACKEND */
+
 #endif  /* ifndef _OS_ABSTRACTION_LAYER_H_ */
 /* __________________________________________________________________________
 * END OF FILE:
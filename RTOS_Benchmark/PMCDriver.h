@@ -18,15 +18,22 @@
 #ifndef __PMC_DRIVER_H__
 #define __PMC_DRIVER_H__
 
+#ifdef INT_BENCH_LINUX_BACKEND
+
+/* The Linux host backend (see the Host folder) provides its own driver */
+#include <LinuxPMCDriver.h>
+
+#else
+
 
 #define stringify(s) tostring(s)
 #define tostring(s) #s
 
-#define mfpmr(rn) {                                             \
+#define mfpmr(rn) ({                                            \
     uint32_t rval;                                              \
     __asm__ volatile("mfpmr %0," stringify(rn) : "=r" (rval));  \
     rval;                                                       \
-}
+})
 
 #define mtpmr(rn, v) __asm__ volatile("mtpmr " stringify(rn) ",%0" : : "r" (v))
 
@@ -433,6 +440,34 @@ ERROR_CODE_E __PMCDrvDisable(const uint32_t pmcID)
     return retCode;
 }
 
+/* Compile-time accessors: the PMC id must be a constant expression. The PMR
+ * ids are encoded in the instructions, the accesses are straight-line
+ * mtpmr/mfpmr sequences instead of the switches of __PMCDrvReadPMR and
+ * __PMCDrvWritePMR. The counters are enabled for every privilege level
+ * without interrupt, as used by the benchmarks.
+ */
+#define __PMC_DRV_MFPMR(PMR, PVALUE)                                           \
+    __asm__ volatile("mfpmr %0,%1" : "=r" (*(PVALUE)) : "i" (PMR))
+#define __PMC_DRV_MTPMR(PMR, VALUE)                                            \
+    __asm__ volatile("mtpmr %0,%1" : : "i" (PMR), "r" ((uint32_t)(VALUE)))
+
+#define __PMC_DRV_READ(ID, PVALUE)  __PMC_DRV_MFPMR(PMR_PMC + (ID), PVALUE)
+#define __PMC_DRV_WRITE(ID, VALUE)  __PMC_DRV_MTPMR(PMR_PMC + (ID), VALUE)
+#define __PMC_DRV_DISABLE(ID)                                                  \
+    __PMC_DRV_MTPMR(PMR_PMLCA + (ID), PMR_PMLCAX_FC)
+#define __PMC_DRV_ENABLE(ID, EVENT) {                                          \
+    uint32_t pmgc0_;                                                           \
+    __PMC_DRV_MTPMR(PMR_PMLCA + (ID),                                          \
+                    PMR_PMLCaX_EVENT_MASK &                                    \
+                    ((uint32_t)(EVENT) << PMR_PMLCaX_EVENT_SHIFT));            \
+    __PMC_DRV_MTPMR(PMR_PMLCB + (ID), 0);                                      \
+    __PMC_DRV_MFPMR(PMR_PMGC0, &pmgc0_);                                       \
+    __PMC_DRV_MTPMR(PMR_PMGC0, (pmgc0_ & ~PMR_PMGC0_FAC) |                     \
+                               PMR_PMGC0_PMIE | PMR_PMGC0_FCECE);              \
+}
+
+#endif /* INT_BENCH_LINUX_BACKEND */
+
 #endif /* __PMC_DRIVER_H__ */
 
 /* __________________________________________________________________________
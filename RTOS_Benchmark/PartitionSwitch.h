@@ -0,0 +1,169 @@
+/* __________________________________________________________________________
+* MODULE DESCRIPTION:
+* -------------------
+* Filename : PartitionSwitch.h
+*
+* Author: Alexy Torres Aurora Dugo
+*
+* Description: This file contains the partition switch benchmark. The OS
+* scheduler calls __IntBenchPartitionSwitchOut after the last instruction of
+* the outgoing partition and __IntBenchPartitionSwitchIn before the first
+* instruction of the incoming one. The switch time and the L2 and TLB misses
+* across the switch (context save and restore, mitigations such as cache
+* flushes on switch) are dumped in the partition switch region.
+*
+* The switches of a core are only measured once a partition of the core
+* started the benchmark (INT_BENCH_PSW_START), INT_BENCH_SAMPLE_COUNT switches
+* are measured per core. The PMCs 3 and 4 are used, the payload measurements
+* use the PMCs 1 and 2 and can span a switch.
+* __________________________________________________________________________
+*/
+
+/* __________________________________________________________________________
+* PREPROCESSOR DIRECTIVES:
+* ------------------------
+*/
+#ifndef __PARTITION_SWITCH_H__
+#define __PARTITION_SWITCH_H__
+
+#include <stdint.h>
+#include <string.h>
+#include <ARINC653.h>
+#include <OSAbstractionLayer.h>
+#include <PMCDriver.h>
+
+/*******************************************************************************
+ * CONFIGURATION
+ ******************************************************************************/
+
+/* PMCs used to measure the switches */
+#define INT_BENCH_PSW_PMC_L2  3
+#define INT_BENCH_PSW_PMC_TLB 4
+
+/* Size of a partition switch record: ID, switch time, L2 and TLB misses */
+#define INT_BENCH_PSW_RECORD_SIZE \
+    (sizeof(uint32_t) * 3 + sizeof(SYSTEM_TIME_TYPE))
+
+/*******************************************************************************
+ * TYPES
+ ******************************************************************************/
+
+/* Partition switch state of a core (INT_BENCH_PSW_STATE_SIZE bytes) */
+typedef struct {
+    /* Time the outgoing partition was left */
+    uint64_t outTime;
+    /* Outgoing partition */
+    uint32_t outPart;
+    /* Set between the two hooks of a switch */
+    uint32_t pending;
+    /* Set when the switches of the core are measured */
+    uint32_t enabled;
+    /* Number of switches measured */
+    uint32_t count;
+} int_bench_psw_state_t;
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* Partition switch record ID: bits[16-23] core, bits[8-15] outgoing
+ * partition, bits[0-7] incoming partition
+ */
+#define INT_BENCH_PSW_ID(CORE, FROM, TO)                                       \
+    ((((uint32_t)(CORE) & 0xFF) << 16) | (((uint32_t)(FROM) & 0xFF) << 8) |    \
+     ((uint32_t)(TO) & 0xFF))
+
+/* Partition switch state of a core */
+#define INT_BENCH_PSW_STATE(CORE)                                              \
+    ((volatile int_bench_psw_state_t*)INT_BENCH_PSW_STATES_ADDR + (CORE))
+
+/* Starts measuring the partition switches of a core. Called by a partition of
+ * the core after INT_BENCH_INIT.
+ */
+#define INT_BENCH_PSW_START(CORE) {                                            \
+    INT_BENCH_PSW_STATE(CORE)->count   = 0;                                    \
+    INT_BENCH_PSW_STATE(CORE)->pending = 0;                                    \
+    INT_BENCH_PSW_STATE(CORE)->enabled = 1;                                    \
+}
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/* OS hook: called by the scheduler of a core when it leaves a partition,
+ * after the last instruction of the partition.
+ */
+static inline void __IntBenchPartitionSwitchOut(const uint32_t core,
+                                                const uint32_t partId)
+{
+    volatile int_bench_psw_state_t* state;
+
+    state = INT_BENCH_PSW_STATE(core);
+    if(0 == state->enabled || INT_BENCH_SAMPLE_COUNT <= state->count)
+    {
+        return;
+    }
+
+    __PMC_DRV_WRITE(INT_BENCH_PSW_PMC_L2, 0);
+    __PMC_DRV_WRITE(INT_BENCH_PSW_PMC_TLB, 0);
+    __PMC_DRV_ENABLE(INT_BENCH_PSW_PMC_L2, INT_BENCH_PMC_EVENT_L2);
+    __PMC_DRV_ENABLE(INT_BENCH_PSW_PMC_TLB, INT_BENCH_PMC_EVENT_TLB);
+
+    state->outPart = partId;
+    state->pending = 1;
+    state->outTime = __IntBenchGetTimestamp();
+}
+
+/* OS hook: called by the scheduler of a core when it enters a partition,
+ * before the first instruction of the partition. The switch is dumped if the
+ * core left a partition since the last call.
+ */
+static inline void __IntBenchPartitionSwitchIn(const uint32_t core,
+                                               const uint32_t partId)
+{
+    volatile int_bench_psw_state_t* state;
+    uint64_t                        inTime;
+    uint32_t                        l2Miss;
+    uint32_t                        tlbMiss;
+    uint32_t                        size;
+    uint8_t*                        cursor;
+
+    inTime = __IntBenchGetTimestamp();
+
+    state = INT_BENCH_PSW_STATE(core);
+    if(0 == state->pending)
+    {
+        return;
+    }
+    state->pending = 0;
+
+    __PMC_DRV_DISABLE(INT_BENCH_PSW_PMC_L2);
+    __PMC_DRV_DISABLE(INT_BENCH_PSW_PMC_TLB);
+    __PMC_DRV_READ(INT_BENCH_PSW_PMC_L2, &l2Miss);
+    __PMC_DRV_READ(INT_BENCH_PSW_PMC_TLB, &tlbMiss);
+
+    /* Every core dumps its switches in the same region */
+    while(0 != __TestAndSet(INT_BENCH_PSW_LOCK));
+    size = *(uint32_t*)INT_BENCH_DUMP_PSW_SIZE_ADDR;
+    if(INT_BENCH_DUMP_REG_SIZE - 8 - size >= INT_BENCH_PSW_RECORD_SIZE)
+    {
+        cursor = (uint8_t*)INT_BENCH_DUMP_PSW_CURSOR_ADDR + size;
+        *(uint32_t*)cursor = INT_BENCH_PSW_ID(core, state->outPart, partId);
+        *(SYSTEM_TIME_TYPE*)(cursor + 4) =
+            (SYSTEM_TIME_TYPE)(inTime - state->outTime);
+        *(uint32_t*)(cursor + 12) = l2Miss;
+        *(uint32_t*)(cursor + 16) = tlbMiss;
+        *(uint32_t*)INT_BENCH_DUMP_PSW_SIZE_ADDR =
+            size + INT_BENCH_PSW_RECORD_SIZE;
+    }
+    __LockRelease(INT_BENCH_PSW_LOCK);
+
+    ++state->count;
+}
+
+#endif  /* ifndef __PARTITION_SWITCH_H__ */
+/* __________________________________________________________________________
+* END OF FILE:
+* -------------
+* ___________________________________________________________________________
+*/
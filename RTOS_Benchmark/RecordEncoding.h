@@ -0,0 +1,168 @@
+/* __________________________________________________________________________
+* MODULE DESCRIPTION:
+* -------------------
+* Filename : RecordEncoding.h
+*
+* Author: Alexy Torres Aurora Dugo
+*
+* Description: This file contains the delta and varint encoding of the dump
+* records (INT_BENCH_DUMP_ENCODING == INT_BENCH_DUMP_ENC_DELTA). The fixed size
+* records waste most of their bytes: the IDs are small, the execution times of
+* a benchmark vary in a narrow band and the counters are small. The encoded
+* records store every field as a varint (7 bits per byte, the high bit is set
+* on all the bytes but the last one) and the execution time as the zig-zag
+* encoded delta to the previous execution time of the same ID.
+*
+* Encoded record:
+* varint(((ID + 1) << 1) | absolute), varint(zig-zag(time or delta)),
+* varint(L2 misses), varint(TLB misses).
+*
+* The time bases are kept per slot (ID modulo INT_BENCH_DUMP_ENC_SLOTS). Every
+* INT_BENCH_DUMP_ENC_SYNC_PERIOD records, a sync point is written (the
+* INT_BENCH_ENC_SYNC_MARKER byte followed by varint(record index)) and the time
+* bases are reset: the first record of each slot after a sync point has an
+* absolute time. The encoded records never start with the marker byte, the
+* extractor checks the record index of every sync point.
+*
+* The encoder state of a region is stored in the last bytes of the region,
+* records that do not fit anymore are dropped and counted in the state.
+* __________________________________________________________________________
+*/
+
+/* __________________________________________________________________________
+* PREPROCESSOR DIRECTIVES:
+* ------------------------
+*/
+#ifndef __RECORD_ENCODING_H__
+#define __RECORD_ENCODING_H__
+
+#include <stdint.h>
+#include <string.h>
+#include <OSAbstractionLayer.h>
+
+/*******************************************************************************
+ * CONFIGURATION
+ ******************************************************************************/
+
+/* Number of time base slots of a region */
+#define INT_BENCH_DUMP_ENC_SLOTS 16
+
+/* First byte of a sync point */
+#define INT_BENCH_ENC_SYNC_MARKER 0x00
+
+/* Maximal size of an encoded record and of its sync point: 1 + 5 bytes of
+ * sync point, 5 bytes of ID, 10 bytes of time and 5 bytes per counter
+ */
+#define INT_BENCH_ENC_MAX_RECORD_SIZE (21 + 5 * 2)
+
+/* Encoder state of a region, stored at the end of the region */
+#define INT_BENCH_ENC_STATE_PTR(MAGIC_ADDR)                                    \
+    ((int_bench_enc_state_t*)((MAGIC_ADDR) + INT_BENCH_DUMP_REG_SIZE -         \
+                              sizeof(int_bench_enc_state_t)))
+
+/*******************************************************************************
+ * TYPES
+ ******************************************************************************/
+
+/* Encoder state of a region */
+typedef struct {
+    /* Records encoded and dropped */
+    uint32_t records;
+    uint32_t dropped;
+    /* Slots with a time base since the last sync point */
+    uint32_t validSlots;
+    uint32_t reserved;
+    int64_t  base[INT_BENCH_DUMP_ENC_SLOTS];
+} int_bench_enc_state_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/* Writes a varint, returns the cursor after it */
+static inline uint8_t* __IntBenchEncVarint(uint8_t* cursor, uint64_t value)
+{
+    while(0x80 <= value)
+    {
+        *cursor++ = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    *cursor++ = (uint8_t)value;
+
+    return cursor;
+}
+
+/* Maps the signed values to unsigned ones, small magnitudes first */
+static inline uint64_t __IntBenchEncZigZag(const int64_t value)
+{
+    return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+/* Resets the encoder state of a region, the region must be empty */
+static inline void __IntBenchEncReset(const uintptr_t magicAddr)
+{
+    memset(INT_BENCH_ENC_STATE_PTR(magicAddr), 0,
+           sizeof(int_bench_enc_state_t));
+}
+
+/* Encodes a record at the end of the region starting at magicAddr */
+static inline void __IntBenchEncDump(const uintptr_t magicAddr,
+                                     const uint32_t  id,
+                                     const int64_t   time,
+                                     const uint32_t  l2Miss,
+                                     const uint32_t  tlbMiss)
+{
+    int_bench_enc_state_t* state;
+    uint32_t*              sizePtr;
+    uint8_t*               start;
+    uint8_t*               cursor;
+    uint32_t               slot;
+
+    state   = INT_BENCH_ENC_STATE_PTR(magicAddr);
+    sizePtr = (uint32_t*)(magicAddr + 4);
+    if(INT_BENCH_DUMP_REG_SIZE - 8 - sizeof(int_bench_enc_state_t) - *sizePtr <
+       INT_BENCH_ENC_MAX_RECORD_SIZE)
+    {
+        ++state->dropped;
+        return;
+    }
+
+    start  = (uint8_t*)(magicAddr + 8 + *sizePtr);
+    cursor = start;
+
+    if(0 == state->records % INT_BENCH_DUMP_ENC_SYNC_PERIOD)
+    {
+        *cursor++ = INT_BENCH_ENC_SYNC_MARKER;
+        cursor = __IntBenchEncVarint(cursor, state->records);
+        state->validSlots = 0;
+    }
+
+    slot = id % INT_BENCH_DUMP_ENC_SLOTS;
+    if(0 != (state->validSlots & (1U << slot)))
+    {
+        cursor = __IntBenchEncVarint(cursor, ((uint64_t)id + 1) << 1);
+        cursor = __IntBenchEncVarint(cursor,
+                                     __IntBenchEncZigZag(time -
+                                                         state->base[slot]));
+    }
+    else
+    {
+        cursor = __IntBenchEncVarint(cursor, (((uint64_t)id + 1) << 1) | 1);
+        cursor = __IntBenchEncVarint(cursor, __IntBenchEncZigZag(time));
+        state->validSlots |= 1U << slot;
+    }
+    state->base[slot] = time;
+
+    cursor = __IntBenchEncVarint(cursor, l2Miss);
+    cursor = __IntBenchEncVarint(cursor, tlbMiss);
+
+    ++state->records;
+    *sizePtr += (uint32_t)(cursor - start);
+}
+
+#endif  /* ifndef __RECORD_ENCODING_H__ */
+/* __________________________________________________________________________
+* END OF FILE:
+* -------------
+* ___________________________________________________________________________
+*/
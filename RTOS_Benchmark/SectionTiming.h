@@ -0,0 +1,107 @@
+/* __________________________________________________________________________
+* MODULE DESCRIPTION:
+* -------------------
+* Filename : SectionTiming.h
+*
+* Author: Alexy Torres Aurora Dugo
+*
+* Description: This file contains the sectioned timing of the payloads. The
+* payload marks its phases (e.g. input acquisition, control law, output) with
+* INT_BENCH_SECTION_BEGIN and INT_BENCH_SECTION_END (InterruptBench.h), up to
+* INT_BENCH_SECTION_COUNT sections per sample. The markers only read the time
+* base (__IntBenchReadTimebase) and the payload PMCs 1 and 2, a section entered
+* several times during a sample accumulates its deltas.
+*
+* The sections of each sample are dumped in the section region, after the PART
+* record of the sample.
+*
+* Record format (16B + 12B per section):
+* ID (4B, INT_BENCH_RECORD_ID of the PART record), sample index (4B), mask of
+* the sections entered (4B), section count (4B) and, for every section, the
+* time (4B, ns), L2 misses (4B) and TLB misses (4B).
+* __________________________________________________________________________
+*/
+
+/* __________________________________________________________________________
+* PREPROCESSOR DIRECTIVES:
+* ------------------------
+*/
+#ifndef __SECTION_TIMING_H__
+#define __SECTION_TIMING_H__
+
+#include <stdint.h>
+#include <OSAbstractionLayer.h>
+
+/*******************************************************************************
+ * CONFIGURATION
+ ******************************************************************************/
+
+/* Size of a section record */
+#define INT_BENCH_SECTION_RECORD_SIZE                                          \
+    (sizeof(uint32_t) * (4 + 3 * INT_BENCH_SECTION_COUNT))
+
+#if INT_BENCH_SECTION_COUNT > 32
+#error "The section mask cannot hold more than 32 sections"
+#endif
+
+/*******************************************************************************
+ * TYPES
+ ******************************************************************************/
+
+/* Section accumulators of a sample */
+typedef struct {
+    /* Time base and PMCs at the last INT_BENCH_SECTION_BEGIN */
+    uint64_t beginTime;
+    uint32_t beginL2;
+    uint32_t beginTlb;
+    /* Accumulated time base ticks and misses */
+    uint64_t time;
+    uint32_t l2Miss;
+    uint32_t tlbMiss;
+} int_bench_section_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/* Dumps the sections of a sample in the section region. The records that do
+ * not fit in the region are dropped and counted in the dump header.
+ */
+static inline void __IntBenchSectionDump(const uint32_t             recordId,
+                                         const uint32_t             sample,
+                                         const uint32_t             mask,
+                                         const int_bench_section_t* sections)
+{
+    uint32_t* cursor;
+    uint32_t  size;
+    uint32_t  i;
+
+    size = *(uint32_t*)INT_BENCH_DUMP_SECTION_SIZE_ADDR;
+    if(INT_BENCH_DUMP_REG_SIZE - 8 - size < INT_BENCH_SECTION_RECORD_SIZE)
+    {
+        ++*(uint32_t*)INT_BENCH_DUMP_REG_HEADER_DROP;
+        return;
+    }
+
+    cursor = (uint32_t*)(INT_BENCH_DUMP_SECTION_CURSOR_ADDR + size);
+    cursor[0] = recordId;
+    cursor[1] = sample;
+    cursor[2] = mask;
+    cursor[3] = INT_BENCH_SECTION_COUNT;
+    for(i = 0; i < INT_BENCH_SECTION_COUNT; ++i)
+    {
+        cursor[4 + i * 3] = (uint32_t)(sections[i].time * 1000000000ULL /
+                                       INT_BENCH_TIMEBASE_HZ);
+        cursor[5 + i * 3] = sections[i].l2Miss;
+        cursor[6 + i * 3] = sections[i].tlbMiss;
+    }
+    *(uint32_t*)INT_BENCH_DUMP_SECTION_SIZE_ADDR =
+        size + INT_BENCH_SECTION_RECORD_SIZE;
+}
+
+#endif  /* ifndef __SECTION_TIMING_H__ */
+/* __________________________________________________________________________
+* END OF FILE:
+* -------------
+* ___________________________________________________________________________
+*/
@@ -0,0 +1,228 @@
+/* __________________________________________________________________________
+* MODULE DESCRIPTION:
+* -------------------
+* Filename : SmtSibling.h
+*
+* Author: Alexy Torres Aurora Dugo
+*
+* Description: This file contains the SMT sibling interference mode. The
+* e6500 cores have two hardware threads: the generators steer their IPIs and
+* external interrupts to the sibling thread of the victim payload
+* (INT_BENCH_DST_THREAD) and the payload records the counters of both threads.
+*
+* The performance counters of a thread cannot be read from its sibling. The
+* sibling thread executes the sibling agent (__IntBenchSmtAgent): it counts
+* the thread L2 and TLB misses on its PMCs 1 and 2, idles until it takes an
+* interrupt (__IntBenchWaitInt) and publishes its counters in its mailbox
+* after every handler. A payload given a sibling state
+* (INT_BENCH_SMT_INIT) reads the mailbox of its sibling at the beginning and at
+* the end of every sample. The sibling misses between the last handler and the
+* snapshot are only the agent's own, a handful of instructions.
+*
+* The mailboxes are sequence locked, the agent is the only writer. A snapshot
+* that cannot be read consistently (no agent on the sibling) is invalid, the
+* sibling fields of the record are then INT_BENCH_SMT_INVALID.
+*
+* Record format (36B):
+* ID (4B, INT_BENCH_RECORD_ID of the PART record), sample index (4B), payload
+* thread (4B), sibling thread (4B), payload L2 misses (4B), payload TLB misses
+* (4B), sibling interrupts (4B, agent wake-ups), sibling L2 misses (4B),
+* sibling TLB misses (4B).
+* __________________________________________________________________________
+*/
+
+/* __________________________________________________________________________
+* PREPROCESSOR DIRECTIVES:
+* ------------------------
+*/
+#ifndef __SMT_SIBLING_H__
+#define __SMT_SIBLING_H__
+
+#include <stdint.h>
+#include <OSAbstractionLayer.h>
+#include <PMCDriver.h>
+
+/*******************************************************************************
+ * CONFIGURATION
+ ******************************************************************************/
+
+/* Size of a sibling record */
+#define INT_BENCH_SMT_RECORD_SIZE (sizeof(uint32_t) * 9)
+
+/* Value of the sibling fields of a record without valid snapshots */
+#define INT_BENCH_SMT_INVALID 0xFFFFFFFF
+
+/* Number of attempts to read a consistent mailbox */
+#define INT_BENCH_SMT_READ_TRIES 16
+
+/* Mailbox of a hardware thread */
+#define INT_BENCH_SMT_MAILBOX_PTR(CORE, THREAD)                                \
+    ((volatile int_bench_smt_mailbox_t*)INT_BENCH_SMT_MAILBOXES_ADDR +         \
+     (CORE) * INT_BENCH_THREADS_PER_CORE + (THREAD))
+
+/*******************************************************************************
+ * TYPES
+ ******************************************************************************/
+
+/* Counters published by the sibling agent (16B), seq is odd during an update */
+typedef struct {
+    uint32_t seq;
+    uint32_t wakeups;
+    uint32_t l2Miss;
+    uint32_t tlbMiss;
+} int_bench_smt_mailbox_t;
+
+/* Sibling state of a payload */
+typedef struct {
+    /* Hardware thread of the payload and of its sibling */
+    uint32_t                thread;
+    uint32_t                sibling;
+    /* Sibling counters at the beginning of the sample, then their deltas */
+    int_bench_smt_mailbox_t counters;
+    uint32_t                valid;
+} int_bench_smt_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/* Reads the mailbox of a hardware thread. Returns 0 on success, -1 if no
+ * consistent snapshot could be read.
+ */
+static inline int32_t __IntBenchSmtRead(const uint32_t           core,
+                                        const uint32_t           thread,
+                                        int_bench_smt_mailbox_t* counters)
+{
+    volatile int_bench_smt_mailbox_t* mailbox;
+    uint32_t                          seq;
+    uint32_t                          i;
+
+    mailbox = INT_BENCH_SMT_MAILBOX_PTR(core, thread);
+    for(i = 0; i < INT_BENCH_SMT_READ_TRIES; ++i)
+    {
+        seq = mailbox->seq;
+        __sync_synchronize();
+        counters->wakeups = mailbox->wakeups;
+        counters->l2Miss  = mailbox->l2Miss;
+        counters->tlbMiss = mailbox->tlbMiss;
+        __sync_synchronize();
+        if(0 == (seq & 1) && seq == mailbox->seq)
+        {
+            counters->seq = seq;
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+/* Sibling agent, executed on the sibling hardware thread of the payloads.
+ * Never returns.
+ */
+static inline void __IntBenchSmtAgent(const uint32_t core,
+                                      const uint32_t thread)
+{
+    volatile int_bench_smt_mailbox_t* mailbox;
+    uint32_t                          l2Miss;
+    uint32_t                          tlbMiss;
+
+    mailbox = INT_BENCH_SMT_MAILBOX_PTR(core, thread);
+    mailbox->seq     = 1;
+    __sync_synchronize();
+    mailbox->wakeups = 0;
+    mailbox->l2Miss  = 0;
+    mailbox->tlbMiss = 0;
+    __sync_synchronize();
+    mailbox->seq     = 2;
+
+    __PMC_DRV_WRITE(INT_BENCH_PAYLOAD_PMC_L2, 0);
+    __PMC_DRV_WRITE(INT_BENCH_PAYLOAD_PMC_TLB, 0);
+    __PMC_DRV_ENABLE(INT_BENCH_PAYLOAD_PMC_L2, INT_BENCH_PMC_EVENT_L2);
+    __PMC_DRV_ENABLE(INT_BENCH_PAYLOAD_PMC_TLB, INT_BENCH_PMC_EVENT_TLB);
+
+    while(1)
+    {
+        __IntBenchWaitInt();
+        __PMC_DRV_READ(INT_BENCH_PAYLOAD_PMC_L2, &l2Miss);
+        __PMC_DRV_READ(INT_BENCH_PAYLOAD_PMC_TLB, &tlbMiss);
+
+        mailbox->seq = mailbox->seq + 1;
+        __sync_synchronize();
+        mailbox->wakeups = mailbox->wakeups + 1;
+        mailbox->l2Miss  = l2Miss;
+        mailbox->tlbMiss = tlbMiss;
+        __sync_synchronize();
+        mailbox->seq = mailbox->seq + 1;
+    }
+}
+
+/* Snapshots the sibling counters at the beginning of a sample */
+static inline void __IntBenchSmtStart(int_bench_smt_t* smt,
+                                      const uint32_t   core)
+{
+    smt->valid = (0 == __IntBenchSmtRead(core, smt->sibling, &smt->counters));
+}
+
+/* Replaces the snapshot by the sibling counters deltas of the sample */
+static inline void __IntBenchSmtStop(int_bench_smt_t* smt,
+                                     const uint32_t   core)
+{
+    int_bench_smt_mailbox_t end;
+
+    if(0 != smt->valid &&
+       0 == __IntBenchSmtRead(core, smt->sibling, &end))
+    {
+        smt->counters.wakeups = end.wakeups - smt->counters.wakeups;
+        smt->counters.l2Miss  = end.l2Miss - smt->counters.l2Miss;
+        smt->counters.tlbMiss = end.tlbMiss - smt->counters.tlbMiss;
+    }
+    else
+    {
+        smt->valid = 0;
+    }
+}
+
+/* Dumps the counters of both threads for a sample in the SMT region */
+static inline void __IntBenchSmtDump(const uint32_t         recordId,
+                                     const uint32_t         sample,
+                                     const int_bench_smt_t* smt,
+                                     const uint32_t         l2Miss,
+                                     const uint32_t         tlbMiss)
+{
+    uint32_t* cursor;
+    uint32_t  size;
+
+    size = *(uint32_t*)INT_BENCH_DUMP_SMT_SIZE_ADDR;
+    if(INT_BENCH_DUMP_REG_SIZE - 8 - size < INT_BENCH_SMT_RECORD_SIZE)
+    {
+        return;
+    }
+
+    cursor = (uint32_t*)(INT_BENCH_DUMP_SMT_CURSOR_ADDR + size);
+    cursor[0] = recordId;
+    cursor[1] = sample;
+    cursor[2] = smt->thread;
+    cursor[3] = smt->sibling;
+    cursor[4] = l2Miss;
+    cursor[5] = tlbMiss;
+    if(0 != smt->valid)
+    {
+        cursor[6] = smt->counters.wakeups;
+        cursor[7] = smt->counters.l2Miss;
+        cursor[8] = smt->counters.tlbMiss;
+    }
+    else
+    {
+        cursor[6] = INT_BENCH_SMT_INVALID;
+        cursor[7] = INT_BENCH_SMT_INVALID;
+        cursor[8] = INT_BENCH_SMT_INVALID;
+    }
+    *(uint32_t*)INT_BENCH_DUMP_SMT_SIZE_ADDR = size + INT_BENCH_SMT_RECORD_SIZE;
+}
+
+#endif  /* ifndef __SMT_SIBLING_H__ */
+/* __________________________________________________________________________
+* END OF FILE:
+* -------------
+* ___________________________________________________________________________
+*/
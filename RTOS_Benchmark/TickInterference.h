@@ -0,0 +1,165 @@
+/* __________________________________________________________________________
+* MODULE DESCRIPTION:
+* -------------------
+* Filename : TickInterference.h
+*
+* Author: Alexy Torres Aurora Dugo
+*
+* Description: This file contains the OS tick interference benchmark. The
+* periodic tick that drives the ARINC653 scheduler interrupts every partition,
+* its cost is part of the PART baseline. The OS tick handler calls
+* __IntBenchTickEnter at its entry and __IntBenchTickExit before returning to
+* the interrupted partition: the entry time, the handler time and the L2 and
+* TLB misses of the handler are dumped in the tick region.
+*
+* The ticks of a core are only measured once a partition of the core started
+* the benchmark (INT_BENCH_TICK_START), INT_BENCH_SAMPLE_COUNT ticks are
+* measured per core. The PMCs 0 and 5 are used: a tick can hit a payload
+* measurement (PMCs 1 and 2) and perform a partition switch (PMCs 3 and 4).
+*
+* The tick frequency requested with INT_BENCH_TICK_HZ is applied by
+* INT_BENCH_DUMP_HADER (__IntBenchSetTickFrequency), the frequency the OS
+* applied is recorded in the dump header. Comparing campaigns executed at
+* several tick frequencies tells if a lower tick rate is worth it.
+*
+* Record format (28B):
+* ID (4B, core), entry time (8B, __IntBenchGetTimestamp), handler time (8B),
+* L2 misses (4B), TLB misses (4B).
+* __________________________________________________________________________
+*/
+
+/* __________________________________________________________________________
+* PREPROCESSOR DIRECTIVES:
+* ------------------------
+*/
+#ifndef __TICK_INTERFERENCE_H__
+#define __TICK_INTERFERENCE_H__
+
+#include <stdint.h>
+#include <ARINC653.h>
+#include <OSAbstractionLayer.h>
+#include <PMCDriver.h>
+
+/*******************************************************************************
+ * CONFIGURATION
+ ******************************************************************************/
+
+/* PMCs used to measure the tick handler */
+#define INT_BENCH_TICK_PMC_L2  0
+#define INT_BENCH_TICK_PMC_TLB 5
+
+/* Size of a tick record: ID, entry time, handler time, L2 and TLB misses */
+#define INT_BENCH_TICK_RECORD_SIZE                                             \
+    (sizeof(uint32_t) * 3 + sizeof(uint64_t) + sizeof(SYSTEM_TIME_TYPE))
+
+/*******************************************************************************
+ * TYPES
+ ******************************************************************************/
+
+/* OS tick state of a core (INT_BENCH_TICK_STATE_SIZE bytes) */
+typedef struct {
+    /* Entry time of the tick being handled */
+    uint64_t enterTime;
+    /* Set between the two hooks of a tick */
+    uint32_t pending;
+    /* Set when the ticks of the core are measured */
+    uint32_t enabled;
+    /* Number of ticks measured */
+    uint32_t count;
+    uint32_t reserved;
+} int_bench_tick_state_t;
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* OS tick state of a core */
+#define INT_BENCH_TICK_STATE(CORE)                                             \
+    ((volatile int_bench_tick_state_t*)INT_BENCH_TICK_STATES_ADDR + (CORE))
+
+/* Starts measuring the OS ticks of a core. Called by a partition of the core
+ * after INT_BENCH_INIT.
+ */
+#define INT_BENCH_TICK_START(CORE) {                                           \
+    INT_BENCH_TICK_STATE(CORE)->count   = 0;                                   \
+    INT_BENCH_TICK_STATE(CORE)->pending = 0;                                   \
+    INT_BENCH_TICK_STATE(CORE)->enabled = 1;                                   \
+}
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/* OS hook: called by the tick handler of a core at its entry */
+static inline void __IntBenchTickEnter(const uint32_t core)
+{
+    volatile int_bench_tick_state_t* state;
+
+    state = INT_BENCH_TICK_STATE(core);
+    if(0 == state->enabled || INT_BENCH_SAMPLE_COUNT <= state->count)
+    {
+        return;
+    }
+
+    __PMC_DRV_WRITE(INT_BENCH_TICK_PMC_L2, 0);
+    __PMC_DRV_WRITE(INT_BENCH_TICK_PMC_TLB, 0);
+    __PMC_DRV_ENABLE(INT_BENCH_TICK_PMC_L2, INT_BENCH_PMC_EVENT_L2);
+    __PMC_DRV_ENABLE(INT_BENCH_TICK_PMC_TLB, INT_BENCH_PMC_EVENT_TLB);
+
+    state->pending   = 1;
+    state->enterTime = __IntBenchGetTimestamp();
+}
+
+/* OS hook: called by the tick handler of a core before it returns to the
+ * interrupted partition (or to the partition it switched to). The tick is
+ * dumped if it was entered since the last call.
+ */
+static inline void __IntBenchTickExit(const uint32_t core)
+{
+    volatile int_bench_tick_state_t* state;
+    uint64_t                         exitTime;
+    uint32_t                         l2Miss;
+    uint32_t                         tlbMiss;
+    uint32_t                         size;
+    uint8_t*                         cursor;
+
+    exitTime = __IntBenchGetTimestamp();
+
+    state = INT_BENCH_TICK_STATE(core);
+    if(0 == state->pending)
+    {
+        return;
+    }
+    state->pending = 0;
+
+    __PMC_DRV_DISABLE(INT_BENCH_TICK_PMC_L2);
+    __PMC_DRV_DISABLE(INT_BENCH_TICK_PMC_TLB);
+    __PMC_DRV_READ(INT_BENCH_TICK_PMC_L2, &l2Miss);
+    __PMC_DRV_READ(INT_BENCH_TICK_PMC_TLB, &tlbMiss);
+
+    /* Every core dumps its ticks in the same region */
+    while(0 != __TestAndSet(INT_BENCH_TICK_LOCK));
+    size = *(uint32_t*)INT_BENCH_DUMP_TICK_SIZE_ADDR;
+    if(INT_BENCH_DUMP_REG_SIZE - 8 - size >= INT_BENCH_TICK_RECORD_SIZE)
+    {
+        cursor = (uint8_t*)INT_BENCH_DUMP_TICK_CURSOR_ADDR + size;
+        *(uint32_t*)cursor = core;
+        *(uint64_t*)(cursor + 4) = state->enterTime;
+        *(SYSTEM_TIME_TYPE*)(cursor + 12) =
+            (SYSTEM_TIME_TYPE)(exitTime - state->enterTime);
+        *(uint32_t*)(cursor + 20) = l2Miss;
+        *(uint32_t*)(cursor + 24) = tlbMiss;
+        *(uint32_t*)INT_BENCH_DUMP_TICK_SIZE_ADDR =
+            size + INT_BENCH_TICK_RECORD_SIZE;
+    }
+    __LockRelease(INT_BENCH_TICK_LOCK);
+
+    ++state->count;
+}
+
+#endif  /* ifndef __TICK_INTERFERENCE_H__ */
+/* __________________________________________________________________________
+* END OF FILE:
+* -------------
+* ___________________________________________________________________________
+*/
@@ -0,0 +1,287 @@
+/* __________________________________________________________________________
+* MODULE DESCRIPTION:
+* -------------------
+* Filename : TraceReplay.h
+*
+* Author: Alexy Torres Aurora Dugo
+*
+* Description: This file contains the trace driven interrupt replay. Instead
+* of generating interrupts at a fixed rate, the replay generators reproduce a
+* recorded interrupt arrival trace against the global time base (GET_TIME)
+* with the generation primitives of OSAbstractionLayer.h. The skew between
+* the scheduled and the actual generation time of every event is dumped in
+* the replay region.
+*
+* Trace format (native byte order, see Scripts/TraceConv.py):
+* Header (16B): magic "IBTR", byte order mark 0x01020304, event count,
+*               reserved.
+* Events (16B): arrival time (8B, ns from the trace origin), type (4B,
+*               INT_BENCH_TYPE_SC, _INTINT, _EXTINT or _IPI), destination core
+*               (4B). The events are sorted by arrival time.
+*
+* The system calls and internal interrupts are raised on their destination
+* core: they are replayed by the generator of that core. The IPIs and external
+* interrupts are replayed by the generator initialized as remote generator.
+* The trace origin is shared by the generators, it is set
+* INT_BENCH_REPLAY_LEAD ns after the initialization of the first generator.
+* __________________________________________________________________________
+*/
+
+/* __________________________________________________________________________
+* PREPROCESSOR DIRECTIVES:
+* ------------------------
+*/
+#ifndef __TRACE_REPLAY_H__
+#define __TRACE_REPLAY_H__
+
+#include <stdint.h>
+#include <string.h>
+#include <ARINC653.h>
+#include <OSAbstractionLayer.h>
+
+/*******************************************************************************
+ * CONFIGURATION
+ ******************************************************************************/
+
+/* Trace header values */
+#define INT_BENCH_REPLAY_MAGIC_VAL "IBTR"
+#define INT_BENCH_REPLAY_BOM_VAL   0x01020304
+
+/* Size of a replay record: ID, skew, event index and generation time */
+#define INT_BENCH_REPLAY_RECORD_SIZE \
+    (sizeof(uint32_t) * 3 + sizeof(SYSTEM_TIME_TYPE))
+
+/*******************************************************************************
+ * TYPES
+ ******************************************************************************/
+
+/* Trace header (16B) */
+typedef struct {
+    char     magic[4];
+    uint32_t bom;
+    uint32_t count;
+    uint32_t reserved;
+} int_bench_replay_header_t;
+
+/* Trace event (16B) */
+typedef struct {
+    uint64_t time;
+    uint32_t type;
+    uint32_t dstCore;
+} int_bench_replay_event_t;
+
+/* Replay generator state */
+typedef struct {
+    /* Trace events */
+    const int_bench_replay_event_t* events;
+    uint32_t                        count;
+    /* Next event to examine */
+    uint32_t                        next;
+    /* Core of the generator, set if it replays the IPIs and external
+     * interrupts
+     */
+    uint32_t                        core;
+    uint32_t                        remote;
+    /* Number of events replayed by the generator */
+    uint32_t                        replayed;
+    /* Set when the generator replayed all its events */
+    uint32_t                        done;
+} int_bench_replay_t;
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* Replay record ID: bits[24-31] type, bits[16-23] source core, bits[8-15]
+ * destination core, bits[0-7] generator partition
+ */
+#define INT_BENCH_REPLAY_ID(TYPE, SRCID, DSTID, PARTID)                        \
+    ((((uint32_t)(TYPE) & 0xFF) << 24) | (((uint32_t)(SRCID) & 0xFF) << 16) |  \
+     (((uint32_t)(DSTID) & 0xFF) << 8) | ((uint32_t)(PARTID) & 0xFF))
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+/* Tells if an event is replayed by the generator */
+static inline uint32_t
+__IntBenchReplayOwns(const int_bench_replay_t*       replay,
+                     const int_bench_replay_event_t* event)
+{
+    if(INT_BENCH_TYPE_SC == event->type ||
+       INT_BENCH_TYPE_INTINT == event->type)
+    {
+        return (event->dstCore == replay->core);
+    }
+    if(INT_BENCH_TYPE_IPI == event->type ||
+       INT_BENCH_TYPE_EXTINT == event->type)
+    {
+        return (0 != replay->remote);
+    }
+    return 0;
+}
+
+/* Initializes a replay generator with the trace given by the OS. Returns -1
+ * if no trace is loaded or if the trace is invalid.
+ * The events that no generator replays (destination core without generator,
+ * no remote generator) are counted in the dump header: the first generator
+ * sets the count to the trace size and every generator removes the events it
+ * owns.
+ */
+static inline int32_t __IntBenchReplayInit(int_bench_replay_t* replay,
+                                           const uint32_t      core,
+                                           const uint32_t      remote)
+{
+    const int_bench_replay_header_t* header;
+    const int_bench_replay_event_t*  events;
+    RETURN_CODE_TYPE                 errCode;
+    SYSTEM_TIME_TYPE                 now;
+    uint32_t                         size;
+    uint32_t                         owned;
+    uint32_t                         i;
+
+    memset(replay, 0, sizeof(int_bench_replay_t));
+    replay->done = 1;
+
+    header = (const int_bench_replay_header_t*)__IntBenchGetReplayTrace(&size);
+    if(NULL == header || sizeof(int_bench_replay_header_t) > size ||
+       0 != memcmp(header->magic, INT_BENCH_REPLAY_MAGIC_VAL, 4) ||
+       INT_BENCH_REPLAY_BOM_VAL != header->bom ||
+       (size - sizeof(int_bench_replay_header_t)) /
+       sizeof(int_bench_replay_event_t) < header->count)
+    {
+        return -1;
+    }
+
+    events = (const int_bench_replay_event_t*)(header + 1);
+    for(i = 1; i < header->count; ++i)
+    {
+        if(events[i].time < events[i - 1].time)
+        {
+            return -1;
+        }
+    }
+
+    replay->events = events;
+    replay->count  = header->count;
+    replay->core   = core;
+    replay->remote = remote;
+    replay->done   = 0;
+
+    owned = 0;
+    for(i = 0; i < replay->count; ++i)
+    {
+        owned += __IntBenchReplayOwns(replay, &events[i]);
+    }
+
+    /* The first generator sets the trace origin */
+    GET_TIME(&now, &errCode);
+    if(NO_ERROR != errCode)
+    {
+        return -1;
+    }
+    while(0 != __TestAndSet(INT_BENCH_SWEEP_LOCK));
+    if(0 == *INT_BENCH_REPLAY_ORIGIN_PTR)
+    {
+        *INT_BENCH_REPLAY_ORIGIN_PTR = (uint64_t)now + INT_BENCH_REPLAY_LEAD;
+        *(uint32_t*)INT_BENCH_DUMP_REG_HEADER_RPLY_SKIP = replay->count;
+    }
+    *(uint32_t*)INT_BENCH_DUMP_REG_HEADER_RPLY_SKIP -= owned;
+    __LockRelease(INT_BENCH_SWEEP_LOCK);
+
+    return 0;
+}
+
+/* Replays the next event of the generator: waits for its arrival time,
+ * generates it and dumps the skew. Late events are generated immediately.
+ * The events owned by the other generators are skipped, the ones without
+ * generator were counted at the initialization.
+ */
+static inline void __IntBenchReplayStep(int_bench_replay_t* replay,
+                                        const uint32_t      partId)
+{
+    const int_bench_replay_event_t* event;
+    RETURN_CODE_TYPE                errCode;
+    SYSTEM_TIME_TYPE                scheduled;
+    SYSTEM_TIME_TYPE                startTime;
+    SYSTEM_TIME_TYPE                endTime;
+    uint8_t*                        cursor;
+    uint32_t                        size;
+
+    if(0 != replay->done)
+    {
+        return;
+    }
+
+    /* Get the next event of the generator */
+    while(replay->next < replay->count &&
+          0 == __IntBenchReplayOwns(replay, &replay->events[replay->next]))
+    {
+        ++replay->next;
+    }
+    if(replay->count <= replay->next)
+    {
+        replay->done = 1;
+        return;
+    }
+    event = &replay->events[replay->next];
+    scheduled = (SYSTEM_TIME_TYPE)(*INT_BENCH_REPLAY_ORIGIN_PTR + event->time);
+
+    /* Wait for the arrival time */
+    do
+    {
+        GET_TIME(&startTime, &errCode);
+        if(NO_ERROR != errCode)
+        {
+            amp_printf_unsafe("Cannot get start execution time: %d\n\r",
+                              errCode);
+            return;
+        }
+    } while(startTime < scheduled);
+
+    /* The generators share the interrupt wait flag */
+    while(0 != __TestAndSet(INT_BENCH_SWEEP_LOCK));
+    GET_TIME(&startTime, &errCode);
+    if(INT_BENCH_TYPE_SC == event->type)
+    {
+        __IntBenchGenerateSyscall();
+    }
+    else if(INT_BENCH_TYPE_INTINT == event->type)
+    {
+        __IntBenchGenerateInternalInt();
+    }
+    else if(INT_BENCH_TYPE_IPI == event->type)
+    {
+        __IntBenchGenerateIPI(event->dstCore);
+    }
+    else
+    {
+        __IntBenchGenerateExternalInt(event->dstCore);
+    }
+    GET_TIME(&endTime, &errCode);
+
+    size = *(uint32_t*)INT_BENCH_DUMP_REPLAY_SIZE_ADDR;
+    if(NO_ERROR == errCode &&
+       INT_BENCH_DUMP_REG_SIZE - 8 - size >= INT_BENCH_REPLAY_RECORD_SIZE)
+    {
+        cursor = (uint8_t*)INT_BENCH_DUMP_REPLAY_CURSOR_ADDR + size;
+        *(uint32_t*)cursor = INT_BENCH_REPLAY_ID(event->type, replay->core,
+                                                 event->dstCore, partId);
+        *(SYSTEM_TIME_TYPE*)(cursor + 4) = startTime - scheduled;
+        *(uint32_t*)(cursor + 12) = replay->next;
+        *(uint32_t*)(cursor + 16) = (uint32_t)(endTime - startTime);
+        *(uint32_t*)INT_BENCH_DUMP_REPLAY_SIZE_ADDR =
+            size + INT_BENCH_REPLAY_RECORD_SIZE;
+    }
+    __LockRelease(INT_BENCH_SWEEP_LOCK);
+
+    ++replay->replayed;
+    ++replay->next;
+}
+
+#endif  /* ifndef __TRACE_REPLAY_H__ */
+/* __________________________________________________________________________
+* END OF FILE:
+* -------------
+* ___________________________________________________________________________
+*/
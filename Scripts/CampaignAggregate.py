@@ -0,0 +1,614 @@
+################################################################################
+# CampaignAggregate.py
+#
+# Description: This python script merges the dumps of a campaign spread over
+# several boards into one dataset. Every input folder (-i) holds the binary
+# dumps of a board (searched recursively). The dumps are extracted in parallel
+# (-j processes) with ExtractionConv.py and placed with their campaign manifest
+# (see CampaignManifest.h): the scenario and the mitigation recorded by the
+# benchmarks tell the dataset folder of each dump.
+#
+# Output folder (-o):
+# - MITIGATION-NAME_mitig/SCENARIO/: the benchmark files (Type,Id,... header)
+#   of every board measuring the configuration, concatenated in the order of
+#   the board identifiers. The first executions of each board are dropped
+#   except for the first board, the visualization scripts drop them for the
+#   first one (see StatsCache.loadDataFrame).
+# - boards/BOARD/MITIGATION-NAME_mitig/SCENARIO/: the extracted files of each
+#   board and the extraction log. Every board folder is a dataset on its own.
+# - campaign_manifest.csv: the manifest of every run.
+# - board_variance.csv: for every configuration, file and partition measured
+#   on several boards, the execution time mean of each board, their spread and
+#   the p-value of the k samples Anderson-Darling test. The partitions whose
+#   boards differ at the -a level by more than the tolerance (-t) are flagged.
+#
+# A configuration is not merged when its boards do not count the same events
+# (counter schema of the manifest), the boards running different firmware
+# revisions are reported. The script exits with 1 when a configuration is not
+# merged and with 2 when no dump can be placed.
+#
+# Author: Alexy Torres Aurora Dugo
+#
+# Date: 03/03/2022
+################################################################################
+
+
+################################################################################
+# IMPORTS
+################################################################################
+import os
+import sys
+import shutil
+import argparse
+import warnings
+import contextlib
+import concurrent.futures
+import numpy as np
+import pandas as pd
+from scipy import stats
+
+import StatsCache
+import ExtractionConv
+
+################################################################################
+# CONSTANTS
+################################################################################
+DUMP_EXTENSION   = ".bin"
+OUTPUT_FILENAME  = "output.csv"
+MANIFEST_FILE    = "MANIFEST_" + OUTPUT_FILENAME
+LOG_FILENAME     = "extraction.log"
+STAGING_FOLDER   = ".staging"
+BOARDS_FOLDER    = "boards"
+BENCH_HEADER     = "Type,Id,"
+METRIC           = "ExecTime"
+
+# Rows dropped by StatsCache.loadDataFrame at the beginning of a file
+WARMUP_ROWS = StatsCache.PARTITION_COUNT * 2
+
+DEFAULT_TOLERANCE = 5.0
+DEFAULT_ALPHA     = 0.05
+
+################################################################################
+# GLOBAL VARIABLES
+################################################################################
+
+# None
+
+################################################################################
+# CLASSES
+################################################################################
+
+class Run:
+    """
+    Describes a dump of the campaign: its path, the folder it was extracted to
+    and its campaign manifest.
+    """
+    def __init__(self, dumpPath, workPath):
+        self.dumpPath = dumpPath
+        self.workPath = workPath
+        self.manifest = None
+        self.error    = None
+
+    def getConfiguration(self):
+        return (self.manifest["Mitigation"], self.manifest["Scenario"])
+
+################################################################################
+# FUNCTIONS
+################################################################################
+def findDumps(boardPaths):
+    """
+        Lists the dumps of the board folders.
+
+    Parameters
+    ----------
+        boardPaths : List[str] (in)
+            The paths to the board folders.
+
+    Return
+    ----------
+        The sorted list of the absolute paths to the dumps.
+
+    Raises
+    ----------
+        None.
+    """
+    dumps = []
+    for boardPath in boardPaths:
+        for folder, _, files in os.walk(boardPath):
+            dumps += [os.path.abspath(os.path.join(folder, name))
+                      for name in files if name.endswith(DUMP_EXTENSION)]
+
+    return sorted(set(dumps))
+
+def readManifest(filename):
+    """
+        Reads the campaign manifest extracted from a dump.
+
+    Parameters
+    ----------
+        filename : str (in)
+            The path to the manifest file.
+
+    Return
+    ----------
+        The manifest as a dictionary of strings, None if the dump has no
+        manifest.
+
+    Raises
+    ----------
+        IOError can be raised during the files manipulations.
+    """
+    if not os.path.isfile(filename):
+        return None
+
+    dataFrame = pd.read_csv(filename, dtype = str, keep_default_na = False)
+    if len(dataFrame) == 0:
+        return None
+
+    return dataFrame.iloc[0].to_dict()
+
+def extractDump(dumpPath, workPath):
+    """
+        Extracts a dump in its work folder, the output of ExtractionConv.py is
+        written to the extraction log. This function is executed by the
+        workers of the pool.
+
+    Parameters
+    ----------
+        dumpPath : str (in)
+            The absolute path to the dump.
+        workPath : str (in)
+            The absolute path to the folder the dump is extracted to.
+
+    Return
+    ----------
+        The campaign manifest of the dump (see readManifest).
+
+    Raises
+    ----------
+        IOError, RuntimeError and others can be raised during the extraction.
+    """
+    os.makedirs(workPath, exist_ok = True)
+
+    # ExtractionConv.py writes its files in the working directory
+    os.chdir(workPath)
+    with open(LOG_FILENAME, "w") as logFile:
+        with contextlib.redirect_stdout(logFile):
+            ExtractionConv.convertFile(dumpPath, OUTPUT_FILENAME)
+
+    return readManifest(os.path.join(workPath, MANIFEST_FILE))
+
+def placeRuns(runs, outputPath):
+    """
+        Moves the extracted files of the runs to their board folder. The runs
+        of a board measuring the same configuration several times get the
+        run number as suffix.
+
+    Parameters
+    ----------
+        runs : List[Run] (in/out)
+            The extracted runs, their work path is updated.
+        outputPath : str (in)
+            The path to the output dataset.
+
+    Return
+    ----------
+        None.
+
+    Raises
+    ----------
+        IOError can be raised during the files manipulations.
+    """
+    placed = {}
+    for run in runs:
+        mitig, scenario = run.getConfiguration()
+        board = run.manifest["Board"]
+        key   = (board, mitig, scenario)
+        placed[key] = placed.get(key, 0) + 1
+        if placed[key] > 1:
+            board += "_run" + str(placed[key])
+
+        boardPath = os.path.join(outputPath, BOARDS_FOLDER, board,
+                                 mitig + "_mitig", scenario)
+        if os.path.isdir(boardPath):
+            shutil.rmtree(boardPath)
+        os.makedirs(os.path.dirname(boardPath), exist_ok = True)
+        shutil.move(run.workPath, boardPath)
+        run.workPath = boardPath
+
+def getBenchFiles(folder):
+    """
+        Lists the benchmark files of an extracted run: the files with a type
+        and a partition column that can be concatenated.
+
+    Parameters
+    ----------
+        folder : str (in)
+            The path to the extracted run.
+
+    Return
+    ----------
+        The sorted list of the benchmark file names.
+
+    Raises
+    ----------
+        IOError can be raised during the files manipulations.
+    """
+    names = []
+    for name in sorted(os.listdir(folder)):
+        if not name.endswith(OUTPUT_FILENAME):
+            continue
+        with open(os.path.join(folder, name), "r") as csvFile:
+            if csvFile.readline().startswith(BENCH_HEADER):
+                names.append(name)
+
+    return names
+
+def mergeConfiguration(runs, setPath):
+    """
+        Concatenates the benchmark files of the runs of a configuration. The
+        first executions of every run but the first one are dropped.
+
+    Parameters
+    ----------
+        runs : List[Run] (in)
+            The runs of the configuration, sorted by board.
+        setPath : str (in)
+            The path to the merged configuration folder.
+
+    Return
+    ----------
+        The list of the merged file names.
+
+    Raises
+    ----------
+        IOError, RuntimeError can be raised during the files manipulations.
+    """
+    os.makedirs(setPath, exist_ok = True)
+
+    names = sorted(set([name for run in runs
+                        for name in getBenchFiles(run.workPath)]))
+    for name in names:
+        header = None
+        with open(os.path.join(setPath, name), "w") as outputFile:
+            for index, run in enumerate(runs):
+                filename = os.path.join(run.workPath, name)
+                if not os.path.isfile(filename):
+                    continue
+                with open(filename, "r") as inputFile:
+                    runHeader = inputFile.readline()
+                    if header is None:
+                        header = runHeader
+                        outputFile.write(header)
+                    elif runHeader != header:
+                        raise RuntimeError("{}: the record format of {} "
+                                           "differs".format(name,
+                                                            run.dumpPath))
+                    for rowIndex, line in enumerate(inputFile):
+                        if index == 0 or rowIndex >= WARMUP_ROWS:
+                            outputFile.write(line)
+
+    return names
+
+def compareBoards(mitig, scenario, name, runs):
+    """
+        Compares the execution times of the boards of a configuration for
+        every partition of a benchmark file. This function is executed by the
+        workers of the pool.
+
+    Parameters
+    ----------
+        mitig : str (in)
+            The mitigation of the configuration.
+        scenario : str (in)
+            The scenario of the configuration.
+        name : str (in)
+            The name of the benchmark file.
+        runs : List[Run] (in)
+            The runs of the configuration.
+
+    Return
+    ----------
+        The list of rows (dictionaries), one per partition measured by at
+        least two runs.
+
+    Raises
+    ----------
+        IOError can be raised during the files manipulations.
+    """
+    samples = {}
+    for run in runs:
+        filename = os.path.join(run.workPath, name)
+        if not os.path.isfile(filename):
+            continue
+        dataFrame = StatsCache.loadDataFrame(filename)
+        if METRIC not in dataFrame.columns:
+            continue
+        for partId, group in dataFrame.groupby("Id"):
+            samples.setdefault(int(partId), []).append(
+                group[METRIC].to_numpy(dtype = float))
+
+    rows = []
+    for partId, boardSamples in sorted(samples.items()):
+        boardSamples = [values for values in boardSamples if len(values) > 0]
+        if len(boardSamples) < 2:
+            continue
+
+        means = [np.mean(values) for values in boardSamples]
+        # The capped p-value warning is expected on large campaigns
+        with warnings.catch_warnings():
+            warnings.simplefilter("ignore")
+            try:
+                pValue = float(stats.anderson_ksamp(boardSamples).pvalue)
+            except ValueError:
+                # All the samples are equal
+                pValue = 1.0
+
+        rows.append({
+            "Mitigation":   mitig,
+            "Set":          scenario,
+            "File":         name,
+            "Part":         partId,
+            "Boards":       len(boardSamples),
+            "Samples":      sum([len(values) for values in boardSamples]),
+            "MinBoardMean": min(means),
+            "MaxBoardMean": max(means),
+            "Spread":       (max(means) - min(means)) / min(means) * 100.0
+                            if min(means) > 0 else 0.0,
+            "PValue":       pValue
+        })
+
+    return rows
+
+def writeManifests(outputFile, runs):
+    """
+        Writes the campaign manifest of every run in CSV format.
+
+    Parameters
+    ----------
+        outputFile : File (out)
+            The file to write the table to.
+        runs : List[Run] (in)
+            The placed runs.
+
+    Return
+    ----------
+        None.
+
+    Raises
+    ----------
+        IOError can be raised during the files manipulations.
+    """
+    columns = ["Board", "Firmware", "Scenario", "Mitigation", "StartDate",
+               "EndDate", "PmcEvents"]
+    outputFile.write(",".join(columns) + ",Dump,Folder\n")
+    for run in runs:
+        outputFile.write(",".join([run.manifest[column] for column in columns])
+                         + ",{},{}\n".format(run.dumpPath, run.workPath))
+
+def writeVariance(outputFile, rows, alpha, tolerance):
+    """
+        Writes the board to board comparison rows in CSV format.
+
+    Parameters
+    ----------
+        outputFile : File (out)
+            The file to write the table to.
+        rows : List[dict] (in)
+            The comparison rows.
+        alpha : float (in)
+            The significance level of the test.
+        tolerance : float (in)
+            The tolerated spread of the board means (%).
+
+    Return
+    ----------
+        None.
+
+    Raises
+    ----------
+        IOError can be raised during the files manipulations.
+    """
+    columns = ["Mitigation", "Set", "File", "Part", "Boards", "Samples",
+               "MinBoardMean", "MaxBoardMean", "Spread", "PValue"]
+    outputFile.write(",".join(columns) + ",Flagged\n")
+    for row in rows:
+        outputFile.write(",".join(["{:.6g}".format(row[column])
+                                   if isinstance(row[column], float) else
+                                   str(row[column]) for column in columns]) +
+                         ",{}\n".format(int(isFlagged(row, alpha,
+                                                      tolerance))))
+
+def isFlagged(row, alpha, tolerance):
+    """
+        Tells if the boards of a comparison row differ: the distributions
+        differ at the alpha level and the spread of the board means exceeds
+        the tolerance.
+
+    Parameters
+    ----------
+        row : dict (in)
+            The comparison row.
+        alpha : float (in)
+            The significance level of the test.
+        tolerance : float (in)
+            The tolerated spread of the board means (%).
+
+    Return
+    ----------
+        True if the row is flagged, False otherwise.
+
+    Raises
+    ----------
+        None.
+    """
+    return row["PValue"] < alpha and row["Spread"] > tolerance
+
+def parseCommand():
+    """
+        Parses the command line to extract the following arguments:
+            -i [inputdirs] The board folders holding the dumps.
+            -o [outputdir] The merged dataset folder.
+            -t [tolerance] The tolerated spread of the board means (%).
+            -a [alpha] The significance level of the distribution test.
+            -j [jobs] The number of worker processes.
+
+    Parameters
+    ----------
+        None.
+
+    Return
+    ----------
+        The argparse object that contains the parsed command line (parse_args
+        is already called in this function).
+
+    Raises
+    ----------
+        None.
+    """
+    parser = argparse.ArgumentParser(description = "Campaign Aggregate Args Parser")
+
+    parser.add_argument("-i", type = str, nargs = "+", dest = "boardPaths",
+                        required = True,
+                        help = "Board folder paths, holding the dumps")
+    parser.add_argument("-o", type = str, nargs = "?", dest = "outputPath",
+                        default = "campaign",
+                        help = "Merged dataset output folder path")
+    parser.add_argument("-t", type = float, nargs = "?", dest = "tolerance",
+                        default = DEFAULT_TOLERANCE,
+                        help = "Tolerated spread of the board means in percent "
+                               "(default: 5)")
+    parser.add_argument("-a", type = float, nargs = "?", dest = "alpha",
+                        default = DEFAULT_ALPHA,
+                        help = "Significance level of the distribution test")
+    parser.add_argument("-j", type = int, nargs = "?", dest = "jobs",
+                        default = os.cpu_count(),
+                        help = "Number of worker processes")
+
+    return parser.parse_args()
+
+if __name__ == "__main__":
+    # Get the arguments
+    args = parseCommand()
+
+    outputPath  = os.path.abspath(args.outputPath)
+    stagingPath = os.path.join(outputPath, STAGING_FOLDER)
+    if os.path.isdir(stagingPath):
+        shutil.rmtree(stagingPath)
+
+    dumps = findDumps(args.boardPaths)
+    if len(dumps) == 0:
+        print("No dump found")
+        sys.exit(2)
+
+    # Extract the dumps in parallel
+    print("Extracting {} dumps with {} processes...".format(len(dumps),
+                                                            args.jobs))
+    runs = [Run(dump, os.path.join(stagingPath, str(index)))
+            for index, dump in enumerate(dumps)]
+    with concurrent.futures.ProcessPoolExecutor(args.jobs) as executor:
+        futures = {executor.submit(extractDump, run.dumpPath, run.workPath): run
+                   for run in runs}
+        for future in concurrent.futures.as_completed(futures):
+            run = futures[future]
+            try:
+                run.manifest = future.result()
+            except Exception as exc:
+                run.error = "extraction failed ({}), see {}".format(
+                    exc, os.path.join(run.workPath, LOG_FILENAME))
+                continue
+            if run.manifest is None:
+                run.error = "no campaign manifest"
+            elif "" in run.getConfiguration():
+                run.error = "no scenario or mitigation in the manifest"
+
+    # The staging folder keeps the logs of the dumps that were not placed
+    for run in runs:
+        if run.error is not None:
+            print("Skipping {}: {}".format(run.dumpPath, run.error))
+    skipped = len([run for run in runs if run.error is not None])
+    runs = [run for run in runs if run.error is None]
+    if len(runs) == 0:
+        print("No dump with a campaign manifest")
+        sys.exit(2)
+
+    runs.sort(key = lambda run: (run.manifest["Board"],
+                                 run.manifest["StartDate"], run.dumpPath))
+    placeRuns(runs, outputPath)
+    if skipped == 0:
+        shutil.rmtree(stagingPath)
+
+    with open(os.path.join(outputPath, "campaign_manifest.csv"), "w") as outputFile:
+        writeManifests(outputFile, runs)
+
+    # Merge the configurations measured with the same counter schema
+    configs = {}
+    for run in runs:
+        configs.setdefault(run.getConfiguration(), []).append(run)
+
+    print("---------------------------------")
+    rejected = 0
+    merged   = []
+    for (mitig, scenario), configRuns in sorted(configs.items()):
+        name = mitig + "_mitig/" + scenario
+        if len(set([run.manifest["PmcEvents"] for run in configRuns])) > 1:
+            print("NOT MERGED {}: the boards count different events ({})"
+                  .format(name, ", ".join(["{}: {}".format(
+                      run.manifest["Board"], run.manifest["PmcEvents"])
+                      for run in configRuns])))
+            rejected += 1
+            continue
+        firmwares = sorted(set([run.manifest["Firmware"]
+                                for run in configRuns]))
+        if len(firmwares) > 1:
+            print("WARNING {}: the boards run different firmwares ({})"
+                  .format(name, ", ".join(firmwares)))
+
+        try:
+            names = mergeConfiguration(configRuns,
+                                       os.path.join(outputPath,
+                                                    mitig + "_mitig",
+                                                    scenario))
+        except RuntimeError as exc:
+            print("NOT MERGED {}: {}".format(name, exc))
+            rejected += 1
+            continue
+        print("{}: {} run(s) on {} board(s), {} file(s)".format(
+              name, len(configRuns),
+              len(set([run.manifest["Board"] for run in configRuns])),
+              len(names)))
+        merged += [(mitig, scenario, filename, configRuns)
+                   for filename in names]
+
+    # Compare the boards of every merged file in parallel
+    rows = []
+    with concurrent.futures.ProcessPoolExecutor(args.jobs) as executor:
+        futures = [executor.submit(compareBoards, mitig, scenario, filename,
+                                   configRuns)
+                   for mitig, scenario, filename, configRuns in merged
+                   if len(configRuns) > 1]
+        for future in concurrent.futures.as_completed(futures):
+            rows += future.result()
+    rows.sort(key = lambda row: (row["Mitigation"], row["Set"], row["File"],
+                                 row["Part"]))
+
+    with open(os.path.join(outputPath, "board_variance.csv"), "w") as outputFile:
+        writeVariance(outputFile, rows, args.alpha, args.tolerance)
+
+    flagged = [row for row in rows if isFlagged(row, args.alpha,
+                                                args.tolerance)]
+    for row in flagged:
+        print("VARIANCE {}_mitig/{} {} part {}: board means spread {:.2f}% "
+              "(p-value {:.2g})".format(row["Mitigation"], row["Set"],
+                                        row["File"], row["Part"],
+                                        row["Spread"], row["PValue"]))
+    print("---------------------------------")
+    print("{} run(s), {} configuration(s) merged, {} partition(s) compared "
+          "across boards, {} flagged (alpha {:g}, tolerance {:.1f}%)".format(
+          len(runs), len(configs) - rejected, len(rows), len(flagged),
+          args.alpha, args.tolerance))
+    if rejected > 0:
+        print("{} configuration(s) not merged".format(rejected))
+        sys.exit(1)
+
+    print("Aggregation finished without error")
@@ -0,0 +1,454 @@
+################################################################################
+# CampaignCompare.py
+#
+# Description: This python script compares a candidate measurement campaign to
+# a reference campaign, typically before and after an update of the RTOS, the
+# BSP or a mitigation. The configurations (mitigation, set and file) of both
+# dataset trees are matched and compared partition by partition in parallel.
+#
+# For every partition and metric, the distributions are compared with a two
+# samples test (-d ks for Kolmogorov-Smirnov, -d ad for Anderson-Darling) and
+# the relative shifts of the mean, the 99th percentile and the maximum are
+# computed with bootstrap confidence intervals. A statistic regresses when the
+# distributions differ at the -a level and the lower bound of its shift
+# interval exceeds the tolerance (-t), so the run to run noise of a campaign
+# does not flag a regression.
+#
+# The full comparison is written to a CSV file (-o), the regressions are
+# reported on the standard output. The script exits with 1 when a statistic
+# regresses and with 2 when the campaigns cannot be loaded.
+#
+# Both input folders must follow the same rules as for DataVisualizer.py.
+#
+# Author: Alexy Torres Aurora Dugo
+#
+# Date: 03/03/2022
+################################################################################
+
+
+################################################################################
+# IMPORTS
+################################################################################
+import os
+import sys
+import zlib
+import argparse
+import warnings
+import concurrent.futures
+import numpy as np
+from scipy import stats
+
+import StatsCache
+import MitigationRanking
+
+################################################################################
+# CONSTANTS
+################################################################################
+PARTITION_COUNT = 10
+STATISTICS      = MitigationRanking.STATISTICS
+TESTS           = ["ks", "ad"]
+
+DEFAULT_FILES = "PART_output.csv,SC_output.csv,IntINT_output.csv," \
+                "ExtINT_output.csv,IPI_output.csv"
+DEFAULT_METRICS   = "ExecTime"
+DEFAULT_TOLERANCE = 5.0
+DEFAULT_ALPHA     = 0.05
+
+################################################################################
+# GLOBAL VARIABLES
+################################################################################
+
+# None
+
+################################################################################
+# CLASSES
+################################################################################
+
+class Configuration:
+    """
+    Describes a configuration measured in both campaigns: the mitigation, the
+    set (Baseline or environment, interrupt type and rate), the file name and
+    the reference and candidate files.
+    """
+    def __init__(self, mitig, setName, name, reference, candidate):
+        self.mitig     = mitig
+        self.setName   = setName
+        self.name      = name
+        self.reference = reference
+        self.candidate = candidate
+
+    def getName(self):
+        return "{};{};{}".format(self.mitig, self.setName, self.name)
+
+################################################################################
+# FUNCTIONS
+################################################################################
+def compareDistributions(reference, candidate, test):
+    """
+        Computes the p-value of the two samples test of the null hypothesis
+        that both samples come from the same distribution.
+
+    Parameters
+    ----------
+        reference : np.ndarray (in)
+            The reference samples.
+        candidate : np.ndarray (in)
+            The candidate samples.
+        test : str (in)
+            The test to use: ks or ad.
+
+    Return
+    ----------
+        The p-value of the test. The Anderson-Darling p-value is floored at
+        0.001 and capped at 0.25.
+
+    Raises
+    ----------
+        None.
+    """
+    if test == "ks":
+        return float(stats.ks_2samp(reference, candidate).pvalue)
+
+    # The capped p-value warning is expected on large campaigns
+    with warnings.catch_warnings():
+        warnings.simplefilter("ignore")
+        try:
+            return float(stats.anderson_ksamp([reference, candidate]).pvalue)
+        except ValueError:
+            # All the samples are equal
+            return 1.0
+
+def processConfiguration(config, metrics, test, bootCount, confidence, seed):
+    """
+        Compares the candidate measurements of a configuration to the
+        reference ones for each partition and metric. This function is
+        executed by the workers of the pool.
+
+    Parameters
+    ----------
+        config : Configuration (in)
+            The configuration to process.
+        metrics : List[str] (in)
+            The compared metrics.
+        test : str (in)
+            The two samples test to use.
+        bootCount : int (in)
+            The number of bootstrap replicates.
+        confidence : float (in)
+            The confidence level of the intervals.
+        seed : int (in)
+            The random generator seed.
+
+    Return
+    ----------
+        The tuple (config, results) where results is a dictionary indexed by
+        (partition ID, metric) containing the test p-value and the dictionary
+        of the tuples (shift, ciLow, ciHigh) indexed by statistic. The shifts
+        are relative to the reference statistic, in percent.
+
+    Raises
+    ----------
+        IOError, RuntimeError and others can be raised during the files
+        manipulations.
+    """
+    # Each configuration has its own reproducible random stream
+    rng = np.random.default_rng([seed, zlib.crc32(config.getName().encode())])
+
+    refData  = StatsCache.loadDataFrame(config.reference)
+    candData = StatsCache.loadDataFrame(config.candidate)
+
+    alpha   = (1.0 - confidence) / 2.0
+    results = {}
+
+    for partId in range(PARTITION_COUNT):
+        refPart  = refData[refData["Id"] == partId]
+        candPart = candData[candData["Id"] == partId]
+        if len(refPart) == 0 or len(candPart) == 0:
+            continue
+
+        for metric in metrics:
+            if metric not in refPart or metric not in candPart:
+                continue
+
+            reference = refPart[metric].values.astype(np.float64)
+            candidate = candPart[metric].values.astype(np.float64)
+
+            refStats  = MitigationRanking.computeStatistics(reference)
+            candStats = MitigationRanking.computeStatistics(candidate)
+            replicates = MitigationRanking.bootstrapPartition(candidate,
+                                                              reference,
+                                                              bootCount, rng)
+
+            shifts = {}
+            for stat in STATISTICS:
+                if refStats[stat] == 0:
+                    continue
+                low, high = np.quantile(replicates[stat], [alpha, 1.0 - alpha])
+                shifts[stat] = (float(candStats[stat] / refStats[stat] - 1) * 100.0,
+                                float(low - 1) * 100.0, float(high - 1) * 100.0)
+
+            results[(partId, metric)] = (compareDistributions(reference,
+                                                              candidate, test),
+                                         shifts)
+
+    return config, results
+
+def getConfigurations(referencePath, candidatePath, filenames):
+    """
+        Matches the configurations of the reference and the candidate
+        campaigns by walking both input directories.
+
+    Parameters
+    ----------
+        referencePath : str (in)
+            The path to the reference campaign directory.
+        candidatePath : str (in)
+            The path to the candidate campaign directory.
+        filenames : List[str] (in)
+            The names of the compared files in each set.
+
+    Return
+    ----------
+        The tuple (configs, missing, new) where configs is the list of
+        matched configurations, missing and new the names of the
+        configurations only found in the reference and in the candidate.
+
+    Raises
+    ----------
+        IOError can be raised during the files manipulations.
+    """
+    def walk(rootPath):
+        files = {}
+        for folder in sorted(os.listdir(rootPath)):
+            splited = folder.split("_")
+            if(len(splited) != 2 or splited[1] != "mitig"):
+                continue
+            for sets in sorted(os.listdir(os.path.join(rootPath, folder))):
+                if(len(sets.split("_")) != 3 and sets != "Baseline"):
+                    continue
+                for name in filenames:
+                    filename = os.path.join(rootPath, folder, sets, name)
+                    if os.path.isfile(filename):
+                        files[(splited[0], sets, name)] = filename
+        return files
+
+    refFiles  = walk(referencePath)
+    candFiles = walk(candidatePath)
+
+    configs = [Configuration(key[0], key[1], key[2], refFiles[key],
+                             candFiles[key])
+               for key in sorted(refFiles.keys()) if key in candFiles]
+    missing = [";".join(key) for key in sorted(refFiles.keys())
+               if key not in candFiles]
+    new     = [";".join(key) for key in sorted(candFiles.keys())
+               if key not in refFiles]
+
+    return configs, missing, new
+
+def findRegressions(results, alpha, tolerance):
+    """
+        Lists the regressed statistics: the distributions differ at the alpha
+        level and the lower bound of the shift interval exceeds the tolerance.
+
+    Parameters
+    ----------
+        results : List[] (in)
+            The list of tuples (config, results) generated by
+            processConfiguration.
+        alpha : float (in)
+            The significance level of the distribution test.
+        tolerance : float (in)
+            The tolerated increase of the statistics (%).
+
+    Return
+    ----------
+        The list of tuples (config, partId, metric, stat, pValue, shift).
+
+    Raises
+    ----------
+        None.
+    """
+    regressions = []
+
+    for config, configResults in results:
+        for (partId, metric), (pValue, shifts) in sorted(configResults.items()):
+            if pValue >= alpha:
+                continue
+            for stat in STATISTICS:
+                if stat in shifts and shifts[stat][1] > tolerance:
+                    regressions.append((config, partId, metric, stat, pValue,
+                                        shifts[stat]))
+
+    return regressions
+
+def writeDetails(outputFile, results):
+    """
+        Writes the comparison of every configuration, partition and metric in
+        CSV format.
+
+    Parameters
+    ----------
+        outputFile : File (out)
+            The file to write the table to.
+        results : List[] (in)
+            The list of tuples (config, results) generated by
+            processConfiguration.
+
+    Return
+    ----------
+        None.
+
+    Raises
+    ----------
+        IOError can be raised during the file manipulations.
+    """
+    header = "mitig,set,file,partId,metric,p-value"
+    for stat in STATISTICS:
+        header += ",{0} shift,{0} ci low,{0} ci high".format(stat)
+    print(header, file = outputFile)
+
+    for config, configResults in results:
+        for (partId, metric), (pValue, shifts) in sorted(configResults.items()):
+            line = "{},{},{},{},{},{:.4g}".format(config.mitig, config.setName,
+                                                  config.name, partId, metric,
+                                                  pValue)
+            for stat in STATISTICS:
+                if stat in shifts:
+                    line += ",{:.3f},{:.3f},{:.3f}".format(*shifts[stat])
+                else:
+                    line += ",,,"
+            print(line, file = outputFile)
+
+def parseCommand():
+    """
+        Parses the command line to extract the following arguments:
+            -r [inputdir] The reference campaign directory.
+            -c [inputdir] The candidate campaign directory.
+            -o [file] The comparison CSV output file.
+            -f [files] The names of the compared files.
+            -m [metrics] The compared metrics.
+            -d [test] The two samples test (ks or ad).
+            -t [tolerance] The tolerated increase of the statistics (%).
+            -a [alpha] The significance level of the distribution test.
+            -b [count] The number of bootstrap replicates.
+            -l [confidence] The confidence level of the intervals.
+            -j [jobs] The number of worker processes.
+            -s [seed] The random generator seed.
+
+    Parameters
+    ----------
+        None.
+
+    Return
+    ----------
+        The argparse object that contains the parsed command line (parse_args
+        is already called in this function).
+
+    Raises
+    ----------
+        None.
+    """
+    parser = argparse.ArgumentParser(description = "Campaign Compare Args Parser")
+
+    parser.add_argument("-r", type = str, nargs = "?", dest = "referencePath",
+                        required = True,
+                        help = "Reference campaign root folder path")
+    parser.add_argument("-c", type = str, nargs = "?", dest = "candidatePath",
+                        required = True,
+                        help = "Candidate campaign root folder path")
+    parser.add_argument("-o", type = str, nargs = "?", dest = "outputFilename",
+                        default = "campaign_compare.csv",
+                        help = "Comparison output file")
+    parser.add_argument("-f", type = str, nargs = "?", dest = "files",
+                        default = DEFAULT_FILES,
+                        help = "Comma separated names of the compared files")
+    parser.add_argument("-m", type = str, nargs = "?", dest = "metrics",
+                        default = DEFAULT_METRICS,
+                        help = "Comma separated compared metrics (default: " +
+                               DEFAULT_METRICS + ")")
+    parser.add_argument("-d", type = str, nargs = "?", dest = "test",
+                        default = "ks", choices = TESTS,
+                        help = "Two samples distribution test")
+    parser.add_argument("-t", type = float, nargs = "?", dest = "tolerance",
+                        default = DEFAULT_TOLERANCE,
+                        help = "Tolerated increase of the mean, 99th percentile "
+                               "and maximum in percent (default: 5)")
+    parser.add_argument("-a", type = float, nargs = "?", dest = "alpha",
+                        default = DEFAULT_ALPHA,
+                        help = "Significance level of the distribution test")
+    parser.add_argument("-b", type = int, nargs = "?", dest = "bootCount",
+                        default = MitigationRanking.DEFAULT_BOOTSTRAP_COUNT,
+                        help = "Number of bootstrap replicates")
+    parser.add_argument("-l", type = float, nargs = "?", dest = "confidence",
+                        default = MitigationRanking.DEFAULT_CONFIDENCE,
+                        help = "Confidence level of the intervals")
+    parser.add_argument("-j", type = int, nargs = "?", dest = "jobs",
+                        default = os.cpu_count(),
+                        help = "Number of worker processes")
+    parser.add_argument("-s", type = int, nargs = "?", dest = "seed",
+                        default = MitigationRanking.DEFAULT_SEED,
+                        help = "Bootstrap random generator seed")
+
+    return parser.parse_args()
+
+if __name__ == "__main__":
+    # Get the arguments
+    args = parseCommand()
+
+    try:
+        configs, missing, new = getConfigurations(args.referencePath,
+                                                  args.candidatePath,
+                                                  args.files.split(","))
+    except IOError as exc:
+        print("Error while loading the campaigns: " + str(exc))
+        sys.exit(2)
+
+    if len(configs) == 0:
+        print("No configuration common to both campaigns")
+        sys.exit(2)
+
+    # Compare the configurations in parallel
+    print("Comparing {} configurations with {} processes...".format(
+          len(configs), args.jobs))
+    results = []
+    try:
+        with concurrent.futures.ProcessPoolExecutor(args.jobs) as executor:
+            futures = [executor.submit(processConfiguration, config,
+                                       args.metrics.split(","), args.test,
+                                       args.bootCount, args.confidence,
+                                       args.seed)
+                       for config in configs]
+            for future in concurrent.futures.as_completed(futures):
+                results.append(future.result())
+    except (IOError, RuntimeError) as exc:
+        print("Error while loading the campaigns: " + str(exc))
+        sys.exit(2)
+
+    results.sort(key = lambda item: item[0].getName())
+
+    with open(args.outputFilename, "w") as outputFile:
+        writeDetails(outputFile, results)
+
+    print("---------------------------------")
+    for name in missing:
+        print("{} missing in the candidate".format(name))
+    for name in new:
+        print("{} new in the candidate".format(name))
+
+    regressions = findRegressions(results, args.alpha, args.tolerance)
+    for config, partId, metric, stat, pValue, shift in regressions:
+        print("REGRESSION {} part {} {} {}: {:+.2f}% [{:+.2f}%, {:+.2f}%] "
+              "(p-value {:.2g})".format(config.getName(), partId, metric, stat,
+                                        *shift, pValue))
+    print("---------------------------------")
+
+    compared = sum([len(configResults) for _, configResults in results])
+    print("{} configurations, {} partition metrics compared ({} test, "
+          "alpha {:g}, tolerance {:.1f}%)".format(len(results), compared,
+                                                  args.test, args.alpha,
+                                                  args.tolerance))
+    if 0 < len(regressions):
+        print("{} statistic(s) regressed".format(len(regressions)))
+        sys.exit(1)
+
+    print("No regression")
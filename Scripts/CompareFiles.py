@@ -7,6 +7,8 @@ import numpy as np
 import matplotlib.pyplot as plt
 from matplotlib.pyplot import cm
 
+import StatsCache
+
 PARTITION_COUNT = 10
 METRICS = ["ExecTime", "l2Miss"]
 #ENVTEST = ["Baseline", "ALL", "IPI", "SC", "EXT", "INT"]
@@ -17,6 +19,7 @@ detectedMitigation = []
 class DataObject:
     def __init__(self):
         self.dataFrame = None
+        self.summary   = {}
         self.min       = {}
         self.max       = {}
         self.mean      = {}
@@ -45,7 +48,12 @@ def printDataObject(obj):
             print("\t\tMin: {}\n\t\tMax: {}\n\t\tAvg: {}\n\t\tMed: {}\n\t\tStd: {}".format(obj.min[i][metric], obj.max[i][metric], obj.mean[i][metric], obj.median[i][metric], obj.stdev[i][metric]))
 
     for metric in METRICS:
-        obj.dataFrame.hist(column = metric, by = "Id", bins = 50)
+        fig = plt.figure(figsize =(10, 7))
+        for i in range(PARTITION_COUNT):
+            ax = fig.add_subplot(2, (PARTITION_COUNT + 1) // 2, i + 1)
+            values, weights, edges = StatsCache.getHistogram(obj.summary[i][metric], 50)
+            ax.hist(values, edges, weights=weights)
+            ax.set_title(str(i))
         plt.show()
 
 def printParitionsData(partitions):
@@ -55,22 +63,32 @@ def printParitionsData(partitions):
             print("\tMitig: " + mitig)
             for typeInf, dataTypeInf in dataInf.items():
                 print("\t\tType: " + typeInf)
-                for intInf, dataFrame in dataTypeInf.items():
+                for intInf, summary in dataTypeInf.items():
                     print("\t\t\tInt: " + str(intInf))
-                    #print(dataFrame)
+                    #print(summary)
 
-def genHistTypes(partitionsData, partId, metric):
+def genHistTypes(partitionsData, partId, metric, mitigations = None,
+                 outputPrefix = None, show = True):
     for mitig, typeData in partitionsData[partId].items():
+        if mitigations is not None and mitig not in mitigations:
+            continue
 
         fig = plt.figure(figsize =(10, 7))
         ax = fig.add_subplot(111)
         for typeInf, dataTypeInf in typeData.items():
-            for intInf, dataFrame in dataTypeInf.items():
-                ax.hist(dataFrame[metric], 200, density=True, histtype='bar', label=typeInf)
+            for intInf, summary in dataTypeInf.items():
+                values, weights, edges = StatsCache.getHistogram(summary[metric], 200)
+                ax.hist(values, edges, weights=weights, density=True, histtype='bar', label=typeInf)
 
         plt.legend(prop={'size': 10})
         plt.title("Partition " + str(partId) + " | " + metric + " | Mitigation: " + mitig)
-        plt.show(block=False)
+        if outputPrefix is not None:
+            plt.savefig(outputPrefix + mitig + ".png")
+            plt.savefig(outputPrefix + mitig + ".pdf")
+        if show:
+            plt.show(block=False)
+        else:
+            plt.close(fig)
 
 def genBoxplotTypes(partitionsData, partId, metric):
     for mitig, typeData in partitionsData[partId].items():
@@ -78,19 +96,17 @@ def genBoxplotTypes(partitionsData, partId, metric):
         labels = []
 
         for typeInf, dataTypeInf in typeData.items():
-                for intInf, dataFrame in dataTypeInf.items():
-                    #print(dataFrame
-                    #plt.hist(dataFrame[metric], n_bins, density=True, histtype='bar', label=typeInf)
+                for intInf, summary in dataTypeInf.items():
                     if(typeInf == "Baseline"):
-                        filteredData.insert(0, dataFrame[metric])
+                        filteredData.insert(0, StatsCache.getBoxStats(summary[metric]))
                         labels.insert(0, typeInf)
                     else:
-                        filteredData.append(dataFrame[metric])
+                        filteredData.append(StatsCache.getBoxStats(summary[metric]))
                         labels.append(typeInf)
 
         fig = plt.figure(figsize =(10, 7))
         ax = fig.add_subplot(111)
-        bp = ax.boxplot(filteredData, notch ='True', vert = 1)
+        bp = ax.bxp(filteredData, shownotches=True)
         ax.set_xticklabels(labels)
 
         plt.legend(prop={'size': 10})
@@ -117,8 +133,8 @@ def genBoxplotTypesComp(partitionsData, partId, metric):
                 mitigDict[mitig] = i
                 mitigDictInv[i] = mitig
                 i += 1
-            for intInf, dataFrame in typeData[envName].items():
-                filteredData[mitigDict[mitig]].append(dataFrame[metric])
+            for intInf, summary in typeData[envName].items():
+                filteredData[mitigDict[mitig]].append(StatsCache.getBoxStats(summary[metric]))
 
     fig = plt.figure(figsize =(3, 6))
     ax = fig.add_subplot(111)
@@ -127,7 +143,7 @@ def genBoxplotTypesComp(partitionsData, partId, metric):
 
     colIdx = 0
     for data in filteredData:
-        bp = ax.boxplot(data, notch ='True', vert = 1, widths=0.4, positions=np.array(range(len(data)))*5.0+offset, sym='.')
+        bp = ax.bxp(data, shownotches=True, widths=0.4, positions=np.array(range(len(data)))*5.0+offset, flierprops={"marker": "."})
         offset += 0.5
         c = next(color)
         colIdx += 1
@@ -173,24 +189,17 @@ def parseFilename(filename, dataObj):
 
         dataObj.intensity = 1.0 / float(intBase + intVal)
 
-def generateDataObject(filename):
+def generateDataObject(filename, cache):
 
     dataObj = DataObject()
 
     print("Extracting {}...".format(filename))
 
-    # Get file
-    dataFrame = pd.read_csv(filename)
-
     # Get file attributes
     parseFilename(filename, dataObj)
 
-    # Drop the first 2 executions for each partition, they contain noisy measurements
-    dataFrame.drop(index =dataFrame.index[:PARTITION_COUNT * 2] , axis = "index", inplace = True)
-
-    # Drop the first column and sort by partition ID
-    dataFrame.drop(labels = "Type", axis = "columns", inplace = True)
-    dataFrame.sort_values(by = "Id", axis = "index", inplace = True)
+    # Get the file summaries, the file is only parsed if not cached or modified
+    dataObj.summary = cache.getSummary(filename)
 
     # Compute data
     for partId in range(PARTITION_COUNT):
@@ -201,31 +210,14 @@ def generateDataObject(filename):
         dataObj.stdev[partId]    = {}
         dataObj.outliers[partId] = {}
 
-    for colName in dataFrame:
-        if(colName not in METRICS): continue
-
-        minTable = dataFrame.groupby("Id")[colName].min()
-        medianTable = dataFrame.groupby("Id")[colName].median()
-        maxTable = dataFrame.groupby("Id")[colName].max()
-        meanTable = dataFrame.groupby("Id")[colName].mean()
-        stdevTable = dataFrame.groupby("Id")[colName].std()
-        outliersTable = dataFrame.groupby("Id")[colName]
-
-        q1 = dataFrame.groupby("Id")[colName].quantile(0.25)
-        q3 = dataFrame.groupby("Id")[colName].quantile(0.75)
-
-        for partId in range(PARTITION_COUNT):
-            dataObj.min[partId][colName]       = minTable[partId]
-            dataObj.max[partId][colName]       = maxTable[partId]
-            dataObj.mean[partId][colName]      = meanTable[partId]
-            dataObj.median[partId][colName]    = medianTable[partId]
-            dataObj.stdev[partId][colName]     = stdevTable[partId]
-
-            iqr = q3[partId] - q1[partId]
-            curTable = outliersTable.get_group(partId)
-            dataObj.outliers[partId][colName] = ((outliersTable.get_group(partId) < (q1[partId] - 1.5 * iqr)) | (outliersTable.get_group(partId) > (q3[partId] + 1.5 * iqr))).sum()
-
-    dataObj.dataFrame = dataFrame
+        for colName in dataObj.summary[partId]:
+            summary = dataObj.summary[partId][colName]
+            dataObj.min[partId][colName]      = summary["min"]
+            dataObj.max[partId][colName]      = summary["max"]
+            dataObj.mean[partId][colName]     = summary["mean"]
+            dataObj.median[partId][colName]   = summary["median"]
+            dataObj.stdev[partId][colName]    = summary["stdev"]
+            dataObj.outliers[partId][colName] = summary["outliers"]
 
     return dataObj
 
@@ -243,7 +235,7 @@ def processDataObjects(dataObjArray):
                 partitions[i][dataObj.mitig] = {}
             if(dataObj.type not in partitions[i][dataObj.mitig]):
                 partitions[i][dataObj.mitig][dataObj.type] = {}
-            partitions[i][dataObj.mitig][dataObj.type][dataObj.intensity] = dataObj.dataFrame.groupby("Id").get_group(i)
+            partitions[i][dataObj.mitig][dataObj.type][dataObj.intensity] = dataObj.summary[i]
 
     return partitions
 
@@ -291,6 +283,11 @@ def parseCommand():
                         required = True,
                         help = "Dataset root folder path")
 
+    # Add command argument: statistics cache file
+    parser.add_argument("-c", type = str, nargs = "?", dest = "cachePath",
+                        default = None,
+                        help = "Statistics cache file path (default: "
+                               "<dataset root>/" + StatsCache.CACHE_FILENAME + ")")
 
     return parser.parse_args()
 
@@ -340,9 +337,17 @@ if __name__ == "__main__":
     args = parseCommand()
     files = getDataSetFiles(args.datasetPath)
 
+    # Load the statistics cache
+    if args.cachePath is None:
+        args.cachePath = StatsCache.getDefaultCachePath(args.datasetPath)
+    cache = StatsCache.StatsCache(args.cachePath)
+
     # Generate data object for each file
     for filename in files:
-        dataObjArray.append(generateDataObject(filename))
+        dataObjArray.append(generateDataObject(filename, cache))
+
+    cache.save()
+    print("Cache: {} hit(s), {} miss(es)".format(cache.hits, cache.misses))
 
     partitions = processDataObjects(dataObjArray)
 
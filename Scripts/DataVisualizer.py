@@ -38,6 +38,8 @@ import collections
 import pandas as pd
 import numpy as np
 
+import StatsCache
+
 import matplotlib.pyplot as plt
 from matplotlib.pyplot import cm
 from matplotlib import rcParams
@@ -47,6 +49,11 @@ from matplotlib import rcParams
 ################################################################################
 PARTITION_COUNT = 10
 METRICS = ["ExecTime", "l2Miss"]
+METRICS_LABELS = {"ExecTime": "Execution time (ns)",
+                  "l2Miss":   "L2 misses",
+                  "tlbMiss":  "L2MMU misses"}
+# Partitions displayed when running the visualizer interactively
+DISPLAYED_PARTITIONS = [2, 8]
 #ENVTEST = ["Baseline", "ALL", "IPI", "SC", "EXT", "INT"]
 ENVTEST = ["ALL"]
 
@@ -74,6 +81,7 @@ class DataObject:
     """
     def __init__(self):
         self.dataFrame = None
+        self.summary   = {}
         self.min       = {}
         self.max       = {}
         self.mean      = {}
@@ -111,7 +119,8 @@ def set_box_color(bp, color):
     plt.setp(bp['caps'], color=color)
     plt.setp(bp['medians'], color=color)
 
-def genBoxplotTypesComp(partitionsData, partId, metric):
+def genBoxplotTypesComp(partitionsData, partId, metric, envTest = None,
+                        mitigations = None, outputPrefix = None, show = True):
     """
         Displays box plots for a given partition of the specified metric.
 
@@ -123,6 +132,16 @@ def genBoxplotTypesComp(partitionsData, partId, metric):
             The partition to output the data of.
         metric : str (in)
             The specific metric to output.
+        envTest : List[str] (in)
+            The environments to display, ENVTEST is used if None.
+        mitigations : List[str] (in)
+            The mitigations to display, the detected mitigations are used if
+            None.
+        outputPrefix : str (in)
+            The path prefix of the PNG and PDF files to generate,
+            "Partition<partId>" is used if None.
+        show : bool (in)
+            Set to False to close the figure instead of displaying it.
 
     Return
     ----------
@@ -132,23 +151,28 @@ def genBoxplotTypesComp(partitionsData, partId, metric):
     ----------
         None.
     """
-    if partId != 8 and partId != 2:
-        return
-    typeDict = {}
-    typeDictInv = {}
-    color = iter(cm.rainbow(np.linspace(0, 1, len(ENVTEST))))
+    if envTest is None:
+        envTest = ENVTEST
+    if mitigations is None:
+        mitigations = detectedMitigation
+    if outputPrefix is None:
+        outputPrefix = "Partition" + str(partId)
+
+    color = iter(cm.rainbow(np.linspace(0, 1, len(envTest))))
 
-    filteredData = [[] for i in range(len(ENVTEST))]
-    i = 0
+    # Boxes are placed according to the mitigation index to support
+    # mitigations that do not provide all the environments.
+    filteredData = [[] for i in range(len(envTest))]
+    positions    = [[] for i in range(len(envTest))]
 
     for mitig, typeData in partitionsData[partId].items():
-        for envName in ENVTEST:
-            for intInf, dataFrame in typeData[envName].items():
-                if(envName not in typeDict):
-                    typeDict[envName] = i
-                    typeDictInv[i] = envName
-                    i += 1
-                filteredData[typeDict[envName]].append(dataFrame[metric])
+        if mitig not in mitigations:
+            continue
+        for envIdx, envName in enumerate(envTest):
+            for intInf, summary in typeData.get(envName, {}).items():
+                filteredData[envIdx].append(
+                    StatsCache.getBoxStats(summary[metric]))
+                positions[envIdx].append(mitigations.index(mitig) * 2)
 
     rcParams.update({'figure.autolayout': True})
     rcParams.update({'font.size': 20})
@@ -156,34 +180,39 @@ def genBoxplotTypesComp(partitionsData, partId, metric):
 
     fig = plt.figure(figsize = (16, 7))
     ax = fig.add_subplot(111)
-    i = 0
-    offset = 1 * (len(ENVTEST) / -5) + 0.3
+    offset = 1 * (len(envTest) / -5) + 0.3
 
-    for data in filteredData:
-        bp = ax.boxplot(data, notch ='True', vert = 1, widths=0.4,
-                        positions=np.array(range(len(data)))*2+offset,
-                        sym='.', showfliers=False)
-        offset += 0.5
+    for i, data in enumerate(filteredData):
         c = next(color)
-        plt.plot([], c=c, label=typeDictInv[i])
+        if len(data) == 0:
+            offset += 0.5
+            continue
+        bp = ax.bxp(data, shownotches = True, widths=0.4,
+                    positions=np.array(positions[i])+offset,
+                    flierprops = {"marker": "."}, showfliers=False)
+        offset += 0.5
+        plt.plot([], c=c, label=envTest[i])
         set_box_color(bp, c)
-        print("Adding plot: " + typeDictInv[i])
-        i += 1
+        print("Adding plot: " + envTest[i])
 
     #plt.legend()
 
-    plt.xticks(range(0, len(detectedMitigation) * 2, 2), detectedMitigation, rotation = 45)
-    plt.xlim(-1, len(detectedMitigation) * 2 - 1)
+    plt.xticks(range(0, len(mitigations) * 2, 2), mitigations, rotation = 45)
+    plt.xlim(-1, len(mitigations) * 2 - 1)
     #plt.tight_layout()
-    plt.ylabel('Execution time (ns)')
+    plt.ylabel(METRICS_LABELS.get(metric, metric))
     #plt.title("Partition " + str(partId) + " | " + metric)
-    plt.show(block=False)
+    if show:
+        plt.show(block=False)
 
+    plt.savefig(outputPrefix + ".png")
+    plt.savefig(outputPrefix + ".pdf")
 
-    plt.savefig("Partition" + str(partId) + ".png")
-    plt.savefig("Partition" + str(partId) + ".pdf")
+    if not show:
+        plt.close(fig)
 
-def genTypeCompCSV(dataArray, metric, partId = -1):
+def genTypeCompCSV(dataArray, metric, partId = -1, envTest = None,
+                   outputFile = None):
     """
         Prints out the objects containted in a DataArray for a given partition
         and a specific studied metric. The output is formated as a CSV output.
@@ -197,6 +226,10 @@ def genTypeCompCSV(dataArray, metric, partId = -1):
         partId : int (in)
             The partition to output the data of. Use -1 to output all the
             partitions contained in the dataArray.
+        envTest : List[str] (in)
+            The environments to output, ENVTEST is used if None.
+        outputFile : File (out)
+            The file to write the CSV to, the standard output is used if None.
 
     Return
     ----------
@@ -206,11 +239,15 @@ def genTypeCompCSV(dataArray, metric, partId = -1):
     ----------
         None.
     """
-    print("partId, metric, type, mitig, min, max, mean, median, stdev, outliers (val), outliers (%)")
+    if envTest is None:
+        envTest = ENVTEST
+
+    print("partId, metric, type, mitig, min, max, mean, median, stdev, outliers (val), outliers (%)",
+          file = outputFile)
     if partId == -1:
         for partId in range(PARTITION_COUNT):
             for dataObj in dataArray:
-                if dataObj.type in ENVTEST:
+                if dataObj.type in envTest:
                     print("{},{},{},{},{},{},{},{},{},{},{}".format(partId, metric, dataObj.type, dataObj.mitig,
                                                                     dataObj.min[partId][metric],
                                                                     dataObj.max[partId][metric],
@@ -218,10 +255,11 @@ def genTypeCompCSV(dataArray, metric, partId = -1):
                                                                     dataObj.median[partId][metric],
                                                                     dataObj.stdev[partId][metric],
                                                                     dataObj.outliers[partId][metric],
-                                                                    dataObj.outliers[partId][metric] / 10000 * 100))
+                                                                    dataObj.outliers[partId][metric] / 10000 * 100),
+                          file = outputFile)
     else:
         for dataObj in dataArray:
-                if dataObj.type in ENVTEST:
+                if dataObj.type in envTest:
                     print("{},{},{},{},{},{},{},{},{},{},{}".format(partId, metric, dataObj.type, dataObj.mitig,
                                                                     dataObj.min[partId][metric],
                                                                     dataObj.max[partId][metric],
@@ -229,7 +267,8 @@ def genTypeCompCSV(dataArray, metric, partId = -1):
                                                                     dataObj.median[partId][metric],
                                                                     dataObj.stdev[partId][metric],
                                                                     dataObj.outliers[partId][metric],
-                                                                    dataObj.outliers[partId][metric] / 10000 * 100))
+                                                                    dataObj.outliers[partId][metric] / 10000 * 100),
+                          file = outputFile)
 
 def parseFilename(filename, dataObj):
     """
@@ -281,10 +320,12 @@ def parseFilename(filename, dataObj):
 
         dataObj.intensity = 1.0 / float(intBase + intVal)
 
-def generateDataObject(filename):
+def generateDataObject(filename, cache):
     """
-        Generates a DataObject based on a file. The function extracts and parse the
-        data from the file and generates the dataObject.
+        Generates a DataObject based on a file. The function retrieves the
+        summaries of the file from the statistics cache (the file is only
+        parsed if it is not cached or was modified) and generates the
+        dataObject.
         Each dictionary of the dataObject has the following hierarchy:
 
         dataObj.min[PART_ID][MITIG_TYPE][INT_TYPE][INT_INTENSITY] -> DataFrame.
@@ -299,6 +340,8 @@ def generateDataObject(filename):
     ----------
         filename : str (in)
             The path to the file to extract and parse.
+        cache : StatsCache (in/out)
+            The statistics cache used to retrieve the file summaries.
 
     Return
     ----------
@@ -316,18 +359,11 @@ def generateDataObject(filename):
 
     print("Extracting {}...".format(filename))
 
-    # Get file
-    dataFrame = pd.read_csv(filename)
-
     # Get file attributes
     parseFilename(filename, dataObj)
 
-    # Drop the first 2 executions for each partition, they contain noisy measurements
-    dataFrame.drop(index =dataFrame.index[:PARTITION_COUNT * 2] , axis = "index", inplace = True)
-
-    # Drop the first column and sort by partition ID
-    dataFrame.drop(labels = "Type", axis = "columns", inplace = True)
-    dataFrame.sort_values(by = "Id", axis = "index", inplace = True)
+    # Get the file summaries
+    dataObj.summary = cache.getSummary(filename)
 
     # Compute data
     for partId in range(PARTITION_COUNT):
@@ -338,40 +374,21 @@ def generateDataObject(filename):
         dataObj.stdev[partId]    = {}
         dataObj.outliers[partId] = {}
 
-    for colName in dataFrame:
-        if(colName not in METRICS): continue
-
-        minTable = dataFrame.groupby("Id")[colName].min()
-        medianTable = dataFrame.groupby("Id")[colName].median()
-        maxTable = dataFrame.groupby("Id")[colName].max()
-        meanTable = dataFrame.groupby("Id")[colName].mean()
-        stdevTable = dataFrame.groupby("Id")[colName].std()
-        outliersTable = dataFrame.groupby("Id")[colName]
-
-        q1 = dataFrame.groupby("Id")[colName].quantile(0.25)
-        q3 = dataFrame.groupby("Id")[colName].quantile(0.75)
-
-        for partId in range(PARTITION_COUNT):
-            dataObj.min[partId][colName]       = minTable[partId]
-            dataObj.max[partId][colName]       = maxTable[partId]
-            dataObj.mean[partId][colName]      = meanTable[partId]
-            dataObj.median[partId][colName]    = medianTable[partId]
-            dataObj.stdev[partId][colName]     = stdevTable[partId]
-
-            iqr = q3[partId] - q1[partId]
-            curTable = outliersTable.get_group(partId)
-            dataObj.outliers[partId][colName] = \
-                ((outliersTable.get_group(partId) < (q1[partId] - 1.5 * iqr)) |
-                (outliersTable.get_group(partId) > (q3[partId] + 1.5 * iqr))).sum()
-
-    dataObj.dataFrame = dataFrame
+        for colName in dataObj.summary[partId]:
+            summary = dataObj.summary[partId][colName]
+            dataObj.min[partId][colName]      = summary["min"]
+            dataObj.max[partId][colName]      = summary["max"]
+            dataObj.mean[partId][colName]     = summary["mean"]
+            dataObj.median[partId][colName]   = summary["median"]
+            dataObj.stdev[partId][colName]    = summary["stdev"]
+            dataObj.outliers[partId][colName] = summary["outliers"]
 
     return dataObj
 
 def processDataObjects(dataObjArray):
     """
         Cleans the dataObjects in the dataObjArray and returns the per-partition
-        array that contains the dataframes of each partition indexed by the
+        array that contains the summaries of each partition indexed by the
         partition ID.
 
     Parameters
@@ -381,7 +398,7 @@ def processDataObjects(dataObjArray):
 
     Return
     ----------
-        This function returns the list of dataframes organized in dictionaries
+        This function returns the list of summaries organized in dictionaries
         and indexed by the partition ID.
 
     Raises
@@ -400,7 +417,7 @@ def processDataObjects(dataObjArray):
                 partitions[i][dataObj.mitig] = {}
             if(dataObj.type not in partitions[i][dataObj.mitig]):
                 partitions[i][dataObj.mitig][dataObj.type] = {}
-            partitions[i][dataObj.mitig][dataObj.type][dataObj.intensity] = dataObj.dataFrame.groupby("Id").get_group(i)
+            partitions[i][dataObj.mitig][dataObj.type][dataObj.intensity] = dataObj.summary[i]
 
     return partitions
 
@@ -447,6 +464,7 @@ def parseCommand():
     """
         Parses the command line to extract the following arguments:
             -d [inputdir] The input directory to parse the extracted files.
+            -c [cachefile] The statistics cache file.
 
     Parameters
     ----------
@@ -468,6 +486,11 @@ def parseCommand():
                         required = True,
                         help = "Dataset root folder path")
 
+    # Add command argument: statistics cache file
+    parser.add_argument("-c", type = str, nargs = "?", dest = "cachePath",
+                        default = None,
+                        help = "Statistics cache file path (default: "
+                               "<dataset root>/" + StatsCache.CACHE_FILENAME + ")")
 
     return parser.parse_args()
 
@@ -503,13 +526,21 @@ if __name__ == "__main__":
     args = parseCommand()
     files = getDataSetFiles(args.datasetPath)
 
+    # Load the statistics cache
+    if args.cachePath is None:
+        args.cachePath = StatsCache.getDefaultCachePath(args.datasetPath)
+    cache = StatsCache.StatsCache(args.cachePath)
+
     # Generate data object for each file
     for filename in files:
-        dataObjArray.append(generateDataObject(filename))
+        dataObjArray.append(generateDataObject(filename, cache))
+
+    cache.save()
+    print("Cache: {} hit(s), {} miss(es)".format(cache.hits, cache.misses))
 
     partitions = processDataObjects(dataObjArray)
 
-    for i in range(PARTITION_COUNT):
+    for i in DISPLAYED_PARTITIONS:
         genBoxplotTypesComp(partitions, i, "ExecTime")
 
     genTypeCompCSV(dataObjArray, "ExecTime", -1)
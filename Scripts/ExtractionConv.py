@@ -16,6 +16,7 @@
 # IMPORTS
 ################################################################################
 import argparse
+import datetime
 import sys
 import struct
 
@@ -32,7 +33,140 @@ INTINT_MAGIC_VALUE = "IINT"
 EXTINT_MAGIC_VALUE = "EINT"
 IPI_MAGIC_VALUE    = "IPI "
 
+# Magic values of the delta/varint encoded regions (RecordEncoding.h)
+ENC_PART_MAGIC     = "PRTZ"
+ENC_SC_MAGIC       = "SCZ "
+ENC_INTINT_MAGIC   = "IINZ"
+ENC_EXTINT_MAGIC   = "EINZ"
+ENC_IPI_MAGIC      = "IPIZ"
+
+SWEEP_MAGIC_VALUE  = "SWEP"
+FLIGHT_MAGIC_VALUE = "FLGT"
+INTCOUNT_MAGIC_VALUE = "PINT"
+PSW_MAGIC_VALUE    = "PSW "
+REPLAY_MAGIC_VALUE = "RPLY"
+ASYNC_MAGIC_VALUE  = "ASYN"
+SECTION_MAGIC_VALUE = "SECT"
+MBW_MAGIC_VALUE    = "MBW "
+SMT_MAGIC_VALUE    = "SMT "
+TICK_MAGIC_VALUE   = "TICK"
+MANIFEST_MAGIC_VALUE = "MNFT"
+MASK_MAGIC_VALUE   = "MASK"
+
+# Regions following the IPI region, absent from legacy dumps:
+# magic value: (type name, output file prefix, CSV header)
+OPTIONAL_REGIONS = {
+    SWEEP_MAGIC_VALUE: ("SWEEP", "SWEEP_",
+                        "Type,Src,Dst,Id,ExecTime,l2Miss,tlbMiss\n"),
+    FLIGHT_MAGIC_VALUE: ("FLIGHT", "FLIGHT_",
+                         "Window,Trigger,Type,Core,Part,Seq,Timestamp,"
+                         "ExecTime,l2Miss,tlbMiss\n"),
+    INTCOUNT_MAGIC_VALUE: ("PARTINT", "PARTINT_",
+                           "Core,Part,Sample,scCount,intIntCount,extIntCount,"
+                           "ipiCount\n"),
+    PSW_MAGIC_VALUE: ("PSW", "PSW_",
+                      "Core,From,To,SwitchTime,l2Miss,tlbMiss\n"),
+    REPLAY_MAGIC_VALUE: ("REPLAY", "REPLAY_",
+                         "Type,Src,Dst,Part,Index,Skew,GenTime\n"),
+    ASYNC_MAGIC_VALUE: ("ASYNC", "ASYNC_", "Core,Part,Sample,AsyncOffset\n"),
+    SECTION_MAGIC_VALUE: ("SECTION", "SECTION_",
+                          "Core,Part,Sample,Section,Time,l2Miss,tlbMiss\n"),
+    MBW_MAGIC_VALUE: ("MBW", "MBW_",
+                      "Core,Part,Window,Mode,Footprint,Stride,Target,Bytes,"
+                      "Time,Bandwidth\n"),
+    SMT_MAGIC_VALUE: ("SMT", "SMT_",
+                      "Core,Part,Sample,Thread,l2Miss,tlbMiss,SiblingThread,"
+                      "SiblingInts,SiblingL2Miss,SiblingTlbMiss\n"),
+    TICK_MAGIC_VALUE: ("TICK", "TICK_",
+                       "Type,Id,TickHz,Timestamp,ExecTime,l2Miss,tlbMiss\n"),
+    MANIFEST_MAGIC_VALUE: ("MANIFEST", "MANIFEST_",
+                           "Version,Board,Firmware,Scenario,Mitigation,"
+                           "StartDate,EndDate,PmcEvents\n"),
+    MASK_MAGIC_VALUE: ("MASK", "MASK_",
+                       "Type,Id,Core,Seq,Missed,FireTime,ExecTime\n")
+}
+
+# Payload section records (SectionTiming.h): ID, sample, section mask and
+# count followed by the time, L2 and TLB misses of each section
+SECTION_HEADER_SIZE = 16
+SECTION_FIELDS_SIZE = 12
+
+# Memory co-runner records (MemCoRunner.h): ID, mode, footprint, stride,
+# target bandwidth, window, bytes moved and window duration
+MBW_RECORD_SIZE = 40
+MBW_MODES       = ["READ", "WRITE", "RMW"]
+
+# SMT sibling records (SmtSibling.h): ID, sample, payload thread, sibling
+# thread, payload misses and sibling counters (INVALID without agent)
+SMT_RECORD_SIZE = 36
+SMT_INVALID     = 0xFFFFFFFF
+
+# OS tick records (TickInterference.h): core, entry time, handler time, L2
+# and TLB misses
+TICK_RECORD_SIZE = 28
+
+# Interrupt masking window records (MaskLatency.h): interrupted partition,
+# core, fire index, missed fires, fire time and delivery delay. The state of
+# the benchmark (enabled, core, period, fires, missed fires, dropped records,
+# next fire time and maximal delay) is stored at the end of the region.
+MASK_RECORD_SIZE = 32
+MASK_STATE_SIZE  = 40
+MASK_NO_PART     = 0xFFFFFFFF
+
+# Campaign manifest (CampaignManifest.h): version, PMC count, board, firmware,
+# scenario and mitigation strings, start and end dates, followed by the event
+# of each PMC
+MANIFEST_FORMAT      = "II32s72s32s32sQQ"
+MANIFEST_FIELDS_SIZE = struct.calcsize(">" + MANIFEST_FORMAT)
+
+# Flight recorder records (FlightRecorder.h), the summaries are written to
+# the FLIGHTSUM_ file
+FLIGHT_RECORD_SIZE  = 40
+FLIGHT_KIND_DETAIL  = 1
+FLIGHT_KIND_TRIGGER = 2
+FLIGHT_KIND_SUMMARY = 3
+FLIGHT_SUM_HEADER   = "Type,Core,Part,FirstSeq,Count,MinExecTime,MaxExecTime,MeanExecTime\n"
+
+# Interrupt count records (InterruptBench.h): ID, sample and the counts of
+# each interrupt type (INT_BENCH_TYPE_SC to _IPI) saturated at 0xFFFF. Only
+# the interrupted samples have a record.
+INTCOUNT_RECORD_SIZE = 16
+
+# Asynchronous injection records (AsyncInject.h): ID, sample and offset of
+# the interrupt
+ASYNC_RECORD_SIZE = 12
+
+# Interrupt types of the sweep records (int_bench_sweep_type_t)
+SWEEP_TYPES = ["IntINT", "IPI", "ExtINT"]
+
+# Adaptive stopping modes (AdaptiveStop.h)
+STOP_MODES = {1: "mean", 2: "quantile"}
+
+# Deferred interrupt delivery modes (INT_BENCH_DEFER_MODE) and the mitigation
+# name of their measurements folder (MITIGATION-NAME_mitig)
+DEFER_MODES = {1: ("partition boundary", "DEFER-BOUNDARY"),
+               2: ("service core", "DEFER-SERVICE")}
+
+# Benchmark types of the record IDs (INT_BENCH_RECORD_ID)
+BENCH_TYPES = ["PART", "SC", "IntINT", "ExtINT", "IPI"]
+
+# Byte order mark written after the magic value, absent from legacy dumps
+BOM_BIG_ENDIAN    = b"\x01\x02\x03\x04"
+BOM_LITTLE_ENDIAN = b"\x04\x03\x02\x01"
+
 MAGIC_SIZE               = 8
+BOM_SIZE                 = 4
+TLB_COUNT_FIELD_SIZE     = 4
+TLB_PAGE_FIELD_SIZE      = 4
+STOP_MODE_FIELD_SIZE     = 4
+STOP_COUNT_FIELD_SIZE    = 4
+STOP_POINT_SIZE          = 12
+FLIGHT_DROP_OFFSET       = 0xE8
+DEFER_MODE_OFFSET        = 0xEC
+TICK_HZ_OFFSET           = 0xF0
+MANIFEST_VERSION_OFFSET  = 0xF4
+RECORD_DROP_OFFSET       = 0xF8
+REPLAY_SKIP_OFFSET       = 0xFC
 DUMP_SIZE_FIELD_SIZE     = 4
 DUMP_REG_MAGIC_SIZE      = 4
 DUMP_PARTID_FIELD_SIZE   = 4
@@ -40,6 +174,13 @@ DUMP_EXECTIME_FIELD_SIZE = 8
 DUMP_L2MISS_FIELD_SIZE   = 4
 DUMP_TLBMISS_FIELD_SIZE  = 4
 
+# Encoded records (RecordEncoding.h): time base slots, sync point marker and
+# encoder state stored at the end of the region (records, dropped, valid
+# slots, reserved and the time bases)
+ENC_SLOTS       = 16
+ENC_SYNC_MARKER = 0x00
+ENC_STATE_SIZE  = 16 + 8 * ENC_SLOTS
+
 ################################################################################
 # GLOBAL VARIABLES
 ################################################################################
@@ -126,39 +267,154 @@ def convertFile(inputFilename, outputFilename):
                 raise RuntimeError("Binary file has an incorrect format "
                                    "(MAGIC invalid)")
 
-            # Read the rest of the header to moove cursor
-            inputFile.read(HEADER_SIZE - MAGIC_SIZE)
+            # Get the byte order, the legacy dumps are big endian
+            byteOrder = getByteOrder(inputFile.read(BOM_SIZE))
+
+            # Get the translations used by the framework, absent (0) from
+            # legacy dumps
+            tlbCount, tlbPage = struct.unpack(byteOrder + "II",
+                inputFile.read(TLB_COUNT_FIELD_SIZE + TLB_PAGE_FIELD_SIZE))
+            if(tlbCount != 0):
+                print("Framework translations: {} (largest page {} bytes)"
+                      .format(tlbCount, tlbPage))
+
+            # Get the adaptive stopping points, absent from legacy dumps
+            headerLeft = (HEADER_SIZE - MAGIC_SIZE - BOM_SIZE -
+                          TLB_COUNT_FIELD_SIZE - TLB_PAGE_FIELD_SIZE)
+            header = inputFile.read(headerLeft)
+            extractStopPoints(header, outputFilename, byteOrder)
+
+            # Get the flight records that did not fit in the flight region
+            dropOffset = FLIGHT_DROP_OFFSET - (HEADER_SIZE - headerLeft)
+            dropped = struct.unpack(byteOrder + "I",
+                                    header[dropOffset:dropOffset + 4])[0]
+            if(dropped != 0):
+                print("Flight recorder: " + str(dropped) + " records dropped")
+
+            # Get the interrupt delivery mode, absent (0) from legacy dumps
+            deferOffset = DEFER_MODE_OFFSET - (HEADER_SIZE - headerLeft)
+            deferMode = struct.unpack(byteOrder + "I",
+                                      header[deferOffset:deferOffset + 4])[0]
+            if(deferMode in DEFER_MODES):
+                print("Deferred interrupt delivery: {} ({}_mitig)"
+                      .format(*DEFER_MODES[deferMode]))
+
+            # Get the OS tick frequency, absent (0) from legacy dumps and for
+            # tickless schedulers
+            tickOffset = TICK_HZ_OFFSET - (HEADER_SIZE - headerLeft)
+            tickHz = struct.unpack(byteOrder + "I",
+                                   header[tickOffset:tickOffset + 4])[0]
+            if(tickHz != 0):
+                print("OS tick frequency: {} Hz".format(tickHz))
+
+            # Get the campaign manifest version, absent (0) from legacy dumps
+            manifestOffset = MANIFEST_VERSION_OFFSET - (HEADER_SIZE - headerLeft)
+            manifestVersion = struct.unpack(byteOrder + "I",
+                header[manifestOffset:manifestOffset + 4])[0]
+            if(manifestVersion != 0):
+                print("Campaign manifest version: {}".format(manifestVersion))
+
+            # Get the records that did not fit in their region, absent (0)
+            # from legacy dumps
+            dropOffset = RECORD_DROP_OFFSET - (HEADER_SIZE - headerLeft)
+            dropped = struct.unpack(byteOrder + "I",
+                                    header[dropOffset:dropOffset + 4])[0]
+            if(dropped != 0):
+                print("Dump regions: " + str(dropped) + " records dropped")
+
+            # Get the trace events that no replay generator owned, absent (0)
+            # from legacy dumps
+            skipOffset = REPLAY_SKIP_OFFSET - (HEADER_SIZE - headerLeft)
+            skipped = struct.unpack(byteOrder + "I",
+                                    header[skipOffset:skipOffset + 4])[0]
+            if(skipped != 0):
+                print("Trace replay: " + str(skipped) +
+                      " events skipped (no generator)")
 
             # Open the output file
             with open("PART_" + outputFilename, "w") as outputFile:
                 # Write header
                 outputFile.write("Type,Id,ExecTime,l2Miss,tlbMiss\n")
                 # Extract the PART region
-                extractRegion("PART", PART_MAGIC_VALUE, inputFile, outputFile)
+                extractBenchRegion("PART", PART_MAGIC_VALUE, ENC_PART_MAGIC,
+                                   inputFile, outputFile, byteOrder)
 
             with open("SC_" + outputFilename, "w") as outputFile:
                 # Write header
                 outputFile.write("Type,Id,ExecTime,l2Miss,tlbMiss\n")
                 # Extract the SC region
-                extractRegion("SC", SC_MAGIC_VALUE, inputFile, outputFile)
+                extractBenchRegion("SC", SC_MAGIC_VALUE, ENC_SC_MAGIC,
+                                   inputFile, outputFile, byteOrder)
 
             with open("IntINT_" + outputFilename, "w") as outputFile:
                 # Write header
                 outputFile.write("Type,Id,ExecTime,l2Miss,tlbMiss\n")
                 # Extract the IntINT region
-                extractRegion("IntINT", INTINT_MAGIC_VALUE, inputFile, outputFile)
+                extractBenchRegion("IntINT", INTINT_MAGIC_VALUE,
+                                   ENC_INTINT_MAGIC, inputFile, outputFile,
+                                   byteOrder)
 
             with open("ExtINT_" + outputFilename, "w") as outputFile:
                 # Write header
                 outputFile.write("Type,Id,ExecTime,l2Miss,tlbMiss\n")
                 # Extract the ExtINT region
-                extractRegion("ExtINT", EXTINT_MAGIC_VALUE, inputFile, outputFile)
+                extractBenchRegion("ExtINT", EXTINT_MAGIC_VALUE,
+                                   ENC_EXTINT_MAGIC, inputFile, outputFile,
+                                   byteOrder)
 
             with open("IPI_" + outputFilename, "w") as outputFile:
                 # Write header
                 outputFile.write("Type,Id,ExecTime,l2Miss,tlbMiss\n")
                 # Extract the IPI region
-                extractRegion("IPI", IPI_MAGIC_VALUE, inputFile, outputFile)
+                extractBenchRegion("IPI", IPI_MAGIC_VALUE, ENC_IPI_MAGIC,
+                                   inputFile, outputFile, byteOrder)
+
+            # Extract the optional regions until the end of the dump
+            buff = inputFile.read(DUMP_REG_MAGIC_SIZE)
+            while(len(buff) == DUMP_REG_MAGIC_SIZE):
+                magic = buff.decode("ASCII", errors = "replace")
+                if(magic not in OPTIONAL_REGIONS):
+                    print("Unknown region \"" + magic + "\", stopping")
+                    break
+                regType, prefix, header = OPTIONAL_REGIONS[magic]
+
+                inputFile.seek(-DUMP_REG_MAGIC_SIZE, 1)
+                with open(prefix + outputFilename, "w") as outputFile:
+                    outputFile.write(header)
+                    if(regType == "FLIGHT"):
+                        with open("FLIGHTSUM_" + outputFilename, "w") as sumFile:
+                            sumFile.write(FLIGHT_SUM_HEADER)
+                            extractFlightRegion(magic, inputFile, outputFile,
+                                                sumFile, byteOrder)
+                    elif(regType == "ASYNC"):
+                        extractAsyncRegion(magic, inputFile, outputFile,
+                                           byteOrder)
+                    elif(regType == "SECTION"):
+                        extractSectionRegion(magic, inputFile, outputFile,
+                                             byteOrder)
+                    elif(regType == "PARTINT"):
+                        extractPartIntRegion(magic, inputFile, outputFile,
+                                             byteOrder)
+                    elif(regType == "MBW"):
+                        extractMbwRegion(magic, inputFile, outputFile,
+                                         byteOrder)
+                    elif(regType == "SMT"):
+                        extractSmtRegion(magic, inputFile, outputFile,
+                                         byteOrder)
+                    elif(regType == "TICK"):
+                        extractTickRegion(magic, inputFile, outputFile,
+                                          tickHz, byteOrder)
+                    elif(regType == "MASK"):
+                        extractMaskRegion(magic, inputFile, outputFile,
+                                          byteOrder)
+                    elif(regType == "MANIFEST"):
+                        extractManifestRegion(magic, inputFile, outputFile,
+                                              byteOrder)
+                    else:
+                        extractRegion(regType, magic, inputFile, outputFile,
+                                      byteOrder)
+
+                buff = inputFile.read(DUMP_REG_MAGIC_SIZE)
 
     except IOError as exc:
         print("Error while manipulating files: " + str(exc))
@@ -170,7 +426,606 @@ def convertFile(inputFilename, outputFilename):
         print("Error while manipulating files: " + str(sys.exc_info()[0]))
         raise
 
-def extractRegion(type, magic, inputFile, outputFile):
+def extractStopPoints(header, outputFilename, byteOrder = ">"):
+    """
+    Extracts the adaptive stopping points from the end of the dump header and
+    writes them to the STOP_ CSV file. Nothing is written if no benchmark
+    used adaptive stopping.
+
+    Parameters
+    ----------
+        header : bytes (in)
+            The dump header following the translations fields.
+        outputFilename: str(in)
+            The name of the output file to generate.
+        byteOrder : str (in)
+            The struct byte order character of the dump.
+
+    Return
+    ----------
+        None.
+
+    Raises
+    ----------
+        IOError can be raised during the file manipulation.
+    """
+
+    mode, count = struct.unpack(byteOrder + "II",
+        header[:STOP_MODE_FIELD_SIZE + STOP_COUNT_FIELD_SIZE])
+    header = header[STOP_MODE_FIELD_SIZE + STOP_COUNT_FIELD_SIZE:]
+    count  = min(count, len(header) // STOP_POINT_SIZE)
+    if(count == 0 or mode not in STOP_MODES):
+        return
+
+    print("Adaptive stopping (" + STOP_MODES[mode] + "): " + str(count) +
+          " stopping points")
+    with open("STOP_" + outputFilename, "w") as outputFile:
+        outputFile.write("Mode,Type,Core,Part,Samples,HalfWidthPpm\n")
+        for i in range(count):
+            pointId, samples, halfWidth = struct.unpack(byteOrder + "III",
+                header[i * STOP_POINT_SIZE:(i + 1) * STOP_POINT_SIZE])
+            typeName, core, partId = getBenchType(pointId)
+            outputFile.write("{},{},{},{},{},{}\n".format(
+                STOP_MODES[mode], typeName, core, partId, samples, halfWidth))
+
+def getBenchType(recordId):
+    """
+    Returns the benchmark type, core and partition of a record ID
+    (INT_BENCH_RECORD_ID).
+
+    Parameters
+    ----------
+        recordId : int (in)
+            The record ID.
+
+    Return
+    ----------
+        The tuple (type name, core, partition).
+
+    Raises
+    ----------
+        None.
+    """
+    typeId = (recordId >> 16) & 0xFF
+    typeName = BENCH_TYPES[typeId] if typeId < len(BENCH_TYPES) else str(typeId)
+    return typeName, (recordId >> 8) & 0xFF, recordId & 0xFF
+
+def extractFlightRegion(magic, inputFile, outputFile, sumFile, byteOrder = ">"):
+    """
+    Extract the flight recorder region. The detailed records of the committed
+    windows are written to the output file and the summaries to the summary
+    file.
+
+    Parameters
+    ----------
+        magic: str (in)
+            The magic value that is validated with the region header.
+        inputFile : File (in)
+            The name of the input file to convert.
+        outputFile: File (out)
+            The detailed records output file.
+        sumFile: File (out)
+            The summaries output file.
+        byteOrder: str (in)
+            The struct byte order character of the dump (see getByteOrder).
+
+    Return
+    ----------
+        None.
+
+    Raises
+    ----------
+        IOError, RuntimeError and others can be raised during the files
+        manipulations.
+    """
+    buff = inputFile.read(DUMP_REG_MAGIC_SIZE).decode("ASCII")
+    if(buff != magic):
+        raise RuntimeError("Dump region file has an incorrect format "
+                           "(MAGIC invalid: \"" + buff + "\", expected: \"" +
+                           magic + "\")")
+
+    print("==== Extracting region FLIGHT")
+    regSize = struct.unpack(byteOrder + "I", inputFile.read(DUMP_SIZE_FIELD_SIZE))[0]
+    print("\tRegion size: " + str(regSize))
+
+    data = inputFile.read(regSize)
+    for offset in range(0, len(data) - FLIGHT_RECORD_SIZE + 1, FLIGHT_RECORD_SIZE):
+        record = data[offset:offset + FLIGHT_RECORD_SIZE]
+        kind, recordId = struct.unpack(byteOrder + "II", record[:8])
+        typeName, core, partId = getBenchType(recordId)
+
+        if(kind == FLIGHT_KIND_SUMMARY):
+            firstSeq, count, minTime, maxTime, sumTime = struct.unpack(
+                byteOrder + "IIQQQ", record[8:])
+            sumFile.write("{},{},{},{},{},{},{},{:.1f}\n".format(
+                typeName, core, partId, firstSeq, count, minTime, maxTime,
+                sumTime / count if count != 0 else 0))
+        else:
+            seq, window, timestamp, execTime, l2Miss, tlbMiss = struct.unpack(
+                byteOrder + "IIQQII", record[8:])
+            outputFile.write("{},{},{},{},{},{},{},{},{},{}\n".format(
+                window, int(kind == FLIGHT_KIND_TRIGGER), typeName, core,
+                partId, seq, timestamp, execTime, l2Miss, tlbMiss))
+
+    # Skip the rest of the region
+    inputFile.seek(DUMP_REGION_SIZE - regSize - DUMP_REG_MAGIC_SIZE - DUMP_SIZE_FIELD_SIZE, 1)
+
+def extractAsyncRegion(magic, inputFile, outputFile, byteOrder = ">"):
+    """
+    Extract the asynchronous injection region. One line is written per sample
+    of the benchmarks with an injection state, with the offset of the
+    interrupt from the start of the measurement. The core, partition and
+    sample index give the matching PART sample.
+
+    Parameters
+    ----------
+        magic: str (in)
+            The magic value that is validated with the region header.
+        inputFile : File (in)
+            The name of the input file to convert.
+        outputFile: File (out)
+            The async records output file.
+        byteOrder: str (in)
+            The struct byte order character of the dump (see getByteOrder).
+
+    Return
+    ----------
+        None.
+
+    Raises
+    ----------
+        IOError, RuntimeError and others can be raised during the files
+        manipulations.
+    """
+    buff = inputFile.read(DUMP_REG_MAGIC_SIZE).decode("ASCII")
+    if(buff != magic):
+        raise RuntimeError("Dump region file has an incorrect format "
+                           "(MAGIC invalid: \"" + buff + "\", expected: \"" +
+                           magic + "\")")
+
+    print("==== Extracting region ASYNC")
+    regSize = struct.unpack(byteOrder + "I", inputFile.read(DUMP_SIZE_FIELD_SIZE))[0]
+    print("\tRegion size: " + str(regSize))
+
+    data = inputFile.read(regSize)
+    for offset in range(0, len(data) - ASYNC_RECORD_SIZE + 1, ASYNC_RECORD_SIZE):
+        recordId, sample, asyncOffset = struct.unpack(byteOrder + "III",
+            data[offset:offset + ASYNC_RECORD_SIZE])
+        _, core, partId = getBenchType(recordId)
+        outputFile.write("{},{},{},{}\n".format(core, partId, sample,
+                                                asyncOffset))
+
+    # Skip the rest of the region
+    inputFile.seek(DUMP_REGION_SIZE - regSize - DUMP_REG_MAGIC_SIZE - DUMP_SIZE_FIELD_SIZE, 1)
+
+def extractSectionRegion(magic, inputFile, outputFile, byteOrder = ">"):
+    """
+    Extract the payload section region. One line is written per section
+    entered by a sample.
+
+    Parameters
+    ----------
+        magic: str (in)
+            The magic value that is validated with the region header.
+        inputFile : File (in)
+            The name of the input file to convert.
+        outputFile: File (out)
+            The section records output file.
+        byteOrder: str (in)
+            The struct byte order character of the dump (see getByteOrder).
+
+    Return
+    ----------
+        None.
+
+    Raises
+    ----------
+        IOError, RuntimeError and others can be raised during the files
+        manipulations.
+    """
+    buff = inputFile.read(DUMP_REG_MAGIC_SIZE).decode("ASCII")
+    if(buff != magic):
+        raise RuntimeError("Dump region file has an incorrect format "
+                           "(MAGIC invalid: \"" + buff + "\", expected: \"" +
+                           magic + "\")")
+
+    print("==== Extracting region SECTION")
+    regSize = struct.unpack(byteOrder + "I", inputFile.read(DUMP_SIZE_FIELD_SIZE))[0]
+    print("\tRegion size: " + str(regSize))
+
+    data = inputFile.read(regSize)
+    offset = 0
+    count = 0
+    while(offset + SECTION_HEADER_SIZE <= len(data)):
+        recordId, sample, mask, count = struct.unpack(
+            byteOrder + "IIII", data[offset:offset + SECTION_HEADER_SIZE])
+        offset += SECTION_HEADER_SIZE
+        _, core, partId = getBenchType(recordId)
+        for section in range(count):
+            time, l2Miss, tlbMiss = struct.unpack(
+                byteOrder + "III", data[offset:offset + SECTION_FIELDS_SIZE])
+            offset += SECTION_FIELDS_SIZE
+            if((mask >> section) & 1):
+                outputFile.write("{},{},{},{},{},{},{}\n".format(
+                    core, partId, sample, section, time, l2Miss, tlbMiss))
+
+    # The records that did not fit are counted in the dump header drops
+    recordSize = SECTION_HEADER_SIZE + count * SECTION_FIELDS_SIZE
+    if(count != 0 and regSize + recordSize > DUMP_REGION_SIZE -
+       DUMP_REG_MAGIC_SIZE - DUMP_SIZE_FIELD_SIZE):
+        print("\tRegion full, the next records were dropped")
+
+    # Skip the rest of the region
+    inputFile.seek(DUMP_REGION_SIZE - regSize - DUMP_REG_MAGIC_SIZE - DUMP_SIZE_FIELD_SIZE, 1)
+
+def extractMbwRegion(magic, inputFile, outputFile, byteOrder = ">"):
+    """
+    Extract the memory co-runner region. One line is written per co-runner
+    window with its achieved bandwidth (MB/s).
+
+    Parameters
+    ----------
+        magic: str (in)
+            The magic value that is validated with the region header.
+        inputFile : File (in)
+            The name of the input file to convert.
+        outputFile: File (out)
+            The co-runner records output file.
+        byteOrder: str (in)
+            The struct byte order character of the dump (see getByteOrder).
+
+    Return
+    ----------
+        None.
+
+    Raises
+    ----------
+        IOError, RuntimeError and others can be raised during the files
+        manipulations.
+    """
+    buff = inputFile.read(DUMP_REG_MAGIC_SIZE).decode("ASCII")
+    if(buff != magic):
+        raise RuntimeError("Dump region file has an incorrect format "
+                           "(MAGIC invalid: \"" + buff + "\", expected: \"" +
+                           magic + "\")")
+
+    print("==== Extracting region MBW")
+    regSize = struct.unpack(byteOrder + "I", inputFile.read(DUMP_SIZE_FIELD_SIZE))[0]
+    print("\tRegion size: " + str(regSize))
+
+    data = inputFile.read(regSize)
+    for offset in range(0, len(data) - MBW_RECORD_SIZE + 1, MBW_RECORD_SIZE):
+        recordId, mode, footprint, stride, target, window, nbBytes, time = \
+            struct.unpack(byteOrder + "IIIIIIQQ",
+                          data[offset:offset + MBW_RECORD_SIZE])
+        _, core, partId = getBenchType(recordId)
+        modeName = MBW_MODES[mode] if mode < len(MBW_MODES) else str(mode)
+        outputFile.write("{},{},{},{},{},{},{},{},{},{:.1f}\n".format(
+            core, partId, window, modeName, footprint, stride, target,
+            nbBytes, time, nbBytes * 1000.0 / time if time != 0 else 0))
+
+    # Skip the rest of the region
+    inputFile.seek(DUMP_REGION_SIZE - regSize - DUMP_REG_MAGIC_SIZE - DUMP_SIZE_FIELD_SIZE, 1)
+
+def extractSmtRegion(magic, inputFile, outputFile, byteOrder = ">"):
+    """
+    Extract the SMT sibling region. One line is written per payload sample
+    with the counters of the payload thread and of its sibling thread. The
+    sibling fields are empty when the sibling agent did not publish consistent
+    counters.
+
+    Parameters
+    ----------
+        magic: str (in)
+            The magic value that is validated with the region header.
+        inputFile : File (in)
+            The name of the input file to convert.
+        outputFile: File (out)
+            The sibling records output file.
+        byteOrder: str (in)
+            The struct byte order character of the dump (see getByteOrder).
+
+    Return
+    ----------
+        None.
+
+    Raises
+    ----------
+        IOError, RuntimeError and others can be raised during the files
+        manipulations.
+    """
+    buff = inputFile.read(DUMP_REG_MAGIC_SIZE).decode("ASCII")
+    if(buff != magic):
+        raise RuntimeError("Dump region file has an incorrect format "
+                           "(MAGIC invalid: \"" + buff + "\", expected: \"" +
+                           magic + "\")")
+
+    print("==== Extracting region SMT")
+    regSize = struct.unpack(byteOrder + "I", inputFile.read(DUMP_SIZE_FIELD_SIZE))[0]
+    print("\tRegion size: " + str(regSize))
+
+    data = inputFile.read(regSize)
+    for offset in range(0, len(data) - SMT_RECORD_SIZE + 1, SMT_RECORD_SIZE):
+        fields = struct.unpack(byteOrder + "IIIIIIIII",
+                               data[offset:offset + SMT_RECORD_SIZE])
+        _, core, partId = getBenchType(fields[0])
+        sibling = ["" if value == SMT_INVALID else value
+                   for value in fields[6:]]
+        outputFile.write("{},{},{},{},{},{},{},{},{},{}\n".format(
+            core, partId, fields[1], fields[2], fields[4], fields[5],
+            fields[3], *sibling))
+
+    # Skip the rest of the region
+    inputFile.seek(DUMP_REGION_SIZE - regSize - DUMP_REG_MAGIC_SIZE - DUMP_SIZE_FIELD_SIZE, 1)
+
+def extractTickRegion(magic, inputFile, outputFile, tickHz, byteOrder = ">"):
+    """
+    Extract the OS tick region. One line is written per tick handler
+    invocation with the tick frequency of the dump, the entry time and the
+    handler time and misses. The Id column is the core, the file can be
+    summarized like the benchmark files (see StatsCache.py).
+
+    Parameters
+    ----------
+        magic: str (in)
+            The magic value that is validated with the region header.
+        inputFile : File (in)
+            The name of the input file to convert.
+        outputFile: File (out)
+            The tick records output file.
+        tickHz: int (in)
+            The OS tick frequency recorded in the dump header.
+        byteOrder: str (in)
+            The struct byte order character of the dump (see getByteOrder).
+
+    Return
+    ----------
+        None.
+
+    Raises
+    ----------
+        IOError, RuntimeError and others can be raised during the files
+        manipulations.
+    """
+    buff = inputFile.read(DUMP_REG_MAGIC_SIZE).decode("ASCII")
+    if(buff != magic):
+        raise RuntimeError("Dump region file has an incorrect format "
+                           "(MAGIC invalid: \"" + buff + "\", expected: \"" +
+                           magic + "\")")
+
+    print("==== Extracting region TICK")
+    regSize = struct.unpack(byteOrder + "I", inputFile.read(DUMP_SIZE_FIELD_SIZE))[0]
+    print("\tRegion size: " + str(regSize))
+
+    data = inputFile.read(regSize)
+    for offset in range(0, len(data) - TICK_RECORD_SIZE + 1, TICK_RECORD_SIZE):
+        fields = struct.unpack(byteOrder + "IQqII",
+                               data[offset:offset + TICK_RECORD_SIZE])
+        outputFile.write("TICK,{},{},{},{},{},{}\n".format(fields[0], tickHz,
+                                                            *fields[1:]))
+
+    # Skip the rest of the region
+    inputFile.seek(DUMP_REGION_SIZE - regSize - DUMP_REG_MAGIC_SIZE - DUMP_SIZE_FIELD_SIZE, 1)
+
+def extractMaskRegion(magic, inputFile, outputFile, byteOrder = ">"):
+    """
+    Extract the interrupt masking window region. One line is written per
+    periodic timer interrupt with the interrupted partition (-1 outside of the
+    partition windows), the fire index, the fires missed before it, the
+    programmed fire time and the delivery delay. The delay is in the ExecTime
+    column, the file can be summarized like the benchmark files (see
+    StatsCache.py). The state of the benchmark is printed.
+
+    Parameters
+    ----------
+        magic: str (in)
+            The magic value that is validated with the region header.
+        inputFile : File (in)
+            The name of the input file to convert.
+        outputFile: File (out)
+            The mask records output file.
+        byteOrder: str (in)
+            The struct byte order character of the dump (see getByteOrder).
+
+    Return
+    ----------
+        None.
+
+    Raises
+    ----------
+        IOError, RuntimeError and others can be raised during the files
+        manipulations.
+    """
+    buff = inputFile.read(DUMP_REG_MAGIC_SIZE).decode("ASCII")
+    if(buff != magic):
+        raise RuntimeError("Dump region file has an incorrect format "
+                           "(MAGIC invalid: \"" + buff + "\", expected: \"" +
+                           magic + "\")")
+
+    print("==== Extracting region MASK")
+    regSize = struct.unpack(byteOrder + "I", inputFile.read(DUMP_SIZE_FIELD_SIZE))[0]
+    print("\tRegion size: " + str(regSize))
+
+    data = inputFile.read(regSize)
+    for offset in range(0, len(data) - MASK_RECORD_SIZE + 1, MASK_RECORD_SIZE):
+        fields = struct.unpack(byteOrder + "IIIIQQ",
+                               data[offset:offset + MASK_RECORD_SIZE])
+        outputFile.write("MASK,{},{},{},{},{},{}\n".format(
+                         -1 if fields[0] == MASK_NO_PART else fields[0],
+                         *fields[1:]))
+
+    # Read the state at the end of the region
+    inputFile.seek(DUMP_REGION_SIZE - MASK_STATE_SIZE - regSize -
+                   DUMP_REG_MAGIC_SIZE - DUMP_SIZE_FIELD_SIZE, 1)
+    _, core, period, fires, missed, dropped, _, maxDelay = \
+        struct.unpack(byteOrder + "IIIIIIQQ", inputFile.read(MASK_STATE_SIZE))
+    print("\tCore: {}, period: {}ns, fires: {}, missed: {}, dropped: {}, "
+          "max delay: {}ns".format(core, period, fires, missed, dropped,
+                                   maxDelay))
+
+def formatManifestDate(date):
+    """
+    Formats a date of the campaign manifest (seconds since the epoch) as an
+    ISO 8601 UTC date, the dates that were not recorded (0) are empty.
+
+    Parameters
+    ----------
+        date: int (in)
+            The date to format.
+
+    Return
+    ----------
+        The formatted date.
+
+    Raises
+    ----------
+        None.
+    """
+    if(date == 0):
+        return ""
+
+    return datetime.datetime.fromtimestamp(date, datetime.timezone.utc) \
+                            .strftime("%Y-%m-%dT%H:%M:%SZ")
+
+def extractManifestRegion(magic, inputFile, outputFile, byteOrder = ">"):
+    """
+    Extract the campaign manifest region. One line is written with the board,
+    the firmware revision, the scenario and mitigation, the dates of the run
+    and the counter schema (event of each PMC, separated by semicolons).
+
+    Parameters
+    ----------
+        magic: str (in)
+            The magic value that is validated with the region header.
+        inputFile : File (in)
+            The name of the input file to convert.
+        outputFile: File (out)
+            The manifest output file.
+        byteOrder: str (in)
+            The struct byte order character of the dump (see getByteOrder).
+
+    Return
+    ----------
+        None.
+
+    Raises
+    ----------
+        IOError, RuntimeError and others can be raised during the files
+        manipulations.
+    """
+    buff = inputFile.read(DUMP_REG_MAGIC_SIZE).decode("ASCII")
+    if(buff != magic):
+        raise RuntimeError("Dump region file has an incorrect format "
+                           "(MAGIC invalid: \"" + buff + "\", expected: \"" +
+                           magic + "\")")
+
+    print("==== Extracting region MANIFEST")
+    regSize = struct.unpack(byteOrder + "I", inputFile.read(DUMP_SIZE_FIELD_SIZE))[0]
+    print("\tRegion size: " + str(regSize))
+
+    data = inputFile.read(regSize)
+    if(len(data) < MANIFEST_FIELDS_SIZE):
+        raise RuntimeError("Campaign manifest too short (" + str(len(data)) +
+                           " bytes)")
+    fields = list(struct.unpack(byteOrder + MANIFEST_FORMAT,
+                                data[:MANIFEST_FIELDS_SIZE]))
+    for i in range(2, 6):
+        fields[i] = fields[i].split(b"\0")[0].decode("ASCII",
+                                                      errors = "replace")
+    pmcEvents = struct.unpack(byteOrder + "I" * fields[1],
+                              data[MANIFEST_FIELDS_SIZE:
+                                   MANIFEST_FIELDS_SIZE + 4 * fields[1]])
+
+    print("\tBoard: {}, firmware: {}".format(fields[2], fields[3]))
+    print("\tScenario: {}, mitigation: {}".format(fields[4], fields[5]))
+    print("\tRun: {} to {}".format(formatManifestDate(fields[6]),
+                                   formatManifestDate(fields[7])))
+    outputFile.write("{},{},{},{},{},{},{},{}\n".format(fields[0],
+        *fields[2:6], formatManifestDate(fields[6]),
+        formatManifestDate(fields[7]), ";".join([str(event) for event in
+                                                 pmcEvents])))
+
+    # Skip the rest of the region
+    inputFile.seek(DUMP_REGION_SIZE - regSize - DUMP_REG_MAGIC_SIZE - DUMP_SIZE_FIELD_SIZE, 1)
+
+def extractPartIntRegion(magic, inputFile, outputFile, byteOrder = ">"):
+    """
+    Extract the interrupt count region. One line is written per interrupted
+    sample of the payload partitions with the number of interrupts of each
+    type, the samples without a line were not interrupted. The core, partition
+    and sample index give the matching PART sample.
+
+    Parameters
+    ----------
+        magic: str (in)
+            The magic value that is validated with the region header.
+        inputFile : File (in)
+            The name of the input file to convert.
+        outputFile: File (out)
+            The interrupt count records output file.
+        byteOrder: str (in)
+            The struct byte order character of the dump (see getByteOrder).
+
+    Return
+    ----------
+        None.
+
+    Raises
+    ----------
+        IOError, RuntimeError and others can be raised during the files
+        manipulations.
+    """
+    buff = inputFile.read(DUMP_REG_MAGIC_SIZE).decode("ASCII")
+    if(buff != magic):
+        raise RuntimeError("Dump region file has an incorrect format "
+                           "(MAGIC invalid: \"" + buff + "\", expected: \"" +
+                           magic + "\")")
+
+    print("==== Extracting region PARTINT")
+    regSize = struct.unpack(byteOrder + "I", inputFile.read(DUMP_SIZE_FIELD_SIZE))[0]
+    print("\tRegion size: " + str(regSize))
+
+    data = inputFile.read(regSize)
+    for offset in range(0, len(data) - INTCOUNT_RECORD_SIZE + 1,
+                        INTCOUNT_RECORD_SIZE):
+        fields = struct.unpack(byteOrder + "IIHHHH",
+                               data[offset:offset + INTCOUNT_RECORD_SIZE])
+        _, core, partId = getBenchType(fields[0])
+        outputFile.write("{},{},{},{},{},{},{}\n".format(core, partId,
+                                                         *fields[1:]))
+
+    # Skip the rest of the region
+    inputFile.seek(DUMP_REGION_SIZE - regSize - DUMP_REG_MAGIC_SIZE - DUMP_SIZE_FIELD_SIZE, 1)
+
+def getByteOrder(bom):
+    """
+    Returns the struct byte order character of the dump given its byte order
+    mark. Dumps generated before the byte order mark was introduced are big
+    endian (PowerPC targets).
+
+    Parameters
+    ----------
+        bom : bytes (in)
+            The byte order mark read in the dump header.
+
+    Return
+    ----------
+        ">" for big endian dumps, "<" for little endian dumps.
+
+    Raises
+    ----------
+        None.
+    """
+    if(bom == BOM_LITTLE_ENDIAN):
+        print("Little endian dump")
+        return "<"
+    elif(bom == BOM_BIG_ENDIAN):
+        print("Big endian dump")
+    else:
+        print("Legacy dump, assuming big endian")
+    return ">"
+
+def extractRegion(type, magic, inputFile, outputFile, byteOrder = ">"):
     """
     Extract a dump region from the binary file given as parameter. The function
     will read the dump region size and convert it to a CSV format that is
@@ -186,6 +1041,8 @@ def extractRegion(type, magic, inputFile, outputFile):
             The name of the input file to convert.
         outputFile: File (out)
             The name of the output file to generate.
+        byteOrder: str (in)
+            The struct byte order character of the dump (see getByteOrder).
 
     Return
     ----------
@@ -206,28 +1063,233 @@ def extractRegion(type, magic, inputFile, outputFile):
 
     print("==== Extracting region " + type)
     # Read the region size
-    regSize = struct.unpack(">I", inputFile.read(DUMP_SIZE_FIELD_SIZE))[0]
+    regSize = struct.unpack(byteOrder + "I", inputFile.read(DUMP_SIZE_FIELD_SIZE))[0]
     print("\tRegion size: " + str(regSize))
 
     # Get each data chunk and convert them
     toRead = regSize
     while toRead > 0:
         # Get the part ID
-        partId = struct.unpack(">I", inputFile.read(DUMP_PARTID_FIELD_SIZE))[0]
-        # Get the execution time
-        execTime = struct.unpack(">Q", inputFile.read(DUMP_EXECTIME_FIELD_SIZE))[0]
+        partId = struct.unpack(byteOrder + "I", inputFile.read(DUMP_PARTID_FIELD_SIZE))[0]
+        # Get the execution time, the replay skew is signed
+        execTime = struct.unpack(byteOrder + ("q" if type == "REPLAY" else "Q"),
+                                 inputFile.read(DUMP_EXECTIME_FIELD_SIZE))[0]
         # Get the L2 miss
-        l2Miss = struct.unpack(">I", inputFile.read(DUMP_L2MISS_FIELD_SIZE))[0]
+        l2Miss = struct.unpack(byteOrder + "I", inputFile.read(DUMP_L2MISS_FIELD_SIZE))[0]
         # Get the TLB miss
-        tlbMiss = struct.unpack(">I", inputFile.read(DUMP_TLBMISS_FIELD_SIZE))[0]
+        tlbMiss = struct.unpack(byteOrder + "I", inputFile.read(DUMP_TLBMISS_FIELD_SIZE))[0]
 
-        outputFile.write("{},{},{},{},{}\n".format(type, partId, execTime, l2Miss, tlbMiss))
+        if(type == "SWEEP"):
+            # The sweep record ID contains the type and the core pair
+            intType = (partId >> 24) & 0xFF
+            intType = SWEEP_TYPES[intType] if intType < len(SWEEP_TYPES) else str(intType)
+            outputFile.write("{},{},{},{},{},{},{}\n".format(intType,
+                                                            (partId >> 16) & 0xFF,
+                                                            (partId >> 8) & 0xFF,
+                                                            partId & 0xFF,
+                                                            execTime, l2Miss,
+                                                            tlbMiss))
+        elif(type == "PSW"):
+            # The partition switch record ID contains the core and the
+            # outgoing and incoming partitions
+            outputFile.write("{},{},{},{},{},{}\n".format((partId >> 16) & 0xFF,
+                                                         (partId >> 8) & 0xFF,
+                                                         partId & 0xFF,
+                                                         execTime, l2Miss,
+                                                         tlbMiss))
+        elif(type == "REPLAY"):
+            # The replay record ID contains the type and the core pair, the
+            # counters are the event index and the generation time
+            intType = (partId >> 24) & 0xFF
+            intType = BENCH_TYPES[intType] if intType < len(BENCH_TYPES) else str(intType)
+            outputFile.write("{},{},{},{},{},{},{}\n".format(intType,
+                                                            (partId >> 16) & 0xFF,
+                                                            (partId >> 8) & 0xFF,
+                                                            partId & 0xFF,
+                                                            l2Miss, execTime,
+                                                            tlbMiss))
+        else:
+            outputFile.write("{},{},{},{},{}\n".format(type, partId, execTime, l2Miss, tlbMiss))
 
         toRead -= DUMP_PARTID_FIELD_SIZE + DUMP_EXECTIME_FIELD_SIZE + DUMP_L2MISS_FIELD_SIZE + DUMP_TLBMISS_FIELD_SIZE
 
     # Skip the rest of the region
     inputFile.seek(DUMP_REGION_SIZE - regSize - DUMP_REG_MAGIC_SIZE - DUMP_SIZE_FIELD_SIZE, 1)
 
+def extractBenchRegion(type, magic, encodedMagic, inputFile, outputFile,
+                       byteOrder = ">"):
+    """
+    Extract a benchmark dump region (PART, SC, IntINT, ExtINT or IPI) that can
+    be either fixed size or delta/varint encoded, depending on its magic value.
+
+    Parameters
+    ----------
+        type : str (in)
+            Type name of the dump region.
+        magic: str (in)
+            The magic value of the fixed size region.
+        encodedMagic: str (in)
+            The magic value of the encoded region.
+        inputFile : File (in)
+            The name of the input file to convert.
+        outputFile: File (out)
+            The name of the output file to generate.
+        byteOrder: str (in)
+            The struct byte order character of the dump (see getByteOrder).
+
+    Return
+    ----------
+        None.
+
+    Raises
+    ----------
+        IOError, RuntimeError and others can be raised during the files
+        manipulations. An error message is associated with the exception to
+        give information about its cause.
+    """
+    buff = inputFile.read(DUMP_REG_MAGIC_SIZE).decode("ASCII")
+    inputFile.seek(-DUMP_REG_MAGIC_SIZE, 1)
+    if(buff == encodedMagic):
+        extractEncodedRegion(type, encodedMagic, inputFile, outputFile,
+                             byteOrder)
+    else:
+        extractRegion(type, magic, inputFile, outputFile, byteOrder)
+
+def readVarint(data, offset):
+    """
+    Reads a varint (7 bits per byte, least significant group first, the high
+    bit is set on all the bytes but the last one).
+
+    Parameters
+    ----------
+        data : bytes (in)
+            The encoded records.
+        offset : int (in)
+            The offset of the varint in data.
+
+    Return
+    ----------
+        The value and the offset following the varint.
+
+    Raises
+    ----------
+        RuntimeError if the varint is truncated.
+    """
+    value = 0
+    shift = 0
+    while True:
+        if(offset >= len(data)):
+            raise RuntimeError("Encoded region is truncated")
+        byte = data[offset]
+        offset += 1
+        value |= (byte & 0x7F) << shift
+        if(byte < 0x80):
+            return value, offset
+        shift += 7
+
+def extractEncodedRegion(type, magic, inputFile, outputFile, byteOrder = ">"):
+    """
+    Extract a delta/varint encoded dump region (see RecordEncoding.h) from the
+    binary file given as parameter. The records are decoded and written in the
+    same CSV format as the fixed size records. The record index of every sync
+    point and the record count of the encoder state are checked.
+
+    Parameters
+    ----------
+        type : str (in)
+            Type name of the dump region.
+        magic: str (in)
+            The magic value that is validated with the region header.
+        inputFile : File (in)
+            The name of the input file to convert.
+        outputFile: File (out)
+            The name of the output file to generate.
+        byteOrder: str (in)
+            The struct byte order character of the dump (see getByteOrder).
+
+    Return
+    ----------
+        None.
+
+    Raises
+    ----------
+        IOError, RuntimeError and others can be raised during the files
+        manipulations. An error message is associated with the exception to
+        give information about its cause.
+    """
+    # Read the magic
+    buff = inputFile.read(DUMP_REG_MAGIC_SIZE).decode("ASCII")
+    if(buff != magic):
+        raise RuntimeError("Dump region file has an incorrect format "
+                           "(MAGIC invalid: \"" + buff + "\", expected: \"" +
+                           magic + "\")")
+
+    print("==== Extracting encoded region " + type)
+    # Read the region size
+    regSize = struct.unpack(byteOrder + "I", inputFile.read(DUMP_SIZE_FIELD_SIZE))[0]
+    print("\tRegion size: " + str(regSize))
+    data = inputFile.read(regSize)
+    if(len(data) != regSize):
+        raise RuntimeError("Encoded region is truncated")
+
+    # Decode the records
+    records = 0
+    bases   = {}
+    synced  = False
+    offset  = 0
+    while offset < regSize:
+        if(data[offset] == ENC_SYNC_MARKER):
+            # Sync point: the time bases are reset
+            index, offset = readVarint(data, offset + 1)
+            if(index != records):
+                raise RuntimeError("Encoded region sync point mismatch "
+                                   "(record " + str(index) + ", expected " +
+                                   str(records) + ")")
+            bases  = {}
+            synced = True
+            continue
+        if(not synced):
+            raise RuntimeError("Encoded region does not start with a sync "
+                               "point")
+
+        key, offset   = readVarint(data, offset)
+        value, offset = readVarint(data, offset)
+        partId = (key >> 1) - 1
+        slot   = partId % ENC_SLOTS
+        value  = (value >> 1) ^ -(value & 1)
+        if((key & 1) == 0):
+            if(slot not in bases):
+                raise RuntimeError("Encoded region delta without time base "
+                                   "(record " + str(records) + ")")
+            value += bases[slot]
+        bases[slot] = value
+
+        l2Miss, offset  = readVarint(data, offset)
+        tlbMiss, offset = readVarint(data, offset)
+
+        outputFile.write("{},{},{},{},{}\n".format(type, partId, value,
+                                                   l2Miss, tlbMiss))
+        records += 1
+
+    # Check the encoder state at the end of the region and skip the rest
+    inputFile.seek(DUMP_REGION_SIZE - ENC_STATE_SIZE - regSize -
+                   DUMP_REG_MAGIC_SIZE - DUMP_SIZE_FIELD_SIZE, 1)
+    stateRecords, dropped = struct.unpack(byteOrder + "II",
+                                          inputFile.read(8))
+    inputFile.seek(ENC_STATE_SIZE - 8, 1)
+    # A dump taken while the partitions execute (host runtime) can have more
+    # records in the state than in the region size, never less
+    if(stateRecords < records):
+        raise RuntimeError("Encoded region record count mismatch "
+                           "(decoded " + str(records) + ", expected " +
+                           str(stateRecords) + ")")
+    print("\tRecords: " + str(records))
+    if(stateRecords != records):
+        print("\t" + str(stateRecords - records) + " records encoded after "
+              "the region size was dumped")
+    if(dropped != 0):
+        print("\t" + str(dropped) + " records dropped (region full)")
+
 if __name__ == "__main__":
     # Get the arguments
     args = parseCommand()
@@ -0,0 +1,311 @@
+################################################################################
+# InterfMatrix.py
+#
+# Description: This python script builds the source x destination interference
+# matrices from the sweep CSV files generated by ExtractionConv.py (SWEEP_*
+# files). For each interrupt type, metric and statistic, an N x N matrix is
+# written where the rows are the source cores and the columns are the
+# destination cores. A heat map is rendered for each matrix when -p is given.
+#
+# The long format dataset (one line per type, source and destination) is also
+# written to allow further processing.
+#
+# Author: Alexy Torres Aurora Dugo
+#
+# Date: 02/02/2022
+################################################################################
+
+
+################################################################################
+# IMPORTS
+################################################################################
+import os
+import sys
+import argparse
+import numpy as np
+import pandas as pd
+
+################################################################################
+# CONSTANTS
+################################################################################
+METRICS    = ["ExecTime", "l2Miss", "tlbMiss"]
+STATISTICS = {
+    "mean":   lambda values: np.mean(values),
+    "median": lambda values: np.median(values),
+    "p99":    lambda values: np.percentile(values, 99),
+    "max":    lambda values: np.max(values)
+}
+
+# Number of samples dropped at the beginning of each combination, they contain
+# noisy measurements (cold caches)
+DEFAULT_WARMUP = 2
+
+################################################################################
+# GLOBAL VARIABLES
+################################################################################
+
+# None
+
+################################################################################
+# CLASSES
+################################################################################
+
+# None
+
+################################################################################
+# FUNCTIONS
+################################################################################
+def loadSweep(filenames, warmup):
+    """
+        Loads and merges the sweep CSV files. The first samples of each
+        (type, source, destination) combination are dropped.
+
+    Parameters
+    ----------
+        filenames : list (in)
+            The sweep CSV files to load.
+        warmup : int (in)
+            The number of samples to drop for each combination.
+
+    Return
+    ----------
+        The merged data frame.
+
+    Raises
+    ----------
+        IOError, RuntimeError and others can be raised during the files
+        manipulations.
+    """
+    dataFrames = []
+    for filename in filenames:
+        dataFrame = pd.read_csv(filename)
+        if "Src" not in dataFrame.columns or "Dst" not in dataFrame.columns:
+            raise RuntimeError(filename + " is not a sweep file")
+        dataFrames.append(dataFrame)
+
+    dataFrame = pd.concat(dataFrames, ignore_index = True)
+
+    # Drop the warmup samples of each combination
+    rank = dataFrame.groupby(["Type", "Src", "Dst"]).cumcount()
+    return dataFrame[rank >= warmup]
+
+def computeMatrices(dataFrame, coreCount):
+    """
+        Computes the interference matrices of a sweep.
+
+    Parameters
+    ----------
+        dataFrame : DataFrame (in)
+            The sweep samples.
+        coreCount : int (in)
+            The number of cores, the matrices are coreCount x coreCount.
+
+    Return
+    ----------
+        A dictionary {(type, metric, statistic): matrix} where the matrix is a
+        numpy array indexed by [source, destination]. Combinations without
+        samples are set to NaN.
+
+    Raises
+    ----------
+        None.
+    """
+    matrices = {}
+    for (intType, src, dst), group in dataFrame.groupby(["Type", "Src", "Dst"]):
+        if src >= coreCount or dst >= coreCount:
+            continue
+        for metric in METRICS:
+            values = group[metric].values.astype(np.float64)
+            for statName, statFunc in STATISTICS.items():
+                key = (intType, metric, statName)
+                if key not in matrices:
+                    matrices[key] = np.full((coreCount, coreCount), np.nan)
+                matrices[key][src, dst] = statFunc(values)
+
+    return matrices
+
+def writeLongDataset(outputFile, dataFrame):
+    """
+        Writes the long format dataset: one line per type, source and
+        destination with the statistics of each metric.
+
+    Parameters
+    ----------
+        outputFile : File (out)
+            The output file.
+        dataFrame : DataFrame (in)
+            The sweep samples.
+
+    Return
+    ----------
+        None.
+
+    Raises
+    ----------
+        IOError can be raised during the file manipulation.
+    """
+    header = ["Type", "Src", "Dst", "Count"]
+    for metric in METRICS:
+        header += [metric + "_" + statName for statName in STATISTICS]
+    outputFile.write(",".join(header) + "\n")
+
+    for (intType, src, dst), group in dataFrame.groupby(["Type", "Src", "Dst"]):
+        line = [intType, str(src), str(dst), str(len(group))]
+        for metric in METRICS:
+            values = group[metric].values.astype(np.float64)
+            line += ["{:.3f}".format(statFunc(values))
+                     for statFunc in STATISTICS.values()]
+        outputFile.write(",".join(line) + "\n")
+
+def writeMatrix(outputFile, matrix):
+    """
+        Writes a matrix in CSV format, the rows are the source cores and the
+        columns the destination cores.
+
+    Parameters
+    ----------
+        outputFile : File (out)
+            The output file.
+        matrix : numpy array (in)
+            The matrix to write.
+
+    Return
+    ----------
+        None.
+
+    Raises
+    ----------
+        IOError can be raised during the file manipulation.
+    """
+    coreCount = matrix.shape[0]
+    outputFile.write("Src\\Dst," +
+                     ",".join(str(i) for i in range(coreCount)) + "\n")
+    for src in range(coreCount):
+        outputFile.write(str(src) + "," +
+                         ",".join("" if np.isnan(value) else
+                                  "{:.3f}".format(value)
+                                  for value in matrix[src]) + "\n")
+
+def plotMatrix(filename, matrix, title):
+    """
+        Renders the heat map of a matrix.
+
+    Parameters
+    ----------
+        filename : str (in)
+            The output image file name.
+        matrix : numpy array (in)
+            The matrix to render.
+        title : str (in)
+            The figure title.
+
+    Return
+    ----------
+        None.
+
+    Raises
+    ----------
+        IOError can be raised during the file manipulation.
+    """
+    import matplotlib
+    matplotlib.use("Agg")
+    import matplotlib.pyplot as plt
+
+    coreCount = matrix.shape[0]
+    fig, ax = plt.subplots()
+    image = ax.imshow(np.ma.masked_invalid(matrix), cmap = "viridis")
+    fig.colorbar(image, ax = ax)
+
+    ax.set_xticks(range(coreCount))
+    ax.set_yticks(range(coreCount))
+    ax.set_xlabel("Destination core")
+    ax.set_ylabel("Source core")
+    ax.set_title(title)
+
+    # Annotate the cells
+    for src in range(coreCount):
+        for dst in range(coreCount):
+            if not np.isnan(matrix[src, dst]):
+                ax.text(dst, src, "{:.0f}".format(matrix[src, dst]),
+                        ha = "center", va = "center", color = "w")
+
+    fig.savefig(filename, bbox_inches = "tight")
+    plt.close(fig)
+
+def parseCommand():
+    """
+        Parses the command line to extract the following arguments:
+            -i [files] The sweep CSV files.
+            -o [outputdir] The output directory of the matrices.
+            -n [cores] The number of cores.
+            -w [warmup] The number of samples dropped per combination.
+            -p Renders the heat maps.
+
+    Parameters
+    ----------
+        None.
+
+    Return
+    ----------
+        The argparse object that contains the parsed command line (parse_args
+        is already called in this function).
+
+    Raises
+    ----------
+        None.
+    """
+    parser = argparse.ArgumentParser(description = "Interference Matrix Args Parser")
+
+    parser.add_argument("-i", type = str, nargs = "+", dest = "inputFilenames",
+                        required = True,
+                        help = "Sweep CSV files (SWEEP_*.csv)")
+    parser.add_argument("-o", type = str, nargs = "?", dest = "outputPath",
+                        default = "matrix",
+                        help = "Matrices output folder path")
+    parser.add_argument("-n", type = int, nargs = "?", dest = "coreCount",
+                        default = 0,
+                        help = "Number of cores (default: deduced from the "
+                               "sweep)")
+    parser.add_argument("-w", type = int, nargs = "?", dest = "warmup",
+                        default = DEFAULT_WARMUP,
+                        help = "Number of samples dropped per combination")
+    parser.add_argument("-p", action = "store_true", dest = "plot",
+                        help = "Render the heat maps")
+
+    return parser.parse_args()
+
+if __name__ == "__main__":
+    # Get the arguments
+    args = parseCommand()
+
+    try:
+        dataFrame = loadSweep(args.inputFilenames, args.warmup)
+    except (IOError, RuntimeError) as exc:
+        print("Error while loading the sweep: " + str(exc))
+        sys.exit(1)
+
+    if len(dataFrame) == 0:
+        print("No sample in the sweep")
+        sys.exit(1)
+
+    coreCount = args.coreCount
+    if coreCount <= 0:
+        coreCount = int(max(dataFrame["Src"].max(), dataFrame["Dst"].max())) + 1
+
+    os.makedirs(args.outputPath, exist_ok = True)
+
+    with open(os.path.join(args.outputPath, "interf_matrix.csv"), "w") as outputFile:
+        writeLongDataset(outputFile, dataFrame)
+
+    matrices = computeMatrices(dataFrame, coreCount)
+    for (intType, metric, statName), matrix in sorted(matrices.items()):
+        name = "matrix_{}_{}_{}".format(intType, metric, statName)
+        with open(os.path.join(args.outputPath, name + ".csv"), "w") as outputFile:
+            writeMatrix(outputFile, matrix)
+        if args.plot:
+            plotMatrix(os.path.join(args.outputPath, name + ".png"), matrix,
+                       "{} {} ({})".format(intType, metric, statName))
+        print("Generated " + name)
+
+    print("---------------------------------")
+    print("Matrix generation finished without error")
@@ -0,0 +1,233 @@
+################################################################################
+# MicroCompare.py
+#
+# Description: This python script compares two results files of the framework
+# microbenchmarks (RTOS_Benchmark/Host/MicroBench.c, make micro), typically
+# written by a reference and a candidate revision on the same host. The
+# benchmarks are matched by name and number of threads and compared on their
+# median cycles per call.
+#
+# A benchmark regresses when its median increases by more than the tolerance
+# and the fastest candidate repetition is slower than the reference median, so
+# the noise of a single repetition does not flag a regression. The host noise
+# between two runs is in the order of 10%, both revisions should be measured
+# back to back on an idle host. The script exits with 1 when a benchmark
+# regresses.
+#
+# The benchmarks measured with both APIs (the C++ one is suffixed with _cpp)
+# are also compared to each other in each results file.
+#
+# Author: Alexy Torres Aurora Dugo
+#
+# Date: 03/03/2022
+################################################################################
+
+
+################################################################################
+# IMPORTS
+################################################################################
+import sys
+import csv
+import argparse
+
+################################################################################
+# CONSTANTS
+################################################################################
+# None
+
+################################################################################
+# GLOBAL VARIABLES
+################################################################################
+
+# None
+
+################################################################################
+# CLASSES
+################################################################################
+
+# None
+
+################################################################################
+# FUNCTIONS
+################################################################################
+def loadResults(filename):
+    """
+        Loads a microbenchmarks results file.
+
+    Parameters
+    ----------
+        filename : str (in)
+            The CSV results file.
+
+    Return
+    ----------
+        The revision of the results and the dictionary of the (minimum,
+        median) cycles per call indexed by (benchmark, threads).
+
+    Raises
+    ----------
+        IOError if the file cannot be read, RuntimeError if a line is invalid.
+    """
+    results  = {}
+    revision = "unknown"
+    with open(filename, "r", newline = "") as inputFile:
+        for line, row in enumerate(csv.DictReader(inputFile), start = 2):
+            try:
+                key = (row["Benchmark"], int(row["Threads"]))
+                results[key] = (float(row["MinCycles"]),
+                                float(row["MedianCycles"]))
+                revision = row["Revision"]
+            except (KeyError, ValueError, TypeError) as exc:
+                raise RuntimeError("Invalid result line " + str(line) + ": " +
+                                   str(exc))
+
+    return revision, results
+
+def compareResults(reference, candidate, tolerance):
+    """
+        Compares the candidate results to the reference and prints the
+        report.
+
+    Parameters
+    ----------
+        reference : dict (in)
+            The reference results.
+        candidate : dict (in)
+            The candidate results.
+        tolerance : float (in)
+            The tolerated increase of the median (%).
+
+    Return
+    ----------
+        The list of the regressed (benchmark, threads).
+
+    Raises
+    ----------
+        None.
+    """
+    regressions = []
+
+    print("{:<20} {:>7} {:>12} {:>12} {:>8}".format("Benchmark", "Threads",
+                                                   "Reference", "Candidate",
+                                                   "Change"))
+    for key in sorted(reference.keys()):
+        if key not in candidate:
+            print("{:<20} {:>7} missing in the candidate".format(*key))
+            continue
+
+        refMin, refMedian = reference[key]
+        candMin, candMedian = candidate[key]
+        change = 0.0
+        if refMedian > 0:
+            change = (candMedian - refMedian) * 100.0 / refMedian
+
+        status = ""
+        if change > tolerance and candMin > refMedian:
+            status = "REGRESSION"
+            regressions.append(key)
+
+        print("{:<20} {:>7} {:>12.2f} {:>12.2f} {:>+7.1f}% {}".format(
+              key[0], key[1], refMedian, candMedian, change, status))
+
+    for key in sorted(candidate.keys()):
+        if key not in reference:
+            print("{:<20} {:>7} new in the candidate".format(*key))
+
+    return regressions
+
+def compareApis(results):
+    """
+        Compares the C++ API benchmarks (suffixed with _cpp) of a results file
+        to their C counterparts and prints the report.
+
+    Parameters
+    ----------
+        results : dict (in)
+            The results of a revision.
+
+    Return
+    ----------
+        None.
+
+    Raises
+    ----------
+        None.
+    """
+    for key in sorted(results.keys()):
+        if not key[0].endswith("_cpp"):
+            continue
+        cKey = (key[0][:-len("_cpp")], key[1])
+        if cKey not in results:
+            continue
+
+        cMedian   = results[cKey][1]
+        cppMedian = results[key][1]
+        change = 0.0
+        if cMedian > 0:
+            change = (cppMedian - cMedian) * 100.0 / cMedian
+
+        print("{:<20} {:>7} {:>12.2f} {:>12.2f} {:>+7.1f}%".format(
+              cKey[0], key[1], cMedian, cppMedian, change))
+
+def parseCommand():
+    """
+        Parses the command line to extract the following arguments:
+            -r [file] The reference results.
+            -c [file] The candidate results.
+            -t [tolerance] The tolerated increase of the median (%).
+
+    Parameters
+    ----------
+        None.
+
+    Return
+    ----------
+        The argparse object that contains the parsed command line (parse_args
+        is already called in this function).
+
+    Raises
+    ----------
+        None.
+    """
+    parser = argparse.ArgumentParser(description = "Microbenchmarks Compare "
+                                                   "Args Parser")
+
+    parser.add_argument("-r", type = str, dest = "referenceFilename",
+                        required = True,
+                        help = "Reference microbenchmarks results")
+    parser.add_argument("-c", type = str, dest = "candidateFilename",
+                        required = True,
+                        help = "Candidate microbenchmarks results")
+    parser.add_argument("-t", type = float, dest = "tolerance", default = 20.0,
+                        help = "Tolerated increase of the median cycles per "
+                               "call in percent (default: 20)")
+
+    return parser.parse_args()
+
+if __name__ == "__main__":
+    # Get the arguments
+    args = parseCommand()
+
+    try:
+        refRevision, reference  = loadResults(args.referenceFilename)
+        candRevision, candidate = loadResults(args.candidateFilename)
+    except (IOError, RuntimeError) as exc:
+        print("Error while loading the results: " + str(exc))
+        sys.exit(2)
+
+    print("Reference: {}, candidate: {}, tolerance {:.1f}%".format(
+          refRevision, candRevision, args.tolerance))
+    print("---------------------------------")
+    regressions = compareResults(reference, candidate, args.tolerance)
+    print("---------------------------------")
+    print("{:<20} {:>7} {:>12} {:>12} {:>8}".format("API (candidate)",
+                                                   "Threads", "C", "C++",
+                                                   "Change"))
+    compareApis(candidate)
+    print("---------------------------------")
+
+    if 0 < len(regressions):
+        print("{} benchmark(s) regressed".format(len(regressions)))
+        sys.exit(1)
+
+    print("No regression")
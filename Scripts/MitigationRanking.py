@@ -0,0 +1,498 @@
+################################################################################
+# MitigationRanking.py
+#
+# Description: This python script classifies and ranks the memory
+# configurations (mitigations) of a dataset. For every mitigation, environment
+# and interrupt type, the slowdown of each partition is computed relative to
+# the mitigation's own Baseline for the mean, the 99th percentile and the
+# maximum execution time. Bootstrap confidence intervals are attached to every
+# slowdown, the configurations being processed in parallel.
+#
+# For each partition, the mitigations are ranked on each statistic. The
+# weighted average of these ranks (see -w) is then averaged over the
+# partitions to produce the final ranking, one table per interrupt type and
+# environment.
+#
+# The input folder must follow the same rules as for DataVisualizer.py.
+#
+# Author: Alexy Torres Aurora Dugo
+#
+# Date: 02/02/2022
+################################################################################
+
+
+################################################################################
+# IMPORTS
+################################################################################
+import os
+import sys
+import zlib
+import argparse
+import concurrent.futures
+import numpy as np
+
+import StatsCache
+
+################################################################################
+# CONSTANTS
+################################################################################
+PARTITION_COUNT = 10
+METRIC          = "ExecTime"
+STATISTICS      = ["mean", "p99", "max"]
+
+DEFAULT_BOOTSTRAP_COUNT = 1000
+DEFAULT_CONFIDENCE      = 0.95
+DEFAULT_SEED            = 0
+
+# Number of bootstrap replicates computed at once, limits memory usage
+BOOTSTRAP_CHUNK = 50
+
+################################################################################
+# GLOBAL VARIABLES
+################################################################################
+
+# None
+
+################################################################################
+# CLASSES
+################################################################################
+
+class Configuration:
+    """
+    Describes a measured configuration: the mitigation, the environment (MC or
+    SC), the interrupt type and rate, the measurement file and the Baseline
+    file of the mitigation.
+    """
+    def __init__(self, mitig, env, intType, rate, filename, baseline):
+        self.mitig    = mitig
+        self.env      = env
+        self.intType  = intType
+        self.rate     = rate
+        self.filename = filename
+        self.baseline = baseline
+
+    def getGroup(self):
+        return "{}_{}_{}".format(self.env, self.intType, self.rate)
+
+################################################################################
+# FUNCTIONS
+################################################################################
+def computeStatistics(samples):
+    """
+        Computes the ranked statistics over the last axis of an array.
+
+    Parameters
+    ----------
+        samples : np.ndarray (in)
+            The samples, the statistics are computed over the last axis.
+
+    Return
+    ----------
+        The dictionary of statistics indexed by name (see STATISTICS).
+
+    Raises
+    ----------
+        None.
+    """
+    return {"mean": samples.mean(axis = -1),
+            "p99":  np.quantile(samples, 0.99, axis = -1),
+            "max":  samples.max(axis = -1)}
+
+def bootstrapPartition(samples, baseline, bootCount, rng):
+    """
+        Computes the bootstrap replicates of the slowdowns of a partition. The
+        measurement and the baseline samples are resampled independently.
+
+    Parameters
+    ----------
+        samples : np.ndarray (in)
+            The partition's measurements.
+        baseline : np.ndarray (in)
+            The partition's baseline measurements.
+        bootCount : int (in)
+            The number of bootstrap replicates.
+        rng : np.random.Generator (in)
+            The random generator to use.
+
+    Return
+    ----------
+        The dictionary of replicates (np.ndarray) indexed by statistic name.
+
+    Raises
+    ----------
+        None.
+    """
+    replicates = {stat: [] for stat in STATISTICS}
+
+    for start in range(0, bootCount, BOOTSTRAP_CHUNK):
+        count = min(BOOTSTRAP_CHUNK, bootCount - start)
+        resampled = samples[rng.integers(0, len(samples),
+                                         (count, len(samples)))]
+        resampledBase = baseline[rng.integers(0, len(baseline),
+                                              (count, len(baseline)))]
+        stats     = computeStatistics(resampled)
+        statsBase = computeStatistics(resampledBase)
+        for stat in STATISTICS:
+            replicates[stat].append(stats[stat] / statsBase[stat])
+
+    return {stat: np.concatenate(replicates[stat]) for stat in STATISTICS}
+
+def processConfiguration(config, bootCount, confidence, seed):
+    """
+        Computes the slowdowns and their bootstrap confidence intervals of a
+        configuration for each partition and for the average over the
+        partitions. This function is executed by the workers of the pool.
+
+    Parameters
+    ----------
+        config : Configuration (in)
+            The configuration to process.
+        bootCount : int (in)
+            The number of bootstrap replicates.
+        confidence : float (in)
+            The confidence level of the intervals.
+        seed : int (in)
+            The random generator seed.
+
+    Return
+    ----------
+        The tuple (config, results) where results is a dictionary indexed by
+        partition ID (-1 for the average over the partitions), then by
+        statistic name, containing the tuple (slowdown, ciLow, ciHigh).
+
+    Raises
+    ----------
+        IOError, RuntimeError and others can be raised during the files
+        manipulations.
+    """
+    # Each configuration has its own reproducible random stream
+    rng = np.random.default_rng([seed, zlib.crc32((config.mitig + "_" +
+                                                   config.getGroup()).encode())])
+
+    data     = StatsCache.loadDataFrame(config.filename)
+    baseData = StatsCache.loadDataFrame(config.baseline)
+
+    alpha      = (1.0 - confidence) / 2.0
+    results    = {}
+    replicates = {stat: [] for stat in STATISTICS}
+    points     = {stat: [] for stat in STATISTICS}
+
+    for partId in range(PARTITION_COUNT):
+        samples  = data[data["Id"] == partId][METRIC].values.astype(np.float64)
+        baseline = baseData[baseData["Id"] == partId][METRIC].values.astype(np.float64)
+        if len(samples) == 0 or len(baseline) == 0:
+            continue
+
+        stats     = computeStatistics(samples)
+        statsBase = computeStatistics(baseline)
+        partReplicates = bootstrapPartition(samples, baseline, bootCount, rng)
+
+        results[partId] = {}
+        for stat in STATISTICS:
+            slowdown = stats[stat] / statsBase[stat]
+            low, high = np.quantile(partReplicates[stat], [alpha, 1.0 - alpha])
+            results[partId][stat] = (float(slowdown), float(low), float(high))
+
+            points[stat].append(slowdown)
+            replicates[stat].append(partReplicates[stat])
+
+    # Average over the partitions, the interval is computed on the average of
+    # the replicates to account for every partition's variability.
+    if len(points[STATISTICS[0]]) != 0:
+        results[-1] = {}
+        for stat in STATISTICS:
+            avgReplicates = np.mean(replicates[stat], axis = 0)
+            low, high = np.quantile(avgReplicates, [alpha, 1.0 - alpha])
+            results[-1][stat] = (float(np.mean(points[stat])), float(low),
+                                 float(high))
+
+    return config, results
+
+def rankGroup(groupResults, weights):
+    """
+        Ranks the mitigations of a group (same environment, interrupt type and
+        rate). For each partition, the mitigations are ranked on each
+        statistic (1 is the lowest slowdown). The score of a mitigation is the
+        weighted average of its ranks, averaged over the partitions.
+
+    Parameters
+    ----------
+        groupResults : dict (in)
+            The results of processConfiguration indexed by mitigation.
+        weights : dict (in)
+            The weight of each statistic.
+
+    Return
+    ----------
+        The list of tuples (mitig, score) sorted by score.
+
+    Raises
+    ----------
+        None.
+    """
+    weightSum = sum(weights.values())
+    scores    = {mitig: [] for mitig in groupResults}
+
+    for partId in range(PARTITION_COUNT):
+        mitigs = [mitig for mitig, results in groupResults.items()
+                  if partId in results]
+        if len(mitigs) == 0:
+            continue
+
+        partScores = {mitig: 0.0 for mitig in mitigs}
+        for stat in STATISTICS:
+            values = [groupResults[mitig][partId][stat][0] for mitig in mitigs]
+            # Rank 1 is the best, equal values get the same (average) rank
+            ranks = np.argsort(np.argsort(values)).astype(np.float64) + 1
+            for value in set(values):
+                mask = np.array(values) == value
+                ranks[mask] = ranks[mask].mean()
+            for mitig, rank in zip(mitigs, ranks):
+                partScores[mitig] += weights[stat] * rank / weightSum
+
+        for mitig in mitigs:
+            scores[mitig].append(partScores[mitig])
+
+    ranking = [(mitig, float(np.mean(score))) for mitig, score in scores.items()
+               if len(score) != 0]
+
+    return sorted(ranking, key = lambda item: item[1])
+
+def getConfigurations(rootPath):
+    """
+        Generates the list of configurations to process by walking the input
+        directory. Configurations without Baseline are ignored.
+
+    Parameters
+    ----------
+        rootPath : str (in)
+            The path to the input directory.
+
+    Return
+    ----------
+        The list of configurations.
+
+    Raises
+    ----------
+        IOError can be raised during the files manipulations.
+    """
+    configs = []
+
+    for folder in sorted(os.listdir(rootPath)):
+        splited = folder.split("_")
+        if(len(splited) != 2 or splited[1] != "mitig"):
+            continue
+
+        baseline = os.path.join(rootPath, folder, "Baseline", "PART_output.csv")
+        if not os.path.isfile(baseline):
+            print("Ignoring {}: no Baseline".format(folder))
+            continue
+
+        for sets in sorted(os.listdir(os.path.join(rootPath, folder))):
+            setSplit = sets.split("_")
+            filename = os.path.join(rootPath, folder, sets, "PART_output.csv")
+            if(len(setSplit) != 3 or not os.path.isfile(filename)):
+                continue
+            configs.append(Configuration(splited[0], setSplit[0], setSplit[1],
+                                         setSplit[2], filename, baseline))
+
+    return configs
+
+def writeRanking(outputFile, group, ranking, groupResults):
+    """
+        Writes the ranking table of a group in CSV format.
+
+    Parameters
+    ----------
+        outputFile : File (out)
+            The file to write the table to.
+        group : str (in)
+            The group name.
+        ranking : List[] (in)
+            The ranking generated by rankGroup.
+        groupResults : dict (in)
+            The results of processConfiguration indexed by mitigation.
+
+    Return
+    ----------
+        None.
+
+    Raises
+    ----------
+        IOError can be raised during the file manipulations.
+    """
+    header = "group,rank,mitig,score"
+    for stat in STATISTICS:
+        header += ",{0} slowdown,{0} ci low,{0} ci high".format(stat)
+    print(header, file = outputFile)
+
+    for rank, (mitig, score) in enumerate(ranking):
+        line = "{},{},{},{:.3f}".format(group, rank + 1, mitig, score)
+        for stat in STATISTICS:
+            line += ",{:.5f},{:.5f},{:.5f}".format(*groupResults[mitig][-1][stat])
+        print(line, file = outputFile)
+
+def writeDetails(outputFile, results):
+    """
+        Writes the per-partition slowdowns of every configuration in CSV
+        format.
+
+    Parameters
+    ----------
+        outputFile : File (out)
+            The file to write the table to.
+        results : List[] (in)
+            The list of tuples (config, results) generated by
+            processConfiguration.
+
+    Return
+    ----------
+        None.
+
+    Raises
+    ----------
+        IOError can be raised during the file manipulations.
+    """
+    header = "group,mitig,partId"
+    for stat in STATISTICS:
+        header += ",{0} slowdown,{0} ci low,{0} ci high".format(stat)
+    print(header, file = outputFile)
+
+    for config, configResults in results:
+        for partId in sorted(configResults.keys()):
+            line = "{},{},{}".format(config.getGroup(), config.mitig,
+                                     "avg" if partId == -1 else partId)
+            for stat in STATISTICS:
+                line += ",{:.5f},{:.5f},{:.5f}".format(*configResults[partId][stat])
+            print(line, file = outputFile)
+
+def parseWeights(weightsStr):
+    """
+        Parses the statistics weights given on the command line.
+
+    Parameters
+    ----------
+        weightsStr : str (in)
+            The weights, formated as "mean=1,p99=1,max=1".
+
+    Return
+    ----------
+        The dictionary of weights indexed by statistic name.
+
+    Raises
+    ----------
+        ValueError is raised if the format is invalid.
+    """
+    weights = {stat: 1.0 for stat in STATISTICS}
+    for item in weightsStr.split(","):
+        name, value = item.split("=")
+        if name not in weights:
+            raise ValueError("Unknown statistic " + name)
+        weights[name] = float(value)
+
+    if sum(weights.values()) == 0:
+        raise ValueError("At least one weight must not be null")
+
+    return weights
+
+def parseCommand():
+    """
+        Parses the command line to extract the following arguments:
+            -d [inputdir] The input directory to parse the extracted files.
+            -o [outputdir] The output directory of the ranking tables.
+            -b [count] The number of bootstrap replicates.
+            -a [confidence] The confidence level of the intervals.
+            -w [weights] The statistics weights.
+            -j [jobs] The number of worker processes.
+            -s [seed] The random generator seed.
+
+    Parameters
+    ----------
+        None.
+
+    Return
+    ----------
+        The argparse object that contains the parsed command line (parse_args
+        is already called in this function).
+
+    Raises
+    ----------
+        None.
+    """
+    parser = argparse.ArgumentParser(description = "Mitigation Ranking Args Parser")
+
+    parser.add_argument("-d", type = str, nargs = "?", dest = "datasetPath",
+                        required = True,
+                        help = "Dataset root folder path")
+    parser.add_argument("-o", type = str, nargs = "?", dest = "outputPath",
+                        default = "ranking",
+                        help = "Ranking tables output folder path")
+    parser.add_argument("-b", type = int, nargs = "?", dest = "bootCount",
+                        default = DEFAULT_BOOTSTRAP_COUNT,
+                        help = "Number of bootstrap replicates")
+    parser.add_argument("-a", type = float, nargs = "?", dest = "confidence",
+                        default = DEFAULT_CONFIDENCE,
+                        help = "Confidence level of the intervals")
+    parser.add_argument("-w", type = str, nargs = "?", dest = "weights",
+                        default = "mean=1,p99=1,max=1",
+                        help = "Weight of each statistic in the ranking score")
+    parser.add_argument("-j", type = int, nargs = "?", dest = "jobs",
+                        default = os.cpu_count(),
+                        help = "Number of worker processes")
+    parser.add_argument("-s", type = int, nargs = "?", dest = "seed",
+                        default = DEFAULT_SEED,
+                        help = "Bootstrap random generator seed")
+
+    return parser.parse_args()
+
+if __name__ == "__main__":
+    # Get the arguments
+    args = parseCommand()
+
+    try:
+        weights = parseWeights(args.weights)
+    except ValueError as exc:
+        print("Invalid weights: " + str(exc))
+        sys.exit(1)
+
+    configs = getConfigurations(args.datasetPath)
+    if len(configs) == 0:
+        print("No configuration found in " + args.datasetPath)
+        sys.exit(1)
+
+    os.makedirs(args.outputPath, exist_ok = True)
+
+    # Compute the slowdowns of each configuration in parallel
+    print("Processing {} configurations with {} processes...".format(
+          len(configs), args.jobs))
+    results = []
+    with concurrent.futures.ProcessPoolExecutor(args.jobs) as executor:
+        futures = [executor.submit(processConfiguration, config,
+                                   args.bootCount, args.confidence, args.seed)
+                   for config in configs]
+        for future in concurrent.futures.as_completed(futures):
+            config, configResults = future.result()
+            print("Processed {};{}".format(config.mitig, config.getGroup()))
+            results.append((config, configResults))
+
+    results.sort(key = lambda item: (item[0].getGroup(), item[0].mitig))
+
+    # Rank each group
+    groups = {}
+    for config, configResults in results:
+        if -1 in configResults:
+            groups.setdefault(config.getGroup(), {})[config.mitig] = configResults
+
+    for group in sorted(groups.keys()):
+        ranking = rankGroup(groups[group], weights)
+        with open(os.path.join(args.outputPath,
+                               "ranking_" + group + ".csv"), "w") as outputFile:
+            writeRanking(outputFile, group, ranking, groups[group])
+        writeRanking(sys.stdout, group, ranking, groups[group])
+        print("")
+
+    with open(os.path.join(args.outputPath, "slowdowns.csv"), "w") as outputFile:
+        writeDetails(outputFile, results)
+
+    print("---------------------------------")
+    print("Ranking finished without error")
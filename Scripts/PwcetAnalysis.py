@@ -0,0 +1,662 @@
+################################################################################
+# PwcetAnalysis.py
+#
+# Description: This python script computes the probabilistic WCET (pWCET) of
+# the measured execution times with the extreme value theory. For every
+# configuration, file and partition of a dataset, the tail of the execution
+# time distribution is fitted and the bounds exceeded with a probability lower
+# than the requested per-run exceedance probabilities (-p) are written.
+#
+# Two tail models are fitted:
+# - bm: block maxima, a GEV distribution is fitted to the maxima of the blocks
+#   of consecutive samples. It is reduced to a Gumbel distribution when the
+#   likelihood ratio test does not reject the null shape.
+# - pot: peaks over threshold, a generalized Pareto distribution is fitted to
+#   the exceedances of the samples over the threshold (the largest -t fraction
+#   of the samples).
+#
+# The fits are only meaningful on independent and identically distributed
+# samples. The lag 1 autocorrelation, the runs test and the Kolmogorov-Smirnov
+# test between the two halves of each series are reported with the bounds, the
+# series failing one of them at the -a level are flagged.
+#
+# Every fit is given a status in the bounds table and on the curves: "ok", or
+# the checks it fails among "iid" (the series failed the tests above), "gof"
+# (the Kolmogorov-Smirnov goodness of fit p-value is lower than -a) and
+# "shape" (the tail shape parameter is larger than -x). The execution times
+# are bounded, a positive shape (heavy tail) comes from the fit, not from the
+# system: the bounds and curves of the fits rejected on their shape are not
+# written. A shape of 1 or more (infinite mean) is always rejected.
+#
+# The script works on the cached summaries (see StatsCache.py): the block
+# maxima and the largest samples are stored with the summaries, the files are
+# only read when they changed. The series are fitted in parallel (-j).
+#
+# The input folder must follow the same rules as for DataVisualizer.py. The
+# interrupt files (IPI_output.csv, etc.) can be analyzed with -f.
+#
+# Author: Alexy Torres Aurora Dugo
+#
+# Date: 03/03/2022
+################################################################################
+
+
+################################################################################
+# IMPORTS
+################################################################################
+import os
+import sys
+import math
+import argparse
+import concurrent.futures
+import numpy as np
+from scipy import stats
+from scipy import special
+
+import StatsCache
+
+################################################################################
+# CONSTANTS
+################################################################################
+METHODS = ["bm", "pot"]
+
+DEFAULT_FILES         = "PART_output.csv"
+DEFAULT_PROBABILITIES = "1e-3,1e-6,1e-9,1e-12,1e-15"
+DEFAULT_ALPHA         = 0.05
+DEFAULT_TAIL_FRACTION = 0.05
+DEFAULT_MAX_SHAPE     = 0.1
+
+# Exceedance probabilities of the pWCET curves
+CURVE_PROBABILITIES = [10.0 ** -(i / 2.0) for i in range(4, 31)]
+
+# Minimal number of block maxima or exceedances to fit a tail model
+MIN_FIT_SAMPLES = 30
+
+# Status of the fits that pass every check
+STATUS_OK = "ok"
+
+METRIC_LABEL = "Execution time (ns)"
+
+################################################################################
+# GLOBAL VARIABLES
+################################################################################
+
+# None
+
+################################################################################
+# CLASSES
+################################################################################
+
+class Series:
+    """
+    Describes an analyzed series: the samples of a partition in a file of a
+    configuration, and its extreme value analysis data from the statistics
+    cache.
+    """
+    def __init__(self, mitig, setName, filename, partId, summary):
+        self.mitig    = mitig
+        self.setName  = setName
+        self.filename = filename
+        self.partId   = partId
+        self.count    = summary["count"]
+        self.max      = summary["max"]
+        self.evt      = summary["evt"]
+
+    def getName(self):
+        return "{}_{}_{}_{}".format(self.mitig, self.setName,
+                                    os.path.splitext(os.path.basename(
+                                        self.filename))[0],
+                                    self.partId)
+
+################################################################################
+# FUNCTIONS
+################################################################################
+def testIid(series, alpha):
+    """
+        Computes the p-values of the independence and identical distribution
+        tests of a series from its cached statistics.
+
+    Parameters
+    ----------
+        series : Series (in)
+            The series to test.
+        alpha : float (in)
+            The significance level of the tests.
+
+    Return
+    ----------
+        The tuple (pLag1, pRuns, pKs, passed).
+
+    Raises
+    ----------
+        None.
+    """
+    evt    = series.evt
+    first  = series.count // 2
+    second = series.count - first
+
+    pLag1 = float(2.0 * stats.norm.sf(abs(evt["lag1"]) * math.sqrt(series.count)))
+    pRuns = float(2.0 * stats.norm.sf(abs(evt["runsZ"])))
+    pKs   = 1.0
+    if first > 0 and second > 0:
+        pKs = float(special.kolmogorov(evt["ksHalves"] *
+                                       math.sqrt(first * second /
+                                                 (first + second))))
+
+    return pLag1, pRuns, pKs, min(pLag1, pRuns, pKs) >= alpha
+
+def fitBlockMaxima(series, alpha):
+    """
+        Fits the block maxima of a series. A GEV distribution is fitted and
+        compared to a Gumbel fit with the likelihood ratio test, the Gumbel
+        distribution is kept unless the test rejects it at the alpha level.
+
+    Parameters
+    ----------
+        series : Series (in)
+            The series to fit.
+        alpha : float (in)
+            The significance level of the likelihood ratio test.
+
+    Return
+    ----------
+        The tuple (distribution name, parameters, tail shape parameter,
+        goodness of fit p-value, quantile function of the per-run exceedance
+        probability), None if the series cannot be fitted.
+
+    Raises
+    ----------
+        None.
+    """
+    maxima    = np.asarray(series.evt["blockMaxima"])
+    blockSize = series.evt["blockSize"]
+    if len(maxima) < MIN_FIT_SAMPLES or np.ptp(maxima) == 0:
+        return None
+
+    gumbelParams = stats.gumbel_r.fit(maxima)
+    gevParams    = stats.genextreme.fit(maxima)
+    ratio = 2.0 * (np.sum(stats.genextreme.logpdf(maxima, *gevParams)) -
+                   np.sum(stats.gumbel_r.logpdf(maxima, *gumbelParams)))
+
+    # The shape of scipy's GEV is the opposite of the tail shape parameter
+    if stats.chi2.sf(max(ratio, 0.0), 1) < alpha:
+        name, dist, params = "gev", stats.genextreme, gevParams
+        shape = -float(gevParams[0])
+    else:
+        name, dist, params = "gumbel", stats.gumbel_r, gumbelParams
+        shape = 0.0
+
+    gof = float(stats.kstest(maxima, dist.cdf, args = params).pvalue)
+
+    # A sample exceeds the bound with probability p when its block maximum
+    # exceeds it with probability 1 - (1 - p) ^ blockSize.
+    def quantile(p):
+        return float(dist.isf(-math.expm1(blockSize * math.log1p(-p)),
+                              *params))
+
+    return name, params, shape, gof, quantile
+
+def fitPeaksOverThreshold(series, tailFraction):
+    """
+        Fits the exceedances of a series over its threshold with a generalized
+        Pareto distribution. The threshold is the sample exceeded by the
+        tailFraction largest samples, limited by the cached tail size.
+
+    Parameters
+    ----------
+        series : Series (in)
+            The series to fit.
+        tailFraction : float (in)
+            The fraction of the samples over the threshold.
+
+    Return
+    ----------
+        The tuple (distribution name, parameters, tail shape parameter,
+        goodness of fit p-value, quantile function of the per-run exceedance
+        probability), None if the series cannot be fitted.
+
+    Raises
+    ----------
+        None.
+    """
+    tail  = np.asarray(series.evt["tail"])
+    count = min(len(tail) - 1, int(math.ceil(tailFraction * series.count)))
+    if count < MIN_FIT_SAMPLES:
+        return None
+
+    threshold   = tail[-count - 1]
+    exceedances = tail[tail > threshold] - threshold
+    if len(exceedances) < MIN_FIT_SAMPLES or np.ptp(exceedances) == 0:
+        return None
+
+    rate   = len(exceedances) / series.count
+    params = stats.genpareto.fit(exceedances, floc = 0)
+    gof    = float(stats.kstest(exceedances, stats.genpareto.cdf,
+                                args = params).pvalue)
+
+    # The model only describes the probabilities lower than the exceedance
+    # rate of the threshold.
+    def quantile(p):
+        if p >= rate:
+            return float("nan")
+        return float(threshold + stats.genpareto.isf(p / rate, *params))
+
+    return "gpd", params, float(params[0]), gof, quantile
+
+def getFitStatus(iid, shape, gof, alpha, maxShape):
+    """
+        Checks a fit against the tests of its series, its goodness of fit and
+        the shape limit.
+
+    Parameters
+    ----------
+        iid : tuple (in)
+            The tuple returned by testIid for the series.
+        shape : float (in)
+            The tail shape parameter of the fit.
+        gof : float (in)
+            The goodness of fit p-value of the fit.
+        alpha : float (in)
+            The significance level of the tests.
+        maxShape : float (in)
+            The largest accepted tail shape parameter.
+
+    Return
+    ----------
+        The list of the failed checks ("iid", "gof", "shape"), empty if the fit
+        passes every check.
+
+    Raises
+    ----------
+        None.
+    """
+    failed = []
+    if not iid[3]:
+        failed.append("iid")
+    if math.isnan(gof) or gof < alpha:
+        failed.append("gof")
+    if math.isnan(shape) or shape > maxShape or shape >= 1:
+        failed.append("shape")
+
+    return failed
+
+def processSeries(series, probabilities, alpha, tailFraction, maxShape):
+    """
+        Tests and fits a series, then computes its pWCET bounds and curves.
+        This function is executed by the workers of the pool.
+
+    Parameters
+    ----------
+        series : Series (in)
+            The series to process.
+        probabilities : List[float] (in)
+            The exceedance probabilities of the bounds.
+        alpha : float (in)
+            The significance level of the tests.
+        tailFraction : float (in)
+            The fraction of the samples over the threshold of the pot fits.
+        maxShape : float (in)
+            The largest accepted tail shape parameter.
+
+    Return
+    ----------
+        The tuple (series, iid, results) where iid is the tuple returned by
+        testIid and results is a dictionary indexed by method containing the
+        tuple (distribution name, parameters, goodness of fit p-value, bounds,
+        curve, tail shape parameter, failed checks). The bounds and the curve
+        of the fits rejected on their shape are NaN.
+
+    Raises
+    ----------
+        None.
+    """
+    iid     = testIid(series, alpha)
+    results = {}
+
+    for method in METHODS:
+        try:
+            if method == "bm":
+                fit = fitBlockMaxima(series, alpha)
+            else:
+                fit = fitPeaksOverThreshold(series, tailFraction)
+        except (ValueError, RuntimeError, FloatingPointError) as exc:
+            print("Cannot fit {} ({}): {}".format(series.getName(), method,
+                                                  str(exc)))
+            fit = None
+        if fit is None:
+            continue
+
+        name, params, shape, gof, quantile = fit
+        failed = getFitStatus(iid, shape, gof, alpha, maxShape)
+        if "shape" in failed:
+            bounds = [float("nan")] * len(probabilities)
+            curve  = [float("nan")] * len(CURVE_PROBABILITIES)
+        else:
+            bounds = [quantile(p) for p in probabilities]
+            curve  = [quantile(p) for p in CURVE_PROBABILITIES]
+        results[method] = (name, [float(param) for param in params], gof,
+                           bounds, curve, shape, failed)
+
+    return series, iid, results
+
+def getSeries(rootPath, filenames, metric, cache, jobs):
+    """
+        Generates the list of series to analyze by walking the input directory
+        and retrieving the summaries of the files from the statistics cache.
+
+    Parameters
+    ----------
+        rootPath : str (in)
+            The path to the input directory.
+        filenames : List[str] (in)
+            The names of the files to analyze in each set.
+        metric : str (in)
+            The analyzed metric.
+        cache : StatsCache (in/out)
+            The statistics cache.
+        jobs : int (in)
+            The number of worker processes summarizing the modified files.
+
+    Return
+    ----------
+        The list of series.
+
+    Raises
+    ----------
+        IOError, RuntimeError and others can be raised during the files
+        manipulations.
+    """
+    files = []
+
+    for folder in sorted(os.listdir(rootPath)):
+        splited = folder.split("_")
+        if(len(splited) != 2 or splited[1] != "mitig"):
+            continue
+
+        for sets in sorted(os.listdir(os.path.join(rootPath, folder))):
+            if(len(sets.split("_")) != 3 and sets != "Baseline"):
+                continue
+            for name in filenames:
+                filename = os.path.join(rootPath, folder, sets, name)
+                if os.path.isfile(filename):
+                    files.append((splited[0], sets, filename))
+
+    summaries  = cache.getSummaries([item[2] for item in files], jobs)
+    seriesList = []
+    for mitig, sets, filename in files:
+        for partId, partSummary in sorted(summaries[filename].items()):
+            if metric in partSummary and "evt" in partSummary[metric]:
+                seriesList.append(Series(mitig, sets, filename, partId,
+                                         partSummary[metric]))
+
+    return seriesList
+
+def writeBounds(outputFile, results, probabilities):
+    """
+        Writes the pWCET bounds of every series and method in CSV format.
+
+    Parameters
+    ----------
+        outputFile : File (out)
+            The file to write the table to.
+        results : List[] (in)
+            The list of tuples generated by processSeries.
+        probabilities : List[float] (in)
+            The exceedance probabilities of the bounds.
+
+    Return
+    ----------
+        None.
+
+    Raises
+    ----------
+        IOError can be raised during the file manipulations.
+    """
+    header = "mitig,set,file,partId,samples,max,lag1 p,runs p,ks p,iid," \
+             "method,dist,params,shape,gof p,status"
+    for p in probabilities:
+        header += ",pWCET {:g}".format(p)
+    print(header, file = outputFile)
+
+    for series, iid, seriesResults in results:
+        for method in METHODS:
+            if method not in seriesResults:
+                continue
+            name, params, gof, bounds, _, shape, failed = seriesResults[method]
+            line = "{},{},{},{},{},{:.0f},{:.4f},{:.4f},{:.4f},{},{},{},{},{:.4f},{:.4f},{}".format(
+                series.mitig, series.setName, os.path.basename(series.filename),
+                series.partId, series.count, series.max, iid[0], iid[1], iid[2],
+                "yes" if iid[3] else "no", method, name,
+                " ".join(["{:.6g}".format(param) for param in params]), shape,
+                gof, " ".join(failed) if failed else STATUS_OK)
+            for bound in bounds:
+                line += ",{:.0f}".format(bound) if not math.isnan(bound) else ","
+            print(line, file = outputFile)
+
+def writeCurves(outputFile, results):
+    """
+        Writes the pWCET curves of every series and method in long CSV format.
+
+    Parameters
+    ----------
+        outputFile : File (out)
+            The file to write the curves to.
+        results : List[] (in)
+            The list of tuples generated by processSeries.
+
+    Return
+    ----------
+        None.
+
+    Raises
+    ----------
+        IOError can be raised during the file manipulations.
+    """
+    print("mitig,set,file,partId,method,status,probability,pWCET",
+          file = outputFile)
+
+    for series, _, seriesResults in results:
+        for method in METHODS:
+            if method not in seriesResults:
+                continue
+            failed = seriesResults[method][6]
+            status = " ".join(failed) if failed else STATUS_OK
+            for p, value in zip(CURVE_PROBABILITIES, seriesResults[method][4]):
+                if math.isnan(value):
+                    continue
+                print("{},{},{},{},{},{},{:.3e},{:.0f}".format(
+                      series.mitig, series.setName,
+                      os.path.basename(series.filename), series.partId, method,
+                      status, p, value), file = outputFile)
+
+def plotCurves(outputDir, result):
+    """
+        Renders the pWCET curves of a series with its empirical exceedance
+        probabilities. The curves of the fits failing a check are dashed and
+        their label gives the failed checks, the fits rejected on their shape
+        have no curve.
+
+    Parameters
+    ----------
+        outputDir : str (in)
+            The folder of the figures.
+        result : tuple (in)
+            The tuple generated by processSeries.
+
+    Return
+    ----------
+        None.
+
+    Raises
+    ----------
+        IOError can be raised during the file manipulations.
+    """
+    import matplotlib
+    matplotlib.use("Agg")
+    import matplotlib.pyplot as plt
+
+    series, _, seriesResults = result
+    tail = np.asarray(series.evt["tail"])
+
+    fig, ax = plt.subplots()
+    ax.plot(tail, (len(tail) - np.arange(len(tail))) / series.count, ".",
+            label = "measured")
+    for method in METHODS:
+        if method not in seriesResults:
+            continue
+        failed = seriesResults[method][6]
+        label  = "{} ({})".format(method, seriesResults[method][0])
+        if failed:
+            label += " - failed: " + ", ".join(failed)
+        ax.plot(seriesResults[method][4], CURVE_PROBABILITIES,
+                "--" if failed else "-", label = label)
+    ax.set_yscale("log")
+    ax.set_xlabel(METRIC_LABEL)
+    ax.set_ylabel("Exceedance probability")
+    ax.set_title(series.getName())
+    ax.legend()
+    fig.savefig(os.path.join(outputDir, series.getName() + ".png"))
+    plt.close(fig)
+
+def parseCommand():
+    """
+        Parses the command line to extract the following arguments:
+            -d [inputdir] The input directory to parse the extracted files.
+            -o [outputdir] The output directory of the pWCET tables.
+            -c [cache] The statistics cache file.
+            -f [files] The names of the analyzed files.
+            -p [probabilities] The exceedance probabilities of the bounds.
+            -a [alpha] The significance level of the tests.
+            -t [fraction] The fraction of the samples over the pot threshold.
+            -x [shape] The largest accepted tail shape parameter.
+            -j [jobs] The number of worker processes.
+            -g Renders the pWCET curves.
+
+    Parameters
+    ----------
+        None.
+
+    Return
+    ----------
+        The argparse object that contains the parsed command line (parse_args
+        is already called in this function).
+
+    Raises
+    ----------
+        None.
+    """
+    parser = argparse.ArgumentParser(description = "pWCET Analysis Args Parser")
+
+    parser.add_argument("-d", type = str, nargs = "?", dest = "datasetPath",
+                        required = True,
+                        help = "Dataset root folder path")
+    parser.add_argument("-o", type = str, nargs = "?", dest = "outputPath",
+                        default = "pwcet",
+                        help = "pWCET tables output folder path")
+    parser.add_argument("-c", type = str, nargs = "?", dest = "cachePath",
+                        default = None,
+                        help = "Statistics cache file path (default: "
+                               "<dataset root>/" + StatsCache.CACHE_FILENAME + ")")
+    parser.add_argument("-f", type = str, nargs = "?", dest = "files",
+                        default = DEFAULT_FILES,
+                        help = "Comma separated names of the analyzed files "
+                               "(default: " + DEFAULT_FILES + ")")
+    parser.add_argument("-p", type = str, nargs = "?", dest = "probabilities",
+                        default = DEFAULT_PROBABILITIES,
+                        help = "Comma separated per-run exceedance "
+                               "probabilities of the bounds")
+    parser.add_argument("-a", type = float, nargs = "?", dest = "alpha",
+                        default = DEFAULT_ALPHA,
+                        help = "Significance level of the tests")
+    parser.add_argument("-t", type = float, nargs = "?", dest = "tailFraction",
+                        default = DEFAULT_TAIL_FRACTION,
+                        help = "Fraction of the samples over the peaks over "
+                               "threshold threshold")
+    parser.add_argument("-x", type = float, nargs = "?", dest = "maxShape",
+                        default = DEFAULT_MAX_SHAPE,
+                        help = "Largest accepted tail shape parameter, the "
+                               "fits with a larger shape are rejected "
+                               "(default: {:g}, must be lower than 1)"
+                               .format(DEFAULT_MAX_SHAPE))
+    parser.add_argument("-j", type = int, nargs = "?", dest = "jobs",
+                        default = os.cpu_count(),
+                        help = "Number of worker processes")
+    parser.add_argument("-g", action = "store_true", dest = "plot",
+                        help = "Render the pWCET curves")
+
+    return parser.parse_args()
+
+if __name__ == "__main__":
+    # Get the arguments
+    args = parseCommand()
+
+    try:
+        probabilities = sorted([float(p) for p in args.probabilities.split(",")],
+                               reverse = True)
+    except ValueError as exc:
+        print("Invalid probabilities: " + str(exc))
+        sys.exit(1)
+    if any([p <= 0 or p >= 1 for p in probabilities]):
+        print("Invalid probabilities: must be in ]0, 1[")
+        sys.exit(1)
+    if args.maxShape >= 1:
+        print("Invalid shape limit: must be lower than 1")
+        sys.exit(1)
+
+    # Load the statistics cache
+    if args.cachePath is None:
+        args.cachePath = StatsCache.getDefaultCachePath(args.datasetPath)
+    cache = StatsCache.StatsCache(args.cachePath)
+
+    seriesList = getSeries(args.datasetPath, args.files.split(","),
+                           StatsCache.EVT_METRICS[0], cache, args.jobs)
+    cache.save()
+    print("Cache: {} hit(s), {} miss(es)".format(cache.hits, cache.misses))
+
+    if len(seriesList) == 0:
+        print("No series found in " + args.datasetPath)
+        sys.exit(1)
+
+    os.makedirs(args.outputPath, exist_ok = True)
+
+    # Fit the series in parallel
+    print("Fitting {} series with {} processes...".format(len(seriesList),
+                                                         args.jobs))
+    results = []
+    with concurrent.futures.ProcessPoolExecutor(args.jobs) as executor:
+        futures = [executor.submit(processSeries, series, probabilities,
+                                   args.alpha, args.tailFraction,
+                                   args.maxShape)
+                   for series in seriesList]
+        for future in concurrent.futures.as_completed(futures):
+            results.append(future.result())
+
+        results.sort(key = lambda item: (item[0].mitig, item[0].setName,
+                                         item[0].filename, item[0].partId))
+
+        if args.plot:
+            plotDir = os.path.join(args.outputPath, "curves")
+            os.makedirs(plotDir, exist_ok = True)
+            list(executor.map(plotCurves, [plotDir] * len(results), results))
+
+    with open(os.path.join(args.outputPath, "pwcet_bounds.csv"), "w") as outputFile:
+        writeBounds(outputFile, results, probabilities)
+    with open(os.path.join(args.outputPath, "pwcet_curves.csv"), "w") as outputFile:
+        writeCurves(outputFile, results)
+
+    notIid = len([result for result in results if not result[1][3]])
+    if notIid != 0:
+        print("{} of {} series failed the independence and identical "
+              "distribution tests (alpha {:g})".format(notIid, len(results),
+                                                       args.alpha))
+
+    fits = [fit for result in results for fit in result[2].values()]
+    for check, reason in [("gof", "failed the goodness of fit test"),
+                          ("shape", "were rejected on their tail shape "
+                                    "(limit {:g})".format(args.maxShape))]:
+        count = len([fit for fit in fits if check in fit[6]])
+        if count != 0:
+            print("{} of {} fits {}".format(count, len(fits), reason))
+
+    print("---------------------------------")
+    print("pWCET analysis finished without error")
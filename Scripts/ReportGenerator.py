@@ -0,0 +1,370 @@
+################################################################################
+# ReportGenerator.py
+#
+# Description: This python script generates, without any user interaction, the
+# complete set of figures and summary tables of a dataset: box plots for every
+# partition, metric and environment, and histograms for every partition, metric
+# and mitigation. The figures are rendered in parallel by a pool of processes
+# using a non-GUI matplotlib backend. An index file (Markdown or HTML) linking
+# every figure and table is generated in the output folder.
+#
+# The input folder must follow the same rules as for DataVisualizer.py. The
+# data is retrieved through the statistics cache (see StatsCache.py).
+#
+# Author: Alexy Torres Aurora Dugo
+#
+# Date: 02/02/2022
+################################################################################
+
+
+################################################################################
+# IMPORTS
+################################################################################
+import os
+import argparse
+import multiprocessing
+
+# The backend must be selected before pyplot is imported by the other modules
+import matplotlib
+matplotlib.use("Agg")
+
+import StatsCache
+import DataVisualizer
+import CompareFiles
+
+################################################################################
+# CONSTANTS
+################################################################################
+REPORT_METRICS = ["ExecTime", "l2Miss", "tlbMiss"]
+REPORT_ENVTEST = ["Baseline", "ALL", "IPI", "SC", "EXT", "INT"]
+
+BOXPLOT_DIR = "boxplots"
+HIST_DIR    = "histograms"
+TABLES_DIR  = "tables"
+
+################################################################################
+# GLOBAL VARIABLES
+################################################################################
+
+# None
+
+################################################################################
+# CLASSES
+################################################################################
+
+# None
+
+################################################################################
+# FUNCTIONS
+################################################################################
+def initWorker():
+    """
+        Initializes a worker process of the rendering pool.
+
+    Parameters
+    ----------
+        None.
+
+    Return
+    ----------
+        None.
+
+    Raises
+    ----------
+        None.
+    """
+    matplotlib.use("Agg")
+
+def renderFigure(task):
+    """
+        Renders a single figure. This function is executed by the workers of
+        the rendering pool.
+
+    Parameters
+    ----------
+        task : tuple (in)
+            The figure to render: (kind, partitionData, partId, metric,
+            selection, mitigations, outputPrefix). kind is either "box" or
+            "hist", selection is the environment for box plots and the
+            mitigation for histograms.
+
+    Return
+    ----------
+        The output prefix of the rendered figure.
+
+    Raises
+    ----------
+        None.
+    """
+    kind, partitionData, partId, metric, selection, mitigations, \
+        outputPrefix = task
+
+    if kind == "box":
+        DataVisualizer.genBoxplotTypesComp(partitionData, partId, metric,
+                                           envTest = [selection],
+                                           mitigations = mitigations,
+                                           outputPrefix = outputPrefix,
+                                           show = False)
+    else:
+        CompareFiles.genHistTypes(partitionData, partId, metric,
+                                  mitigations = [selection],
+                                  outputPrefix = outputPrefix,
+                                  show = False)
+        outputPrefix += selection
+
+    return outputPrefix
+
+def genTasks(partitions, mitigations, envTest, outputDir):
+    """
+        Generates the list of figures to render.
+
+    Parameters
+    ----------
+        partitions : List[] (in)
+            The per-partition summaries generated by processDataObjects.
+        mitigations : List[str] (in)
+            The detected mitigations.
+        envTest : List[str] (in)
+            The detected environments.
+        outputDir : str (in)
+            The report output folder.
+
+    Return
+    ----------
+        The list of tasks to provide to renderFigure.
+
+    Raises
+    ----------
+        None.
+    """
+    tasks = []
+    for partId in range(len(partitions)):
+        # Only send the data of the rendered partition to the workers
+        partitionData = {partId: partitions[partId]}
+        for metric in REPORT_METRICS:
+            for envName in envTest:
+                prefix = os.path.join(outputDir, BOXPLOT_DIR,
+                                      "P{}_{}_{}".format(partId, metric,
+                                                         envName))
+                tasks.append(("box", partitionData, partId, metric, envName,
+                              mitigations, prefix))
+            for mitig in mitigations:
+                # genHistTypes appends the mitigation name to the prefix
+                prefix = os.path.join(outputDir, HIST_DIR,
+                                      "P{}_{}_".format(partId, metric))
+                tasks.append(("hist", partitionData, partId, metric, mitig,
+                              mitigations, prefix))
+
+    return tasks
+
+def genTables(dataObjArray, envTest, outputDir):
+    """
+        Generates the summary CSV tables, one per metric.
+
+    Parameters
+    ----------
+        dataObjArray : DataObject[] (in)
+            The array of dataObject to output.
+        envTest : List[str] (in)
+            The environments to output.
+        outputDir : str (in)
+            The report output folder.
+
+    Return
+    ----------
+        The list of generated tables paths.
+
+    Raises
+    ----------
+        IOError can be raised during the file manipulations.
+    """
+    tables = []
+    for metric in REPORT_METRICS:
+        path = os.path.join(outputDir, TABLES_DIR, metric + "_summary.csv")
+        with open(path, "w") as outputFile:
+            DataVisualizer.genTypeCompCSV(dataObjArray, metric, -1, envTest,
+                                          outputFile)
+        tables.append(path)
+
+    return tables
+
+def genIndex(outputDir, indexFormat, tables, partitionCount, mitigations,
+             envTest):
+    """
+        Generates the report index linking the figures and the tables.
+
+    Parameters
+    ----------
+        outputDir : str (in)
+            The report output folder.
+        indexFormat : str (in)
+            The index format, "md" or "html".
+        tables : List[str] (in)
+            The list of tables paths.
+        partitionCount : int (in)
+            The number of partitions.
+        mitigations : List[str] (in)
+            The detected mitigations.
+        envTest : List[str] (in)
+            The detected environments.
+
+    Return
+    ----------
+        The path of the generated index.
+
+    Raises
+    ----------
+        IOError can be raised during the file manipulations.
+    """
+    lines = []
+    html  = indexFormat == "html"
+
+    def title(level, text):
+        if html:
+            lines.append("<h{0}>{1}</h{0}>".format(level, text))
+        else:
+            lines.append("#" * level + " " + text + "\n")
+
+    def link(text, path):
+        path = os.path.relpath(path, outputDir)
+        if html:
+            lines.append("<li><a href=\"{}\">{}</a></li>".format(path, text))
+        else:
+            lines.append("- [{}]({})".format(text, path))
+
+    def image(text, path):
+        path = os.path.relpath(path, outputDir)
+        if html:
+            lines.append("<p>{0}<br/><a href=\"{1}.pdf\"><img src=\"{1}.png\" "
+                         "width=\"800\"/></a></p>".format(text, path))
+        else:
+            lines.append("**{0}** ([pdf]({1}.pdf))\n\n![{0}]({1}.png)\n"
+                         .format(text, path))
+
+    if html:
+        lines.append("<html><head><title>Interrupt Interference Report"
+                     "</title></head><body>")
+
+    title(1, "Interrupt Interference Report")
+    title(2, "Summary tables")
+    for table in tables:
+        link(os.path.basename(table), table)
+    if not html:
+        lines.append("")
+
+    for partId in range(partitionCount):
+        title(2, "Partition " + str(partId))
+        for metric in REPORT_METRICS:
+            title(3, metric)
+            for envName in envTest:
+                image("Box plot | " + envName,
+                      os.path.join(outputDir, BOXPLOT_DIR,
+                                   "P{}_{}_{}".format(partId, metric,
+                                                      envName)))
+            for mitig in mitigations:
+                image("Histogram | " + mitig,
+                      os.path.join(outputDir, HIST_DIR,
+                                   "P{}_{}_{}".format(partId, metric, mitig)))
+
+    if html:
+        lines.append("</body></html>")
+
+    path = os.path.join(outputDir, "index." + indexFormat)
+    with open(path, "w") as indexFile:
+        indexFile.write("\n".join(lines) + "\n")
+
+    return path
+
+def parseCommand():
+    """
+        Parses the command line to extract the following arguments:
+            -d [inputdir] The input directory to parse the extracted files.
+            -o [outputdir] The report output directory.
+            -c [cachefile] The statistics cache file.
+            -j [jobs] The number of rendering processes.
+            -f [format] The index format (md or html).
+
+    Parameters
+    ----------
+        None.
+
+    Return
+    ----------
+        The argparse object that contains the parsed command line (parse_args
+        is already called in this function).
+
+    Raises
+    ----------
+        None.
+    """
+    parser = argparse.ArgumentParser(description = "Report Generator Args Parser")
+
+    # Add command argument: dataset root folder
+    parser.add_argument("-d", type = str, nargs = "?", dest = "datasetPath",
+                        required = True,
+                        help = "Dataset root folder path")
+
+    # Add command argument: output folder
+    parser.add_argument("-o", type = str, nargs = "?", dest = "outputPath",
+                        default = "report",
+                        help = "Report output folder path")
+
+    # Add command argument: statistics cache file
+    parser.add_argument("-c", type = str, nargs = "?", dest = "cachePath",
+                        default = None,
+                        help = "Statistics cache file path (default: "
+                               "<dataset root>/" + StatsCache.CACHE_FILENAME + ")")
+
+    # Add command argument: number of rendering processes
+    parser.add_argument("-j", type = int, nargs = "?", dest = "jobs",
+                        default = os.cpu_count(),
+                        help = "Number of rendering processes")
+
+    # Add command argument: index format
+    parser.add_argument("-f", type = str, nargs = "?", dest = "indexFormat",
+                        default = "md", choices = ["md", "html"],
+                        help = "Index format")
+
+    return parser.parse_args()
+
+if __name__ == "__main__":
+    dataObjArray = []
+
+    # Get the arguments
+    args = parseCommand()
+    files = DataVisualizer.getDataSetFiles(args.datasetPath)
+
+    for folder in [BOXPLOT_DIR, HIST_DIR, TABLES_DIR]:
+        os.makedirs(os.path.join(args.outputPath, folder), exist_ok = True)
+
+    # Load the statistics cache
+    if args.cachePath is None:
+        args.cachePath = StatsCache.getDefaultCachePath(args.datasetPath)
+    cache = StatsCache.StatsCache(args.cachePath)
+
+    # Generate data object for each file
+    for filename in files:
+        dataObjArray.append(DataVisualizer.generateDataObject(filename, cache))
+
+    cache.save()
+    print("Cache: {} hit(s), {} miss(es)".format(cache.hits, cache.misses))
+
+    partitions  = DataVisualizer.processDataObjects(dataObjArray)
+    mitigations = list(DataVisualizer.detectedMitigation)
+    envTest     = [env for env in REPORT_ENVTEST
+                   if env in set([dataObj.type for dataObj in dataObjArray])]
+
+    # Render the figures
+    tasks = genTasks(partitions, mitigations, envTest, args.outputPath)
+    print("Rendering {} figures with {} processes...".format(len(tasks),
+                                                             args.jobs))
+    with multiprocessing.Pool(args.jobs, initializer = initWorker) as pool:
+        for done, prefix in enumerate(pool.imap_unordered(renderFigure, tasks)):
+            print("[{}/{}] {}".format(done + 1, len(tasks), prefix))
+
+    tables = genTables(dataObjArray, envTest, args.outputPath)
+    index  = genIndex(args.outputPath, args.indexFormat, tables,
+                      len(partitions), mitigations, envTest)
+
+    print("\n---------------------------------")
+    print("Report generated: " + index)
@@ -0,0 +1,690 @@
+################################################################################
+# StatsCache.py
+#
+# Description: This python module provides a persistent cache of the per-file,
+# per-partition and per-metric summaries computed from the extracted benchmark
+# CSV files. The summaries (counts, moments, quantile sketch, histogram, box
+# plot statistics, outliers and, for the execution times, the tail data of the
+# extreme value analysis) are only recomputed for the files that changed since
+# the last run. A file is considered unchanged when its size and modification
+# time match the cached entry, or when its content hash matches it.
+#
+# The cache is stored as a JSON file, by default at the root of the dataset
+# folder (see CACHE_FILENAME).
+#
+# Author: Alexy Torres Aurora Dugo
+#
+# Date: 02/02/2022
+################################################################################
+
+
+################################################################################
+# IMPORTS
+################################################################################
+import os
+import json
+import math
+import hashlib
+import concurrent.futures
+import pandas as pd
+import numpy as np
+
+################################################################################
+# CONSTANTS
+################################################################################
+PARTITION_COUNT = 10
+METRICS = ["ExecTime", "l2Miss", "tlbMiss"]
+
+CACHE_VERSION  = 3
+CACHE_FILENAME = ".intbench_cache.json"
+
+# Quantiles kept in the sketch: every percentile plus a finer grid on the tail
+QUANTILE_GRID = sorted(set([round(i / 100.0, 4) for i in range(101)] +
+                           [round(0.99 + i / 1000.0, 4) for i in range(10)] +
+                           [0.9995, 0.9999]))
+
+# Number of equal width bins between the minimum and the maximum of the stored
+# histograms. The scripts can only rebin to a divisor of this count.
+HISTOGRAM_BINS = 200
+
+# Maximal number of outlier values kept per partition and metric (the most
+# extreme ones are kept), the outlier count is always exact.
+MAX_OUTLIER_VALUES = 500
+
+HASH_BLOCK_SIZE = 1 << 20
+
+# Metrics summarized for the extreme value analysis (see PwcetAnalysis.py). The
+# block maxima are computed on blocks of at least EVT_MIN_BLOCK_SIZE samples in
+# measurement order, the block size grows to keep at most EVT_MAX_BLOCKS
+# maxima. The EVT_MAX_TAIL_VALUES largest samples are kept for the peaks over
+# threshold fits.
+EVT_METRICS         = ["ExecTime"]
+EVT_MIN_BLOCK_SIZE  = 50
+EVT_MAX_BLOCKS      = 1000
+EVT_MAX_TAIL_VALUES = 1000
+
+################################################################################
+# GLOBAL VARIABLES
+################################################################################
+
+# None
+
+################################################################################
+# CLASSES
+################################################################################
+
+class StatsCache:
+    """
+    Persistent summaries cache. Each entry has the following hierarchy:
+    entries[FILE_PATH]["partitions"][PART_ID][METRIC] -> summary dictionary.
+
+    - FILE_PATH is the normalized path of the CSV file.
+    - PART_ID is the partition ID (stored as a string in the JSON file).
+    - METRIC is the metric name (ExecTime, l2Miss, etc.)
+
+    """
+    def __init__(self, cachePath):
+        self.cachePath = cachePath
+        self.entries   = {}
+        self.dirty     = False
+        self.hits      = 0
+        self.misses    = 0
+
+        self.load()
+
+    def load(self):
+        """
+            Loads the cache from the disk. An invalid or outdated cache file is
+            ignored and will be overwritten on the next save.
+
+        Parameters
+        ----------
+            None.
+
+        Return
+        ----------
+            None.
+
+        Raises
+        ----------
+            None.
+        """
+        if not os.path.isfile(self.cachePath):
+            return
+
+        try:
+            with open(self.cachePath, "r") as cacheFile:
+                content = json.load(cacheFile)
+            if content.get("version") == CACHE_VERSION:
+                self.entries = content.get("entries", {})
+            else:
+                print("Cache version mismatch, rebuilding cache")
+        except (IOError, ValueError) as exc:
+            print("Cannot load cache, rebuilding it: " + str(exc))
+            self.entries = {}
+
+    def save(self):
+        """
+            Saves the cache to the disk if it was modified. The file is first
+            written to a temporary file to avoid corrupting the cache.
+
+        Parameters
+        ----------
+            None.
+
+        Return
+        ----------
+            None.
+
+        Raises
+        ----------
+            IOError can be raised during the file manipulations.
+        """
+        if not self.dirty:
+            return
+
+        tmpPath = self.cachePath + ".tmp"
+        with open(tmpPath, "w") as cacheFile:
+            json.dump({"version": CACHE_VERSION, "entries": self.entries},
+                      cacheFile)
+        os.replace(tmpPath, self.cachePath)
+        self.dirty = False
+
+    def getSummary(self, filename):
+        """
+            Returns the summary of a file. The summary is computed and stored
+            in the cache if the file is not cached or if it was modified.
+
+        Parameters
+        ----------
+            filename : str (in)
+                The path to the CSV file to summarize.
+
+        Return
+        ----------
+            The summary dictionary, indexed by partition ID (int) then metric.
+
+        Raises
+        ----------
+            IOError, RuntimeError and others can be raised during the files
+            manipulations.
+        """
+        partitions, fileHash = self.lookup(filename)
+        if partitions is not None:
+            return partitions
+
+        print("Summarizing {}...".format(filename))
+        partitions = summarizeFile(filename)
+        self.store(filename, fileHash, partitions)
+
+        return partitions
+
+    def getSummaries(self, filenames, jobs):
+        """
+            Returns the summaries of a list of files. The files that are not
+            cached or were modified are summarized in parallel.
+
+        Parameters
+        ----------
+            filenames : List[str] (in)
+                The paths to the CSV files to summarize.
+            jobs : int (in)
+                The number of worker processes.
+
+        Return
+        ----------
+            The dictionary of summaries indexed by file path.
+
+        Raises
+        ----------
+            IOError, RuntimeError and others can be raised during the files
+            manipulations.
+        """
+        summaries = {}
+        missing   = {}
+        for filename in filenames:
+            summaries[filename], fileHash = self.lookup(filename)
+            if summaries[filename] is None:
+                missing[filename] = fileHash
+
+        if len(missing) == 0:
+            return summaries
+
+        print("Summarizing {} file(s) with {} processes...".format(len(missing),
+                                                                  jobs))
+        with concurrent.futures.ProcessPoolExecutor(jobs) as executor:
+            futures = {executor.submit(summarizeFile, filename): filename
+                       for filename in missing}
+            for future in concurrent.futures.as_completed(futures):
+                filename = futures[future]
+                summaries[filename] = future.result()
+                self.store(filename, missing[filename], summaries[filename])
+                print("Summarized " + filename)
+
+        return summaries
+
+    def lookup(self, filename):
+        """
+            Returns the cached summary of a file if the file did not change
+            since it was summarized.
+
+        Parameters
+        ----------
+            filename : str (in)
+                The path to the CSV file.
+
+        Return
+        ----------
+            The tuple (summary, fileHash). The summary is None when the file is
+            not cached or was modified, fileHash is then the hash to give to
+            store.
+
+        Raises
+        ----------
+            IOError can be raised during the file manipulations.
+        """
+        key   = os.path.normpath(os.path.abspath(filename))
+        stat  = os.stat(filename)
+        entry = self.entries.get(key)
+
+        if entry is not None:
+            if(entry["size"] == stat.st_size and
+               entry["mtime"] == stat.st_mtime_ns):
+                self.hits += 1
+                return toPartitionDict(entry["partitions"]), entry["hash"]
+
+            # Timestamp changed, check if the content actually changed
+            fileHash = hashFile(filename)
+            if(entry["size"] == stat.st_size and entry["hash"] == fileHash):
+                entry["mtime"] = stat.st_mtime_ns
+                self.dirty = True
+                self.hits += 1
+                return toPartitionDict(entry["partitions"]), fileHash
+        else:
+            fileHash = hashFile(filename)
+
+        return None, fileHash
+
+    def store(self, filename, fileHash, partitions):
+        """
+            Stores the summary of a file in the cache.
+
+        Parameters
+        ----------
+            filename : str (in)
+                The path to the summarized CSV file.
+            fileHash : str (in)
+                The hash of the file content returned by lookup.
+            partitions : dict (in)
+                The summary dictionary returned by summarizeFile.
+
+        Return
+        ----------
+            None.
+
+        Raises
+        ----------
+            IOError can be raised during the file manipulations.
+        """
+        stat = os.stat(filename)
+        self.misses += 1
+        self.entries[os.path.normpath(os.path.abspath(filename))] = {
+            "size":       stat.st_size,
+            "mtime":      stat.st_mtime_ns,
+            "hash":       fileHash,
+            "partitions": {str(k): v for k, v in partitions.items()}}
+        self.dirty = True
+
+    def prune(self, filenames):
+        """
+            Removes the entries that are not part of the file list given as
+            parameter.
+
+        Parameters
+        ----------
+            filenames : List[str] (in)
+                The list of files to keep in the cache.
+
+        Return
+        ----------
+            None.
+
+        Raises
+        ----------
+            None.
+        """
+        keep = set([os.path.normpath(os.path.abspath(f)) for f in filenames])
+        for key in list(self.entries.keys()):
+            if key not in keep:
+                del self.entries[key]
+                self.dirty = True
+
+################################################################################
+# FUNCTIONS
+################################################################################
+def hashFile(filename):
+    """
+        Computes the SHA1 hash of a file content.
+
+    Parameters
+    ----------
+        filename : str (in)
+            The path to the file to hash.
+
+    Return
+    ----------
+        The hexadecimal digest of the file content.
+
+    Raises
+    ----------
+        IOError can be raised during the file manipulations.
+    """
+    sha = hashlib.sha1()
+    with open(filename, "rb") as inputFile:
+        for block in iter(lambda: inputFile.read(HASH_BLOCK_SIZE), b""):
+            sha.update(block)
+    return sha.hexdigest()
+
+def toPartitionDict(jsonPartitions):
+    """
+        Converts the JSON partitions dictionary (string keys) to the summary
+        dictionary indexed by integer partition ID.
+
+    Parameters
+    ----------
+        jsonPartitions : dict (in)
+            The partitions dictionary as stored in the JSON cache.
+
+    Return
+    ----------
+        The partitions dictionary indexed by integer partition ID.
+
+    Raises
+    ----------
+        None.
+    """
+    return {int(k): v for k, v in jsonPartitions.items()}
+
+def loadDataFrame(filename):
+    """
+        Loads an extracted CSV file and applies the same cleaning as the
+        visualization scripts: the first 2 executions of each partition are
+        dropped as they contain noisy measurements and the type column is
+        removed.
+
+    Parameters
+    ----------
+        filename : str (in)
+            The path to the CSV file to load.
+
+    Return
+    ----------
+        The cleaned data frame.
+
+    Raises
+    ----------
+        IOError, RuntimeError and others can be raised during the files
+        manipulations.
+    """
+    dataFrame = pd.read_csv(filename)
+
+    # Drop the first 2 executions for each partition, they contain noisy measurements
+    dataFrame.drop(index = dataFrame.index[:PARTITION_COUNT * 2], axis = "index",
+                   inplace = True)
+
+    # Drop the first column and sort by partition ID
+    dataFrame.drop(labels = "Type", axis = "columns", inplace = True)
+    dataFrame.sort_values(by = "Id", axis = "index", inplace = True,
+                          kind = "stable")
+
+    return dataFrame
+
+def summarizeTail(values):
+    """
+        Computes the data of the extreme value analysis of a set of samples:
+        the block maxima, the largest samples and the statistics of the
+        independence and identical distribution tests. The block maxima and
+        the tests depend on the measurement order.
+
+        - lag1: lag 1 autocorrelation coefficient.
+        - runsZ: z-score of the Wald-Wolfowitz runs test around the median.
+        - ksHalves: Kolmogorov-Smirnov statistic between the first and the
+          second half of the samples.
+
+    Parameters
+    ----------
+        values : np.ndarray (in)
+            The samples in measurement order.
+
+    Return
+    ----------
+        The extreme value analysis dictionary.
+
+    Raises
+    ----------
+        None.
+    """
+    count = len(values)
+
+    blockSize = max(EVT_MIN_BLOCK_SIZE, int(math.ceil(count / EVT_MAX_BLOCKS)))
+    blocks    = count // blockSize
+    maxima    = values[:blocks * blockSize].reshape(blocks, blockSize).max(axis = 1)
+
+    tail = np.sort(values)[max(0, count - EVT_MAX_TAIL_VALUES):]
+
+    # Independence: lag 1 autocorrelation and runs above and below the median
+    diff = values - values.mean()
+    var  = float(np.sum(diff ** 2))
+    lag1 = float(np.sum(diff[1:] * diff[:-1]) / var) if var > 0 else 0.0
+
+    median = np.median(values)
+    above  = values[values != median] > median
+    nAbove = int(np.count_nonzero(above))
+    nBelow = len(above) - nAbove
+    runsZ  = 0.0
+    if nAbove > 0 and nBelow > 0:
+        runs    = 1 + int(np.count_nonzero(above[1:] != above[:-1]))
+        total   = nAbove + nBelow
+        mean    = 2.0 * nAbove * nBelow / total + 1
+        runsVar = (mean - 1) * (mean - 2) / (total - 1)
+        if runsVar > 0:
+            runsZ = float((runs - mean) / math.sqrt(runsVar))
+
+    # Identical distribution: first half against second half
+    first    = np.sort(values[:count // 2])
+    second   = np.sort(values[count // 2:])
+    ksHalves = 0.0
+    if len(first) > 0 and len(second) > 0:
+        points   = np.concatenate([first, second])
+        ksHalves = float(np.max(np.abs(
+            np.searchsorted(first, points, side = "right") / len(first) -
+            np.searchsorted(second, points, side = "right") / len(second))))
+
+    return {
+        "blockSize":   blockSize,
+        "blockMaxima": [float(v) for v in maxima],
+        "tail":        [float(v) for v in tail],
+        "lag1":        lag1,
+        "runsZ":       runsZ,
+        "ksHalves":    ksHalves
+    }
+
+def summarizeSeries(values, evt = False):
+    """
+        Computes the summary of a set of samples: count, central moments,
+        quantile sketch, histogram, box plot statistics and outliers (1.5 IQR
+        rule).
+
+    Parameters
+    ----------
+        values : np.ndarray (in)
+            The samples to summarize, in measurement order.
+        evt : bool (in)
+            Adds the extreme value analysis data (see summarizeTail) to the
+            summary.
+
+    Return
+    ----------
+        The summary dictionary.
+
+    Raises
+    ----------
+        None.
+    """
+    values  = np.asarray(values, dtype = np.float64)
+    evtData = summarizeTail(values) if evt else None
+
+    values = np.sort(values)
+    count  = len(values)
+    mean   = float(values.mean())
+    diff   = values - mean
+
+    quantiles = np.quantile(values, QUANTILE_GRID)
+    histogram = np.histogram(values, HISTOGRAM_BINS)[0]
+    q1, median, q3 = np.quantile(values, [0.25, 0.5, 0.75])
+    iqr = q3 - q1
+
+    lowFence  = q1 - 1.5 * iqr
+    highFence = q3 + 1.5 * iqr
+    inFences  = values[(values >= lowFence) & (values <= highFence)]
+    lowOut    = values[values < lowFence]
+    highOut   = values[values > highFence]
+
+    # Keep the most extreme outliers when there are too many
+    keepLow  = min(len(lowOut), MAX_OUTLIER_VALUES // 2)
+    keepHigh = min(len(highOut), MAX_OUTLIER_VALUES - keepLow)
+    outlierValues = lowOut[:keepLow].tolist() + \
+                    highOut[len(highOut) - keepHigh:].tolist()
+
+    summary = {
+        "count":     count,
+        "min":       float(values[0]),
+        "max":       float(values[-1]),
+        "mean":      mean,
+        "m2":        float(np.sum(diff ** 2)),
+        "m3":        float(np.sum(diff ** 3)),
+        "m4":        float(np.sum(diff ** 4)),
+        "stdev":     float(values.std(ddof = 1)) if count > 1 else float("nan"),
+        "median":    float(median),
+        "q1":        float(q1),
+        "q3":        float(q3),
+        "whislo":    float(inFences[0]) if len(inFences) else float(q1),
+        "whishi":    float(inFences[-1]) if len(inFences) else float(q3),
+        "quantiles": [float(q) for q in quantiles],
+        "histogram": [int(c) for c in histogram],
+        "outliers":  int(len(lowOut) + len(highOut)),
+        "outlierValues": outlierValues
+    }
+    if evtData is not None:
+        summary["evt"] = evtData
+
+    return summary
+
+def summarizeFile(filename):
+    """
+        Computes the summaries of every partition and metric of a CSV file.
+
+    Parameters
+    ----------
+        filename : str (in)
+            The path to the CSV file to summarize.
+
+    Return
+    ----------
+        The summary dictionary, indexed by partition ID (int) then metric.
+
+    Raises
+    ----------
+        IOError, RuntimeError and others can be raised during the files
+        manipulations.
+    """
+    dataFrame  = loadDataFrame(filename)
+    partitions = {}
+
+    for partId, group in dataFrame.groupby("Id"):
+        partitions[int(partId)] = {}
+        for metric in METRICS:
+            if metric in group:
+                partitions[int(partId)][metric] = \
+                    summarizeSeries(group[metric].values,
+                                    metric in EVT_METRICS)
+
+    return partitions
+
+def getQuantile(summary, q):
+    """
+        Returns an approximated quantile from the summary's quantile sketch,
+        values between the sketch points are linearly interpolated.
+
+    Parameters
+    ----------
+        summary : dict (in)
+            The summary to use.
+        q : float (in)
+            The quantile to retrieve, between 0 and 1.
+
+    Return
+    ----------
+        The approximated quantile value.
+
+    Raises
+    ----------
+        None.
+    """
+    return float(np.interp(q, QUANTILE_GRID, summary["quantiles"]))
+
+def getBoxStats(summary, label = None):
+    """
+        Generates the box plot statistics used by matplotlib's Axes.bxp from a
+        summary. The notch confidence interval is computed as matplotlib does
+        (median +/- 1.57 * IQR / sqrt(N)).
+
+    Parameters
+    ----------
+        summary : dict (in)
+            The summary to use.
+        label : str (in)
+            The label of the box.
+
+    Return
+    ----------
+        The statistics dictionary to provide to Axes.bxp.
+
+    Raises
+    ----------
+        None.
+    """
+    iqr   = summary["q3"] - summary["q1"]
+    notch = 1.57 * iqr / np.sqrt(summary["count"])
+
+    stats = {"med":    summary["median"],
+             "q1":     summary["q1"],
+             "q3":     summary["q3"],
+             "whislo": summary["whislo"],
+             "whishi": summary["whishi"],
+             "cilo":   summary["median"] - notch,
+             "cihi":   summary["median"] + notch,
+             "mean":   summary["mean"],
+             "fliers": summary["outlierValues"]}
+    if label is not None:
+        stats["label"] = label
+
+    return stats
+
+def getHistogram(summary, bins = HISTOGRAM_BINS):
+    """
+        Generates the histogram of the summary's samples from the stored bin
+        counts. The stored bins are merged when fewer bins are requested, the
+        counts are exact.
+
+    Parameters
+    ----------
+        summary : dict (in)
+            The summary to use.
+        bins : int (in)
+            The number of bins, must divide HISTOGRAM_BINS.
+
+    Return
+    ----------
+        The tuple (values, weights, edges) to provide to the histogram
+        function: hist(values, edges, weights = weights).
+
+    Raises
+    ----------
+        ValueError if bins does not divide HISTOGRAM_BINS.
+    """
+    if bins <= 0 or HISTOGRAM_BINS % bins != 0:
+        raise ValueError("The histogram bin count must divide " +
+                         str(HISTOGRAM_BINS))
+
+    # Same edges as numpy.histogram on the samples
+    low  = summary["min"]
+    high = summary["max"]
+    if low == high:
+        low  -= 0.5
+        high += 0.5
+
+    edges   = np.linspace(low, high, bins + 1)
+    weights = np.asarray(summary["histogram"]).reshape(bins, -1).sum(axis = 1)
+    values  = (edges[1:] + edges[:-1]) / 2.0
+
+    return values, weights, edges
+
+def getDefaultCachePath(rootPath):
+    """
+        Returns the default path of the cache file for a dataset.
+
+    Parameters
+    ----------
+        rootPath : str (in)
+            The path to the dataset root folder.
+
+    Return
+    ----------
+        The path to the cache file.
+
+    Raises
+    ----------
+        None.
+    """
+    return os.path.join(rootPath, CACHE_FILENAME)
@@ -0,0 +1,370 @@
+################################################################################
+# TickBreakdown.py
+#
+# Description: This python script breaks down the payload execution times into
+# the OS tick cost and the payload cost. For every configuration of a dataset
+# that has tick records (TICK_output.csv, see TickInterference.h), the tick
+# load (tick frequency times the mean tick handler time) gives the share of a
+# sample spent in the tick handlers:
+# - TickCost = ExecTimeMean * TickLoad, PayloadCost = ExecTimeMean - TickCost.
+# - WorstTickCost bounds the tick time of the longest sample: the number of
+#   ticks that can hit it times the longest tick handler time.
+#
+# Several datasets measured at different tick frequencies can be given (-d).
+# The configurations are matched by mitigation, set and partition, the Gain
+# column is the reduction of the mean execution time relative to the highest
+# tick frequency: it tells, for each memory mitigation, whether a lower tick
+# rate is worth it.
+#
+# The input folders must follow the same rules as for DataVisualizer.py. The
+# script works on the cached summaries of each dataset (see StatsCache.py).
+#
+# Author: Alexy Torres Aurora Dugo
+#
+# Date: 03/03/2022
+################################################################################
+
+
+################################################################################
+# IMPORTS
+################################################################################
+import os
+import sys
+import math
+import argparse
+import pandas as pd
+
+import StatsCache
+
+################################################################################
+# CONSTANTS
+################################################################################
+TICK_FILENAME = "TICK_output.csv"
+PART_FILENAME = "PART_output.csv"
+METRIC        = "ExecTime"
+
+NS_PER_SEC = 1e9
+
+################################################################################
+# GLOBAL VARIABLES
+################################################################################
+
+# None
+
+################################################################################
+# CLASSES
+################################################################################
+
+class Configuration:
+    """
+    Describes a configuration with tick records: the dataset, the mitigation,
+    the set, the tick frequency and the tick and payload files.
+    """
+    def __init__(self, rootPath, mitig, setName, tickFile, partFile):
+        self.rootPath = rootPath
+        self.mitig    = mitig
+        self.setName  = setName
+        self.tickFile = tickFile
+        self.partFile = partFile
+        self.tickHz   = 0
+
+################################################################################
+# FUNCTIONS
+################################################################################
+def getTickFrequency(tickFile):
+    """
+        Returns the tick frequency of a tick file, written on every record by
+        ExtractionConv.py.
+
+    Parameters
+    ----------
+        tickFile : str (in)
+            The path to the tick file.
+
+    Return
+    ----------
+        The tick frequency (Hz), 0 when the file has no record.
+
+    Raises
+    ----------
+        IOError can be raised during the files manipulations.
+    """
+    dataFrame = pd.read_csv(tickFile, nrows = 1)
+    if len(dataFrame) == 0:
+        return 0
+
+    return int(dataFrame["TickHz"].iloc[0])
+
+def getConfigurations(rootPath):
+    """
+        Generates the list of configurations of a dataset that have both tick
+        and payload records.
+
+    Parameters
+    ----------
+        rootPath : str (in)
+            The path to the input directory.
+
+    Return
+    ----------
+        The list of configurations.
+
+    Raises
+    ----------
+        IOError can be raised during the files manipulations.
+    """
+    configs = []
+
+    for folder in sorted(os.listdir(rootPath)):
+        splited = folder.split("_")
+        if(len(splited) != 2 or splited[1] != "mitig"):
+            continue
+
+        for sets in sorted(os.listdir(os.path.join(rootPath, folder))):
+            if(len(sets.split("_")) != 3 and sets != "Baseline"):
+                continue
+            tickFile = os.path.join(rootPath, folder, sets, TICK_FILENAME)
+            partFile = os.path.join(rootPath, folder, sets, PART_FILENAME)
+            if os.path.isfile(tickFile) and os.path.isfile(partFile):
+                configs.append(Configuration(rootPath, splited[0], sets,
+                                             tickFile, partFile))
+
+    return configs
+
+def mergeTickSummaries(tickSummary):
+    """
+        Merges the tick handler time summaries of the cores of a tick file.
+
+    Parameters
+    ----------
+        tickSummary : dict (in)
+            The summary of the tick file, indexed by core then metric.
+
+    Return
+    ----------
+        The tuple (count, mean, max) of the tick handler times, None if the
+        file has no tick.
+
+    Raises
+    ----------
+        None.
+    """
+    count = 0
+    total = 0.0
+    worst = 0.0
+    for coreSummary in tickSummary.values():
+        if METRIC not in coreSummary:
+            continue
+        count += coreSummary[METRIC]["count"]
+        total += coreSummary[METRIC]["count"] * coreSummary[METRIC]["mean"]
+        worst  = max(worst, coreSummary[METRIC]["max"])
+
+    if count == 0:
+        return None
+
+    return count, total / count, worst
+
+def breakdownConfiguration(config, tickSummary, partSummary):
+    """
+        Breaks down the execution times of the partitions of a configuration
+        into the tick cost and the payload cost.
+
+    Parameters
+    ----------
+        config : Configuration (in)
+            The configuration to process.
+        tickSummary : dict (in)
+            The summary of the tick file.
+        partSummary : dict (in)
+            The summary of the payload file.
+
+    Return
+    ----------
+        The list of rows (dictionaries) of the configuration, one per
+        partition.
+
+    Raises
+    ----------
+        None.
+    """
+    ticks = mergeTickSummaries(tickSummary)
+    if ticks is None or config.tickHz == 0:
+        return []
+
+    tickCount, tickMean, tickMax = ticks
+    tickLoad = config.tickHz * tickMean / NS_PER_SEC
+
+    rows = []
+    for partId, summary in sorted(partSummary.items()):
+        if METRIC not in summary:
+            continue
+        execMean = summary[METRIC]["mean"]
+        execMax  = summary[METRIC]["max"]
+        worstTicks = math.ceil(execMax * config.tickHz / NS_PER_SEC)
+        rows.append({
+            "Mitigation":    config.mitig,
+            "Set":           config.setName,
+            "Part":          partId,
+            "TickHz":        config.tickHz,
+            "Ticks":         tickCount,
+            "TickMean":      tickMean,
+            "TickMax":       tickMax,
+            "TickLoad":      tickLoad,
+            "ExecTimeMean":  execMean,
+            "TickCost":      execMean * tickLoad,
+            "PayloadCost":   execMean * (1.0 - tickLoad),
+            "ExecTimeMax":   execMax,
+            "WorstTickCost": worstTicks * tickMax,
+            "Gain":          None
+        })
+
+    return rows
+
+def computeGains(rows):
+    """
+        Computes the gain of every row relative to the highest tick frequency
+        measured for the same mitigation, set and partition.
+
+    Parameters
+    ----------
+        rows : List[dict] (in/out)
+            The breakdown rows, their Gain is updated.
+
+    Return
+    ----------
+        None.
+
+    Raises
+    ----------
+        None.
+    """
+    groups = {}
+    for row in rows:
+        groups.setdefault((row["Mitigation"], row["Set"], row["Part"]),
+                          []).append(row)
+
+    for groupRows in groups.values():
+        if len(set([row["TickHz"] for row in groupRows])) < 2:
+            continue
+        reference = max(groupRows, key = lambda row: row["TickHz"])
+        for row in groupRows:
+            row["Gain"] = (reference["ExecTimeMean"] - row["ExecTimeMean"]) / \
+                          reference["ExecTimeMean"] * 100.0
+
+def writeBreakdown(outputFile, rows):
+    """
+        Writes the breakdown rows in CSV format.
+
+    Parameters
+    ----------
+        outputFile : File (out)
+            The file to write the table to.
+        rows : List[dict] (in)
+            The breakdown rows.
+
+    Return
+    ----------
+        None.
+
+    Raises
+    ----------
+        IOError can be raised during the files manipulations.
+    """
+    columns = ["Mitigation", "Set", "Part", "TickHz", "Ticks", "TickMean",
+               "TickMax", "TickLoad", "ExecTimeMean", "TickCost",
+               "PayloadCost", "ExecTimeMax", "WorstTickCost", "Gain"]
+    outputFile.write(",".join(columns) + "\n")
+    for row in rows:
+        outputFile.write(",".join(["" if row[column] is None else
+                                   "{:.6g}".format(row[column])
+                                   if isinstance(row[column], float) else
+                                   str(row[column]) for column in columns]) +
+                         "\n")
+
+def parseCommand():
+    """
+        Parses the command line to extract the following arguments:
+            -d [inputdirs] The input directories to parse the extracted files.
+            -o [outputdir] The output directory of the breakdown table.
+            -j [jobs] The number of worker processes.
+
+    Parameters
+    ----------
+        None.
+
+    Return
+    ----------
+        The argparse object that contains the parsed command line (parse_args
+        is already called in this function).
+
+    Raises
+    ----------
+        None.
+    """
+    parser = argparse.ArgumentParser(description = "Tick Breakdown Args Parser")
+
+    parser.add_argument("-d", type = str, nargs = "+", dest = "datasetPaths",
+                        required = True,
+                        help = "Dataset root folder paths, one per tick "
+                               "frequency")
+    parser.add_argument("-o", type = str, nargs = "?", dest = "outputPath",
+                        default = "tick",
+                        help = "Breakdown table output folder path")
+    parser.add_argument("-j", type = int, nargs = "?", dest = "jobs",
+                        default = os.cpu_count(),
+                        help = "Number of worker processes")
+
+    return parser.parse_args()
+
+if __name__ == "__main__":
+    # Get the arguments
+    args = parseCommand()
+
+    rows = []
+    for rootPath in args.datasetPaths:
+        configs = getConfigurations(rootPath)
+        if len(configs) == 0:
+            print("No tick records found in " + rootPath)
+            continue
+
+        # Each dataset has its own statistics cache
+        cache = StatsCache.StatsCache(StatsCache.getDefaultCachePath(rootPath))
+        summaries = cache.getSummaries([config.tickFile for config in configs] +
+                                       [config.partFile for config in configs],
+                                       args.jobs)
+        cache.save()
+        print("{}: {} configuration(s), cache: {} hit(s), {} miss(es)".format(
+              rootPath, len(configs), cache.hits, cache.misses))
+
+        for config in configs:
+            config.tickHz = getTickFrequency(config.tickFile)
+            rows += breakdownConfiguration(config, summaries[config.tickFile],
+                                           summaries[config.partFile])
+
+    if len(rows) == 0:
+        print("No configuration with tick records found")
+        sys.exit(1)
+
+    computeGains(rows)
+    rows.sort(key = lambda row: (row["Mitigation"], row["Set"], row["Part"],
+                                 -row["TickHz"]))
+
+    os.makedirs(args.outputPath, exist_ok = True)
+    with open(os.path.join(args.outputPath, "tick_breakdown.csv"), "w") as outputFile:
+        writeBreakdown(outputFile, rows)
+
+    # Summary: tick load and gain of each mitigation and tick frequency,
+    # averaged over the sets and partitions
+    print("")
+    print("Mitigation,TickHz,TickLoad,Gain")
+    summary = {}
+    for row in rows:
+        summary.setdefault((row["Mitigation"], row["TickHz"]), []).append(row)
+    for (mitig, tickHz), groupRows in sorted(summary.items()):
+        gains = [row["Gain"] for row in groupRows if row["Gain"] is not None]
+        print("{},{},{:.4%},{}".format(mitig, tickHz,
+              sum([row["TickLoad"] for row in groupRows]) / len(groupRows),
+              "{:.2f}%".format(sum(gains) / len(gains)) if len(gains) else ""))
+
+    print("---------------------------------")
+    print("Breakdown finished without error")
@@ -0,0 +1,181 @@
+################################################################################
+# TraceConv.py
+#
+# Description: This python script converts a captured interrupt arrival log to
+# the binary trace format replayed by the trace replay generators (see
+# RTOS_Benchmark/TraceReplay.h). The log is a CSV file with the following
+# columns:
+#     Time: arrival time (ns).
+#     Type: interrupt type (SC, IntINT, ExtINT, IPI).
+#     Dst:  destination core.
+#
+# The events are sorted by arrival time and, unless -k is given, the times are
+# made relative to the first event. The trace is written with the byte order
+# of the target (big endian for the T2080 by default).
+#
+# Author: Alexy Torres Aurora Dugo
+#
+# Date: 03/03/2022
+################################################################################
+
+
+################################################################################
+# IMPORTS
+################################################################################
+import sys
+import csv
+import struct
+import argparse
+
+################################################################################
+# CONSTANTS
+################################################################################
+TRACE_MAGIC = b"IBTR"
+TRACE_BOM   = 0x01020304
+
+# Interrupt types (INT_BENCH_TYPE_* in OSAbstractionLayer.h)
+TRACE_TYPES = {"SC": 1, "IntINT": 2, "ExtINT": 3, "IPI": 4}
+
+BYTE_ORDERS = {"big": ">", "little": "<"}
+
+################################################################################
+# GLOBAL VARIABLES
+################################################################################
+
+# None
+
+################################################################################
+# CLASSES
+################################################################################
+
+# None
+
+################################################################################
+# FUNCTIONS
+################################################################################
+def loadLog(filename):
+    """
+        Loads the arrival log and returns its events sorted by arrival time.
+
+    Parameters
+    ----------
+        filename : str (in)
+            The CSV arrival log.
+
+    Return
+    ----------
+        The list of (time, type, destination core) events.
+
+    Raises
+    ----------
+        IOError if the file cannot be read, RuntimeError if an event is
+        invalid.
+    """
+    events = []
+    with open(filename, "r", newline = "") as inputFile:
+        for line, row in enumerate(csv.DictReader(inputFile), start = 2):
+            try:
+                intType = row["Type"].strip()
+                if intType not in TRACE_TYPES:
+                    raise ValueError("unknown type \"" + intType + "\"")
+                time = int(row["Time"])
+                dst  = int(row["Dst"])
+                if time < 0 or dst < 0:
+                    raise ValueError("negative value")
+            except (KeyError, ValueError, AttributeError) as exc:
+                raise RuntimeError("Invalid event line " + str(line) + ": " +
+                                   str(exc))
+            events.append((time, TRACE_TYPES[intType], dst))
+
+    events.sort(key = lambda event: event[0])
+    return events
+
+def writeTrace(filename, events, byteOrder, keepTime):
+    """
+        Writes the binary trace.
+
+    Parameters
+    ----------
+        filename : str (in)
+            The output trace file.
+        events : list (in)
+            The (time, type, destination core) events sorted by time.
+        byteOrder : str (in)
+            The struct byte order character of the target.
+        keepTime : bool (in)
+            Keeps the arrival times instead of making them relative to the
+            first event.
+
+    Return
+    ----------
+        None.
+
+    Raises
+    ----------
+        IOError if the file cannot be written.
+    """
+    origin = 0
+    if not keepTime and len(events) > 0:
+        origin = events[0][0]
+
+    with open(filename, "wb") as outputFile:
+        outputFile.write(TRACE_MAGIC)
+        outputFile.write(struct.pack(byteOrder + "III", TRACE_BOM,
+                                     len(events), 0))
+        for time, intType, dst in events:
+            outputFile.write(struct.pack(byteOrder + "QII", time - origin,
+                                         intType, dst))
+
+def parseCommand():
+    """
+        Parses the command line to extract the following arguments:
+            -i [file] The CSV arrival log.
+            -o [file] The binary trace.
+            -e [order] The byte order of the target (big or little).
+            -k Keeps the arrival times.
+
+    Parameters
+    ----------
+        None.
+
+    Return
+    ----------
+        The argparse object that contains the parsed command line (parse_args
+        is already called in this function).
+
+    Raises
+    ----------
+        None.
+    """
+    parser = argparse.ArgumentParser(description = "Trace Converter Args Parser")
+
+    parser.add_argument("-i", type = str, dest = "inputFilename",
+                        required = True,
+                        help = "CSV arrival log (Time,Type,Dst)")
+    parser.add_argument("-o", type = str, dest = "outputFilename",
+                        required = True,
+                        help = "Binary trace file")
+    parser.add_argument("-e", type = str, dest = "byteOrder",
+                        choices = sorted(BYTE_ORDERS.keys()), default = "big",
+                        help = "Byte order of the target (default: big)")
+    parser.add_argument("-k", action = "store_true", dest = "keepTime",
+                        help = "Keep the arrival times instead of making "
+                               "them relative to the first event")
+
+    return parser.parse_args()
+
+if __name__ == "__main__":
+    # Get the arguments
+    args = parseCommand()
+
+    try:
+        events = loadLog(args.inputFilename)
+        writeTrace(args.outputFilename, events, BYTE_ORDERS[args.byteOrder],
+                   args.keepTime)
+    except (IOError, RuntimeError) as exc:
+        print("Error while converting the trace: " + str(exc))
+        sys.exit(1)
+
+    print("Converted {} events".format(len(events)))
+    print("---------------------------------")
+    print("Trace conversion finished without error")